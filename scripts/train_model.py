@@ -10,6 +10,9 @@ import os
 import sys
 import json
 import argparse
+import struct
+import time
+import zlib
 import numpy as np
 from pathlib import Path
 from datetime import datetime
@@ -22,11 +25,43 @@ FEATURE_NAMES = [
     'response_time', 'beacon_count', 'beacon_jitter',
     'responds_to_probe', 'probe_response_time',
     'vendor_ie_count', 'supported_rates', 'ht_capabilities', 'vht_capabilities',
-    'anomaly_score'
+    'anomaly_score', 'twin_score'
 ]
 
+# All 32 vector slots as named in a PCTS file (24..31 reserved)
+TRAINING_FEATURE_COLUMNS = FEATURE_NAMES + [f'f{i}' for i in range(24, 32)]
+
 LABELS = ['normal', 'rogue_ap', 'evil_twin', 'deauth_target', 'vulnerable']
 
+# Quantized model format - must match src/ml/quant_model.h
+QMODEL_MAGIC = 0x4C4D4350  # "PCML"
+QMODEL_FORMAT_VERSION = 1
+QMODEL_MAX_LAYERS = 4
+QMODEL_MAX_WIDTH = 128
+QMODEL_FLAG_FOLDED_NORM = 0x0001
+QMODEL_HEADER = struct.Struct('<IHH16sHHIII')  # 40 bytes
+QMODEL_LAYER = struct.Struct('<HHB3xfI')       # 16 bytes
+ACT_LINEAR = 0
+ACT_RELU = 1
+
+# Normalization statistics snapshot - must match src/ml/norm_stats.h
+NORM_STATS_MAGIC = 0x534E4350  # "PCNS"
+NORM_STATS_FORMAT_VERSION = 1
+NORM_STATS_FEATURES = 32       # FEATURE_VECTOR_SIZE
+NORM_STATS_HEADER = struct.Struct('<IHH6sHII')  # 24 bytes
+NORM_KIND_LOCAL = 0
+NORM_KIND_FLEET = 1
+
+# Columnar training set - must match src/ml/training_set.h
+TRAINING_SET_MAGIC = 0x53544350  # "PCTS"
+TRAINING_SET_FORMAT_VERSION = 1
+TRAINING_SET_HEADER = struct.Struct('<IHHIII12s')  # 32 bytes
+TRAINING_SET_COLUMN = struct.Struct('<24s4sI')     # 32 bytes
+
+# WarhogMode::exportMLTraining label column -> MLLabel class index
+# (0 = unknown is skipped for training)
+CSV_LABEL_TO_CLASS = {1: 0, 2: 1, 3: 2, 4: 4}
+
 
 def load_capture_data(filepath):
     """Load captured WiFi data from Porkchop export format."""
@@ -61,8 +96,11 @@ def extract_features(entry):
     """Extract feature vector from capture entry."""
     features = np.zeros(32, dtype=np.float32)
     
+    n = len(FEATURE_NAMES)
     if 'features' in entry and len(entry['features']) >= 23:
-        features[:23] = entry['features'][:23]
+        # Exports before twin_score have 23 values
+        k = min(n, len(entry['features']))
+        features[:k] = entry['features'][:k]
     else:
         # Basic features from simple capture
         features[0] = entry.get('rssi', -80)
@@ -176,12 +214,721 @@ const float FEATURE_STDS[FEATURE_VECTOR_SIZE] = {{
     print(f"C header exported to {output_path}")
 
 
+def label_index(entry):
+    """Map an entry's label (name or index) to a class index."""
+    label = entry.get('label', 'normal')
+    if isinstance(label, int):
+        return label if 0 <= label < len(LABELS) else 0
+    return LABELS.index(label) if label in LABELS else 0
+
+
+def train_mlp(X, y, hidden=32, epochs=300, lr=0.05, seed=1):
+    """Train a one-hidden-layer ReLU MLP with softmax output (full-batch GD).
+
+    X is expected to be z-scored already. Returns [(W, b, activation), ...]
+    with W shaped (out, in).
+    """
+    rng = np.random.default_rng(seed)
+    n, d = X.shape
+    k = len(LABELS)
+    W1 = rng.normal(0, np.sqrt(2.0 / d), (hidden, d)).astype(np.float32)
+    b1 = np.zeros(hidden, dtype=np.float32)
+    W2 = rng.normal(0, np.sqrt(2.0 / hidden), (k, hidden)).astype(np.float32)
+    b2 = np.zeros(k, dtype=np.float32)
+    Y = np.eye(k, dtype=np.float32)[y]
+
+    for epoch in range(epochs):
+        h_pre = X @ W1.T + b1
+        h = np.maximum(h_pre, 0)
+        logits = h @ W2.T + b2
+        logits -= logits.max(axis=1, keepdims=True)
+        p = np.exp(logits)
+        p /= p.sum(axis=1, keepdims=True)
+
+        g_logits = (p - Y) / n
+        g_W2 = g_logits.T @ h
+        g_b2 = g_logits.sum(axis=0)
+        g_h = (g_logits @ W2) * (h_pre > 0)
+        g_W1 = g_h.T @ X
+        g_b1 = g_h.sum(axis=0)
+
+        W1 -= lr * g_W1
+        b1 -= lr * g_b1
+        W2 -= lr * g_W2
+        b2 -= lr * g_b2
+
+        if epoch % 50 == 0 or epoch == epochs - 1:
+            loss = -np.mean(np.log(p[np.arange(n), y] + 1e-9))
+            acc = np.mean(p.argmax(axis=1) == y)
+            print(f"  epoch {epoch:4d}: loss={loss:.4f} acc={acc:.3f}")
+
+    return [(W1, b1, ACT_RELU), (W2, b2, ACT_LINEAR)]
+
+
+def calibrate_input_scales(layers, X):
+    """Per-layer int8 input step from the max |activation| seen on X.
+
+    X is the normalized training set; layer 0's step then applies to
+    z-scores, with the normalization itself folded into the quantizer.
+    """
+    scales = []
+    a = X
+    for W, b, act in layers:
+        peak = float(np.abs(a).max()) if a.size else 1.0
+        scales.append(max(peak, 1e-6) / 127.0)
+        a = a @ W.T + b
+        if act == ACT_RELU:
+            a = np.maximum(a, 0)
+    return scales
+
+
+def export_quantized_model(layers, input_scales, output_path, version, means=None, stds=None):
+    """Write layers as an int8 per-channel quantized PCML model file.
+
+    With means/stds the z-score normalization is folded into the layer 0
+    input quantizer so the device can feed raw feature vectors.
+    """
+    if not 1 <= len(layers) <= QMODEL_MAX_LAYERS:
+        raise ValueError(f"model needs 1..{QMODEL_MAX_LAYERS} layers")
+
+    in_size0 = layers[0][0].shape[1]
+    folded = means is not None and stds is not None
+    norm = b''
+    if folded:
+        mean = np.asarray(means, dtype=np.float32)[:in_size0]
+        mul = 1.0 / (np.asarray(stds, dtype=np.float32)[:in_size0] * input_scales[0])
+        norm = mean.astype('<f4').tobytes() + mul.astype('<f4').tobytes()
+
+    table_bytes = QMODEL_LAYER.size * len(layers) + len(norm)
+    descs = []
+    data = bytearray()
+    for (W, b, act), in_scale in zip(layers, input_scales):
+        out_size, in_size = W.shape
+        if max(out_size, in_size) > QMODEL_MAX_WIDTH:
+            raise ValueError(f"layer wider than {QMODEL_MAX_WIDTH}")
+
+        # Symmetric per-output-channel weight scales
+        w_scale = np.abs(W).max(axis=1) / 127.0
+        w_scale[w_scale == 0] = 1.0
+        W_q = np.clip(np.round(W / w_scale[:, np.newaxis]), -127, 127).astype(np.int8)
+
+        offset = table_bytes + len(data)
+        descs.append(QMODEL_LAYER.pack(in_size, out_size, act, in_scale, offset))
+
+        data += W_q.tobytes()
+        data += b'\0' * (-len(data) % 4)
+        data += w_scale.astype('<f4').tobytes()
+        data += np.asarray(b, dtype='<f4').tobytes()
+
+    payload = b''.join(descs) + norm + bytes(data)
+    header = QMODEL_HEADER.pack(
+        QMODEL_MAGIC, QMODEL_FORMAT_VERSION, len(layers),
+        version.encode()[:16],
+        in_size0, layers[-1][0].shape[0],
+        QMODEL_FLAG_FOLDED_NORM if folded else 0,
+        len(payload), zlib.crc32(payload) & 0xFFFFFFFF
+    )
+
+    with open(output_path, 'wb') as f:
+        f.write(header + payload)
+
+    params = sum(W.size + b.size for W, b, _ in layers)
+    print(f"Quantized model exported to {output_path}")
+    print(f"  {len(layers)} layers, {params} params, {len(header) + len(payload)} bytes")
+
+
+def read_quantized_model(path):
+    """Parse a PCML file: (header dict, layers, mean, mul). mean/mul are None without folded norm."""
+    with open(path, 'rb') as f:
+        blob = f.read()
+    magic, fmt, n_layers, version, in_size, out_size, flags, payload_size, crc = \
+        QMODEL_HEADER.unpack_from(blob, 0)
+    payload = blob[QMODEL_HEADER.size:QMODEL_HEADER.size + payload_size]
+    if magic != QMODEL_MAGIC or fmt != QMODEL_FORMAT_VERSION or len(payload) != payload_size:
+        raise ValueError(f"{path}: not a PCML v{QMODEL_FORMAT_VERSION} model")
+    if zlib.crc32(payload) & 0xFFFFFFFF != crc:
+        raise ValueError(f"{path}: payload CRC mismatch")
+
+    layers = []
+    for l in range(n_layers):
+        l_in, l_out, act, in_scale, offset = QMODEL_LAYER.unpack_from(payload, l * QMODEL_LAYER.size)
+        w = np.frombuffer(payload, dtype=np.int8, count=l_in * l_out, offset=offset).reshape(l_out, l_in)
+        off = offset + l_in * l_out + (-(l_in * l_out) % 4)
+        scales = np.frombuffer(payload, dtype='<f4', count=l_out, offset=off)
+        bias = np.frombuffer(payload, dtype='<f4', count=l_out, offset=off + 4 * l_out)
+        layers.append((w, scales, bias, act, np.float32(in_scale)))
+
+    mean = mul = None
+    if flags & QMODEL_FLAG_FOLDED_NORM:
+        off = QMODEL_LAYER.size * n_layers
+        mean = np.frombuffer(payload, dtype='<f4', count=in_size, offset=off)
+        mul = np.frombuffer(payload, dtype='<f4', count=in_size, offset=off + 4 * in_size)
+
+    info = {'version': version.rstrip(b'\0').decode(errors='replace'), 'input_size': in_size,
+            'output_size': out_size, 'flags': flags, 'crc': crc}
+    return info, layers, mean, mul
+
+
+def _round_away(x):
+    """C roundf: halves away from zero (np.round is half-to-even)."""
+    return np.sign(x) * np.floor(np.abs(x) + np.float32(0.5))
+
+
+def quantized_predict(model, x):
+    """Mirror of QuantModel::run for one raw (or pre-normalized) vector -> softmax scores."""
+    info, layers, mean, mul = model
+    a = np.zeros(info['input_size'], dtype=np.float32)   # Device pads to FEATURE_VECTOR_SIZE
+    n = min(len(x), len(a))
+    a[:n] = x[:n]
+    for l, (w, scales, bias, act, in_scale) in enumerate(layers):
+        if l == 0 and mean is not None:
+            q = _round_away((a - mean) * mul)
+        else:
+            q = _round_away(a * (np.float32(1.0) / in_scale))
+        q = np.clip(q, -127, 127).astype(np.int32)
+        acc = w.astype(np.int32) @ q
+        a = acc.astype(np.float32) * (scales * in_scale) + bias
+        if act == ACT_RELU:
+            a = np.maximum(a, np.float32(0))
+    e = np.exp(a - a.max())
+    return e / e.sum()
+
+
+def load_training_set(filepath):
+    """Map a PCTS training set; returns {column name: read-only numpy view}."""
+    with open(filepath, 'rb') as f:
+        head = f.read(TRAINING_SET_HEADER.size)
+        if len(head) < TRAINING_SET_HEADER.size:
+            raise ValueError(f"{filepath}: truncated header")
+        magic, version, n_cols, n_rows, _, _, _ = TRAINING_SET_HEADER.unpack(head)
+        if magic != TRAINING_SET_MAGIC or version != TRAINING_SET_FORMAT_VERSION:
+            raise ValueError(f"{filepath}: not a PCTS v{TRAINING_SET_FORMAT_VERSION} training set")
+        col_table = f.read(TRAINING_SET_COLUMN.size * n_cols)
+
+    columns = {}
+    for i in range(n_cols):
+        name, dtype, offset = TRAINING_SET_COLUMN.unpack_from(col_table, i * TRAINING_SET_COLUMN.size)
+        name = name.split(b'\0', 1)[0].decode()
+        dtype = np.dtype(dtype.split(b'\0', 1)[0].decode())
+        columns[name] = np.memmap(filepath, dtype=dtype, mode='r', offset=offset, shape=(n_rows,))
+    return columns
+
+
+def write_training_csv(columns, output_path):
+    """Write a PCTS set as the CSV load_training_csv reads (for hand labeling / Edge Impulse)."""
+    import csv
+
+    extra = [name for name in ('latitude', 'longitude') if name in columns]
+    n_rows = len(columns['label'])
+    with open(output_path, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(['bssid', 'ssid'] + TRAINING_FEATURE_COLUMNS + ['label'] + extra)
+        for r in range(n_rows):
+            bssid = int(columns['bssid'][r]).to_bytes(6, 'big').hex(':').upper()
+            ssid = bytes(columns['ssid'][r]).rstrip(b'\0').decode('utf-8', 'replace')
+            row = [bssid, ssid] + [f"{columns[name][r]:.4f}" for name in TRAINING_FEATURE_COLUMNS]
+            row.append(int(columns['label'][r]))
+            row += [f"{columns[name][r]:.6f}" for name in extra]
+            writer.writerow(row)
+    return n_rows
+
+
+def load_training_csv(filepath):
+    """Load a WarhogMode::exportMLTraining CSV (or PCTS set) into (X, y), skipping unlabeled rows."""
+    import csv
+
+    if not filepath.endswith('.csv'):
+        with open(filepath, 'rb') as f:
+            is_pcts = f.read(4) == struct.pack('<I', TRAINING_SET_MAGIC)
+        if is_pcts:
+            cols = load_training_set(filepath)
+            labels = np.asarray(cols['label'])
+            keep = np.isin(labels, list(CSV_LABEL_TO_CLASS))
+            X = np.stack([cols[name][keep] for name in TRAINING_FEATURE_COLUMNS], axis=1).astype(np.float32)
+            y = np.array([CSV_LABEL_TO_CLASS[int(v)] for v in labels[keep]], dtype=np.int64)
+            return X, y
+
+    X, y = [], []
+    with open(filepath, newline='') as f:
+        reader = csv.reader(f)
+        header = next(reader, None)
+        if not header or 'label' not in header:
+            raise ValueError(f"{filepath}: not an ML training export")
+        first = header.index('rssi')
+        label_col = header.index('label')
+
+        for row in reader:
+            if len(row) <= label_col:
+                continue
+            cls = CSV_LABEL_TO_CLASS.get(int(float(row[label_col])))
+            if cls is None:
+                continue
+            X.append([float(v) for v in row[first:first + 32]])
+            y.append(cls)
+
+    return np.array(X, dtype=np.float32).reshape(-1, 32), np.array(y, dtype=np.int64)
+
+
+def _gini_best_split(X, y, features, min_leaf):
+    """Best (gain, feature, threshold) over the candidate features."""
+    n = len(y)
+    k = len(LABELS)
+    total = np.bincount(y, minlength=k).astype(np.float64)
+    parent = 1.0 - np.sum((total / n) ** 2)
+    best = (0.0, None, None)
+
+    for f in features:
+        order = np.argsort(X[:, f], kind='stable')
+        xs = X[order, f]
+        onehot = np.eye(k)[y[order]]
+        left = np.cumsum(onehot, axis=0)[:-1]
+        right = total - left
+        nl = np.arange(1, n, dtype=np.float64)
+        nr = n - nl
+
+        # Only split between distinct values, honouring min_leaf
+        valid = (xs[1:] > xs[:-1]) & (nl >= min_leaf) & (nr >= min_leaf)
+        if not valid.any():
+            continue
+
+        gini_l = 1.0 - np.sum((left / nl[:, None]) ** 2, axis=1)
+        gini_r = 1.0 - np.sum((right / nr[:, None]) ** 2, axis=1)
+        gain = parent - (nl * gini_l + nr * gini_r) / n
+        gain[~valid] = -1.0
+
+        i = int(np.argmax(gain))
+        if gain[i] > best[0]:
+            # float32 midpoint - the device compares in float32
+            thr = np.float32((np.float64(xs[i]) + np.float64(xs[i + 1])) / 2)
+            if thr >= xs[i + 1]:
+                thr = xs[i]
+            best = (gain[i], f, thr)
+
+    return best
+
+
+def build_tree(X, y, depth, max_depth, min_leaf, n_features, rng):
+    """CART tree as nested dicts; leaves hold class probability vectors."""
+    dist = np.bincount(y, minlength=len(LABELS)) / len(y)
+    if depth >= max_depth or len(y) < 2 * min_leaf or dist.max() == 1.0:
+        return {'leaf': dist}
+
+    features = rng.choice(X.shape[1], size=n_features, replace=False)
+    gain, f, thr = _gini_best_split(X, y, features, min_leaf)
+    if f is None:
+        return {'leaf': dist}
+
+    mask = X[:, f] <= thr
+    return {
+        'feature': int(f),
+        'threshold': thr,
+        'left': build_tree(X[mask], y[mask], depth + 1, max_depth, min_leaf, n_features, rng),
+        'right': build_tree(X[~mask], y[~mask], depth + 1, max_depth, min_leaf, n_features, rng),
+    }
+
+
+def train_forest(X, y, n_trees=8, max_depth=6, min_leaf=2, seed=1):
+    """Bagged random forest over the used feature columns."""
+    rng = np.random.default_rng(seed)
+    n_features = max(1, int(np.sqrt(X.shape[1])))
+    trees = []
+    for _ in range(n_trees):
+        idx = rng.integers(0, len(y), len(y))
+        trees.append(build_tree(X[idx], y[idx], 0, max_depth, min_leaf, n_features, rng))
+    return trees
+
+
+def flatten_tree(tree, depth):
+    """Pad a tree to a complete binary tree of `depth` levels.
+
+    Returns (feature[2^d-1], threshold[2^d-1], leaf_dists[2^d]). An early
+    leaf becomes dummy splits with threshold FLT_MAX (always left) whose
+    descendants all carry the same distribution.
+    """
+    internal = (1 << depth) - 1
+    feature = np.zeros(internal, dtype=np.uint8)
+    threshold = np.full(internal, np.finfo(np.float32).max, dtype=np.float32)
+    leaves = [None] * (1 << depth)
+
+    def fill(node, idx, level):
+        if level == depth:
+            leaves[idx - internal] = node['leaf']  # max_depth == depth, always a leaf
+            return
+        if 'leaf' in node:
+            fill(node, 2 * idx + 1, level + 1)
+            fill(node, 2 * idx + 2, level + 1)
+            return
+        feature[idx] = node['feature']
+        threshold[idx] = node['threshold']
+        fill(node['left'], 2 * idx + 1, level + 1)
+        fill(node['right'], 2 * idx + 2, level + 1)
+
+    fill(tree, 0, 0)
+    return feature, threshold, leaves
+
+
+def forest_tables(trees, depth):
+    """Flatten every tree and deduplicate leaf distributions (pre-divided by tree count)."""
+    features, thresholds, leaf_idx = [], [], []
+    dists, dist_index = [], {}
+    for tree in trees:
+        f, t, leaves = flatten_tree(tree, depth)
+        features.append(f)
+        thresholds.append(t)
+        idx = []
+        for leaf in leaves:
+            d = (np.asarray(leaf, dtype=np.float64) / len(trees)).astype(np.float32)
+            key = d.tobytes()
+            if key not in dist_index:
+                dist_index[key] = len(dists)
+                dists.append(d)
+            idx.append(dist_index[key])
+        leaf_idx.append(idx)
+    return (np.array(features), np.array(thresholds),
+            np.array(leaf_idx, dtype=np.uint16), np.array(dists, dtype=np.float32))
+
+
+def forest_predict(tables, depth, X):
+    """Bit-for-bit mirror of ForestClassifier::predict (float32 accumulation)."""
+    features, thresholds, leaf_idx, dists = tables
+    internal = (1 << depth) - 1
+    scores = np.zeros((len(X), len(LABELS)), dtype=np.float32)
+    for t in range(len(features)):
+        idx = np.zeros(len(X), dtype=np.int64)
+        for _ in range(depth):
+            f = features[t][idx]
+            go_right = X[np.arange(len(X)), f] > thresholds[t][idx]
+            idx = 2 * idx + 1 + go_right
+        scores += dists[leaf_idx[t][idx - internal]]
+    return scores
+
+
+def _c_float(v):
+    """float32 value as a round-tripping C++ float literal."""
+    if not np.isfinite(v):
+        return '3.40282347e+38f'
+    s = f'{float(v):.9g}'
+    if '.' not in s and 'e' not in s:
+        s += '.0'
+    return s + 'f'
+
+
+def _c_floats(values):
+    return ', '.join(_c_float(v) for v in values)
+
+
+def export_forest_header(tables, depth, golden_X, golden_y, output_path, note=''):
+    """Write the flattened forest as a constexpr C++ header for forest.cpp."""
+    features, thresholds, leaf_idx, dists = tables
+    n_trees = len(features)
+    n_used = len(FEATURE_NAMES)
+
+    lines = [
+        '// Auto-generated by scripts/train_model.py train-forest - do not edit',
+        f'// Generated: {datetime.now().isoformat(timespec="seconds")}',
+    ]
+    if note:
+        lines.append(f'// {note}')
+    lines += [
+        '#pragma once',
+        '',
+        '#include <stdint.h>',
+        '',
+        '#ifndef DRAM_ATTR',
+        '#define DRAM_ATTR',
+        '#endif',
+        '',
+        '#define FOREST_AVAILABLE 1',
+        f'#define FOREST_TREES {n_trees}',
+        f'#define FOREST_DEPTH {depth}',
+        f'#define FOREST_CLASSES {len(LABELS)}',
+        f'#define FOREST_FEATURES {n_used}',
+        '#define FOREST_INTERNAL ((1 << FOREST_DEPTH) - 1)',
+        '#define FOREST_LEAVES (1 << FOREST_DEPTH)',
+        f'#define FOREST_DISTS {len(dists)}',
+        f'#define FOREST_GOLDEN {len(golden_y)}',
+        '',
+        '// Split feature / threshold per internal node (x > threshold goes right)',
+        'static constexpr DRAM_ATTR uint8_t FOREST_FEATURE[FOREST_TREES][FOREST_INTERNAL] = {',
+    ]
+    for f in features:
+        lines.append('    {' + ', '.join(str(int(v)) for v in f) + '},')
+    lines += ['};', '', 'static constexpr DRAM_ATTR float FOREST_THRESHOLD[FOREST_TREES][FOREST_INTERNAL] = {']
+    for t in thresholds:
+        lines.append('    {' + _c_floats(t) + '},')
+    lines += ['};', '', '// Leaf -> row of FOREST_DIST',
+              'static constexpr DRAM_ATTR uint16_t FOREST_LEAF[FOREST_TREES][FOREST_LEAVES] = {']
+    for l in leaf_idx:
+        lines.append('    {' + ', '.join(str(int(v)) for v in l) + '},')
+    lines += ['};', '', '// Class distributions, pre-divided by FOREST_TREES',
+              'static constexpr DRAM_ATTR float FOREST_DIST[FOREST_DISTS][FOREST_CLASSES] = {']
+    for d in dists:
+        lines.append('    {' + _c_floats(d) + '},')
+    lines += ['};', '', '// Holdout vectors and the labels Python predicted for them (ForestClassifier::selfTest)']
+    if len(golden_y):
+        lines.append('static constexpr float FOREST_GOLDEN_X[FOREST_GOLDEN][FOREST_FEATURES] = {')
+        for x in golden_X:
+            lines.append('    {' + _c_floats(x[:n_used]) + '},')
+        lines += ['};', 'static constexpr uint8_t FOREST_GOLDEN_Y[FOREST_GOLDEN] = {',
+                  '    ' + ', '.join(str(int(v)) for v in golden_y), '};']
+    else:
+        lines += ['static constexpr float FOREST_GOLDEN_X[1][FOREST_FEATURES] = {{0}};',
+                  'static constexpr uint8_t FOREST_GOLDEN_Y[1] = {0};']
+
+    with open(output_path, 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+    table_bytes = features.nbytes + thresholds.nbytes + leaf_idx.nbytes + dists.nbytes
+    print(f"Forest header exported to {output_path}")
+    print(f"  {n_trees} trees, depth {depth}, {len(dists)} leaf distributions, {table_bytes} bytes")
+
+
+def export_forest_reference(X, scores, output_path):
+    """Holdout rows with Python's forest scores, for tools/ml_check/forest_parity."""
+    import csv
+
+    with open(output_path, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(['label'] + [f'score_{c}' for c in LABELS] + FEATURE_NAMES)
+        for x, s in zip(X, scores):
+            # %.9g round-trips float32 exactly
+            writer.writerow([int(np.argmax(s))] + [f'{float(v):.9g}' for v in s] +
+                            [f'{float(v):.9g}' for v in x[:len(FEATURE_NAMES)]])
+    print(f"Forest reference ({len(X)} holdout rows) written to {output_path}")
+
+
+# Golden vectors for MLInference::benchmarkGolden: a plain WPA2/WPA3 router
+# plus per-case overrides, at least one case per MLLabel class
+GOLDEN_BASE = {
+    'rssi': -60, 'noise': -95, 'snr': 35, 'channel': 6, 'beacon_interval': 100,
+    'capability_low': 0x11, 'capability_high': 0x04, 'has_wpa2': 1, 'has_wpa3': 1,
+    'beacon_count': 20, 'beacon_jitter': 2.0, 'vendor_ie_count': 4, 'supported_rates': 8,
+    'ht_capabilities': 1, 'vht_capabilities': 1,
+}
+
+GOLDEN_CASES = [
+    ('normal', 'wpa3_home', {}),
+    ('normal', 'wpa2_far', {'rssi': -78, 'snr': 17, 'channel': 1, 'has_wpa3': 0}),
+    ('normal', 'mesh_node', {'rssi': -48, 'snr': 47, 'channel': 11, 'vendor_ie_count': 6}),
+    ('rogue_ap', 'laptop_hotspot', {'rssi': -25, 'snr': 70, 'channel': 3, 'beacon_interval': 40,
+                                    'beacon_jitter': 14.0, 'vendor_ie_count': 0, 'supported_rates': 3,
+                                    'ht_capabilities': 0, 'has_wpa3': 0}),
+    ('rogue_ap', 'open_wps_honeypot', {'rssi': -28, 'snr': 67, 'beacon_interval': 250,
+                                       'beacon_jitter': 12.0, 'vendor_ie_count': 1, 'has_wps': 1,
+                                       'has_wpa2': 0, 'has_wpa3': 0}),
+    ('evil_twin', 'twin_downgrade', {'rssi': -45, 'snr': 50, 'has_wpa3': 0, 'twin_score': 0.9}),
+    ('evil_twin', 'hidden_twin', {'rssi': -40, 'snr': 55, 'is_hidden': 1, 'twin_score': 0.6}),
+    ('deauth_target', 'wpa2_no_pmf', {'rssi': -55, 'snr': 40, 'has_wpa3': 0}),
+    ('deauth_target', 'wpa2_busy_ap', {'rssi': -50, 'snr': 43, 'channel': 11, 'has_wpa3': 0,
+                                       'beacon_count': 200, 'responds_to_probe': 1}),
+    ('vulnerable', 'open_wps_hidden', {'rssi': -65, 'snr': 30, 'has_wps': 1, 'is_hidden': 1,
+                                       'has_wpa2': 0, 'has_wpa3': 0}),
+    ('vulnerable', 'wpa1_wps_hidden', {'rssi': -72, 'snr': 23, 'channel': 3, 'has_wps': 1,
+                                       'has_wpa': 1, 'has_wpa2': 0, 'has_wpa3': 0, 'is_hidden': 1,
+                                       'beacon_jitter': 11.0, 'supported_rates': 3}),
+]
+
+
+def golden_vectors():
+    """(X, intended class, case names) for GOLDEN_CASES, raw feature units."""
+    X = np.zeros((len(GOLDEN_CASES), len(FEATURE_NAMES)), dtype=np.float32)
+    classes, names = [], []
+    for row, (label, name, overrides) in enumerate(GOLDEN_CASES):
+        values = dict(GOLDEN_BASE, **overrides)
+        for k, v in values.items():
+            X[row, FEATURE_NAMES.index(k)] = v
+        classes.append(LABELS.index(label))
+        names.append(name)
+    return X, np.array(classes), names
+
+
+def heuristic_predict(x):
+    """Mirror of MLInference::runInference on a raw feature vector -> scores (float32)."""
+    f = np.float32
+    rssi, channel, interval = x[0], int(x[3]), x[5]
+    wps, wpa, wpa2, wpa3, hidden = (x[i] > 0.5 for i in (8, 9, 10, 11, 12))
+    jitter, vendor_ies, rates = x[15], int(x[18]), int(x[19])
+    ht, vht, twin = x[20] > 0.5, x[21] > 0.5, x[23]
+    open_net = not wpa and not wpa2 and not wpa3
+
+    anomaly = f(0)
+    if rssi > -30: anomaly += f(0.3)
+    if interval < 50 or interval > 200: anomaly += f(0.2)
+    if jitter > 10.0: anomaly += f(0.15)
+    if vendor_ies < 2: anomaly += f(0.1)
+    if open_net and wps: anomaly += f(0.25)
+    if channel <= 14 and channel not in (1, 6, 11): anomaly += f(0.05)
+    if vht and not ht: anomaly += f(0.2)
+    if rates < 4: anomaly += f(0.1)
+
+    twin_score = f(0)
+    if hidden and rssi > -50: twin_score += f(0.2)
+    twin_score += f(twin)
+
+    vuln = f(0)
+    if open_net: vuln += f(0.5)
+    if wpa and not wpa2 and not wpa3: vuln += f(0.4)
+    if wps: vuln += f(0.2)
+    if hidden and vuln > 0.3: vuln += f(0.1)
+
+    deauth = f(0)
+    if -70 < rssi < -30: deauth += f(0.2)
+    if not wpa3: deauth += f(0.3)
+
+    scores = np.array([f(1) - (anomaly + twin_score + vuln) / f(3),
+                       min(f(1), anomaly), min(f(1), twin_score),
+                       min(f(1), deauth), min(f(1), vuln)], dtype=np.float32)
+    total = scores.sum(dtype=np.float32)
+    return scores / total if total > 0 else scores
+
+
+def host_latency(fn, X, reps):
+    """p50/p99/max in us of fn over every row of X, reps times each."""
+    samples = []
+    for _ in range(reps):
+        for x in X:
+            t0 = time.perf_counter_ns()
+            fn(x)
+            samples.append((time.perf_counter_ns() - t0) / 1000.0)
+    samples = np.array(samples)
+    return np.percentile(samples, 50), np.percentile(samples, 99), samples.max()
+
+
+def export_golden_header(X, classes, names, heur_scores, model_info, model_y, output_path):
+    """Write golden_vectors.h for MLInference::benchmarkGolden."""
+    lines = [
+        '// Auto-generated by scripts/train_model.py golden - do not edit',
+        f'// Generated: {datetime.now().isoformat(timespec="seconds")}',
+        '//',
+        '// Raw feature vectors covering every MLLabel class, with the outputs the',
+        '// Python mirrors of the heuristic rules and (optionally) one quantized',
+        '// model produce for them. Cases live in GOLDEN_CASES in train_model.py.',
+        '#pragma once',
+        '',
+        '#include <stdint.h>',
+        '',
+        f'#define GOLDEN_COUNT {len(names)}',
+        f'#define GOLDEN_FEATURES {X.shape[1]}',
+        f'#define GOLDEN_CLASSES {len(LABELS)}',
+        '',
+        '// CRC of the PCML payload GOLDEN_MODEL_Y was computed for (0 = none)',
+        f'#define GOLDEN_MODEL_CRC 0x{model_info["crc"] if model_info else 0:08X}UL',
+        '',
+        'static constexpr const char* GOLDEN_NAME[GOLDEN_COUNT] = {',
+        '    ' + ', '.join(f'"{n}"' for n in names),
+        '};',
+        '',
+        '// Class each case was written to represent',
+        'static constexpr uint8_t GOLDEN_CLASS[GOLDEN_COUNT] = {',
+        '    ' + ', '.join(str(int(c)) for c in classes),
+        '};',
+        '',
+        'static constexpr float GOLDEN_X[GOLDEN_COUNT][GOLDEN_FEATURES] = {',
+    ]
+    for x in X:
+        lines.append('    {' + _c_floats(x) + '},')
+    lines += ['};', '', '// MLInference::runInference output',
+              'static constexpr uint8_t GOLDEN_HEURISTIC_Y[GOLDEN_COUNT] = {',
+              '    ' + ', '.join(str(int(s.argmax())) for s in heur_scores), '};',
+              'static constexpr float GOLDEN_HEURISTIC_SCORES[GOLDEN_COUNT][GOLDEN_CLASSES] = {']
+    for sc in heur_scores:
+        lines.append('    {' + _c_floats(sc) + '},')
+    lines += ['};', '',
+              f'// QuantModel::run labels for model "{model_info["version"]}"' if model_info
+              else '// QuantModel::run labels (no model given)',
+              'static constexpr uint8_t GOLDEN_MODEL_Y[GOLDEN_COUNT] = {',
+              '    ' + ', '.join(str(int(v)) for v in model_y), '};']
+
+    with open(output_path, 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+    print(f"Golden vectors exported to {output_path}")
+
+
+def read_norm_snapshot(path):
+    """Read a NormStats snapshot: (device_id, kind, count, mean, m2)."""
+    with open(path, 'rb') as f:
+        blob = f.read()
+    if len(blob) < NORM_STATS_HEADER.size:
+        raise ValueError(f"{path}: truncated header")
+    
+    magic, version, n_feat, device, kind, count, crc = NORM_STATS_HEADER.unpack_from(blob)
+    if magic != NORM_STATS_MAGIC or version != NORM_STATS_FORMAT_VERSION:
+        raise ValueError(f"{path}: not a norm stats snapshot")
+    payload = blob[NORM_STATS_HEADER.size:NORM_STATS_HEADER.size + 16 * n_feat]
+    if len(payload) != 16 * n_feat:
+        raise ValueError(f"{path}: truncated payload")
+    if zlib.crc32(payload) != crc:
+        raise ValueError(f"{path}: CRC mismatch")
+    
+    values = np.frombuffer(payload, dtype='<f8')
+    return device, kind, count, values[:n_feat].copy(), values[n_feat:].copy()
+
+
+def write_norm_snapshot(path, count, mean, m2, kind=NORM_KIND_FLEET, device=b'\0' * 6):
+    """Write a NormStats snapshot the device can load."""
+    payload = np.asarray(mean, dtype='<f8').tobytes() + np.asarray(m2, dtype='<f8').tobytes()
+    header = NORM_STATS_HEADER.pack(NORM_STATS_MAGIC, NORM_STATS_FORMAT_VERSION, len(mean),
+                                    device, kind, count, zlib.crc32(payload))
+    with open(path, 'wb') as f:
+        f.write(header + payload)
+
+
+def merge_welford(a, b):
+    """Parallel Welford merge (Chan et al.) of (count, mean, m2) triples."""
+    na, mean_a, m2_a = a
+    nb, mean_b, m2_b = b
+    if nb == 0:
+        return a
+    if na == 0:
+        return b
+    n = na + nb
+    delta = mean_b - mean_a
+    mean = mean_a + delta * nb / n
+    m2 = m2_a + m2_b + delta * delta * na * nb / n
+    return n, mean, m2
+
+
+def merge_norm_snapshots(paths):
+    """Merge per-device snapshots, keeping only the newest one per device."""
+    latest = {}
+    for path in paths:
+        try:
+            device, kind, count, mean, m2 = read_norm_snapshot(path)
+        except ValueError as e:
+            print(f"  skipping {e}")
+            continue
+        if kind != NORM_KIND_LOCAL:
+            # Fleet/delta files already contain other devices' samples
+            print(f"  skipping {path}: not a device snapshot")
+            continue
+        # A device's counts only grow, so the largest snapshot is the newest
+        if device not in latest or count > latest[device][0]:
+            latest[device] = (count, mean, m2)
+    
+    merged = (0, np.zeros(NORM_STATS_FEATURES), np.zeros(NORM_STATS_FEATURES))
+    for device, stats in sorted(latest.items()):
+        print(f"  {device.hex(':')}: {stats[0]} samples")
+        merged = merge_welford(merged, stats)
+    return len(latest), merged
+
+
 def main():
     parser = argparse.ArgumentParser(description='Porkchop ML Training Pipeline')
-    parser.add_argument('command', choices=['prepare', 'export-header', 'analyze'])
+    parser.add_argument('command', choices=['prepare', 'export-header', 'analyze', 'train-mlp', 'train-forest',
+                                            'merge-norm', 'golden', 'to-csv'])
     parser.add_argument('--input', '-i', help='Input data file')
     parser.add_argument('--output', '-o', help='Output directory or file')
     parser.add_argument('--label', '-l', help='Default label for unlabeled data', default='normal')
+    parser.add_argument('--hidden', type=int, default=32, help='Hidden layer width for train-mlp')
+    parser.add_argument('--epochs', type=int, default=300, help='Training epochs for train-mlp')
+    parser.add_argument('--trees', type=int, default=8, help='Tree count for train-forest')
+    parser.add_argument('--depth', type=int, default=6, help='Tree depth for train-forest')
+    parser.add_argument('--holdout', type=float, default=0.2, help='Holdout fraction for train-forest')
+    parser.add_argument('--reference', help='train-forest: also write the holdout rows and their Python scores (CSV)')
+    parser.add_argument('--model', help='PCML model to record golden outputs for')
+    parser.add_argument('--reps', type=int, default=50, help='Timing repetitions per golden vector')
+    parser.add_argument('--version', default='mlp-' + datetime.now().strftime('%y%m%d'),
+                        help='Model version string (max 16 chars)')
     
     args = parser.parse_args()
     
@@ -209,6 +956,134 @@ def main():
         
         export_c_header(norm_params, args.output)
     
+    elif args.command == 'train-mlp':
+        if not args.input or not args.output:
+            print("Error: --input and --output required for train-mlp")
+            sys.exit(1)
+        
+        data = load_capture_data(args.input)
+        if not data:
+            print("Error: no samples in input")
+            sys.exit(1)
+        
+        for entry in data:
+            if 'label' not in entry:
+                entry['label'] = args.label
+        
+        X = np.array([extract_features(e) for e in data], dtype=np.float32)
+        y = np.array([label_index(e) for e in data])
+        means, stds = compute_normalization_params(X)
+        X_norm = (X - np.array(means, dtype=np.float32)) / np.array(stds, dtype=np.float32)
+        
+        print(f"Training MLP on {len(data)} samples ({args.hidden} hidden)")
+        layers = train_mlp(X_norm, y, hidden=args.hidden, epochs=args.epochs)
+        
+        # Device feeds raw features; normalization lives in the input quantizer
+        scales = calibrate_input_scales(layers, X_norm)
+        export_quantized_model(layers, scales, args.output, args.version, means, stds)
+    
+    elif args.command == 'train-forest':
+        if not args.input or not args.output:
+            print("Error: --input and --output required for train-forest")
+            sys.exit(1)
+        
+        X, y = load_training_csv(args.input)
+        if len(y) < 10:
+            print(f"Error: need at least 10 labeled rows, got {len(y)}")
+            sys.exit(1)
+        
+        # Trees only split on the populated features
+        X = X[:, :len(FEATURE_NAMES)]
+        rng = np.random.default_rng(0)
+        order = rng.permutation(len(y))
+        n_hold = max(1, int(len(y) * args.holdout))
+        hold, train = order[:n_hold], order[n_hold:]
+        
+        print(f"Training forest on {len(train)} rows, {n_hold} held out")
+        trees = train_forest(X[train], y[train], n_trees=args.trees, max_depth=args.depth)
+        tables = forest_tables(trees, args.depth)
+        
+        train_acc = np.mean(forest_predict(tables, args.depth, X[train]).argmax(axis=1) == y[train])
+        hold_pred = forest_predict(tables, args.depth, X[hold]).argmax(axis=1)
+        hold_acc = np.mean(hold_pred == y[hold])
+        print(f"  train acc={train_acc:.3f} holdout acc={hold_acc:.3f}")
+        
+        # Golden vectors: holdout rows with the labels this exact forest predicts
+        golden = hold[:64]
+        export_forest_header(tables, args.depth, X[golden], hold_pred[:64], args.output,
+                             note=f'train acc {train_acc:.3f}, holdout acc {hold_acc:.3f}')
+        if args.reference:
+            export_forest_reference(X[hold], forest_predict(tables, args.depth, X[hold]), args.reference)
+    
+    elif args.command == 'merge-norm':
+        if not args.input or not args.output:
+            print("Error: --input (snapshot dir) and --output required for merge-norm")
+            sys.exit(1)
+        
+        src = Path(args.input)
+        paths = sorted(src.glob('norm_*.bin')) if src.is_dir() else [src]
+        devices, (count, mean, m2) = merge_norm_snapshots(paths)
+        if count == 0:
+            print("Error: no usable snapshots")
+            sys.exit(1)
+        
+        write_norm_snapshot(args.output, count, mean, m2)
+        
+        # Same shape as prepare's normalization.json, for export-header
+        stds = np.sqrt(m2 / count)
+        stds[stds < 0.001] = 1.0
+        json_path = Path(args.output).with_suffix('.json')
+        with open(json_path, 'w') as f:
+            json.dump({'means': mean.tolist(), 'stds': stds.tolist(), 'samples': int(count)}, f, indent=2)
+        
+        print(f"Merged {devices} devices, {count} samples -> {args.output}")
+        print("Copy it to the SD card as /mldata/norm_fleet.bin to install on next boot")
+    
+    elif args.command == 'golden':
+        if not args.output:
+            print("Error: --output required for golden")
+            sys.exit(1)
+        
+        X, classes, names = golden_vectors()
+        heur = np.array([heuristic_predict(x) for x in X])
+        model = None
+        model_y = np.zeros(len(names), dtype=np.int64)
+        if args.model:
+            model = read_quantized_model(args.model)
+            if model[2] is None:
+                print("Error: golden needs a model with folded normalization (raw inputs)")
+                sys.exit(1)
+            model_y = np.array([quantized_predict(model, x).argmax() for x in X])
+        
+        print(f"{'case':<20} {'class':<14} {'heuristic':<14} {'model' if model else ''}")
+        for i, name in enumerate(names):
+            print(f"{name:<20} {LABELS[classes[i]]:<14} {LABELS[heur[i].argmax()]:<14} "
+                  f"{LABELS[model_y[i]] if model else ''}")
+        
+        # Cases the rules can't tell apart would make parity flaky on device
+        top2 = np.sort(heur, axis=1)[:, -2:]
+        if np.any(top2[:, 1] - top2[:, 0] < 1e-3):
+            print("Warning: a heuristic case is within 1e-3 of a tie")
+        missing = sorted(set(range(len(LABELS))) - set(heur.argmax(axis=1)))
+        if missing:
+            print("Heuristic never predicts: " + ', '.join(LABELS[c] for c in missing))
+        
+        p50, p99, worst = host_latency(heuristic_predict, X, args.reps)
+        print(f"Host heuristic: p50 {p50:.1f} us, p99 {p99:.1f} us, max {worst:.1f} us")
+        if model:
+            p50, p99, worst = host_latency(lambda x: quantized_predict(model, x), X, args.reps)
+            print(f"Host model:     p50 {p50:.1f} us, p99 {p99:.1f} us, max {worst:.1f} us")
+        
+        export_golden_header(X, classes, names, heur, model[0] if model else None, model_y, args.output)
+    
+    elif args.command == 'to-csv':
+        if not args.input or not args.output:
+            print("Error: --input (.pcts) and --output (.csv) required for to-csv")
+            sys.exit(1)
+        
+        n = write_training_csv(load_training_set(args.input), args.output)
+        print(f"Wrote {n} rows to {args.output}")
+    
     elif args.command == 'analyze':
         if not args.input:
             print("Error: --input required for analyze")
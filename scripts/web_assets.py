@@ -0,0 +1,67 @@
+# Porkchop web UI asset builder
+# Gzips src/web/ui/index.html into src/web/web_assets.h (PROGMEM) with a
+# content-hash ETag, so the file server sends a few KB once and 304s after.
+#
+# Runs as a PlatformIO pre: script, or by hand: python scripts/web_assets.py
+
+import gzip
+import hashlib
+import os
+
+
+def bytes_to_c(data, indent="    ", per_line=16):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append(indent + ", ".join("0x%02x" % b for b in data[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def build(project_dir):
+    src = os.path.join(project_dir, "src", "web", "ui", "index.html")
+    out = os.path.join(project_dir, "src", "web", "web_assets.h")
+
+    with open(src, "rb") as f:
+        html = f.read()
+    if b')rawliteral"' in html:
+        raise ValueError("index.html must not contain the raw string delimiter")
+
+    # mtime=0 keeps the output identical for identical input
+    gz = gzip.compress(html, compresslevel=9, mtime=0)
+    digest = hashlib.sha256(html).hexdigest()[:16]
+
+    header = (
+        "// Auto-generated by scripts/web_assets.py from src/web/ui/index.html - do not edit\n"
+        "#pragma once\n"
+        "\n"
+        "#include <Arduino.h>\n"
+        "\n"
+        "// Each encoding is its own representation, so each has its own strong ETag\n"
+        '#define WEB_INDEX_ETAG "\\"%s\\""\n'
+        '#define WEB_INDEX_GZ_ETAG "\\"%s-gz\\""\n'
+        "#define WEB_INDEX_HTML_LEN %d\n"
+        "#define WEB_INDEX_GZ_LEN %d\n"
+        "\n"
+        "// Plain copy for clients that don't accept gzip\n"
+        'static const char WEB_INDEX_HTML[] PROGMEM = R"rawliteral(%s)rawliteral";\n'
+        "\n"
+        "static const uint8_t WEB_INDEX_GZ[] PROGMEM = {\n"
+        "%s\n"
+        "};\n"
+    ) % (digest, digest, len(html), len(gz), html.decode("utf-8"), bytes_to_c(gz))
+
+    # Only touch the header when the page changed, so builds stay incremental
+    old = None
+    if os.path.exists(out):
+        with open(out, "r", encoding="utf-8") as f:
+            old = f.read()
+    if old != header:
+        with open(out, "w", encoding="utf-8", newline="\n") as f:
+            f.write(header)
+        print("web_assets: index.html %d -> %d bytes gzipped, etag %s" % (len(html), len(gz), digest))
+
+
+try:
+    Import("env")   # noqa: F821 - provided by PlatformIO/SCons
+    build(env.subst("$PROJECT_DIR"))    # noqa: F821
+except NameError:
+    build(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
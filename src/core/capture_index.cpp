@@ -0,0 +1,348 @@
+// Persistent capture index implementation
+
+#include "capture_index.h"
+#include <SD.h>
+#include <vector>
+#include <algorithm>
+
+#define CAPTURE_INDEX_TMP_PATH "/handshakes/index.tmp"
+
+int32_t CaptureIndex::cachedCount = -1;
+uint32_t CaptureIndex::recordCount = 0;
+
+// Loaded with the index: file slot of every live record in capture order,
+// and the live slot per BSSID sorted by BSSID for add()'s lookup
+struct BssidSlot {
+    uint8_t bssid[6];
+    uint32_t slot;
+};
+static std::vector<uint32_t> liveSlots;
+static std::vector<BssidSlot> bssidSlots;
+
+static bool bssidLess(const BssidSlot& a, const uint8_t* bssid) {
+    return memcmp(a.bssid, bssid, 6) < 0;
+}
+
+// Make `slot` the live record for its BSSID. Returns the slot it
+// supersedes, or -1 for a BSSID not seen before.
+static int32_t trackSlot(const uint8_t* bssid, uint32_t slot) {
+    auto it = std::lower_bound(bssidSlots.begin(), bssidSlots.end(), bssid, bssidLess);
+    if (it != bssidSlots.end() && memcmp(it->bssid, bssid, 6) == 0) {
+        int32_t old = it->slot;
+        it->slot = slot;
+        auto live = std::lower_bound(liveSlots.begin(), liveSlots.end(), (uint32_t)old);
+        if (live != liveSlots.end() && *live == (uint32_t)old) liveSlots.erase(live);
+        liveSlots.push_back(slot);
+        return old;
+    }
+    BssidSlot e;
+    memcpy(e.bssid, bssid, 6);
+    e.slot = slot;
+    bssidSlots.insert(it, e);
+    liveSlots.push_back(slot);
+    return -1;
+}
+
+static bool readHeader(File& f) {
+    CaptureIndexHeader hdr;
+    if (f.size() < sizeof(hdr)) return false;
+    if (f.read((uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr)) return false;
+    return hdr.magic == CAPTURE_INDEX_MAGIC && hdr.version == CAPTURE_INDEX_VERSION &&
+           hdr.recordSize == sizeof(CaptureRecord);
+}
+
+static bool writeHeader(File& f) {
+    CaptureIndexHeader hdr = {
+        .magic = CAPTURE_INDEX_MAGIC,
+        .version = CAPTURE_INDEX_VERSION,
+        .recordSize = sizeof(CaptureRecord)
+    };
+    return f.write((const uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr);
+}
+
+bool CaptureIndex::load() {
+    File f = SD.open(CAPTURE_INDEX_PATH, FILE_READ);
+    if (!f) return false;
+    if (!readHeader(f)) {
+        f.close();
+        return false;
+    }
+
+    liveSlots.clear();
+    bssidSlots.clear();
+    recordCount = (f.size() - sizeof(CaptureIndexHeader)) / sizeof(CaptureRecord);
+
+    // One sequential pass. A duplicate BSSID without the flag means power
+    // was lost between appending and flagging; the later record wins.
+    const uint16_t CHUNK = 16;
+    CaptureRecord buf[CHUNK];
+    uint32_t slot = 0;
+    while (slot < recordCount) {
+        size_t got = f.read((uint8_t*)buf, sizeof(buf)) / sizeof(CaptureRecord);
+        if (got == 0) break;
+        for (size_t i = 0; i < got; i++, slot++) {
+            if (!(buf[i].flags & CAPTURE_REPLACED)) trackSlot(buf[i].bssid, slot);
+        }
+    }
+    f.close();
+
+    cachedCount = liveSlots.size();
+    return true;
+}
+
+bool CaptureIndex::isValid() {
+    return cachedCount >= 0 || load();
+}
+
+uint32_t CaptureIndex::count() {
+    return isValid() ? (uint32_t)cachedCount : 0;
+}
+
+uint16_t CaptureIndex::read(uint32_t first, CaptureRecord* out, uint16_t n) {
+    uint32_t total = count();
+    if (first >= total || n == 0) return 0;
+    if (first + n > total) n = total - first;
+
+    File f = SD.open(CAPTURE_INDEX_PATH, FILE_READ);
+    if (!f) return 0;
+
+    // One seek, then read forward: live slots ascend, replaced records in
+    // between are read over and dropped
+    uint32_t slot = liveSlots[first];
+    f.seek(sizeof(CaptureIndexHeader) + slot * sizeof(CaptureRecord));
+    uint16_t got = 0;
+    while (got < n && f.read((uint8_t*)&out[got], sizeof(CaptureRecord)) == sizeof(CaptureRecord)) {
+        if (slot++ == liveSlots[first + got]) got++;
+    }
+    f.close();
+    return got;
+}
+
+bool CaptureIndex::add(const CaptureRecord& rec) {
+    // No index yet: the captures menu rebuilds it on open and will pick
+    // this file up along with any older ones
+    if (!isValid()) return false;
+
+    File f = SD.open(CAPTURE_INDEX_PATH, "r+");
+    if (!f) {
+        Serial.println("[CAPIDX] Failed to open index for writing");
+        return false;
+    }
+
+    // Append first, flag the old record second: a power cut in between
+    // leaves a duplicate that load() resolves, never a lost capture
+    CaptureRecord r = rec;
+    r.flags = 0;
+    uint32_t slot = recordCount;
+    f.seek(sizeof(CaptureIndexHeader) + slot * sizeof(CaptureRecord));
+    bool ok = f.write((const uint8_t*)&r, sizeof(r)) == sizeof(r);
+
+    int32_t old = ok ? trackSlot(r.bssid, slot) : -1;
+    if (old >= 0) {
+        CaptureRecord prev;
+        f.seek(sizeof(CaptureIndexHeader) + old * sizeof(CaptureRecord));
+        ok = f.read((uint8_t*)&prev, sizeof(prev)) == sizeof(prev);
+        prev.flags |= CAPTURE_REPLACED;
+        ok = ok && f.seek(sizeof(CaptureIndexHeader) + old * sizeof(CaptureRecord)) &&
+             f.write((const uint8_t*)&prev, sizeof(prev)) == sizeof(prev);
+    }
+    f.close();
+
+    if (!ok) {
+        // Half-written record: make the next open rebuild
+        invalidate();
+        return false;
+    }
+    recordCount++;
+    cachedCount = liveSlots.size();
+    return true;
+}
+
+void CaptureIndex::invalidate() {
+    cachedCount = -1;
+    recordCount = 0;
+    liveSlots.clear();
+    bssidSlots.clear();
+    if (SD.exists(CAPTURE_INDEX_PATH)) {
+        SD.remove(CAPTURE_INDEX_PATH);
+    }
+}
+
+static int8_t hexNibble(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// "64EEB7208286.pcap" -> 64:EE:B7:20:82:86
+static bool parseBssidName(const char* name, uint8_t* bssid) {
+    for (uint8_t i = 0; i < 6; i++) {
+        int8_t hi = hexNibble(name[i * 2]);
+        int8_t lo = hi < 0 ? -1 : hexNibble(name[i * 2 + 1]);
+        if (lo < 0) return false;
+        bssid[i] = (hi << 4) | lo;
+    }
+    return name[12] == '.';
+}
+
+bool CaptureIndex::scanPcap(const char* path, CaptureRecord& rec) {
+    File f = SD.open(path, FILE_READ);
+    if (!f) return false;
+
+    uint8_t hdr[24];
+    if (f.read(hdr, sizeof(hdr)) != sizeof(hdr) ||
+        hdr[0] != 0xD4 || hdr[1] != 0xC3 || hdr[2] != 0xB2 || hdr[3] != 0xA1) {
+        f.close();
+        return false;
+    }
+
+    static const uint8_t EAPOL_LLC[8] = {0xAA, 0xAA, 0x03, 0x00, 0x00, 0x00, 0x88, 0x8E};
+    bool haveBssid = false;
+    for (uint8_t i = 0; i < 6; i++) {
+        if (rec.bssid[i]) haveBssid = true;
+    }
+
+    // Only the 802.11 header and the EAPOL key info are needed per packet
+    uint8_t pkt[48];
+    uint8_t pktHdr[16];
+    while (f.read(pktHdr, sizeof(pktHdr)) == sizeof(pktHdr)) {
+        uint32_t inclLen;
+        memcpy(&inclLen, pktHdr + 8, 4);
+        size_t take = inclLen < sizeof(pkt) ? inclLen : sizeof(pkt);
+        if (f.read(pkt, take) != take) break;
+        if (inclLen > take) f.seek(f.position() + (inclLen - take));
+        if (take < 24) continue;
+
+        uint8_t type = (pkt[0] >> 2) & 0x03;
+        uint8_t subtype = (pkt[0] >> 4) & 0x0F;
+
+        if (type == 0 && subtype == 8) {
+            rec.frameMask |= CAPTURE_HAS_BEACON;
+            if (!haveBssid) {
+                memcpy(rec.bssid, pkt + 16, 6);
+                haveBssid = true;
+            }
+        } else if (type == 2) {
+            uint8_t hdrLen = (subtype & 0x08) ? 26 : 24;    // QoS data
+            if (take < (size_t)hdrLen + 15 || memcmp(pkt + hdrLen, EAPOL_LLC, 8) != 0) continue;
+            const uint8_t* eapol = pkt + hdrLen + 8;
+            if (eapol[1] != 3) continue;    // EAPOL-Key only
+
+            // Key info bits as in OinkMode::processEAPOL; Secure tells M4 from M2
+            uint16_t keyInfo = (eapol[5] << 8) | eapol[6];
+            bool install = keyInfo & (1 << 6);
+            bool keyAck = keyInfo & (1 << 7);
+            bool keyMic = keyInfo & (1 << 8);
+            bool secure = keyInfo & (1 << 9);
+            if (keyAck && !keyMic) rec.frameMask |= CAPTURE_HAS_M1;
+            else if (!keyAck && keyMic && !install && !secure) rec.frameMask |= CAPTURE_HAS_M2;
+            else if (keyAck && keyMic && install) rec.frameMask |= CAPTURE_HAS_M3;
+            else if (!keyAck && keyMic && secure) rec.frameMask |= CAPTURE_HAS_M4;
+
+            if (!haveBssid) {
+                // FromDS: addr2 is the AP; ToDS: addr1 is
+                memcpy(rec.bssid, (pkt[1] & 0x02) ? pkt + 10 : pkt + 4, 6);
+                haveBssid = true;
+            }
+        }
+    }
+    f.close();
+    return true;
+}
+
+uint32_t CaptureIndex::rebuild() {
+    uint32_t t0 = millis();
+    invalidate();
+
+    File dir = SD.open("/handshakes");
+    if (!dir || !dir.isDirectory()) {
+        Serial.println("[CAPIDX] No handshakes directory");
+        return 0;
+    }
+
+    // Pass 1: records in directory order into a temp file. Only the sort
+    // keys stay in RAM (8 bytes per capture, not 52).
+    struct SortKey {
+        uint32_t timestamp;
+        uint32_t slot;
+    };
+    std::vector<SortKey> keys;
+
+    File tmp = SD.open(CAPTURE_INDEX_TMP_PATH, FILE_WRITE);
+    if (!tmp) {
+        dir.close();
+        Serial.println("[CAPIDX] Failed to create temp index");
+        return 0;
+    }
+
+    File file = dir.openNextFile();
+    while (file) {
+        String name = file.name();
+        if (name.endsWith(".pcap") && !file.isDirectory()) {
+            CaptureRecord rec;
+            memset(&rec, 0, sizeof(rec));
+            rec.fileSize = file.size();
+            rec.timestamp = (uint32_t)file.getLastWrite();
+            file.close();
+
+            String baseName = name.substring(0, name.indexOf('.'));
+            parseBssidName(name.c_str(), rec.bssid);
+
+            String path = "/handshakes/" + name;
+            scanPcap(path.c_str(), rec);
+
+            // SSID from the companion .txt written at capture time
+            String txtPath = "/handshakes/" + baseName + ".txt";
+            File txtFile = SD.open(txtPath, FILE_READ);
+            if (txtFile) {
+                String ssid = txtFile.readStringUntil('\n');
+                ssid.trim();
+                strncpy(rec.ssid, ssid.c_str(), sizeof(rec.ssid) - 1);
+                txtFile.close();
+            }
+
+            tmp.write((const uint8_t*)&rec, sizeof(rec));
+            keys.push_back({rec.timestamp, (uint32_t)keys.size()});
+        } else {
+            file.close();
+        }
+        file = dir.openNextFile();
+    }
+    dir.close();
+    tmp.close();
+
+    // Pass 2: copy out oldest first, so the menu reads newest from the end
+    std::stable_sort(keys.begin(), keys.end(), [](const SortKey& a, const SortKey& b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    tmp = SD.open(CAPTURE_INDEX_TMP_PATH, FILE_READ);
+    File idx = SD.open(CAPTURE_INDEX_PATH, FILE_WRITE);
+    bool ok = tmp && idx && writeHeader(idx);
+    for (size_t i = 0; ok && i < keys.size(); i++) {
+        CaptureRecord rec;
+        tmp.seek(keys[i].slot * sizeof(CaptureRecord));
+        ok = tmp.read((uint8_t*)&rec, sizeof(rec)) == sizeof(rec) &&
+             idx.write((const uint8_t*)&rec, sizeof(rec)) == sizeof(rec);
+    }
+    if (tmp) tmp.close();
+    if (idx) idx.close();
+    SD.remove(CAPTURE_INDEX_TMP_PATH);
+
+    if (!ok) {
+        Serial.println("[CAPIDX] Rebuild failed");
+        invalidate();
+        return 0;
+    }
+
+    // One file per BSSID, so nothing is replaced yet; load() still builds
+    // the lookup table the same way as on any other boot
+    if (!load()) {
+        invalidate();
+        return 0;
+    }
+    Serial.printf("[CAPIDX] Rebuilt: %lu captures in %lu ms\n",
+                  (unsigned long)cachedCount, (unsigned long)(millis() - t0));
+    return cachedCount;
+}
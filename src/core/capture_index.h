@@ -0,0 +1,74 @@
+// Persistent index of saved handshake captures
+//
+// /handshakes/index.bin: a small header, then one fixed-size record per
+// capture in capture order. Records are only ever appended: a re-saved
+// BSSID gets a new record at the end and its old one is flagged
+// CAPTURE_REPLACED, so the file stays oldest first. The first use per
+// boot reads the index once into a BSSID -> slot table (about 16 bytes
+// per capture); after that a page of records is one seek and a forward
+// read, and add() never scans the card.
+#pragma once
+
+#include <Arduino.h>
+
+#define CAPTURE_INDEX_PATH "/handshakes/index.bin"
+#define CAPTURE_INDEX_MAGIC 0x58494350      // "PCIX"
+#define CAPTURE_INDEX_VERSION 2
+
+// frameMask bits
+#define CAPTURE_HAS_M1 0x01
+#define CAPTURE_HAS_M2 0x02
+#define CAPTURE_HAS_M3 0x04
+#define CAPTURE_HAS_M4 0x08
+#define CAPTURE_HAS_BEACON 0x10
+
+// CaptureRecord flags
+#define CAPTURE_REPLACED 0x01       // A later record has the same BSSID
+
+#pragma pack(push, 1)
+struct CaptureIndexHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+};
+
+struct CaptureRecord {
+    uint8_t bssid[6];
+    uint8_t frameMask;
+    uint8_t flags;
+    uint32_t fileSize;
+    uint32_t timestamp;     // Unix seconds when saved (file mtime on rebuild)
+    char ssid[33];          // Empty if unknown
+    uint8_t pad[3];
+};
+#pragma pack(pop)
+
+class CaptureIndex {
+public:
+    // False if the file is missing or from another format version
+    static bool isValid();
+    static uint32_t count();        // Live captures (replaced records excluded)
+
+    // Read live records [first, first + n) in capture order; returns how
+    // many were read
+    static uint16_t read(uint32_t first, CaptureRecord* out, uint16_t n);
+
+    // Record a saved capture at the end of the index. If the BSSID is
+    // already there (the .pcap was overwritten) its old record is flagged
+    // replaced.
+    static bool add(const CaptureRecord& rec);
+
+    // Rescan /handshakes (parses each pcap for its frame mask). Slow, only
+    // needed when the index is missing or files changed behind our back.
+    static uint32_t rebuild();
+
+    // Drop the index so the next open rebuilds it
+    static void invalidate();
+
+private:
+    static int32_t cachedCount;     // Live records, -1 = not loaded
+    static uint32_t recordCount;    // Records in the file, replaced included
+
+    static bool load();
+    static bool scanPcap(const char* path, CaptureRecord& rec);
+};
@@ -86,17 +86,27 @@ bool Config::load() {
         gpsConfig.sleepTimeMs = doc["gps"]["sleepTimeMs"] | 5000;
         gpsConfig.powerSave = doc["gps"]["powerSave"] | true;
         gpsConfig.timezoneOffset = doc["gps"]["timezoneOffset"] | 0;
+        gpsConfig.adaptiveRate = doc["gps"]["adaptiveRate"] | true;
+        gpsConfig.scanSpacingM = doc["gps"]["scanSpacingM"] | 50;
+        gpsConfig.minScanIntervalMs = doc["gps"]["minScanIntervalMs"] | 2000;
+        gpsConfig.maxScanIntervalMs = doc["gps"]["maxScanIntervalMs"] | 30000;
+        gpsConfig.stationarySpeed = doc["gps"]["stationarySpeed"] | 2;
+        gpsConfig.stationaryHoldS = doc["gps"]["stationaryHoldS"] | 60;
     }
     
     // ML config
     if (doc["ml"].is<JsonObject>()) {
         mlConfig.enabled = doc["ml"]["enabled"] | true;
+        mlConfig.backend = backendFromName(doc["ml"]["backend"] | "auto");
         mlConfig.modelPath = doc["ml"]["modelPath"] | "/models/porkchop_model.bin";
         mlConfig.confidenceThreshold = doc["ml"]["confidenceThreshold"] | 0.7f;
         mlConfig.rogueApThreshold = doc["ml"]["rogueApThreshold"] | 0.8f;
         mlConfig.vulnScorerThreshold = doc["ml"]["vulnScorerThreshold"] | 0.6f;
         mlConfig.autoUpdate = doc["ml"]["autoUpdate"] | false;
         mlConfig.updateUrl = doc["ml"]["updateUrl"] | "";
+        mlConfig.cacheTtlMs = doc["ml"]["cacheTtlMs"] | 30000;
+        mlConfig.onlineNorm = doc["ml"]["onlineNorm"] | false;
+        mlConfig.normSaveIntervalMs = doc["ml"]["normSaveIntervalMs"] | 300000;
     }
     
     // WiFi config
@@ -185,15 +195,25 @@ bool Config::save() {
     doc["gps"]["sleepTimeMs"] = gpsConfig.sleepTimeMs;
     doc["gps"]["powerSave"] = gpsConfig.powerSave;
     doc["gps"]["timezoneOffset"] = gpsConfig.timezoneOffset;
+    doc["gps"]["adaptiveRate"] = gpsConfig.adaptiveRate;
+    doc["gps"]["scanSpacingM"] = gpsConfig.scanSpacingM;
+    doc["gps"]["minScanIntervalMs"] = gpsConfig.minScanIntervalMs;
+    doc["gps"]["maxScanIntervalMs"] = gpsConfig.maxScanIntervalMs;
+    doc["gps"]["stationarySpeed"] = gpsConfig.stationarySpeed;
+    doc["gps"]["stationaryHoldS"] = gpsConfig.stationaryHoldS;
     
     // ML config
     doc["ml"]["enabled"] = mlConfig.enabled;
+    doc["ml"]["backend"] = backendName(mlConfig.backend);
     doc["ml"]["modelPath"] = mlConfig.modelPath;
     doc["ml"]["confidenceThreshold"] = mlConfig.confidenceThreshold;
     doc["ml"]["rogueApThreshold"] = mlConfig.rogueApThreshold;
     doc["ml"]["vulnScorerThreshold"] = mlConfig.vulnScorerThreshold;
     doc["ml"]["autoUpdate"] = mlConfig.autoUpdate;
     doc["ml"]["updateUrl"] = mlConfig.updateUrl;
+    doc["ml"]["cacheTtlMs"] = mlConfig.cacheTtlMs;
+    doc["ml"]["onlineNorm"] = mlConfig.onlineNorm;
+    doc["ml"]["normSaveIntervalMs"] = mlConfig.normSaveIntervalMs;
     
     // WiFi config
     doc["wifi"]["channelHopInterval"] = wifiConfig.channelHopInterval;
@@ -253,3 +273,19 @@ void Config::setPersonality(const PersonalityConfig& cfg) {
     // Save personality to SPIFFS (always available)
     savePersonalityToSPIFFS();
 }
+
+static const char* const BACKEND_NAMES[] = {
+    "auto", "heuristic", "forest", "model", "edge_impulse"
+};
+
+const char* Config::backendName(MLBackend b) {
+    uint8_t i = (uint8_t)b;
+    return i < sizeof(BACKEND_NAMES) / sizeof(BACKEND_NAMES[0]) ? BACKEND_NAMES[i] : "auto";
+}
+
+MLBackend Config::backendFromName(const char* name) {
+    for (uint8_t i = 0; i < sizeof(BACKEND_NAMES) / sizeof(BACKEND_NAMES[0]); i++) {
+        if (name && strcmp(name, BACKEND_NAMES[i]) == 0) return (MLBackend)i;
+    }
+    return MLBackend::AUTO;
+}
@@ -17,17 +17,41 @@ struct GPSConfig {
     uint16_t sleepTimeMs = 5000;        // Sleep duration when stationary
     bool powerSave = true;
     int8_t timezoneOffset = 0;          // Hours offset from UTC (-12 to +14)
+    
+    // Speed-adaptive scheduling (WARHOG)
+    bool adaptiveRate = true;           // Scale fix rate + scan cadence with speed
+    uint16_t scanSpacingM = 50;         // Target distance between scans (meters)
+    uint16_t minScanIntervalMs = 2000;  // Fastest scan cadence (highway)
+    uint16_t maxScanIntervalMs = 30000; // Slowest scan cadence (parked)
+    uint8_t stationarySpeed = 2;        // km/h below which we count as parked
+    uint16_t stationaryHoldS = 60;      // Seconds parked before GPS duty-cycling
+};
+
+// Classifier backend (MLConfig::backend). AUTO picks the best available:
+// Edge Impulse SDK, then quantized model file, then compiled-in forest,
+// then the heuristic rules. An explicit choice that isn't available
+// falls back to the heuristic rules.
+enum class MLBackend : uint8_t {
+    AUTO = 0,
+    HEURISTIC,
+    FOREST,
+    MODEL,
+    EDGE_IMPULSE
 };
 
 // ML settings
 struct MLConfig {
     bool enabled = true;
+    MLBackend backend = MLBackend::AUTO;
     String modelPath = "/models/porkchop_model.bin";
     float confidenceThreshold = 0.7f;
     float rogueApThreshold = 0.8f;
     float vulnScorerThreshold = 0.6f;
     bool autoUpdate = false;
     String updateUrl = "";
+    uint32_t cacheTtlMs = 30000;    // Re-score a cached network at least this often
+    bool onlineNorm = false;        // Normalize from on-device running statistics
+    uint32_t normSaveIntervalMs = 300000;
 };
 
 // WiFi settings for scanning and OTA
@@ -64,6 +88,8 @@ public:
     // Getters
     static GPSConfig& gps() { return gpsConfig; }
     static MLConfig& ml() { return mlConfig; }
+    static const char* backendName(MLBackend b);
+    static MLBackend backendFromName(const char* name);
     static WiFiConfig& wifi() { return wifiConfig; }
     static PersonalityConfig& personality() { return personalityConfig; }
     
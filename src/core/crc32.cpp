@@ -0,0 +1,27 @@
+// CRC-32 implementation (table driven, table built on first use)
+
+#include "crc32.h"
+
+static uint32_t crcTable[256];
+static bool crcTableReady = false;
+
+static void buildTable() {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? (0xEDB88320UL ^ (c >> 1)) : (c >> 1);
+        }
+        crcTable[i] = c;
+    }
+    crcTableReady = true;
+}
+
+uint32_t Crc32::update(uint32_t crc, const uint8_t* data, size_t len) {
+    if (!crcTableReady) buildTable();
+
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
@@ -0,0 +1,13 @@
+// CRC-32 (IEEE 802.3, same as zlib/PNG/ZIP)
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+class Crc32 {
+public:
+    // Incremental: crc = Crc32::update(crc, chunk, len) starting from 0.
+    // Result of the last call is the final CRC - no extra inversion needed.
+    static uint32_t update(uint32_t crc, const uint8_t* data, size_t len);
+    static uint32_t compute(const uint8_t* data, size_t len) { return update(0, data, len); }
+};
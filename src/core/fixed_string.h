@@ -0,0 +1,94 @@
+// Fixed-capacity strings for per-frame UI text
+//
+// Storage lives inside the object (stack or static), so building a label
+// never touches the heap the packet tables share. Appends past capacity
+// are truncated, never reallocated.
+#pragma once
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+template <size_t N>
+class FixedString {
+public:
+    FixedString() { clear(); }
+    FixedString(const char* s) {
+        clear();
+        append(s);
+    }
+
+    void clear() {
+        len = 0;
+        buf[0] = 0;
+    }
+
+    const char* c_str() const { return buf; }
+    operator const char*() const { return buf; }
+    size_t length() const { return len; }
+    bool isEmpty() const { return len == 0; }
+    static size_t capacity() { return N - 1; }
+
+    FixedString& append(const char* s, size_t n) {
+        if (!s) return *this;
+        size_t room = N - 1 - len;
+        if (n > room) n = room;
+        memcpy(buf + len, s, n);
+        len += n;
+        buf[len] = 0;
+        return *this;
+    }
+
+    FixedString& append(const char* s) { return s ? append(s, strlen(s)) : *this; }
+
+    FixedString& append(char c) {
+        if (len < N - 1) {
+            buf[len++] = c;
+            buf[len] = 0;
+        }
+        return *this;
+    }
+
+    FixedString& appendf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, fmt);
+        vappendf(fmt, args);
+        va_end(args);
+        return *this;
+    }
+
+    // clear() + appendf()
+    FixedString& format(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        clear();
+        va_list args;
+        va_start(args, fmt);
+        vappendf(fmt, args);
+        va_end(args);
+        return *this;
+    }
+
+    FixedString& operator=(const char* s) {
+        clear();
+        return append(s);
+    }
+    FixedString& operator+=(const char* s) { return append(s); }
+    FixedString& operator+=(char c) { return append(c); }
+
+    bool equals(const char* s) const { return s && strcmp(buf, s) == 0; }
+    bool operator==(const FixedString& other) const {
+        return len == other.len && memcmp(buf, other.buf, len) == 0;
+    }
+    bool operator!=(const FixedString& other) const { return !(*this == other); }
+
+private:
+    char buf[N];
+    size_t len;
+
+    void vappendf(const char* fmt, va_list args) {
+        int n = vsnprintf(buf + len, N - len, fmt, args);
+        if (n > 0) {
+            len += ((size_t)n < N - len) ? (size_t)n : N - 1 - len;
+        }
+    }
+};
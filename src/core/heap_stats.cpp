@@ -0,0 +1,73 @@
+// Heap allocation counter and fragmentation probes
+
+#include "heap_stats.h"
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static volatile TaskHandle_t watchedTask = nullptr;
+static volatile uint32_t allocCount = 0;
+static size_t minLargestBlock = SIZE_MAX;
+
+#ifdef HEAP_ALLOC_HOOK
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+// Only the watched task writes the counter, so no lock is needed
+static inline void countAlloc() {
+    if (watchedTask && xTaskGetCurrentTaskHandle() == watchedTask) {
+        allocCount = allocCount + 1;
+    }
+}
+
+void* __wrap_malloc(size_t size) {
+    countAlloc();
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+    countAlloc();
+    return __real_calloc(n, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    countAlloc();
+    return __real_realloc(ptr, size);
+}
+}
+#endif
+
+void HeapStats::watchCurrentTask() {
+    watchedTask = xTaskGetCurrentTaskHandle();
+}
+
+uint32_t HeapStats::getAllocCount() {
+    return allocCount;
+}
+
+bool HeapStats::isHooked() {
+#ifdef HEAP_ALLOC_HOOK
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t HeapStats::getFreeHeap() {
+    return heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+size_t HeapStats::getLargestFreeBlock() {
+    return heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+}
+
+size_t HeapStats::getMinLargestFreeBlock() {
+    return minLargestBlock == SIZE_MAX ? getLargestFreeBlock() : minLargestBlock;
+}
+
+void HeapStats::sample() {
+    size_t largest = getLargestFreeBlock();
+    if (largest < minLargestBlock) minLargestBlock = largest;
+}
@@ -0,0 +1,25 @@
+// Heap allocation counter and fragmentation probes
+//
+// Counting needs the linker to route malloc/calloc/realloc through the
+// hooks in heap_stats.cpp: build with -DHEAP_ALLOC_HOOK and
+// -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc (the debug env does).
+// Without it getAllocCount() stays 0 and isHooked() is false.
+#pragma once
+
+#include <Arduino.h>
+
+class HeapStats {
+public:
+    // Only allocations made by the calling task are counted, so WiFi and
+    // ML worker tasks don't show up in per-frame numbers
+    static void watchCurrentTask();
+
+    static uint32_t getAllocCount();
+    static bool isHooked();
+
+    static size_t getFreeHeap();
+    static size_t getLargestFreeBlock();
+    static size_t getMinLargestFreeBlock();     // Lowest seen by sample()
+
+    static void sample();                       // Track the largest-block minimum
+};
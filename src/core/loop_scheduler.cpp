@@ -0,0 +1,126 @@
+// Deadline-driven cooperative scheduler implementation
+
+#include "loop_scheduler.h"
+
+LoopScheduler::Task LoopScheduler::tasks[LOOP_MAX_TASKS];
+uint8_t LoopScheduler::taskCount = 0;
+
+// micros() wraps every ~71 minutes; compare through signed differences
+static inline bool reached(uint32_t now, uint32_t t) {
+    return (int32_t)(now - t) >= 0;
+}
+
+int8_t LoopScheduler::add(const char* name, LoopTaskFn fn, uint32_t periodMs,
+                          uint32_t deadlineMs, uint32_t budgetUs) {
+    if (taskCount >= LOOP_MAX_TASKS || !fn || periodMs == 0) {
+        Serial.printf("[SCHED] Cannot add task %s\n", name);
+        return -1;
+    }
+
+    Task& t = tasks[taskCount];
+    memset(&t, 0, sizeof(t));
+    t.fn = fn;
+    t.releaseUs = micros();
+    t.stats.name = name;
+    t.stats.periodUs = periodMs * 1000;
+    t.stats.deadlineUs = deadlineMs * 1000;
+    t.stats.budgetUs = budgetUs;
+    return (int8_t)taskCount++;
+}
+
+void LoopScheduler::expedite(int8_t id) {
+    if (id < 0 || id >= taskCount) return;
+    uint32_t now = micros();
+    if (!reached(now, tasks[id].releaseUs)) {
+        tasks[id].releaseUs = now;
+    }
+}
+
+void LoopScheduler::tick() {
+    // Each task runs at most once per tick, so an overloaded task can't
+    // keep the loop from sleeping
+    uint32_t ranMask = 0;
+
+    while (true) {
+        uint32_t now = micros();
+        int8_t pick = -1;
+        uint32_t pickDeadline = 0;
+
+        for (uint8_t i = 0; i < taskCount; i++) {
+            if ((ranMask & (1UL << i)) || !reached(now, tasks[i].releaseUs)) continue;
+            uint32_t deadline = tasks[i].releaseUs + tasks[i].stats.deadlineUs;
+            if (pick < 0 || (int32_t)(deadline - pickDeadline) < 0) {
+                pick = i;
+                pickDeadline = deadline;
+            }
+        }
+        if (pick < 0) break;
+
+        Task& t = tasks[pick];
+        LoopTaskStats& s = t.stats;
+        ranMask |= 1UL << pick;
+
+        uint32_t late = now - t.releaseUs;
+        if (late > s.maxLateUs) s.maxLateUs = late;
+        if (late > s.deadlineUs) s.lateStarts++;
+
+        t.fn();
+
+        uint32_t end = micros();
+        uint32_t ran = end - now;
+        s.runs++;
+        if (ran > s.maxRunUs) s.maxRunUs = ran;
+        if (ran > s.budgetUs) s.overruns++;
+
+        // Stay on the release grid (no drift); if we're a whole period or
+        // more behind, drop those slots rather than running back to back
+        t.releaseUs += s.periodUs;
+        uint32_t behind = end - t.releaseUs;
+        if ((int32_t)behind >= (int32_t)s.periodUs) {
+            uint32_t skip = behind / s.periodUs;
+            t.releaseUs += skip * s.periodUs;
+            s.skipped += skip;
+        }
+    }
+
+    if (taskCount == 0) {
+        delay(1);
+        return;
+    }
+
+    // Sleep to the next release. At least one tick, so the idle task and
+    // the WiFi/BT tasks always get the core even when something is overrunning.
+    uint32_t now = micros();
+    uint32_t next = tasks[0].releaseUs;
+    for (uint8_t i = 1; i < taskCount; i++) {
+        if ((int32_t)(tasks[i].releaseUs - next) < 0) next = tasks[i].releaseUs;
+    }
+    uint32_t waitMs = 1;
+    if (!reached(now, next)) {
+        waitMs = max((uint32_t)1, (next - now + 999) / 1000);
+    }
+    delay(waitMs);
+}
+
+void LoopScheduler::resetStats() {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        LoopTaskStats& s = tasks[i].stats;
+        s.runs = 0;
+        s.lateStarts = 0;
+        s.overruns = 0;
+        s.skipped = 0;
+        s.maxLateUs = 0;
+        s.maxRunUs = 0;
+    }
+}
+
+void LoopScheduler::logStats() {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const LoopTaskStats& s = tasks[i].stats;
+        Serial.printf("[SCHED] %-8s %4lu ms: runs=%lu late=%lu (max %lu us) over=%lu (max %lu/%lu us) skip=%lu\n",
+                      s.name, (unsigned long)(s.periodUs / 1000), (unsigned long)s.runs,
+                      (unsigned long)s.lateStarts, (unsigned long)s.maxLateUs,
+                      (unsigned long)s.overruns, (unsigned long)s.maxRunUs, (unsigned long)s.budgetUs,
+                      (unsigned long)s.skipped);
+    }
+}
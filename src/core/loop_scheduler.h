@@ -0,0 +1,51 @@
+// Deadline-driven cooperative scheduler for loop()
+#pragma once
+
+#include <Arduino.h>
+
+#define LOOP_MAX_TASKS 10
+
+typedef void (*LoopTaskFn)();
+
+struct LoopTaskStats {
+    const char* name;
+    uint32_t periodUs;
+    uint32_t deadlineUs;    // Max start delay after release
+    uint32_t budgetUs;      // Expected run time
+    uint32_t runs;
+    uint32_t lateStarts;    // Started past the deadline
+    uint32_t overruns;      // Ran longer than the budget
+    uint32_t skipped;       // Whole periods dropped after falling behind
+    uint32_t maxLateUs;
+    uint32_t maxRunUs;
+};
+
+class LoopScheduler {
+public:
+    // Tasks are released on a fixed grid of `periodMs` from registration.
+    // Due tasks run earliest-absolute-deadline first. Returns the task id,
+    // -1 when the table is full.
+    static int8_t add(const char* name, LoopTaskFn fn, uint32_t periodMs,
+                      uint32_t deadlineMs, uint32_t budgetUs);
+
+    // Release a task now instead of at its next slot (e.g. redraw on a key)
+    static void expedite(int8_t id);
+
+    // Run whatever is due, then sleep until the next release. Call from loop().
+    static void tick();
+
+    static uint8_t getTaskCount() { return taskCount; }
+    static const LoopTaskStats& getStats(uint8_t id) { return tasks[id].stats; }
+    static void resetStats();
+    static void logStats();
+
+private:
+    struct Task {
+        LoopTaskFn fn;
+        uint32_t releaseUs;     // Next release, micros() time base
+        LoopTaskStats stats;
+    };
+
+    static Task tasks[LOOP_MAX_TASKS];
+    static uint8_t taskCount;
+};
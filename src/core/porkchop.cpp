@@ -6,10 +6,14 @@
 #include "../ui/menu.h"
 #include "../ui/settings_menu.h"
 #include "../ui/captures_menu.h"
+#include "../ui/channel_view.h"
+#include "../ui/network_list_view.h"
+#include "../ui/ml_stats_view.h"
 #include "../piglet/mood.h"
 #include "../piglet/avatar.h"
 #include "../modes/oink.h"
 #include "../modes/warhog.h"
+#include "../ml/inference.h"
 #include "../web/fileserver.h"
 #include "config.h"
 
@@ -89,8 +93,13 @@ void Porkchop::setMode(PorkchopMode mode) {
     
     // Cleanup previous mode
     switch (previousMode) {
+        case PorkchopMode::IDLE:
+            MLStatsView::hide();
+            break;
         case PorkchopMode::OINK_MODE:
             OinkMode::stop();
+            ChannelView::hide();
+            NetworkListView::hide();
             break;
         case PorkchopMode::WARHOG_MODE:
             WarhogMode::stop();
@@ -235,16 +244,45 @@ void Porkchop::handleInput() {
                 case 'S':
                     setMode(PorkchopMode::SETTINGS);
                     break;
+                case 'm': // ML latency stats
+                case 'M':
+                    MLStatsView::toggle();
+                    break;
+                case 'b': // Golden-vector benchmark (stats screen only)
+                case 'B':
+                    if (MLStatsView::isVisible()) MLInference::benchmarkGolden(20);
+                    break;
+                case 'r':
+                case 'R':
+                    if (MLStatsView::isVisible()) MLInference::resetLatency();
+                    break;
             }
         }
     }
     
-    // OINK mode - Backspace to stop and return to idle
+    // OINK mode - Backspace to stop and return to idle, C for channel quality,
+    // L for the network list (; . to move, S to change sort, Enter to target)
     if (currentMode == PorkchopMode::OINK_MODE) {
         if (M5Cardputer.Keyboard.isKeyPressed(KEY_BACKSPACE)) {
             setMode(PorkchopMode::IDLE);
             return;
         }
+        for (auto c : keys.word) {
+            if (c == 'c' || c == 'C') {
+                NetworkListView::hide();
+                ChannelView::toggle();
+            } else if (c == 'l' || c == 'L') {
+                ChannelView::hide();
+                NetworkListView::toggle();
+            } else if (NetworkListView::isVisible()) {
+                if (c == ';') OinkMode::moveSelectionUp();
+                else if (c == '.') OinkMode::moveSelectionDown();
+                else if (c == 's' || c == 'S') NetworkListView::cycleSortKey();
+            }
+        }
+        if (keys.enter && NetworkListView::isVisible()) {
+            OinkMode::confirmSelection();
+        }
     }
     
     // FILE_TRANSFER mode - Backspace to stop and return to menu
@@ -13,6 +13,7 @@ GPSData GPS::currentData = {0};
 uint32_t GPS::fixCount = 0;
 uint32_t GPS::lastFixTime = 0;
 uint32_t GPS::lastUpdateTime = 0;
+uint16_t GPS::fixPeriodMs = 1000;
 
 void GPS::init(uint8_t rxPin, uint8_t txPin, uint32_t baud) {
     // Use Serial2 for GPS (UART2)
@@ -151,6 +152,42 @@ void GPS::setPowerMode(bool isActive) {
     }
 }
 
+void GPS::setFixPeriod(uint16_t periodMs) {
+    if (!serial) return;
+    periodMs = constrain(periodMs, 100, 1000);
+    if (periodMs == fixPeriodMs) return;
+    
+    // CFG-RATE: measRate(ms), navRate(cycles), timeRef(1 = GPS time)
+    uint8_t payload[6] = {
+        (uint8_t)(periodMs & 0xFF), (uint8_t)(periodMs >> 8),
+        0x01, 0x00,
+        0x01, 0x00
+    };
+    sendUBX(0x06, 0x08, payload, sizeof(payload));
+    fixPeriodMs = periodMs;
+    Serial.printf("[GPS] Fix period set to %u ms\n", periodMs);
+}
+
+void GPS::sendUBX(uint8_t msgClass, uint8_t msgId, const uint8_t* payload, uint16_t len) {
+    uint8_t header[6] = {0xB5, 0x62, msgClass, msgId, (uint8_t)(len & 0xFF), (uint8_t)(len >> 8)};
+    
+    // 8-bit Fletcher checksum over class, id, length and payload
+    uint8_t ckA = 0, ckB = 0;
+    for (int i = 2; i < 6; i++) {
+        ckA += header[i];
+        ckB += ckA;
+    }
+    for (uint16_t i = 0; i < len; i++) {
+        ckA += payload[i];
+        ckB += ckA;
+    }
+    
+    serial->write(header, sizeof(header));
+    serial->write(payload, len);
+    serial->write(ckA);
+    serial->write(ckB);
+}
+
 bool GPS::isActive() {
     return active;
 }
@@ -175,8 +212,15 @@ String GPS::getLocationString() {
 }
 
 String GPS::getTimeString() {
+    char buf[8];
+    formatTime(buf, sizeof(buf));
+    return String(buf);
+}
+
+void GPS::formatTime(char* buf, size_t len) {
     if (!gps.time.isValid()) {
-        return "--:--";
+        snprintf(buf, len, "--:--");
+        return;
     }
     
     // Apply timezone offset from config
@@ -187,7 +231,5 @@ String GPS::getTimeString() {
     if (hour >= 24) hour -= 24;
     if (hour < 0) hour += 24;
     
-    char buf[8];
-    snprintf(buf, sizeof(buf), "%02d:%02d", hour, gps.time.minute());
-    return String(buf);
+    snprintf(buf, len, "%02d:%02d", hour, gps.time.minute());
 }
@@ -30,11 +30,16 @@ public:
     static GPSData getData();
     static String getLocationString();
     static String getTimeString();
+    static void formatTime(char* buf, size_t len);  // "HH:MM" local, no heap
     
     // Power management
     static void setPowerMode(bool active);
     static bool isActive();
     
+    // Navigation solution rate (ms between fixes, 100-1000)
+    static void setFixPeriod(uint16_t periodMs);
+    static uint16_t getFixPeriod() { return fixPeriodMs; }
+    
     // Statistics
     static uint32_t getFixCount() { return fixCount; }
     static uint32_t getLastFixTime() { return lastFixTime; }
@@ -47,7 +52,9 @@ private:
     static uint32_t fixCount;
     static uint32_t lastFixTime;
     static uint32_t lastUpdateTime;
+    static uint16_t fixPeriodMs;
     
+    static void sendUBX(uint8_t msgClass, uint8_t msgId, const uint8_t* payload, uint16_t len);
     static void processSerial();
     static void updateData();
 };
@@ -0,0 +1,255 @@
+// Speed-adaptive GPS / scan scheduler implementation
+//
+// Keeps spatial sampling density roughly constant: scan interval is
+// scanSpacingM / speed, so a scan happens every ~50m whether walking or
+// on the highway. When parked the cadence drops to maxScanIntervalMs and,
+// with powerSave on, the GPS is duty-cycled (sleep, wake to probe speed).
+
+#include "gps_scheduler.h"
+#include "gps.h"
+#include "../core/config.h"
+
+// WiFi scan covers 13 channels; default ESP32 dwell is 300ms per channel
+static const uint8_t SCAN_CHANNELS = 13;
+static const uint16_t DWELL_MAX_MS = 300;
+static const uint16_t DWELL_MIN_MS = 80;
+
+static const uint32_t SAMPLE_INTERVAL_MS = 1000;   // Speed sampling period
+static const uint32_t RATE_CHANGE_HOLDOFF_MS = 5000; // Min time between CFG-RATE commands
+static const uint32_t PROBE_WINDOW_MS = 15000;     // Max wake time to get a fix when duty-cycling
+static const float SPEED_ALPHA = 0.3f;             // EWMA weight of newest sample
+static const float WALKING_MAX_KMH = 10.0f;
+static const float HYSTERESIS_KMH = 2.0f;
+
+// Static members
+bool GPSScheduler::running = false;
+MotionState GPSScheduler::motion = MotionState::UNKNOWN;
+float GPSScheduler::speedKmh = 0.0f;
+uint32_t GPSScheduler::scanIntervalMs = 5000;
+uint16_t GPSScheduler::dwellMs = DWELL_MAX_MS;
+uint16_t GPSScheduler::fixPeriodMs = 1000;
+uint32_t GPSScheduler::stationarySince = 0;
+uint32_t GPSScheduler::lastSample = 0;
+uint32_t GPSScheduler::lastRateChange = 0;
+bool GPSScheduler::dutyCycling = false;
+uint32_t GPSScheduler::dutyPhaseStart = 0;
+
+void GPSScheduler::start() {
+    running = true;
+    motion = MotionState::UNKNOWN;
+    speedKmh = 0.0f;
+    stationarySince = 0;
+    lastSample = 0;
+    lastRateChange = 0;
+    dutyCycling = false;
+    dutyPhaseStart = 0;
+
+    recompute(millis());
+
+    Serial.printf("[GPSSCHED] Started (adaptive: %s, spacing: %um)\n",
+                  Config::gps().adaptiveRate ? "ON" : "OFF",
+                  Config::gps().scanSpacingM);
+}
+
+void GPSScheduler::stop() {
+    if (!running) return;
+    running = false;
+    dutyCycling = false;
+
+    // Leave the receiver at its default rate for the next user
+    GPS::setFixPeriod(1000);
+
+    Serial.println("[GPSSCHED] Stopped");
+}
+
+void GPSScheduler::update() {
+    if (!running) return;
+
+    uint32_t now = millis();
+
+    if (!Config::gps().adaptiveRate) {
+        // Fixed cadence from updateInterval, no power games
+        scanIntervalMs = Config::gps().updateInterval * 1000UL;
+        dwellMs = DWELL_MAX_MS;
+
+        // Switched off mid-session: don't leave the receiver asleep or slowed
+        if (dutyCycling) {
+            dutyCycling = false;
+            GPS::wake();
+            Serial.println("[GPSSCHED] Adaptive off, GPS awake");
+        }
+        if (fixPeriodMs != 1000 && GPS::isActive()) {
+            GPS::setFixPeriod(1000);
+            fixPeriodMs = 1000;
+            lastRateChange = now;
+        }
+        return;
+    }
+
+    if (now - lastSample >= SAMPLE_INTERVAL_MS) {
+        sampleSpeed(now);
+        recompute(now);
+        lastSample = now;
+    }
+
+    updatePower(now);
+}
+
+const char* GPSScheduler::motionName(MotionState state) {
+    switch (state) {
+        case MotionState::STATIONARY: return "PARKED";
+        case MotionState::WALKING:    return "WALKING";
+        case MotionState::DRIVING:    return "DRIVING";
+        default:                      return "UNKNOWN";
+    }
+}
+
+void GPSScheduler::sampleSpeed(uint32_t now) {
+    if (!GPS::isActive() || !GPS::hasFix()) {
+        // Sleeping on purpose: keep last known motion. Otherwise we're blind.
+        if (!dutyCycling) {
+            motion = MotionState::UNKNOWN;
+        }
+        return;
+    }
+
+    float raw = GPS::getData().speed;  // km/h
+    if (motion == MotionState::UNKNOWN) {
+        speedKmh = raw;
+    } else {
+        speedKmh = SPEED_ALPHA * raw + (1.0f - SPEED_ALPHA) * speedKmh;
+    }
+
+    // Classify with hysteresis so GPS speed noise doesn't flap the state
+    float parked = Config::gps().stationarySpeed;
+    MotionState next = motion;
+    switch (motion) {
+        case MotionState::STATIONARY:
+            if (speedKmh > parked + HYSTERESIS_KMH) next = MotionState::WALKING;
+            break;
+        case MotionState::WALKING:
+            if (speedKmh < parked) next = MotionState::STATIONARY;
+            else if (speedKmh > WALKING_MAX_KMH + HYSTERESIS_KMH) next = MotionState::DRIVING;
+            break;
+        case MotionState::DRIVING:
+            if (speedKmh < WALKING_MAX_KMH) next = MotionState::WALKING;
+            break;
+        default:
+            if (speedKmh < parked) next = MotionState::STATIONARY;
+            else if (speedKmh < WALKING_MAX_KMH) next = MotionState::WALKING;
+            else next = MotionState::DRIVING;
+            break;
+    }
+    // Big jumps (parked -> highway) skip straight through
+    if (next == MotionState::WALKING && speedKmh > WALKING_MAX_KMH + HYSTERESIS_KMH) {
+        next = MotionState::DRIVING;
+    }
+
+    if (next != motion) {
+        Serial.printf("[GPSSCHED] Motion %s -> %s (%.1f km/h)\n",
+                      motionName(motion), motionName(next), speedKmh);
+        if (next == MotionState::STATIONARY) {
+            stationarySince = now;
+        }
+        motion = next;
+    }
+}
+
+void GPSScheduler::recompute(uint32_t now) {
+    const GPSConfig& cfg = Config::gps();
+    uint32_t interval;
+    uint16_t dwell;
+    uint16_t fixPeriod;
+
+    switch (motion) {
+        case MotionState::UNKNOWN:
+            interval = cfg.updateInterval * 1000UL;
+            dwell = DWELL_MAX_MS;
+            fixPeriod = 1000;
+            break;
+        case MotionState::STATIONARY:
+            // Same spot, same APs - thorough but rare scans
+            interval = cfg.maxScanIntervalMs;
+            dwell = DWELL_MAX_MS;
+            fixPeriod = 1000;
+            break;
+        default: {
+            // Time to cover scanSpacingM at current speed
+            float mps = max(speedKmh, 0.5f) / 3.6f;
+            interval = (uint32_t)(cfg.scanSpacingM / mps * 1000.0f);
+            interval = constrain(interval, (uint32_t)cfg.minScanIntervalMs, (uint32_t)cfg.maxScanIntervalMs);
+
+            // Keep the scan itself under half the interval so position blur stays low
+            dwell = constrain(interval / 2 / SCAN_CHANNELS, (uint32_t)DWELL_MIN_MS, (uint32_t)DWELL_MAX_MS);
+
+            // A few fixes per scan, rounded to 100ms steps the receiver accepts
+            fixPeriod = constrain(interval / 4, (uint32_t)200, (uint32_t)1000);
+            fixPeriod = (fixPeriod / 100) * 100;
+            break;
+        }
+    }
+
+    // Only log meaningful changes (>10% or dwell/fix moved)
+    uint32_t delta = interval > scanIntervalMs ? interval - scanIntervalMs : scanIntervalMs - interval;
+    bool changed = delta * 10 > scanIntervalMs || dwell != dwellMs || fixPeriod != fixPeriodMs;
+
+    scanIntervalMs = interval;
+    dwellMs = dwell;
+
+    if (fixPeriod != fixPeriodMs && GPS::isActive() &&
+        (lastRateChange == 0 || now - lastRateChange >= RATE_CHANGE_HOLDOFF_MS)) {
+        GPS::setFixPeriod(fixPeriod);
+        fixPeriodMs = fixPeriod;
+        lastRateChange = now;
+    }
+
+    if (changed) {
+        Serial.printf("[GPSSCHED] %s %.1f km/h -> scan %lu ms, dwell %u ms, fix %u ms\n",
+                      motionName(motion), speedKmh, scanIntervalMs, dwellMs, fixPeriodMs);
+    }
+}
+
+void GPSScheduler::updatePower(uint32_t now) {
+    const GPSConfig& cfg = Config::gps();
+
+    if (!cfg.powerSave) {
+        if (dutyCycling) {
+            dutyCycling = false;
+            GPS::wake();
+        }
+        return;
+    }
+
+    if (!dutyCycling) {
+        // Parked long enough - start sleeping the receiver between probes
+        if (motion == MotionState::STATIONARY &&
+            now - stationarySince >= cfg.stationaryHoldS * 1000UL) {
+            GPS::sleep();
+            dutyCycling = true;
+            dutyPhaseStart = now;
+            Serial.printf("[GPSSCHED] Parked %us, GPS duty-cycling (sleep %u ms)\n",
+                          cfg.stationaryHoldS, cfg.sleepTimeMs);
+        }
+        return;
+    }
+
+    if (!GPS::isActive()) {
+        // Asleep - wake up periodically to check whether we've moved
+        if (now - dutyPhaseStart >= cfg.sleepTimeMs) {
+            GPS::wake();
+            dutyPhaseStart = now;
+            Serial.println("[GPSSCHED] Probe wake");
+        }
+        return;
+    }
+
+    // Awake on a probe - wait for a fresh speed sample taken after wake
+    bool freshSample = GPS::hasFix() && lastSample > dutyPhaseStart;
+    if (freshSample && motion != MotionState::STATIONARY) {
+        dutyCycling = false;
+        Serial.printf("[GPSSCHED] Moving again (%.1f km/h), GPS stays awake\n", speedKmh);
+    } else if (freshSample || now - dutyPhaseStart >= PROBE_WINDOW_MS) {
+        GPS::sleep();
+        dutyPhaseStart = now;
+    }
+}
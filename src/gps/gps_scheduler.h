@@ -0,0 +1,45 @@
+// Speed-adaptive GPS / scan scheduler for WARHOG
+#pragma once
+
+#include <Arduino.h>
+
+enum class MotionState : uint8_t {
+    UNKNOWN = 0,    // No fix yet - use configured defaults
+    STATIONARY,     // Parked
+    WALKING,        // < 10 km/h
+    DRIVING         // Everything faster
+};
+
+class GPSScheduler {
+public:
+    static void start();
+    static void stop();
+    static void update();
+
+    // Current decisions
+    static uint32_t getScanIntervalMs() { return scanIntervalMs; }
+    static uint16_t getDwellMs() { return dwellMs; }
+    static uint16_t getFixPeriodMs() { return fixPeriodMs; }
+    static MotionState getMotionState() { return motion; }
+    static float getSpeedKmh() { return speedKmh; }
+    static bool isGPSDutyCycling() { return dutyCycling; }
+
+    static const char* motionName(MotionState state);
+
+private:
+    static bool running;
+    static MotionState motion;
+    static float speedKmh;           // EWMA-smoothed ground speed
+    static uint32_t scanIntervalMs;
+    static uint16_t dwellMs;
+    static uint16_t fixPeriodMs;
+    static uint32_t stationarySince;
+    static uint32_t lastSample;
+    static uint32_t lastRateChange;
+    static bool dutyCycling;         // GPS sleeping between position probes
+    static uint32_t dutyPhaseStart;
+
+    static void sampleSpeed(uint32_t now);
+    static void recompute(uint32_t now);
+    static void updatePower(uint32_t now);
+};
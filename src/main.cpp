@@ -6,18 +6,68 @@
 #include <M5Unified.h>
 #include "core/porkchop.h"
 #include "core/config.h"
+#include "core/loop_scheduler.h"
+#include "core/heap_stats.h"
 #include "ui/display.h"
 #include "gps/gps.h"
 #include "piglet/avatar.h"
 #include "piglet/mood.h"
 #include "ml/features.h"
 #include "ml/inference.h"
+#include "ml/forest.h"
+#include "ml/norm_stats.h"
+#include "ml/model_installer.h"
 #include "modes/oink.h"
 #include "modes/warhog.h"
 
 Porkchop porkchop;
 
+static int8_t displayTask = -1;
+
+// Keyboard, G0 and the mode state machines (OINK hop/attack timers,
+// WARHOG scans, file server). Redraw right away when a key changed.
+static void inputTask() {
+    M5.update();
+    M5Cardputer.update();
+    porkchop.update();
+    if (M5Cardputer.Keyboard.isChange()) {
+        LoopScheduler::expedite(displayTask);
+    }
+}
+
+// Checked every run: GPS can be switched off from settings at runtime
+static void gpsTask() {
+    if (Config::gps().enabled) {
+        GPS::update();
+    }
+}
+
+static void moodTask() {
+    Mood::update();
+}
+
+// ML callbacks, normalization snapshots, serial model uploads
+static void mlTask() {
+    MLInference::update();
+    NormStats::update();
+    ModelInstaller::serviceSerial();
+}
+
+static void displayTaskFn() {
+    Display::update();
+}
+
+#ifdef DEBUG_MODE
+static void schedStatsTask() {
+    LoopScheduler::logStats();
+    LoopScheduler::resetStats();
+}
+#endif
+
 void setup() {
+    // setup() and loop() share the Arduino loop task; count its allocations
+    HeapStats::watchCurrentTask();
+    
     Serial.begin(115200);
     delay(100);
     Serial.println("\n=== PORKCHOP STARTING ===");
@@ -61,6 +111,14 @@ void setup() {
     // Initialize ML subsystem
     FeatureExtractor::init();
     MLInference::init();
+    NormStats::init();
+#ifdef DEBUG_MODE
+    MLInference::benchmarkBatch(256);
+    MLInference::benchmarkGolden();
+    ForestClassifier::selfTest();
+    Display::benchmarkPush();
+    Display::benchmarkPiglet();
+#endif
     Display::showProgress("ML ready...", 70);
     
     // Initialize modes
@@ -74,31 +132,23 @@ void setup() {
     
     delay(500);
     
+    // Periods replace the old fixed delay(50): input is polled every 10 ms,
+    // the screen still renders at 20 fps. Budgets are typical run times;
+    // going over is counted, not enforced.
+    LoopScheduler::add("input", inputTask, 10, 5, 8000);
+    LoopScheduler::add("gps", gpsTask, 20, 10, 2000);
+    LoopScheduler::add("ml", mlTask, 20, 20, 5000);
+    LoopScheduler::add("mood", moodTask, 100, 50, 1000);
+    displayTask = LoopScheduler::add("display", displayTaskFn, 50, 25, 15000);
+#ifdef DEBUG_MODE
+    LoopScheduler::add("stats", schedStatsTask, 30000, 1000, 5000);
+#endif
+    
     Serial.println("=== PORKCHOP READY ===");
     Serial.printf("Piglet: %s\n", Config::personality().name);
 }
 
 void loop() {
-    M5.update();
-    M5Cardputer.update();
-    
-    // Update GPS
-    if (Config::gps().enabled) {
-        GPS::update();
-    }
-    
-    // Update mood system
-    Mood::update();
-    
-    // Update main controller (handles modes, input, state)
-    porkchop.update();
-    
-    // Update ML (process any pending callbacks)
-    MLInference::update();
-    
-    // Update display
-    Display::update();
-    
-    // Slower update rate for smoother animation
-    delay(50);
+    // Runs whatever is due, then sleeps until the next deadline
+    LoopScheduler::tick();
 }
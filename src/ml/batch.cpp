@@ -0,0 +1,168 @@
+// Batch (struct-of-arrays) feature kernels implementation
+//
+// On ESP32-S3 the affine parts (normalization, score scaling) go through
+// esp-dsp, which uses the PIE SIMD unit. Everywhere else the loops are
+// written branch-free over contiguous columns so the compiler can
+// auto-vectorize them.
+
+#include "batch.h"
+
+#if defined(ESP_PLATFORM) && __has_include(<esp_dsp.h>)
+#include <esp_dsp.h>
+#define BATCH_USE_ESP_DSP 1
+#else
+#define BATCH_USE_ESP_DSP 0
+#endif
+
+// Feature column indices (see FeatureExtractor::toFeatureVector)
+enum : int {
+    COL_RSSI = 0,
+    COL_CHANNEL = 3,
+    COL_BEACON_INTERVAL = 5,
+    COL_WPS = 8,
+    COL_WPA = 9,
+    COL_WPA2 = 10,
+    COL_WPA3 = 11,
+    COL_HIDDEN = 12,
+    COL_JITTER = 15,
+    COL_VENDOR_IES = 18,
+    COL_RATES = 19,
+    COL_HT = 20,
+    COL_VHT = 21,
+    COL_TWIN = 23
+};
+
+static void addConst(const float* in, float* out, int n, float c) {
+#if BATCH_USE_ESP_DSP
+    dsps_addc_f32(in, out, n, c, 1, 1);
+#else
+    for (int i = 0; i < n; i++) out[i] = in[i] + c;
+#endif
+}
+
+static void mulConst(const float* in, float* out, int n, float c) {
+#if BATCH_USE_ESP_DSP
+    dsps_mulc_f32(in, out, n, c, 1, 1);
+#else
+    for (int i = 0; i < n; i++) out[i] = in[i] * c;
+#endif
+}
+
+bool BatchKernels::isAccelerated() {
+    return BATCH_USE_ESP_DSP != 0;
+}
+
+void BatchKernels::normalize(FeatureMatrix& m, const float* means, const float* stds) {
+    int n = (int)m.rows;
+    if (n == 0) return;
+
+    for (int c = 0; c < FEATURE_VECTOR_SIZE; c++) {
+        float* col = m.column(c);
+        if (stds[c] < 0.001f) {
+            for (int i = 0; i < n; i++) col[i] = 0.0f;
+            continue;
+        }
+        // (x - mean) / std as one add + one multiply pass
+        addConst(col, col, n, -means[c]);
+        mulConst(col, col, n, 1.0f / stds[c]);
+    }
+}
+
+void BatchKernels::heuristicScores(const FeatureMatrix& m, ScoreMatrix& out) {
+    size_t n = m.rows;
+    out.resize(n);
+    if (n == 0) return;
+
+    const float* __restrict rssi = m.column(COL_RSSI);
+    const float* __restrict channel = m.column(COL_CHANNEL);
+    const float* __restrict beaconInterval = m.column(COL_BEACON_INTERVAL);
+    const float* __restrict wps = m.column(COL_WPS);
+    const float* __restrict wpa = m.column(COL_WPA);
+    const float* __restrict wpa2 = m.column(COL_WPA2);
+    const float* __restrict wpa3 = m.column(COL_WPA3);
+    const float* __restrict hidden = m.column(COL_HIDDEN);
+    const float* __restrict jitter = m.column(COL_JITTER);
+    const float* __restrict vendorIEs = m.column(COL_VENDOR_IES);
+    const float* __restrict rates = m.column(COL_RATES);
+    const float* __restrict ht = m.column(COL_HT);
+    const float* __restrict vht = m.column(COL_VHT);
+    const float* __restrict twin = m.column(COL_TWIN);
+
+    float* __restrict normal = out.column(0);
+    float* __restrict anomaly = out.column(1);
+    float* __restrict evilTwin = out.column(2);
+    float* __restrict deauth = out.column(3);
+    float* __restrict vuln = out.column(4);
+
+    // Rules are evaluated in the same order as HeuristicRules::score
+    // so float accumulation matches the scalar classifier exactly.
+    for (size_t i = 0; i < n; i++) {
+        bool hasWPS = wps[i] > 0.5f;
+        bool hasWPA = wpa[i] > 0.5f;
+        bool hasWPA2 = wpa2[i] > 0.5f;
+        bool hasWPA3 = wpa3[i] > 0.5f;
+        bool isOpen = !hasWPA && !hasWPA2 && !hasWPA3;
+        bool isHidden = hidden[i] > 0.5f;
+        float ch = (float)(uint8_t)channel[i];
+
+        float a = 0.0f;
+        a += rssi[i] > -30 ? 0.3f : 0.0f;
+        a += (beaconInterval[i] < 50 || beaconInterval[i] > 200) ? 0.2f : 0.0f;
+        a += jitter[i] > 10.0f ? 0.15f : 0.0f;
+        a += (float)(uint8_t)vendorIEs[i] < 2 ? 0.1f : 0.0f;
+        a += (isOpen && hasWPS) ? 0.25f : 0.0f;
+        a += (ch <= 14 && ch != 1 && ch != 6 && ch != 11) ? 0.05f : 0.0f;
+        a += (vht[i] > 0.5f && !(ht[i] > 0.5f)) ? 0.2f : 0.0f;
+        a += (float)(uint8_t)rates[i] < 4 ? 0.1f : 0.0f;
+        anomaly[i] = a;
+
+        evilTwin[i] = ((isHidden && rssi[i] > -50) ? 0.2f : 0.0f) + twin[i];
+
+        float v = 0.0f;
+        v += isOpen ? 0.5f : 0.0f;
+        v += (hasWPA && !hasWPA2 && !hasWPA3) ? 0.4f : 0.0f;
+        v += hasWPS ? 0.2f : 0.0f;
+        v += (isHidden && v > 0.3f) ? 0.1f : 0.0f;
+        vuln[i] = v;
+
+        float d = 0.0f;
+        d += (rssi[i] > -70 && rssi[i] < -30) ? 0.2f : 0.0f;
+        d += !hasWPA3 ? 0.3f : 0.0f;
+        deauth[i] = d;
+    }
+
+    // Class scores: NORMAL from the raw sums, others clamped to 1
+    for (size_t i = 0; i < n; i++) {
+        normal[i] = 1.0f - (anomaly[i] + evilTwin[i] + vuln[i]) / 3.0f;
+        anomaly[i] = anomaly[i] < 1.0f ? anomaly[i] : 1.0f;
+        evilTwin[i] = evilTwin[i] < 1.0f ? evilTwin[i] : 1.0f;
+        deauth[i] = deauth[i] < 1.0f ? deauth[i] : 1.0f;
+        vuln[i] = vuln[i] < 1.0f ? vuln[i] : 1.0f;
+    }
+
+    // Normalize to a distribution and pick the winner
+    for (size_t i = 0; i < n; i++) {
+        float sum = 0.0f;
+        sum += normal[i];
+        sum += anomaly[i];
+        sum += evilTwin[i];
+        sum += deauth[i];
+        sum += vuln[i];
+        if (sum > 0) {
+            normal[i] /= sum;
+            anomaly[i] /= sum;
+            evilTwin[i] /= sum;
+            deauth[i] /= sum;
+            vuln[i] /= sum;
+        }
+
+        uint8_t best = 0;
+        float bestScore = normal[i];
+        if (anomaly[i] > bestScore) { bestScore = anomaly[i]; best = 1; }
+        if (evilTwin[i] > bestScore) { bestScore = evilTwin[i]; best = 2; }
+        if (deauth[i] > bestScore) { bestScore = deauth[i]; best = 3; }
+        if (vuln[i] > bestScore) { bestScore = vuln[i]; best = 4; }
+        out.label[i] = best;
+        out.confidence[i] = bestScore;
+    }
+}
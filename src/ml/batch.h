@@ -0,0 +1,63 @@
+// Batch (struct-of-arrays) feature kernels
+// Plain C++ so the same code runs on device and in host builds.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#ifndef FEATURE_VECTOR_SIZE
+#define FEATURE_VECTOR_SIZE 32
+#endif
+
+#define ML_CLASS_COUNT 5
+
+// Column-major feature matrix: feature c of row r lives at data[c * stride + r].
+// stride is rows rounded up to 4 so every column starts 16-byte aligned.
+struct FeatureMatrix {
+    std::vector<float> data;
+    size_t rows = 0;
+    size_t stride = 0;
+
+    void resize(size_t n) {
+        rows = n;
+        stride = (n + 3) & ~(size_t)3;
+        data.assign(stride * FEATURE_VECTOR_SIZE, 0.0f);
+    }
+    float* column(int c) { return data.data() + c * stride; }
+    const float* column(int c) const { return data.data() + c * stride; }
+};
+
+// Per-row classifier output, also column-major (one column per class)
+struct ScoreMatrix {
+    std::vector<float> scores;   // ML_CLASS_COUNT columns of `stride`
+    std::vector<uint8_t> label;
+    std::vector<float> confidence;
+    size_t rows = 0;
+    size_t stride = 0;
+
+    void resize(size_t n) {
+        rows = n;
+        stride = (n + 3) & ~(size_t)3;
+        scores.assign(stride * ML_CLASS_COUNT, 0.0f);
+        label.assign(stride, 0);
+        confidence.assign(stride, 0.0f);
+    }
+    float* column(int c) { return scores.data() + c * stride; }
+    const float* column(int c) const { return scores.data() + c * stride; }
+};
+
+class BatchKernels {
+public:
+    // z-score every column in place; columns with std < 0.001 become 0
+    // (same rule as FeatureExtractor::normalize)
+    static void normalize(FeatureMatrix& m, const float* means, const float* stds);
+
+    // HeuristicRules::score over all rows.
+    // Expects raw (un-normalized) features; output is bit-identical to the
+    // scalar path because each score accumulates in the same order.
+    static void heuristicScores(const FeatureMatrix& m, ScoreMatrix& out);
+
+    // Whether the ESP32-S3 esp-dsp (PIE) kernels are compiled in
+    static bool isAccelerated();
+};
@@ -0,0 +1,119 @@
+// RF channel quality tracking implementation
+
+#include "channel_quality.h"
+#include <string.h>
+
+// EWMA: x += (sample - x) / 2^CQ_EWMA_SHIFT
+#define CQ_EWMA_SHIFT 4
+
+ChannelQuality::ChannelSlot ChannelQuality::channels[CQ_CHANNELS];
+ChannelQuality::BSSIDSlot ChannelQuality::bssids[CQ_BSSID_SLOTS];
+uint32_t ChannelQuality::bssidEvictions = 0;
+
+// Single writer (WiFi task); the lock only keeps readers from seeing a
+// half-updated slot
+static portMUX_TYPE cqMux = portMUX_INITIALIZER_UNLOCKED;
+
+static inline int32_t ewma(int32_t accQ8, int32_t sample, bool first) {
+    int32_t sampleQ8 = sample * 256;
+    if (first) return sampleQ8;
+    return accQ8 + ((sampleQ8 - accQ8) >> CQ_EWMA_SHIFT);
+}
+
+void ChannelQuality::reset() {
+    portENTER_CRITICAL(&cqMux);
+    memset(channels, 0, sizeof(channels));
+    memset(bssids, 0, sizeof(bssids));
+    bssidEvictions = 0;
+    portEXIT_CRITICAL(&cqMux);
+}
+
+uint32_t ChannelQuality::slotFor(const uint8_t* bssid) {
+    // NIC bytes carry the entropy; the OUI is shared across a vendor's APs
+    uint32_t h = ((uint32_t)bssid[3] << 16) | ((uint32_t)bssid[4] << 8) | bssid[5];
+    h ^= h >> 7;
+    h ^= (uint32_t)bssid[2] * 31u;
+    return h & (CQ_BSSID_SLOTS - 1);
+}
+
+void IRAM_ATTR ChannelQuality::recordFrame(uint8_t channel, int8_t rssi, int8_t noiseFloor,
+                                           uint8_t rate, uint8_t sigMode) {
+    if (channel < 1 || channel > CQ_CHANNELS) return;
+    // noise_floor is 0 when the PHY didn't report one
+    if (noiseFloor == 0) noiseFloor = CQ_DEFAULT_NOISE;
+
+    ChannelSlot& s = channels[channel - 1];
+    portENTER_CRITICAL_ISR(&cqMux);
+    bool first = (s.frames == 0);
+    s.noiseQ8 = ewma(s.noiseQ8, noiseFloor, first);
+    s.snrQ8 = ewma(s.snrQ8, rssi - noiseFloor, first);
+    s.frames++;
+    if (sigMode == CQ_SIG_NON_HT) {
+        s.lastRate = rate;
+    } else {
+        s.htFrames++;
+    }
+    s.lastSeen = millis();
+    portEXIT_CRITICAL_ISR(&cqMux);
+}
+
+void IRAM_ATTR ChannelQuality::recordBSSID(const uint8_t* bssid, int8_t rssi, int8_t noiseFloor) {
+    if (noiseFloor == 0) noiseFloor = CQ_DEFAULT_NOISE;
+
+    BSSIDSlot& s = bssids[slotFor(bssid)];
+    portENTER_CRITICAL_ISR(&cqMux);
+    bool first = !s.used || memcmp(s.bssid, bssid, 6) != 0;
+    if (first) {
+        // Collision: newest BSSID takes the slot
+        if (s.used) bssidEvictions++;
+        memcpy(s.bssid, bssid, 6);
+        s.used = true;
+    }
+    s.snrQ8 = ewma(s.snrQ8, rssi - noiseFloor, first);
+    portEXIT_CRITICAL_ISR(&cqMux);
+}
+
+int8_t ChannelQuality::getNoise(uint8_t channel) {
+    if (channel < 1 || channel > CQ_CHANNELS) return CQ_DEFAULT_NOISE;
+
+    portENTER_CRITICAL(&cqMux);
+    const ChannelSlot& s = channels[channel - 1];
+    int32_t noiseQ8 = s.noiseQ8;
+    bool sampled = s.frames > 0;
+    portEXIT_CRITICAL(&cqMux);
+
+    if (!sampled) return CQ_DEFAULT_NOISE;
+    return (int8_t)(noiseQ8 / 256);
+}
+
+float ChannelQuality::getBSSIDSNR(const uint8_t* bssid, float fallback) {
+    const BSSIDSlot& s = bssids[slotFor(bssid)];
+    float snr = fallback;
+
+    portENTER_CRITICAL(&cqMux);
+    if (s.used && memcmp(s.bssid, bssid, 6) == 0) {
+        snr = s.snrQ8 / 256.0f;
+    }
+    portEXIT_CRITICAL(&cqMux);
+    return snr;
+}
+
+ChannelQualityInfo ChannelQuality::getChannel(uint8_t channel) {
+    ChannelQualityInfo info = {0};
+    info.channel = channel;
+    info.noise = CQ_DEFAULT_NOISE;
+    if (channel < 1 || channel > CQ_CHANNELS) return info;
+
+    portENTER_CRITICAL(&cqMux);
+    ChannelSlot s = channels[channel - 1];
+    portEXIT_CRITICAL(&cqMux);
+
+    if (s.frames == 0) return info;
+    info.noise = (int8_t)(s.noiseQ8 / 256);
+    info.snr = s.snrQ8 / 256.0f;
+    info.frames = s.frames;
+    info.lastRate = s.lastRate;
+    info.htPercent = (uint8_t)((uint64_t)s.htFrames * 100 / s.frames);
+    info.lastSeen = s.lastSeen;
+    return info;
+}
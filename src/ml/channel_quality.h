@@ -0,0 +1,72 @@
+// RF channel quality tracking
+//
+// Fed from the promiscuous callback with rx_ctrl metadata (noise floor,
+// rate, sig_mode). Keeps an exponentially weighted noise floor and SNR per
+// 2.4 GHz channel, plus a per-BSSID SNR estimate, so the noise/snr
+// features reflect what the radio actually measured instead of -95.
+//
+// Every update is O(1) on fixed tables; nothing is allocated per frame.
+// EWMAs are Q8 fixed point (alpha = 1/16) to keep the hot path integer-only.
+#pragma once
+
+#include <Arduino.h>
+
+#define CQ_CHANNELS 14
+#define CQ_BSSID_SLOTS 128      // Direct-mapped, power of two
+#define CQ_DEFAULT_NOISE -95    // Until a channel has been sampled
+
+// rx_ctrl.sig_mode values
+#define CQ_SIG_NON_HT 0
+#define CQ_SIG_HT 1
+#define CQ_SIG_VHT 3
+
+struct ChannelQualityInfo {
+    uint8_t channel;
+    int8_t noise;           // EWMA noise floor (dBm)
+    float snr;              // EWMA SNR of every frame on the channel (dB)
+    uint32_t frames;
+    uint8_t lastRate;       // rx_ctrl.rate of the last legacy frame
+    uint8_t htPercent;      // Share of HT/VHT frames
+    uint32_t lastSeen;      // millis(), 0 = never sampled
+};
+
+class ChannelQuality {
+public:
+    static void reset();
+
+    // Per-frame hooks (WiFi task, promiscuous callback)
+    static void IRAM_ATTR recordFrame(uint8_t channel, int8_t rssi, int8_t noiseFloor,
+                                      uint8_t rate, uint8_t sigMode);
+    static void IRAM_ATTR recordBSSID(const uint8_t* bssid, int8_t rssi, int8_t noiseFloor);
+
+    // Noise floor for a channel, CQ_DEFAULT_NOISE if never sampled
+    static int8_t getNoise(uint8_t channel);
+
+    // Smoothed SNR for a BSSID, fallback if it isn't tracked (or was evicted)
+    static float getBSSIDSNR(const uint8_t* bssid, float fallback);
+
+    static ChannelQualityInfo getChannel(uint8_t channel);
+    static uint32_t getBSSIDEvictions() { return bssidEvictions; }
+
+private:
+    struct ChannelSlot {
+        int32_t noiseQ8;
+        int32_t snrQ8;
+        uint32_t frames;
+        uint32_t htFrames;
+        uint8_t lastRate;
+        uint32_t lastSeen;
+    };
+
+    struct BSSIDSlot {
+        uint8_t bssid[6];
+        bool used;
+        int32_t snrQ8;
+    };
+
+    static ChannelSlot channels[CQ_CHANNELS];
+    static BSSIDSlot bssids[CQ_BSSID_SLOTS];
+    static uint32_t bssidEvictions;
+
+    static uint32_t slotFor(const uint8_t* bssid);
+};
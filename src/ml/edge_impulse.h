@@ -190,7 +190,7 @@ public:
         Serial.print("capability_lo,capability_hi,has_wps,has_wpa,has_wpa2,has_wpa3,");
         Serial.print("is_hidden,response_time,beacon_count,beacon_jitter,");
         Serial.print("responds_probe,probe_response_time,vendor_ie_count,");
-        Serial.print("supported_rates,ht_cap,vht_cap,anomaly_score,");
-        Serial.println("f23,f24,f25,f26,f27,f28,f29,f30,f31,label");
+        Serial.print("supported_rates,ht_cap,vht_cap,anomaly_score,twin_score,");
+        Serial.println("f24,f25,f26,f27,f28,f29,f30,f31,label");
     }
 };
@@ -0,0 +1,158 @@
+// Evil-twin detection index implementation
+
+#include "evil_twin.h"
+
+EvilTwinIndex::SSIDEntry EvilTwinIndex::table[TWIN_BUCKETS][TWIN_WAYS];
+uint32_t EvilTwinIndex::flaggedCount = 0;
+uint32_t EvilTwinIndex::evictions = 0;
+
+// Score weights: a security downgrade is the classic evil-twin tell, a new
+// vendor is suspicious, and a channel change alone is normal for meshes
+#define TWIN_WEIGHT_SECURITY 0.6f
+#define TWIN_WEIGHT_VENDOR 0.3f
+#define TWIN_WEIGHT_CHANNEL 0.1f
+
+void EvilTwinIndex::clear() {
+    memset(table, 0, sizeof(table));
+    flaggedCount = 0;
+    evictions = 0;
+}
+
+uint32_t EvilTwinIndex::hashSSID(const char* ssid) {
+    // FNV-1a; 0 marks an empty way so never return it
+    uint32_t h = 2166136261UL;
+    for (const char* p = ssid; *p; p++) {
+        h ^= (uint8_t)*p;
+        h *= 16777619UL;
+    }
+    return h ? h : 1;
+}
+
+EvilTwinIndex::SSIDEntry* EvilTwinIndex::findOrInsert(uint32_t hash, bool& isNew) {
+    SSIDEntry* bucket = table[hash % TWIN_BUCKETS];
+    SSIDEntry* victim = &bucket[0];
+
+    for (int w = 0; w < TWIN_WAYS; w++) {
+        if (bucket[w].hash == hash) {
+            isNew = false;
+            return &bucket[w];
+        }
+        if (bucket[w].hash == 0) {
+            victim = &bucket[w];
+        } else if (victim->hash != 0 && bucket[w].lastSeen < victim->lastSeen) {
+            victim = &bucket[w];
+        }
+    }
+
+    // Empty way, else the least recently seen SSID in this bucket
+    if (victim->hash != 0) evictions++;
+    memset(victim, 0, sizeof(SSIDEntry));
+    victim->hash = hash;
+    isNew = true;
+    return victim;
+}
+
+uint8_t EvilTwinIndex::observe(const char* ssid, const uint8_t* bssid, uint8_t channel, TwinSecurity security) {
+    if (!ssid || !ssid[0] || !bssid) return 0;
+
+    bool isNew;
+    SSIDEntry* e = findOrInsert(hashSSID(ssid), isNew);
+    e->lastSeen = millis();
+
+    uint16_t chBit = (channel >= 1 && channel <= 14) ? (uint16_t)(1 << channel) : 0;
+
+    if (isNew) {
+        // First AP for this SSID defines the profile
+        e->firstSecurity = (uint8_t)security;
+        e->firstChannel = channel;
+        e->channelMask = chBit;
+        memcpy(e->ouis[0], bssid, 3);
+        e->ouiCount = 1;
+        memcpy(e->members[0].nic, bssid + 3, 3);
+        e->members[0].ouiIdx = 0;
+        e->members[0].flags = 0;
+        e->memberCount = 1;
+        e->bssidCount = 1;
+        return 0;
+    }
+
+    int ouiIdx = -1;
+    for (int i = 0; i < e->ouiCount; i++) {
+        if (memcmp(e->ouis[i], bssid, 3) == 0) {
+            ouiIdx = i;
+            break;
+        }
+    }
+
+    // Already a member: same verdict as last time
+    if (ouiIdx >= 0) {
+        for (int i = 0; i < e->memberCount; i++) {
+            const Member& m = e->members[i];
+            if (m.ouiIdx == ouiIdx && memcmp(m.nic, bssid + 3, 3) == 0) {
+                return m.flags;
+            }
+        }
+    }
+
+    uint8_t flags = 0;
+    if ((uint8_t)security != e->firstSecurity) {
+        flags |= TWIN_FLAG_SECURITY;
+    }
+    if (ouiIdx < 0) {
+        flags |= TWIN_FLAG_VENDOR;
+        if (e->ouiCount < TWIN_MAX_OUIS) {
+            memcpy(e->ouis[e->ouiCount], bssid, 3);
+            ouiIdx = e->ouiCount++;
+        }
+    }
+    if (chBit && !(e->channelMask & chBit)) {
+        flags |= TWIN_FLAG_CHANNEL;
+        e->channelMask |= chBit;
+    }
+
+    // Past the member cap we still score, we just can't remember the BSSID
+    if (ouiIdx >= 0 && e->memberCount < TWIN_MAX_MEMBERS) {
+        Member& m = e->members[e->memberCount++];
+        memcpy(m.nic, bssid + 3, 3);
+        m.ouiIdx = (uint8_t)ouiIdx;
+        m.flags = flags;
+    }
+    if (e->bssidCount < 255) e->bssidCount++;
+    if (flags) flaggedCount++;
+
+    return flags;
+}
+
+float EvilTwinIndex::score(uint8_t flags) {
+    float s = 0.0f;
+    if (flags & TWIN_FLAG_SECURITY) s += TWIN_WEIGHT_SECURITY;
+    if (flags & TWIN_FLAG_VENDOR) s += TWIN_WEIGHT_VENDOR;
+    if (flags & TWIN_FLAG_CHANNEL) s += TWIN_WEIGHT_CHANNEL;
+    return s < 1.0f ? s : 1.0f;
+}
+
+TwinSecurity EvilTwinIndex::securityFromAuthMode(wifi_auth_mode_t mode) {
+    switch (mode) {
+        case WIFI_AUTH_OPEN:
+            return TwinSecurity::OPEN;
+        case WIFI_AUTH_WEP:
+        case WIFI_AUTH_WPA_PSK:
+            return TwinSecurity::LEGACY;
+        default:
+            return TwinSecurity::RSN;
+    }
+}
+
+uint16_t EvilTwinIndex::getSSIDCount() {
+    uint16_t n = 0;
+    for (int b = 0; b < TWIN_BUCKETS; b++) {
+        for (int w = 0; w < TWIN_WAYS; w++) {
+            if (table[b][w].hash != 0) n++;
+        }
+    }
+    return n;
+}
+
+size_t EvilTwinIndex::getMemoryBytes() {
+    return sizeof(table);
+}
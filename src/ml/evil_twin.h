@@ -0,0 +1,79 @@
+// Evil-twin detection index
+//
+// Maps SSID hash -> compact set of BSSIDs advertising that SSID, plus a
+// profile of the first AP seen (security class, vendor OUIs, channels).
+// A new BSSID that reuses a known SSID but breaks the profile gets
+// mismatch flags, which become the twin_score feature (index 23).
+//
+// Fixed memory: 2-way set-associative table of TWIN_BUCKETS x 2 SSIDs,
+// each holding at most TWIN_MAX_MEMBERS BSSIDs and TWIN_MAX_OUIS vendor
+// prefixes. Big deployments (one SSID, dozens of APs) just stop adding
+// members; every update is O(1).
+#pragma once
+
+#include <Arduino.h>
+#include <esp_wifi.h>
+
+#define TWIN_BUCKETS 64
+#define TWIN_WAYS 2
+#define TWIN_MAX_MEMBERS 6
+#define TWIN_MAX_OUIS 3
+
+// Mismatch flags returned by EvilTwinIndex::observe
+#define TWIN_FLAG_SECURITY 0x01     // RSN vs open/legacy differs from first AP
+#define TWIN_FLAG_VENDOR   0x02     // OUI not seen on this SSID before
+#define TWIN_FLAG_CHANNEL  0x04     // Different channel from every other AP
+
+// Coarse security class - finer differences (WPA2 vs WPA3) are normal
+// within one deployment
+enum class TwinSecurity : uint8_t {
+    OPEN = 0,
+    LEGACY = 1,     // WEP / WPA1
+    RSN = 2         // WPA2 / WPA3
+};
+
+class EvilTwinIndex {
+public:
+    static void clear();
+
+    // Record a BSSID advertising ssid; returns TWIN_FLAG_* for this BSSID.
+    // Hidden (empty) SSIDs are ignored. Not ISR-safe; call from one context.
+    static uint8_t observe(const char* ssid, const uint8_t* bssid, uint8_t channel, TwinSecurity security);
+
+    // EVIL_TWIN contribution for a set of flags (0..1)
+    static float score(uint8_t flags);
+
+    static TwinSecurity securityFromAuthMode(wifi_auth_mode_t mode);
+
+    static uint16_t getSSIDCount();
+    static uint32_t getFlaggedCount() { return flaggedCount; }
+    static uint32_t getEvictions() { return evictions; }
+    static size_t getMemoryBytes();
+
+private:
+    struct Member {
+        uint8_t nic[3];         // Lower half of the BSSID
+        uint8_t ouiIdx;         // Into SSIDEntry::ouis
+        uint8_t flags;          // Verdict when first seen
+    };
+
+    struct SSIDEntry {
+        uint32_t hash;          // 0 = empty way
+        uint32_t lastSeen;
+        uint16_t channelMask;   // Bit n = channel n (2.4 GHz)
+        uint8_t firstSecurity;
+        uint8_t firstChannel;
+        uint8_t ouis[TWIN_MAX_OUIS][3];
+        uint8_t ouiCount;
+        uint8_t memberCount;
+        uint8_t bssidCount;     // Saturating total, including overflow
+        Member members[TWIN_MAX_MEMBERS];
+    };
+
+    static SSIDEntry table[TWIN_BUCKETS][TWIN_WAYS];
+    static uint32_t flaggedCount;
+    static uint32_t evictions;
+
+    static uint32_t hashSSID(const char* ssid);
+    static SSIDEntry* findOrInsert(uint32_t hash, bool& isNew);
+};
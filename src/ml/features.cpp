@@ -1,6 +1,7 @@
 // ML Feature Extraction implementation
 
 #include "features.h"
+#include "channel_quality.h"
 #include <string.h>
 
 // Static members
@@ -23,8 +24,8 @@ WiFiFeatures FeatureExtractor::extractFromScan(const wifi_ap_record_t* ap) {
     WiFiFeatures f = {0};
     
     f.rssi = ap->rssi;
-    f.noise = -95;  // Typical noise floor for ESP32
-    f.snr = (float)(f.rssi - f.noise);
+    f.noise = ChannelQuality::getNoise(ap->primary);
+    f.snr = ChannelQuality::getBSSIDSNR(ap->bssid, (float)(f.rssi - f.noise));
     
     f.channel = ap->primary;
     f.secondaryChannel = ap->second;
@@ -67,7 +68,7 @@ WiFiFeatures FeatureExtractor::extractFromScan(const wifi_ap_record_t* ap) {
     return f;
 }
 
-WiFiFeatures FeatureExtractor::extractFromBeacon(const uint8_t* frame, uint16_t len, int8_t rssi) {
+WiFiFeatures FeatureExtractor::extractFromBeacon(const uint8_t* frame, uint16_t len, int8_t rssi, int8_t noise) {
     WiFiFeatures f = {0};
     
     if (len < 36) return f;  // Minimum beacon frame size
@@ -76,8 +77,8 @@ WiFiFeatures FeatureExtractor::extractFromBeacon(const uint8_t* frame, uint16_t
     // Fixed params: timestamp(8) + beacon_interval(2) + capability(2)
     
     f.rssi = rssi;
-    f.noise = -95;
-    f.snr = (float)(f.rssi - f.noise);
+    f.noise = noise;
+    f.snr = ChannelQuality::getBSSIDSNR(frame + 16, (float)(f.rssi - f.noise));
     
     f.beaconInterval = parseBeaconInterval(frame, len);
     f.capability = parseCapability(frame, len);
@@ -135,16 +136,17 @@ void FeatureExtractor::toFeatureVector(const WiFiFeatures& features, float* outp
     output[20] = (float)features.htCapabilities;
     output[21] = (float)features.vhtCapabilities;
     output[22] = features.anomalyScore;
+    output[23] = features.twinScore;
     // Pad remaining with zeros
-    for (int i = 23; i < FEATURE_VECTOR_SIZE; i++) {
+    for (int i = 24; i < FEATURE_VECTOR_SIZE; i++) {
         output[i] = 0.0f;
     }
-    
-    // Apply normalization if available
-    if (normParamsLoaded) {
-        for (int i = 0; i < FEATURE_VECTOR_SIZE; i++) {
-            output[i] = normalize(output[i], featureMeans[i], featureStds[i]);
-        }
+}
+
+void FeatureExtractor::normalizeVector(float* v) {
+    if (!normParamsLoaded) return;
+    for (int i = 0; i < FEATURE_VECTOR_SIZE; i++) {
+        v[i] = normalize(v[i], featureMeans[i], featureStds[i]);
     }
 }
 
@@ -173,6 +175,44 @@ std::vector<float> FeatureExtractor::extractBatchFeatures(const std::vector<WiFi
     return batch;
 }
 
+void FeatureExtractor::toColumns(const std::vector<WiFiFeatures>& networks, FeatureMatrix& out) {
+    out.resize(networks.size());
+    
+    // Same order as toFeatureVector - columns 24..31 stay zero
+    for (size_t r = 0; r < networks.size(); r++) {
+        const WiFiFeatures& f = networks[r];
+        out.column(0)[r] = (float)f.rssi;
+        out.column(1)[r] = (float)f.noise;
+        out.column(2)[r] = f.snr;
+        out.column(3)[r] = (float)f.channel;
+        out.column(4)[r] = (float)f.secondaryChannel;
+        out.column(5)[r] = (float)f.beaconInterval;
+        out.column(6)[r] = (float)(f.capability & 0xFF);
+        out.column(7)[r] = (float)((f.capability >> 8) & 0xFF);
+        out.column(8)[r] = f.hasWPS ? 1.0f : 0.0f;
+        out.column(9)[r] = f.hasWPA ? 1.0f : 0.0f;
+        out.column(10)[r] = f.hasWPA2 ? 1.0f : 0.0f;
+        out.column(11)[r] = f.hasWPA3 ? 1.0f : 0.0f;
+        out.column(12)[r] = f.isHidden ? 1.0f : 0.0f;
+        out.column(13)[r] = (float)f.responseTime;
+        out.column(14)[r] = (float)f.beaconCount;
+        out.column(15)[r] = f.beaconJitter;
+        out.column(16)[r] = f.respondsToProbe ? 1.0f : 0.0f;
+        out.column(17)[r] = (float)f.probeResponseTime;
+        out.column(18)[r] = (float)f.vendorIECount;
+        out.column(19)[r] = (float)f.supportedRates;
+        out.column(20)[r] = (float)f.htCapabilities;
+        out.column(21)[r] = (float)f.vhtCapabilities;
+        out.column(22)[r] = f.anomalyScore;
+        out.column(23)[r] = f.twinScore;
+    }
+}
+
+void FeatureExtractor::normalizeColumns(FeatureMatrix& m) {
+    if (!normParamsLoaded) return;
+    BatchKernels::normalize(m, featureMeans, featureStds);
+}
+
 void FeatureExtractor::setNormalizationParams(const float* means, const float* stds) {
     memcpy(featureMeans, means, FEATURE_VECTOR_SIZE * sizeof(float));
     memcpy(featureStds, stds, FEATURE_VECTOR_SIZE * sizeof(float));
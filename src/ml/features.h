@@ -8,6 +8,8 @@
 // Feature vector size for Edge Impulse model
 #define FEATURE_VECTOR_SIZE 32
 
+#include "batch.h"
+
 struct WiFiFeatures {
     // Signal characteristics
     int8_t rssi;
@@ -44,6 +46,7 @@ struct WiFiFeatures {
     
     // Derived
     float anomalyScore;
+    float twinScore;        // EvilTwinIndex mismatch score for this BSSID
 };
 
 struct ProbeFeatures {
@@ -61,18 +64,25 @@ public:
     
     // Extract features from raw WiFi scan
     static WiFiFeatures extractFromScan(const wifi_ap_record_t* ap);
-    static WiFiFeatures extractFromBeacon(const uint8_t* frame, uint16_t len, int8_t rssi);
+    // noise: channel noise floor (ChannelQuality::getNoise)
+    static WiFiFeatures extractFromBeacon(const uint8_t* frame, uint16_t len, int8_t rssi, int8_t noise);
     
     // Extract probe request features
     static ProbeFeatures extractFromProbe(const uint8_t* frame, uint16_t len, int8_t rssi);
     
-    // Convert to feature vector for ML
+    // Convert to raw feature vector for ML (training exports, statistics)
     static void toFeatureVector(const WiFiFeatures& features, float* output);
+    static void normalizeVector(float* v);  // z-score in place, no-op until params are set
     static void probeToFeatureVector(const ProbeFeatures& features, float* output);
     
     // Batch feature extraction
     static std::vector<float> extractBatchFeatures(const std::vector<WiFiFeatures>& networks);
     
+    // Column-major batch: raw features for every network, then optional
+    // vectorized z-score pass (no-op until normalization params are loaded)
+    static void toColumns(const std::vector<WiFiFeatures>& networks, FeatureMatrix& out);
+    static void normalizeColumns(FeatureMatrix& m);
+    
     // Normalization (must be called after model training)
     static void setNormalizationParams(const float* means, const float* stds);
     
@@ -0,0 +1,100 @@
+// Compiled-in random forest classifier implementation
+
+#include "forest.h"
+#include <Arduino.h>
+// Host checks (tools/ml_check) point this at a freshly generated header
+#ifdef FOREST_MODEL_HEADER
+#include FOREST_MODEL_HEADER
+#else
+#include "forest_model.h"
+#endif
+
+#if FOREST_AVAILABLE
+
+bool ForestClassifier::isAvailable() {
+    return true;
+}
+
+void ForestClassifier::predict(const float* features, float* scores) {
+    for (int c = 0; c < FOREST_CLASSES; c++) scores[c] = 0.0f;
+
+    for (int t = 0; t < FOREST_TREES; t++) {
+        const uint8_t* feature = FOREST_FEATURE[t];
+        const float* threshold = FOREST_THRESHOLD[t];
+
+        // Complete tree: children of i are 2i+1 (<=) and 2i+2 (>)
+        uint32_t idx = 0;
+        for (int d = 0; d < FOREST_DEPTH; d++) {
+            idx = 2 * idx + 1 + (uint32_t)(features[feature[idx]] > threshold[idx]);
+        }
+
+        // Leaf distributions are pre-divided by the tree count
+        const float* dist = FOREST_DIST[FOREST_LEAF[t][idx - FOREST_INTERNAL]];
+        for (int c = 0; c < FOREST_CLASSES; c++) scores[c] += dist[c];
+    }
+}
+
+bool ForestClassifier::selfTest() {
+    float x[FOREST_FEATURES > 32 ? FOREST_FEATURES : 32] = {0};
+    float scores[FOREST_CLASSES];
+    int matches = 0;
+
+    uint32_t t0 = micros();
+    for (int i = 0; i < FOREST_GOLDEN; i++) {
+        for (int f = 0; f < FOREST_FEATURES; f++) x[f] = FOREST_GOLDEN_X[i][f];
+        predict(x, scores);
+
+        int best = 0;
+        for (int c = 1; c < FOREST_CLASSES; c++) {
+            if (scores[c] > scores[best]) best = c;
+        }
+        if (best == FOREST_GOLDEN_Y[i]) matches++;
+    }
+    uint32_t elapsed = micros() - t0;
+
+    Serial.printf("[FOREST] %d trees x depth %d, %u bytes, parity %d/%d, %.2f us/classification\n",
+                  FOREST_TREES, FOREST_DEPTH, (unsigned)getTableBytes(), matches, FOREST_GOLDEN,
+                  FOREST_GOLDEN ? elapsed / (float)FOREST_GOLDEN : 0.0f);
+    return matches == FOREST_GOLDEN;
+}
+
+uint16_t ForestClassifier::getTreeCount() {
+    return FOREST_TREES;
+}
+
+uint8_t ForestClassifier::getDepth() {
+    return FOREST_DEPTH;
+}
+
+size_t ForestClassifier::getTableBytes() {
+    return sizeof(FOREST_FEATURE) + sizeof(FOREST_THRESHOLD) + sizeof(FOREST_LEAF) + sizeof(FOREST_DIST);
+}
+
+#else  // No forest generated yet
+
+bool ForestClassifier::isAvailable() {
+    return false;
+}
+
+void ForestClassifier::predict(const float* features, float* scores) {
+    for (int c = 0; c < 5; c++) scores[c] = 0.0f;
+}
+
+bool ForestClassifier::selfTest() {
+    Serial.println("[FOREST] No forest compiled in");
+    return true;
+}
+
+uint16_t ForestClassifier::getTreeCount() {
+    return 0;
+}
+
+uint8_t ForestClassifier::getDepth() {
+    return 0;
+}
+
+size_t ForestClassifier::getTableBytes() {
+    return 0;
+}
+
+#endif
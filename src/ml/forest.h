@@ -0,0 +1,28 @@
+// Compiled-in random forest classifier
+//
+// Tree data comes from forest_model.h, generated by
+// scripts/train_model.py train-forest. Every tree is padded to a complete
+// binary tree of FOREST_DEPTH, so evaluation is a fixed number of
+// compare-and-index steps per tree: no branches on the data, no heap,
+// and the tables sit in DRAM (no flash cache misses).
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+class ForestClassifier {
+public:
+    // False until a forest has been generated into forest_model.h
+    static bool isAvailable();
+
+    // Raw (un-normalized) feature vector in, averaged class probabilities out
+    static void predict(const float* features, float* scores);
+
+    // Run the holdout vectors embedded by the generator and log label
+    // parity with the Python predictions plus us/classification
+    static bool selfTest();
+
+    static uint16_t getTreeCount();
+    static uint8_t getDepth();
+    static size_t getTableBytes();
+};
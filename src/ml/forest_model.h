@@ -0,0 +1,7 @@
+// Auto-generated by scripts/train_model.py train-forest - do not edit
+//
+// Placeholder: no forest trained yet. Regenerate with
+//   python scripts/train_model.py train-forest -i ml_training.csv -o src/ml/forest_model.h
+#pragma once
+
+#define FOREST_AVAILABLE 0
@@ -0,0 +1,62 @@
+// Auto-generated by scripts/train_model.py golden - do not edit
+// Generated: 2026-10-18T12:37:52
+//
+// Raw feature vectors covering every MLLabel class, with the outputs the
+// Python mirrors of the heuristic rules and (optionally) one quantized
+// model produce for them. Cases live in GOLDEN_CASES in train_model.py.
+#pragma once
+
+#include <stdint.h>
+
+#define GOLDEN_COUNT 11
+#define GOLDEN_FEATURES 24
+#define GOLDEN_CLASSES 5
+
+// CRC of the PCML payload GOLDEN_MODEL_Y was computed for (0 = none)
+#define GOLDEN_MODEL_CRC 0x00000000UL
+
+static constexpr const char* GOLDEN_NAME[GOLDEN_COUNT] = {
+    "wpa3_home", "wpa2_far", "mesh_node", "laptop_hotspot", "open_wps_honeypot", "twin_downgrade", "hidden_twin", "wpa2_no_pmf", "wpa2_busy_ap", "open_wps_hidden", "wpa1_wps_hidden"
+};
+
+// Class each case was written to represent
+static constexpr uint8_t GOLDEN_CLASS[GOLDEN_COUNT] = {
+    0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4
+};
+
+static constexpr float GOLDEN_X[GOLDEN_COUNT][GOLDEN_FEATURES] = {
+    {-60.0f, -95.0f, 35.0f, 6.0f, 0.0f, 100.0f, 17.0f, 4.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 20.0f, 2.0f, 0.0f, 0.0f, 4.0f, 8.0f, 1.0f, 1.0f, 0.0f, 0.0f},
+    {-78.0f, -95.0f, 17.0f, 1.0f, 0.0f, 100.0f, 17.0f, 4.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 20.0f, 2.0f, 0.0f, 0.0f, 4.0f, 8.0f, 1.0f, 1.0f, 0.0f, 0.0f},
+    {-48.0f, -95.0f, 47.0f, 11.0f, 0.0f, 100.0f, 17.0f, 4.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 20.0f, 2.0f, 0.0f, 0.0f, 6.0f, 8.0f, 1.0f, 1.0f, 0.0f, 0.0f},
+    {-25.0f, -95.0f, 70.0f, 3.0f, 0.0f, 40.0f, 17.0f, 4.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 20.0f, 14.0f, 0.0f, 0.0f, 0.0f, 3.0f, 0.0f, 1.0f, 0.0f, 0.0f},
+    {-28.0f, -95.0f, 67.0f, 6.0f, 0.0f, 250.0f, 17.0f, 4.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 20.0f, 12.0f, 0.0f, 0.0f, 1.0f, 8.0f, 1.0f, 1.0f, 0.0f, 0.0f},
+    {-45.0f, -95.0f, 50.0f, 6.0f, 0.0f, 100.0f, 17.0f, 4.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 20.0f, 2.0f, 0.0f, 0.0f, 4.0f, 8.0f, 1.0f, 1.0f, 0.0f, 0.899999976f},
+    {-40.0f, -95.0f, 55.0f, 6.0f, 0.0f, 100.0f, 17.0f, 4.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 20.0f, 2.0f, 0.0f, 0.0f, 4.0f, 8.0f, 1.0f, 1.0f, 0.0f, 0.600000024f},
+    {-55.0f, -95.0f, 40.0f, 6.0f, 0.0f, 100.0f, 17.0f, 4.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 20.0f, 2.0f, 0.0f, 0.0f, 4.0f, 8.0f, 1.0f, 1.0f, 0.0f, 0.0f},
+    {-50.0f, -95.0f, 43.0f, 11.0f, 0.0f, 100.0f, 17.0f, 4.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 200.0f, 2.0f, 1.0f, 0.0f, 4.0f, 8.0f, 1.0f, 1.0f, 0.0f, 0.0f},
+    {-65.0f, -95.0f, 30.0f, 6.0f, 0.0f, 100.0f, 17.0f, 4.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 20.0f, 2.0f, 0.0f, 0.0f, 4.0f, 8.0f, 1.0f, 1.0f, 0.0f, 0.0f},
+    {-72.0f, -95.0f, 23.0f, 3.0f, 0.0f, 100.0f, 17.0f, 4.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 20.0f, 11.0f, 0.0f, 0.0f, 4.0f, 3.0f, 1.0f, 1.0f, 0.0f, 0.0f},
+};
+
+// MLInference::runInference output
+static constexpr uint8_t GOLDEN_HEURISTIC_Y[GOLDEN_COUNT] = {
+    0, 0, 0, 1, 1, 2, 2, 0, 0, 4, 4
+};
+static constexpr float GOLDEN_HEURISTIC_SCORES[GOLDEN_COUNT][GOLDEN_CLASSES] = {
+    {0.833333313f, 0.0f, 0.0f, 0.166666657f, 0.0f},
+    {0.769230783f, 0.0f, 0.0f, 0.230769247f, 0.0f},
+    {0.833333313f, 0.0f, 0.0f, 0.166666657f, 0.0f},
+    {0.327586204f, 0.517241359f, 0.0f, 0.155172408f, 0.0f},
+    {0.178082183f, 0.410958886f, 0.0f, 0.12328767f, 0.287671208f},
+    {0.333333373f, 0.0f, 0.428571433f, 0.238095254f, 0.0f},
+    {0.423076928f, 0.0f, 0.461538464f, 0.115384616f, 0.0f},
+    {0.666666687f, 0.0f, 0.0f, 0.333333343f, 0.0f},
+    {0.666666687f, 0.0f, 0.0f, 0.333333343f, 0.0f},
+    {0.295454532f, 0.11363636f, 0.0f, 0.227272719f, 0.363636374f},
+    {0.338983029f, 0.152542382f, 0.0f, 0.152542382f, 0.355932236f},
+};
+
+// QuantModel::run labels (no model given)
+static constexpr uint8_t GOLDEN_MODEL_Y[GOLDEN_COUNT] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
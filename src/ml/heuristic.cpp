@@ -0,0 +1,145 @@
+// Hand-written rule classifier implementation
+
+#include "heuristic.h"
+
+uint8_t HeuristicRules::score(const float* input, float* scores) {
+    // ========================================
+    // ENHANCED HEURISTIC CLASSIFIER
+    // Feature indices from features.cpp:
+    //  0: rssi, 1: noise, 2: snr, 3: channel, 4: secondary_ch
+    //  5: beacon_interval, 6: capability_lo, 7: capability_hi
+    //  8: hasWPS, 9: hasWPA, 10: hasWPA2, 11: hasWPA3
+    // 12: isHidden, 13: responseTime, 14: beaconCount, 15: beaconJitter
+    // 16: respondsToProbe, 17: probeResponseTime, 18: vendorIECount
+    // 19: supportedRates, 20: htCapabilities, 21: vhtCapabilities
+    // 22: anomalyScore, 23: twinScore (EvilTwinIndex)
+    // ========================================
+
+    float rssi = input[0];
+    uint8_t channel = (uint8_t)input[3];
+    float beaconInterval = input[5];
+    bool hasWPS = input[8] > 0.5f;
+    bool hasWPA = input[9] > 0.5f;
+    bool hasWPA2 = input[10] > 0.5f;
+    bool hasWPA3 = input[11] > 0.5f;
+    bool isHidden = input[12] > 0.5f;
+    float beaconJitter = input[15];
+    uint8_t vendorIECount = (uint8_t)input[18];
+    uint8_t supportedRates = (uint8_t)input[19];
+    bool hasHT = input[20] > 0.5f;
+    bool hasVHT = input[21] > 0.5f;
+    float twinScore = input[23];
+
+    float anomalyScore = 0.0f;
+
+    // ---- ROGUE AP DETECTION ----
+    // 1. Suspiciously strong signal (someone nearby with laptop hotspot)
+    if (rssi > -30) {
+        anomalyScore += 0.3f;
+    }
+
+    // 2. Non-standard beacon interval (default is 100ms, 102.4 TU)
+    if (beaconInterval < 50 || beaconInterval > 200) {
+        anomalyScore += 0.2f;
+    }
+
+    // 3. High beacon jitter (inconsistent timing = software AP)
+    if (beaconJitter > 10.0f) {
+        anomalyScore += 0.15f;
+    }
+
+    // 4. Missing vendor-specific IEs (real routers have many)
+    if (vendorIECount < 2) {
+        anomalyScore += 0.1f;
+    }
+
+    // 5. Open network with WPS enabled (honeypot pattern)
+    if (!hasWPA && !hasWPA2 && !hasWPA3 && hasWPS) {
+        anomalyScore += 0.25f;
+    }
+
+    // 6. Channel anomaly - using unusual channels (non-1,6,11 for 2.4GHz)
+    if (channel <= 14 && channel != 1 && channel != 6 && channel != 11) {
+        anomalyScore += 0.05f;
+    }
+
+    // 7. Claims VHT (WiFi 5) but no HT (WiFi 4) - inconsistent
+    if (hasVHT && !hasHT) {
+        anomalyScore += 0.2f;
+    }
+
+    // 8. Very few supported rates (minimal AP implementation)
+    if (supportedRates < 4) {
+        anomalyScore += 0.1f;
+    }
+
+    // ---- EVIL TWIN DETECTION ----
+    // Hidden network with a suspiciously strong signal
+    float evilTwinScore = 0.0f;
+    if (isHidden && rssi > -50) {
+        evilTwinScore += 0.2f;
+    }
+
+    // Known SSID re-advertised with different security/vendor/channel
+    evilTwinScore += twinScore;
+
+    // ---- VULNERABLE NETWORK DETECTION ----
+    float vulnScore = 0.0f;
+
+    // Open network
+    if (!hasWPA && !hasWPA2 && !hasWPA3) {
+        vulnScore += 0.5f;
+    }
+
+    // WPA1 only (TKIP vulnerable)
+    if (hasWPA && !hasWPA2 && !hasWPA3) {
+        vulnScore += 0.4f;
+    }
+
+    // WPS enabled (PIN attack vulnerable)
+    if (hasWPS) {
+        vulnScore += 0.2f;
+    }
+
+    // Hidden SSID with weak security
+    if (isHidden && vulnScore > 0.3f) {
+        vulnScore += 0.1f;
+    }
+
+    // ---- DEAUTH TARGET SCORING ----
+    float deauthScore = 0.0f;
+
+    // Good signal for reliable deauth
+    if (rssi > -70 && rssi < -30) {
+        deauthScore += 0.2f;
+    }
+
+    // Not WPA3 (PMF protected)
+    if (!hasWPA3) {
+        deauthScore += 0.3f;
+    }
+
+    // Has active clients (would need client tracking)
+    // deauthScore += clientCount > 0 ? 0.2f : 0.0f;
+
+    // ---- CLASSIFICATION ----
+    scores[0] = 1.0f - (anomalyScore + evilTwinScore + vulnScore) / 3.0f;  // NORMAL
+    scores[1] = anomalyScore < 1.0f ? anomalyScore : 1.0f;  // ROGUE_AP
+    scores[2] = evilTwinScore < 1.0f ? evilTwinScore : 1.0f;  // EVIL_TWIN
+    scores[3] = deauthScore < 1.0f ? deauthScore : 1.0f;  // DEAUTH_TARGET
+    scores[4] = vulnScore < 1.0f ? vulnScore : 1.0f;  // VULNERABLE
+
+    // Normalize scores
+    float sum = 0.0f;
+    for (int i = 0; i < 5; i++) sum += scores[i];
+    if (sum > 0) {
+        for (int i = 0; i < 5; i++) scores[i] /= sum;
+    }
+
+    // Find highest score
+    uint8_t maxIdx = 0;
+    for (int i = 1; i < 5; i++) {
+        if (scores[i] > scores[maxIdx]) maxIdx = i;
+    }
+    return maxIdx;
+}
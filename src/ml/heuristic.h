@@ -0,0 +1,15 @@
+// Hand-written rule classifier (the HEURISTIC backend)
+// Plain C++ so the same code runs on device and in host builds.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+class HeuristicRules {
+public:
+    // Raw (un-normalized) feature vector of FEATURE_VECTOR_SIZE in,
+    // ML_CLASS_COUNT normalized class scores out. Returns the winning
+    // class index (MLLabel). BatchKernels::heuristicScores is the
+    // column-major version and must stay bit-identical to this.
+    static uint8_t score(const float* input, float* scores);
+};
@@ -4,18 +4,79 @@
 
 #include "inference.h"
 #include "edge_impulse.h"
+#include "quant_model.h"
+#include "result_cache.h"
+#include "forest.h"
+#include "heuristic.h"
+#include "model_partition.h"
+#include "model_installer.h"
+#include "golden_vectors.h"
 #include "../core/config.h"
 #include "../ui/display.h"
 #include "../piglet/mood.h"
 #include <SPIFFS.h>
+#include <SD.h>
 
 // Static members
 bool MLInference::modelLoaded = false;
 char MLInference::modelVersion[16] = "none";
 size_t MLInference::modelSize = 0;
+uint32_t MLInference::modelLoadUs = 0;
 uint32_t MLInference::inferenceCount = 0;
-uint32_t MLInference::avgInferenceTime = 0;
+LatencyHistogram MLInference::latency;
+MLBenchResult MLInference::benchResults[ML_BENCH_MAX_BACKENDS];
+uint8_t MLInference::benchCount = 0;
 const char* MLInference::MODEL_PATH = "/models/porkchop_model.bin";
+static const char* MODEL_INSTALLED_PATH = "/models/porkchop_model.installed";
+
+// Quantized model image, read once at load time and bound by QuantModel
+static uint8_t* modelBlob = nullptr;
+
+// Async classification. Requests live in a fixed slot pool; slot indices
+// travel main -> worker on requestQueue and back on completionQueue, which
+// update() drains. Slot state changes happen under asyncMux. Callbacks are
+// only ever touched from the main loop.
+#define ML_QUEUE_DEPTH 16
+#define ML_WORKER_STACK 4096
+
+enum class SlotState : uint8_t {
+    FREE,
+    PENDING,
+    RUNNING,
+    DONE
+};
+
+struct AsyncSlot {
+    SlotState state;
+    bool keyed;
+    uint8_t bssid[6];
+    float features[FEATURE_VECTOR_SIZE];
+    size_t featureCount;
+    uint32_t enqueuedUs;
+    MLResult result;
+    MLCallback callback;
+};
+
+static AsyncSlot asyncSlots[ML_QUEUE_DEPTH];
+static portMUX_TYPE asyncMux = portMUX_INITIALIZER_UNLOCKED;
+static QueueHandle_t requestQueue = nullptr;
+static QueueHandle_t completionQueue = nullptr;
+static TaskHandle_t workerHandle = nullptr;
+static MLQueueStats queueStats = {};
+
+// Serializes the inference engines (QuantModel's arena is shared) and model swaps
+static SemaphoreHandle_t engineMutex = nullptr;
+
+static void lockEngine() {
+    if (engineMutex) xSemaphoreTake(engineMutex, portMAX_DELAY);
+}
+
+static void unlockEngine() {
+    if (engineMutex) xSemaphoreGive(engineMutex);
+}
+
+// Set by ModelInstaller::finish() from whichever task installed the model
+static volatile bool reloadPending = false;
 
 // Edge Impulse will generate these - placeholder structure
 struct ei_impulse_result_t {
@@ -24,6 +85,25 @@ struct ei_impulse_result_t {
 };
 
 void MLInference::init() {
+    // Async worker first - model loading takes the engine mutex
+    engineMutex = xSemaphoreCreateMutex();
+    ModelInstaller::init();
+    requestQueue = xQueueCreate(ML_QUEUE_DEPTH, sizeof(uint8_t));
+    completionQueue = xQueueCreate(ML_QUEUE_DEPTH, sizeof(uint8_t));
+    if (engineMutex && requestQueue && completionQueue &&
+        xTaskCreatePinnedToCore(workerTask, "ml_worker", ML_WORKER_STACK, nullptr,
+                                tskIDLE_PRIORITY + 1, &workerHandle, 0) == pdPASS) {
+        Serial.printf("[ML] Async worker started (%d slots)\n", ML_QUEUE_DEPTH);
+    } else {
+        // classifyAsync degrades to synchronous calls
+        if (requestQueue) vQueueDelete(requestQueue);
+        if (completionQueue) vQueueDelete(completionQueue);
+        requestQueue = nullptr;
+        completionQueue = nullptr;
+        workerHandle = nullptr;
+        Serial.println("[ML] Async worker unavailable, classifyAsync runs inline");
+    }
+    
     // Initialize SPIFFS for model storage
     if (!SPIFFS.begin(true)) {
         Serial.println("[ML] Failed to mount SPIFFS");
@@ -36,23 +116,141 @@ void MLInference::init() {
         strncpy(modelVersion, "EI-SDK", 15);
         EdgeImpulse::printInfo();
     }
-    // Try to load existing model file
-    else if (SPIFFS.exists(MODEL_PATH)) {
-        loadModel(MODEL_PATH);
-    } else {
-        Serial.println("[ML] No model found, using heuristic classifier");
+    else {
+        // A model file on SPIFFS or SD is new: stream it into the model
+        // partition so every boot maps it instead of copying to RAM
+        if (ModelPartition::isAvailable()) {
+            if (SPIFFS.exists(MODEL_PATH) && ModelInstaller::installFromFile(SPIFFS, MODEL_PATH)) {
+                SPIFFS.remove(MODEL_PATH);
+            }
+            if (Config::isSDAvailable() && SD.exists(MODEL_PATH) &&
+                ModelInstaller::installFromFile(SD, MODEL_PATH)) {
+                SD.rename(MODEL_PATH, MODEL_INSTALLED_PATH);
+            }
+        }
+        
+        if (!modelLoaded && !loadMappedModel()) {
+            if (SPIFFS.exists(MODEL_PATH)) {
+                loadModel(MODEL_PATH);  // No partition: RAM copy
+            } else {
+                Serial.println("[ML] No model found, using heuristic classifier");
+            }
+        }
     }
     
-    Serial.println("[ML] Inference engine initialized");
+    Serial.printf("[ML] Inference engine initialized, backend: %s\n",
+                  Config::backendName(activeBackend()));
     Display::setMLStatus(true);
 }
 
 void MLInference::update() {
-    // Process any pending async inference callbacks
-    // In real implementation, check for completed inference tasks
+    if (reloadPending) loadMappedModel();
+    if (!completionQueue) return;
+    
+    // Drain finished async requests and fire their callbacks on the main loop
+    uint8_t idx;
+    while (xQueueReceive(completionQueue, &idx, 0) == pdTRUE) {
+        AsyncSlot& slot = asyncSlots[idx];
+        MLResult result = slot.result;
+        MLCallback callback = std::move(slot.callback);
+        slot.callback = nullptr;
+        uint32_t waitUs = micros() - slot.enqueuedUs;
+        
+        portENTER_CRITICAL(&asyncMux);
+        slot.state = SlotState::FREE;
+        portEXIT_CRITICAL(&asyncMux);
+        
+        queueStats.completed++;
+        queueStats.avgLatencyUs = (uint32_t)(((uint64_t)queueStats.avgLatencyUs * (queueStats.completed - 1) + waitUs) / queueStats.completed);
+        if (waitUs > queueStats.maxLatencyUs) queueStats.maxLatencyUs = waitUs;
+        
+        inferenceCount++;
+        latency.record(result.inferenceTimeUs);
+        
+        if (result.valid) {
+            Mood::onMLPrediction(result.confidence);
+        }
+        if (callback) {
+            callback(result);
+        }
+    }
+}
+
+void MLInference::workerTask(void* param) {
+    float input[FEATURE_VECTOR_SIZE];
+    uint8_t idx;
+    
+    for (;;) {
+        if (xQueueReceive(requestQueue, &idx, portMAX_DELAY) != pdTRUE) continue;
+        AsyncSlot& slot = asyncSlots[idx];
+        
+        // Snapshot features; from here on the request can no longer coalesce
+        portENTER_CRITICAL(&asyncMux);
+        size_t count = slot.featureCount;
+        memcpy(input, slot.features, count * sizeof(float));
+        slot.state = SlotState::RUNNING;
+        portEXIT_CRITICAL(&asyncMux);
+        
+        MLResult result = classifyCore(input, count);
+        
+        portENTER_CRITICAL(&asyncMux);
+        slot.result = result;
+        slot.state = SlotState::DONE;
+        portEXIT_CRITICAL(&asyncMux);
+        
+        xQueueSend(completionQueue, &idx, portMAX_DELAY);
+    }
 }
 
 MLResult MLInference::classify(const float* features, size_t featureCount) {
+    MLResult result = classifyCore(features, featureCount);
+    
+    inferenceCount++;
+    latency.record(result.inferenceTimeUs);
+    
+    // Trigger mood based on result
+    if (result.valid) {
+        Mood::onMLPrediction(result.confidence);
+    }
+    
+    return result;
+}
+
+MLResult MLInference::classifyCore(const float* features, size_t featureCount) {
+    lockEngine();
+    MLResult result = runBackend(activeBackend(), features, featureCount);
+    unlockEngine();
+    
+    return result;
+}
+
+MLBackend MLInference::activeBackend() {
+    switch (Config::ml().backend) {
+        case MLBackend::AUTO:
+            if (EdgeImpulse::isEnabled()) return MLBackend::EDGE_IMPULSE;
+            if (QuantModel::isLoaded()) return MLBackend::MODEL;
+            if (ForestClassifier::isAvailable()) return MLBackend::FOREST;
+            return MLBackend::HEURISTIC;
+        case MLBackend::EDGE_IMPULSE:
+            return EdgeImpulse::isEnabled() ? MLBackend::EDGE_IMPULSE : MLBackend::HEURISTIC;
+        case MLBackend::MODEL:
+            return QuantModel::isLoaded() ? MLBackend::MODEL : MLBackend::HEURISTIC;
+        case MLBackend::FOREST:
+            return ForestClassifier::isAvailable() ? MLBackend::FOREST : MLBackend::HEURISTIC;
+        default:
+            return MLBackend::HEURISTIC;
+    }
+}
+
+// Heuristic rules and the forest work on raw units; only a trained model
+// wants z-scores, and a quantized model may already have them folded in
+bool MLInference::wantsNormalized(MLBackend backend) {
+    return backend == MLBackend::EDGE_IMPULSE ||
+           (backend == MLBackend::MODEL && !QuantModel::hasFoldedNorm());
+}
+
+// Caller holds the engine lock
+MLResult MLInference::runBackend(MLBackend backend, const float* features, size_t featureCount) {
     MLResult result = {
         .label = MLLabel::UNKNOWN,
         .confidence = 0.0f,
@@ -61,8 +259,7 @@ MLResult MLInference::classify(const float* features, size_t featureCount) {
         .valid = false
     };
     
-    // Try Edge Impulse SDK first if enabled
-    if (EdgeImpulse::isEnabled()) {
+    if (backend == MLBackend::EDGE_IMPULSE) {
         uint32_t startTime = micros();
         EIResult eiResult = EdgeImpulse::classify(features, featureCount);
         
@@ -78,228 +275,563 @@ MLResult MLInference::classify(const float* features, size_t featureCount) {
             // Fallback to heuristic classifier
             result = runInference(features, featureCount);
         }
+    } else if (backend == MLBackend::MODEL) {
+        result = runQuantized(features, featureCount);
+    } else if (backend == MLBackend::FOREST) {
+        result = runForest(features, featureCount);
     } else {
         // Use heuristic classifier
         result = runInference(features, featureCount);
     }
     
-    inferenceCount++;
-    avgInferenceTime = (avgInferenceTime * (inferenceCount - 1) + result.inferenceTimeUs) / inferenceCount;
-    
-    // Trigger mood based on result
-    if (result.valid) {
-        Mood::onMLPrediction(result.confidence);
-    }
-    
     return result;
 }
 
 MLResult MLInference::classifyNetwork(const WiFiFeatures& network) {
     float features[FEATURE_VECTOR_SIZE];
     FeatureExtractor::toFeatureVector(network, features);
+    if (wantsNormalized(activeBackend())) {
+        FeatureExtractor::normalizeVector(features);
+    }
     return classify(features, FEATURE_VECTOR_SIZE);
 }
 
-void MLInference::classifyAsync(const float* features, size_t featureCount, MLCallback callback) {
-    // For ESP32 without PSRAM, we do sync inference
-    // A real async implementation would use a task queue
-    MLResult result = classify(features, featureCount);
-    if (callback) {
-        callback(result);
+MLResult MLInference::classifyNetwork(const uint8_t* bssid, const WiFiFeatures& network) {
+    MLResult result;
+    if (MLResultCache::lookup(bssid, network, result)) {
+        return result;
     }
+    
+    result = classifyNetwork(network);
+    MLResultCache::store(bssid, network, result);
+    return result;
 }
 
-MLResult MLInference::runInference(const float* input, size_t size) {
-    uint32_t startTime = micros();
+bool MLInference::classifyAsync(const float* features, size_t featureCount, MLCallback callback) {
+    return classifyAsync(nullptr, features, featureCount, callback);
+}
+
+bool MLInference::classifyAsync(const uint8_t* bssid, const float* features, size_t featureCount, MLCallback callback) {
+    if (!requestQueue) {
+        MLResult result = classify(features, featureCount);
+        if (callback) {
+            callback(result);
+        }
+        return true;
+    }
     
-    MLResult result = {
-        .label = MLLabel::NORMAL,
-        .confidence = 0.0f,
-        .scores = {0.8f, 0.05f, 0.05f, 0.05f, 0.05f},
-        .inferenceTimeUs = 0,
-        .valid = true
-    };
+    size_t count = min(featureCount, (size_t)FEATURE_VECTOR_SIZE);
+    int idx = -1;
+    bool coalesced = false;
+    uint16_t depth = 0;
+    
+    portENTER_CRITICAL(&asyncMux);
+    if (bssid) {
+        for (int i = 0; i < ML_QUEUE_DEPTH; i++) {
+            AsyncSlot& s = asyncSlots[i];
+            if (s.state == SlotState::PENDING && s.keyed && memcmp(s.bssid, bssid, 6) == 0) {
+                idx = i;
+                coalesced = true;
+                break;
+            }
+        }
+    }
+    if (!coalesced) {
+        for (int i = 0; i < ML_QUEUE_DEPTH; i++) {
+            if (asyncSlots[i].state != SlotState::FREE) {
+                depth++;
+            } else if (idx < 0) {
+                idx = i;
+            }
+        }
+    }
+    if (idx >= 0) {
+        AsyncSlot& s = asyncSlots[idx];
+        memcpy(s.features, features, count * sizeof(float));
+        s.featureCount = count;
+        if (!coalesced) {
+            s.state = SlotState::PENDING;
+            s.keyed = bssid != nullptr;
+            if (bssid) memcpy(s.bssid, bssid, 6);
+            s.enqueuedUs = micros();
+        }
+    }
+    portEXIT_CRITICAL(&asyncMux);
     
-    if (size < FEATURE_VECTOR_SIZE) {
-        result.valid = false;
-        return result;
+    if (idx < 0) {
+        queueStats.dropped++;
+        return false;
     }
     
-    // ========================================
-    // ENHANCED HEURISTIC CLASSIFIER
-    // Feature indices from features.cpp:
-    //  0: rssi, 1: noise, 2: snr, 3: channel, 4: secondary_ch
-    //  5: beacon_interval, 6: capability_lo, 7: capability_hi
-    //  8: hasWPS, 9: hasWPA, 10: hasWPA2, 11: hasWPA3
-    // 12: isHidden, 13: responseTime, 14: beaconCount, 15: beaconJitter
-    // 16: respondsToProbe, 17: probeResponseTime, 18: vendorIECount
-    // 19: supportedRates, 20: htCapabilities, 21: vhtCapabilities
-    // 22: anomalyScore
-    // ========================================
+    // Only the main loop reads callbacks, so this is safe outside the lock
+    asyncSlots[idx].callback = callback;
     
-    float rssi = input[0];
-    float snr = input[2];
-    uint8_t channel = (uint8_t)input[3];
-    float beaconInterval = input[5];
-    bool hasWPS = input[8] > 0.5f;
-    bool hasWPA = input[9] > 0.5f;
-    bool hasWPA2 = input[10] > 0.5f;
-    bool hasWPA3 = input[11] > 0.5f;
-    bool isHidden = input[12] > 0.5f;
-    float beaconJitter = input[15];
-    uint8_t vendorIECount = (uint8_t)input[18];
-    uint8_t supportedRates = (uint8_t)input[19];
-    bool hasHT = input[20] > 0.5f;
-    bool hasVHT = input[21] > 0.5f;
+    if (coalesced) {
+        queueStats.coalesced++;
+        return true;
+    }
     
-    float anomalyScore = 0.0f;
+    queueStats.submitted++;
+    if (depth + 1 > queueStats.highWater) queueStats.highWater = depth + 1;
     
-    // ---- ROGUE AP DETECTION ----
-    // 1. Suspiciously strong signal (someone nearby with laptop hotspot)
-    if (rssi > -30) {
-        anomalyScore += 0.3f;
+    uint8_t slotIdx = (uint8_t)idx;
+    xQueueSend(requestQueue, &slotIdx, 0);  // Never full: one entry per slot
+    return true;
+}
+
+MLQueueStats MLInference::getQueueStats() {
+    MLQueueStats stats = queueStats;
+    stats.depth = 0;
+    portENTER_CRITICAL(&asyncMux);
+    for (int i = 0; i < ML_QUEUE_DEPTH; i++) {
+        if (asyncSlots[i].state != SlotState::FREE) stats.depth++;
     }
+    portEXIT_CRITICAL(&asyncMux);
+    return stats;
+}
+
+void MLInference::classifyBatch(const FeatureMatrix& features, std::vector<MLResult>& results) {
+    size_t n = features.rows;
+    results.resize(n);
+    if (n == 0) return;
     
-    // 2. Non-standard beacon interval (default is 100ms, 102.4 TU)
-    if (beaconInterval < 50 || beaconInterval > 200) {
-        anomalyScore += 0.2f;
+    uint32_t startTime = micros();
+    lockEngine();
+    MLBackend backend = activeBackend();
+    
+    if (backend != MLBackend::HEURISTIC) {
+        // Model backends classify one vector at a time - gather each row
+        float row[FEATURE_VECTOR_SIZE];
+        for (size_t r = 0; r < n; r++) {
+            for (int c = 0; c < FEATURE_VECTOR_SIZE; c++) {
+                row[c] = features.column(c)[r];
+            }
+            results[r] = runBackend(backend, row, FEATURE_VECTOR_SIZE);
+        }
+    } else {
+        ScoreMatrix scores;
+        BatchKernels::heuristicScores(features, scores);
+        for (size_t r = 0; r < n; r++) {
+            MLResult& res = results[r];
+            res.label = (MLLabel)scores.label[r];
+            res.confidence = scores.confidence[r];
+            for (int i = 0; i < ML_CLASS_COUNT; i++) res.scores[i] = scores.column(i)[r];
+            res.valid = true;
+        }
     }
     
-    // 3. High beacon jitter (inconsistent timing = software AP)
-    if (beaconJitter > 10.0f) {
-        anomalyScore += 0.15f;
-    }
+    unlockEngine();
+    uint32_t perRow = (micros() - startTime) / n;
+    for (auto& res : results) res.inferenceTimeUs = perRow;
     
-    // 4. Missing vendor-specific IEs (real routers have many)
-    if (vendorIECount < 2) {
-        anomalyScore += 0.1f;
-    }
+    inferenceCount += n;
+    latency.record(perRow, n);
+}
+
+void MLInference::classifyNetworks(const std::vector<WiFiFeatures>& networks, std::vector<MLResult>& results) {
+    FeatureMatrix m;
+    FeatureExtractor::toColumns(networks, m);
     
-    // 5. Open network with WPS enabled (honeypot pattern)
-    if (!hasWPA && !hasWPA2 && !hasWPA3 && hasWPS) {
-        anomalyScore += 0.25f;
+    if (wantsNormalized(activeBackend())) {
+        FeatureExtractor::normalizeColumns(m);
     }
     
-    // 6. Channel anomaly - using unusual channels (non-1,6,11 for 2.4GHz)
-    if (channel <= 14 && channel != 1 && channel != 6 && channel != 11) {
-        anomalyScore += 0.05f;
+    classifyBatch(m, results);
+}
+
+void MLInference::benchmarkBatch(size_t rows) {
+    if (rows == 0) return;
+    
+    // Synthetic but plausible network table
+    std::vector<WiFiFeatures> nets(rows);
+    for (auto& f : nets) {
+        memset(&f, 0, sizeof(f));
+        f.rssi = random(-95, -20);
+        f.noise = random(-98, -85);
+        f.snr = (float)(f.rssi - f.noise);
+        f.channel = random(1, 14);
+        f.beaconInterval = random(0, 4) == 0 ? random(20, 400) : 100;
+        f.hasWPS = random(0, 4) == 0;
+        f.hasWPA = random(0, 5) == 0;
+        f.hasWPA2 = random(0, 4) != 0;
+        f.hasWPA3 = random(0, 6) == 0;
+        f.isHidden = random(0, 8) == 0;
+        f.beaconJitter = random(0, 200) / 10.0f;
+        f.vendorIECount = random(0, 6);
+        f.supportedRates = random(1, 12);
+        f.htCapabilities = random(0, 2);
+        f.vhtCapabilities = random(0, 2);
+        f.twinScore = random(0, 10) == 0 ? 0.6f : 0.0f;
     }
     
-    // 7. Claims VHT (WiFi 5) but no HT (WiFi 4) - inconsistent
-    if (hasVHT && !hasHT) {
-        anomalyScore += 0.2f;
+    // Scalar path: row vector + rule set per network
+    std::vector<MLResult> scalar(rows);
+    float vec[FEATURE_VECTOR_SIZE];
+    uint32_t t0 = micros();
+    for (size_t r = 0; r < rows; r++) {
+        FeatureExtractor::toFeatureVector(nets[r], vec);
+        scalar[r] = runInference(vec, FEATURE_VECTOR_SIZE);
+    }
+    uint32_t scalarUs = micros() - t0;
+    
+    // Batch path: transpose once, column kernels over the whole table
+    FeatureMatrix m;
+    ScoreMatrix scores;
+    t0 = micros();
+    FeatureExtractor::toColumns(nets, m);
+    BatchKernels::heuristicScores(m, scores);
+    uint32_t batchUs = micros() - t0;
+    
+    size_t mismatches = 0;
+    for (size_t r = 0; r < rows; r++) {
+        if ((uint8_t)scalar[r].label != scores.label[r] ||
+            scalar[r].confidence != scores.confidence[r]) {
+            mismatches++;
+        }
     }
     
-    // 8. Very few supported rates (minimal AP implementation)
-    if (supportedRates < 4) {
-        anomalyScore += 0.1f;
+    Serial.printf("[ML] Batch bench: %u nets, scalar %.1f nets/ms, batch %.1f nets/ms (esp-dsp: %s), parity: %s\n",
+                  (unsigned)rows,
+                  rows * 1000.0f / max(scalarUs, (uint32_t)1),
+                  rows * 1000.0f / max(batchUs, (uint32_t)1),
+                  BatchKernels::isAccelerated() ? "yes" : "no",
+                  mismatches == 0 ? "OK" : "MISMATCH");
+    if (mismatches > 0) {
+        Serial.printf("[ML] Batch parity: %u of %u rows differ\n", (unsigned)mismatches, (unsigned)rows);
+    }
+}
+
+static_assert(GOLDEN_FEATURES <= FEATURE_VECTOR_SIZE, "golden vectors wider than the feature vector");
+
+bool MLInference::benchmarkGolden(uint16_t reps) {
+    if (reps == 0) reps = 1;
+    
+    MLBackend backends[ML_BENCH_MAX_BACKENDS];
+    uint8_t n = 0;
+    backends[n++] = MLBackend::HEURISTIC;
+    if (ForestClassifier::isAvailable()) backends[n++] = MLBackend::FOREST;
+    if (QuantModel::isLoaded()) backends[n++] = MLBackend::MODEL;
+    if (EdgeImpulse::isEnabled()) backends[n++] = MLBackend::EDGE_IMPULSE;
+    
+    // 640 bytes; keep it off the loop task's stack
+    static LatencyHistogram hist;
+    bool allOk = true;
+    benchCount = 0;
+    
+    for (uint8_t b = 0; b < n; b++) {
+        MLBackend backend = backends[b];
+        
+        // Reference labels exist for the rules, and for the one model the
+        // header was generated against
+        const uint8_t* expected = nullptr;
+        if (backend == MLBackend::HEURISTIC) {
+            expected = GOLDEN_HEURISTIC_Y;
+        } else if (backend == MLBackend::MODEL && GOLDEN_MODEL_CRC != 0 &&
+                   QuantModel::getPayloadCrc() == GOLDEN_MODEL_CRC) {
+            expected = GOLDEN_MODEL_Y;
+        }
+        
+        MLBenchResult& r = benchResults[benchCount++];
+        memset(&r, 0, sizeof(r));
+        r.backend = backend;
+        r.mismatches = expected ? 0 : -1;
+        hist.reset();
+        
+        float vec[FEATURE_VECTOR_SIZE];
+        for (uint16_t rep = 0; rep < reps; rep++) {
+            for (int i = 0; i < GOLDEN_COUNT; i++) {
+                memset(vec, 0, sizeof(vec));
+                memcpy(vec, GOLDEN_X[i], sizeof(GOLDEN_X[i]));
+                if (wantsNormalized(backend)) {
+                    FeatureExtractor::normalizeVector(vec);
+                }
+                
+                lockEngine();
+                uint32_t t0 = micros();
+                MLResult res = runBackend(backend, vec, FEATURE_VECTOR_SIZE);
+                uint32_t elapsed = micros() - t0;
+                unlockEngine();
+                hist.record(elapsed);
+                
+                // Outputs are deterministic; check them on the first pass only
+                if (rep > 0) continue;
+                if (res.valid && (uint8_t)res.label < ML_CLASS_COUNT) {
+                    r.classesSeen |= 1 << (uint8_t)res.label;
+                }
+                if (!expected) continue;
+                
+                bool match = res.valid && (uint8_t)res.label == expected[i];
+                if (match && backend == MLBackend::HEURISTIC) {
+                    for (int c = 0; c < ML_CLASS_COUNT; c++) {
+                        if (fabsf(res.scores[c] - GOLDEN_HEURISTIC_SCORES[i][c]) > 1e-5f) match = false;
+                    }
+                }
+                if (!match) {
+                    r.mismatches++;
+                    Serial.printf("[ML] Golden %s: %s got %d, expected %d\n",
+                                  Config::backendName(backend), GOLDEN_NAME[i], (int)res.label, expected[i]);
+                }
+            }
+        }
+        
+        r.runs = hist.getCount();
+        r.p50Us = hist.percentile(50.0f);
+        r.p99Us = hist.percentile(99.0f);
+        r.maxUs = hist.getMax();
+        r.meanUs = hist.getMean();
+        if (r.mismatches > 0) allOk = false;
+        
+        char parity[16];
+        if (r.mismatches < 0) {
+            strcpy(parity, "n/a");
+        } else if (r.mismatches == 0) {
+            strcpy(parity, "OK");
+        } else {
+            snprintf(parity, sizeof(parity), "%d/%d BAD", r.mismatches, GOLDEN_COUNT);
+        }
+        Serial.printf("[ML] Golden %s: %u runs, p50 %u us, p99 %u us, max %u us, mean %.2f us, classes 0x%02X, parity %s\n",
+                      Config::backendName(backend), r.runs, r.p50Us, r.p99Us, r.maxUs, r.meanUs,
+                      r.classesSeen, parity);
     }
     
-    // ---- EVIL TWIN DETECTION ----
-    // Would need SSID comparison with known networks
-    // For now, flag hidden networks copying popular names
-    float evilTwinScore = 0.0f;
-    if (isHidden && rssi > -50) {
-        evilTwinScore += 0.2f;
+    // Column kernels must reproduce the scalar rules on the same vectors
+    FeatureMatrix m;
+    ScoreMatrix scores;
+    m.resize(GOLDEN_COUNT);
+    for (int c = 0; c < GOLDEN_FEATURES; c++) {
+        for (int i = 0; i < GOLDEN_COUNT; i++) m.column(c)[i] = GOLDEN_X[i][c];
+    }
+    BatchKernels::heuristicScores(m, scores);
+    int batchMismatches = 0;
+    for (int i = 0; i < GOLDEN_COUNT; i++) {
+        if (scores.label[i] != GOLDEN_HEURISTIC_Y[i]) batchMismatches++;
+    }
+    if (batchMismatches > 0) {
+        Serial.printf("[ML] Golden batch kernels: %d/%d labels differ\n", batchMismatches, GOLDEN_COUNT);
+        benchResults[0].mismatches += batchMismatches;
+        allOk = false;
     }
     
-    // ---- VULNERABLE NETWORK DETECTION ----
-    float vulnScore = 0.0f;
+    return allOk;
+}
+
+const MLBenchResult* MLInference::getBenchResults(uint8_t& count) {
+    count = benchCount;
+    return benchResults;
+}
+
+MLResult MLInference::runInference(const float* input, size_t size) {
+    uint32_t startTime = micros();
     
-    // Open network
-    if (!hasWPA && !hasWPA2 && !hasWPA3) {
-        vulnScore += 0.5f;
-    }
+    MLResult result = {
+        .label = MLLabel::NORMAL,
+        .confidence = 0.0f,
+        .scores = {0.8f, 0.05f, 0.05f, 0.05f, 0.05f},
+        .inferenceTimeUs = 0,
+        .valid = true
+    };
     
-    // WPA1 only (TKIP vulnerable)
-    if (hasWPA && !hasWPA2 && !hasWPA3) {
-        vulnScore += 0.4f;
+    if (size < FEATURE_VECTOR_SIZE) {
+        result.valid = false;
+        return result;
     }
     
-    // WPS enabled (PIN attack vulnerable)
-    if (hasWPS) {
-        vulnScore += 0.2f;
-    }
+    // Rule set lives in heuristic.cpp so host builds run the same code
+    uint8_t best = HeuristicRules::score(input, result.scores);
     
-    // Hidden SSID with weak security
-    if (isHidden && vulnScore > 0.3f) {
-        vulnScore += 0.1f;
-    }
+    result.label = (MLLabel)best;
+    result.confidence = result.scores[best];
+    result.inferenceTimeUs = micros() - startTime;
     
-    // ---- DEAUTH TARGET SCORING ----
-    float deauthScore = 0.0f;
+    return result;
+}
+
+MLResult MLInference::runForest(const float* input, size_t size) {
+    uint32_t startTime = micros();
     
-    // Good signal for reliable deauth
-    if (rssi > -70 && rssi < -30) {
-        deauthScore += 0.2f;
-    }
+    MLResult result = {
+        .label = MLLabel::UNKNOWN,
+        .confidence = 0.0f,
+        .scores = {0},
+        .inferenceTimeUs = 0,
+        .valid = false
+    };
+    
+    if (size < FEATURE_VECTOR_SIZE) return result;
+    
+    ForestClassifier::predict(input, result.scores);
     
-    // Not WPA3 (PMF protected)
-    if (!hasWPA3) {
-        deauthScore += 0.3f;
+    int maxIdx = 0;
+    for (int i = 1; i < ML_CLASS_COUNT; i++) {
+        if (result.scores[i] > result.scores[maxIdx]) maxIdx = i;
     }
     
-    // Has active clients (would need client tracking)
-    // deauthScore += clientCount > 0 ? 0.2f : 0.0f;
+    result.label = (MLLabel)maxIdx;
+    result.confidence = result.scores[maxIdx];
+    result.inferenceTimeUs = micros() - startTime;
+    result.valid = true;
     
-    // ---- CLASSIFICATION ----
-    result.scores[0] = 1.0f - (anomalyScore + evilTwinScore + vulnScore) / 3.0f;  // NORMAL
-    result.scores[1] = min(1.0f, anomalyScore);  // ROGUE_AP
-    result.scores[2] = min(1.0f, evilTwinScore);  // EVIL_TWIN
-    result.scores[3] = min(1.0f, deauthScore);  // DEAUTH_TARGET
-    result.scores[4] = min(1.0f, vulnScore);  // VULNERABLE
+    return result;
+}
+
+MLResult MLInference::runQuantized(const float* input, size_t size) {
+    uint32_t startTime = micros();
     
-    // Normalize scores
-    float sum = 0.0f;
-    for (int i = 0; i < 5; i++) sum += result.scores[i];
-    if (sum > 0) {
-        for (int i = 0; i < 5; i++) result.scores[i] /= sum;
+    MLResult result = {
+        .label = MLLabel::UNKNOWN,
+        .confidence = 0.0f,
+        .scores = {0},
+        .inferenceTimeUs = 0,
+        .valid = false
+    };
+    
+    if (!QuantModel::run(input, size, result.scores)) {
+        return runInference(input, size);
     }
     
-    // Find highest score
     int maxIdx = 0;
-    float maxScore = result.scores[0];
-    for (int i = 1; i < 5; i++) {
-        if (result.scores[i] > maxScore) {
-            maxScore = result.scores[i];
-            maxIdx = i;
-        }
+    for (int i = 1; i < ML_CLASS_COUNT; i++) {
+        if (result.scores[i] > result.scores[maxIdx]) maxIdx = i;
     }
     
     result.label = (MLLabel)maxIdx;
-    result.confidence = maxScore;
+    result.confidence = result.scores[maxIdx];
     result.inferenceTimeUs = micros() - startTime;
+    result.valid = true;
     
     return result;
 }
 
+void MLInference::benchmarkModel() {
+    const int runs = 100;
+    float vec[FEATURE_VECTOR_SIZE] = {0};
+    float scores[ML_CLASS_COUNT];
+    
+    lockEngine();
+    uint32_t t0 = micros();
+    for (int i = 0; i < runs; i++) {
+        vec[0] = -40.0f - i % 50;  // Vary RSSI so nothing gets hoisted
+        QuantModel::run(vec, FEATURE_VECTOR_SIZE, scores);
+    }
+    uint32_t elapsed = micros() - t0;
+    unlockEngine();
+    
+    // Mapped weights live in flash and cost no heap
+    size_t weightRam = modelBlob ? modelSize : 0;
+    Serial.printf("[ML] Quantized model: %.1f us/classification, RAM %u bytes (weights %u + arena %u)\n",
+                  elapsed / (float)runs,
+                  (unsigned)(weightRam + QuantModel::getArenaBytes()),
+                  (unsigned)weightRam, (unsigned)QuantModel::getArenaBytes());
+}
+
 bool MLInference::loadModel(const char* path) {
+    uint32_t t0 = micros();
     File f = SPIFFS.open(path, "r");
     if (!f) {
         Serial.printf("[ML] Failed to open model: %s\n", path);
         return false;
     }
     
-    modelSize = f.size();
+    size_t size = f.size();
+    if (size < sizeof(QModelHeader) || size > 100000) {
+        Serial.printf("[ML] Model size out of range: %u bytes\n", (unsigned)size);
+        f.close();
+        return false;
+    }
+    
+    // malloc is 4-byte aligned, which QuantModel::bind requires
+    uint8_t* buf = (uint8_t*)malloc(size);
+    if (!buf) {
+        Serial.printf("[ML] No memory for model (%u bytes)\n", (unsigned)size);
+        f.close();
+        return false;
+    }
+    
+    size_t got = f.read(buf, size);
+    f.close();
+    
+    if (got != size || !QuantModel::validate(buf, size, ML_CLASS_COUNT)) {
+        Serial.println("[ML] Model invalid, using heuristic classifier");
+        free(buf);
+        return false;
+    }
+    
+    // Drop the previous image before binding the new one; the worker
+    // task may be mid-inference, so swap under the engine lock
+    lockEngine();
+    QuantModel::unload();
+    ModelPartition::unmap();
+    if (modelBlob) free(modelBlob);
+    modelBlob = buf;
+    modelLoaded = QuantModel::bind(modelBlob, size);
+    if (!modelLoaded) {
+        free(modelBlob);
+        modelBlob = nullptr;
+    }
+    unlockEngine();
+    if (!modelLoaded) return false;
+    modelSize = size;
     
-    // Read model header (version info)
-    char header[32];
-    f.readBytes(header, min((size_t)31, modelSize));
-    header[31] = 0;
+    // Cached results came from the previous model
+    MLResultCache::clear();
     
-    // Parse version from header
-    strncpy(modelVersion, header, 15);
+    strncpy(modelVersion, QuantModel::getVersion(), 15);
     modelVersion[15] = 0;
+    modelLoaded = true;
+    modelLoadUs = micros() - t0;
     
-    // In real implementation:
-    // - Validate model format
-    // - Load weights into inference engine
-    // - Initialize Edge Impulse runtime
+    Serial.printf("[ML] Model loaded: %s (%d bytes, %u params)\n",
+                  modelVersion, modelSize, QuantModel::getParamCount());
+    Serial.printf("[ML] SPIFFS load: %u us, %u bytes heap\n", modelLoadUs, (unsigned)size);
+    benchmarkModel();
+    return true;
+}
+
+void MLInference::requestModelReload() {
+    reloadPending = true;
+}
+
+bool MLInference::loadMappedModel() {
+    reloadPending = false;
+    if (!ModelPartition::isAvailable()) return false;
+    
+    uint32_t t0 = micros();
+    const uint8_t* blob = nullptr;
+    size_t size = 0;
+    
+    lockEngine();
+    QuantModel::unload();
+    bool ok = ModelPartition::map(&blob, &size) &&
+              QuantModel::validate(blob, size, ML_CLASS_COUNT) &&
+              QuantModel::bind(blob, size);
+    if (ok) {
+        // Weights now come from flash; drop any RAM copy
+        if (modelBlob) free(modelBlob);
+        modelBlob = nullptr;
+    } else {
+        ModelPartition::unmap();
+        modelLoaded = modelBlob && QuantModel::bind(modelBlob, modelSize);
+    }
+    unlockEngine();
     
-    f.close();
+    if (!ok) {
+        if (size) Serial.println("[ML] Mapped model invalid");
+        return false;
+    }
+    
+    modelSize = size;
     modelLoaded = true;
+    modelLoadUs = micros() - t0;
+    MLResultCache::clear();
+    
+    strncpy(modelVersion, QuantModel::getVersion(), 15);
+    modelVersion[15] = 0;
     
-    Serial.printf("[ML] Model loaded: %s (%d bytes)\n", modelVersion, modelSize);
+    Serial.printf("[ML] Model mapped: %s (%u bytes, %u params)\n",
+                  modelVersion, (unsigned)size, QuantModel::getParamCount());
+    Serial.printf("[ML] Flash map: %u us (CRC %u us), 0 bytes heap - %u bytes saved vs SPIFFS load\n",
+                  modelLoadUs, ModelPartition::getMapTimeUs(), (unsigned)size);
+    benchmarkModel();
     return true;
 }
 
@@ -315,6 +847,16 @@ bool MLInference::updateModel(const uint8_t* modelData, size_t size) {
         return false;
     }
     
+    // Flash slot when the partition exists; the old model stays mapped
+    // until the new one is fully written
+    if (ModelPartition::isAvailable()) {
+        if (!ModelInstaller::begin(size) || !ModelInstaller::write(modelData, size) ||
+            !ModelInstaller::finish()) {
+            return false;
+        }
+        return loadMappedModel();   // Main loop: no need to wait for update()
+    }
+    
     // Save to SPIFFS
     File f = SPIFFS.open(MODEL_PATH, "w");
     if (!f) {
@@ -332,12 +874,13 @@ bool MLInference::updateModel(const uint8_t* modelData, size_t size) {
 bool MLInference::validateModel(const uint8_t* data, size_t size) {
     // Basic validation
     if (size < 64) return false;  // Too small
-    if (size > 100000) return false;  // Too large for ESP32
+    // Flash installs are bounded by the slot; without the partition the
+    // model is loaded from SPIFFS into RAM
+    size_t limit = ModelPartition::isAvailable() ? ModelPartition::getSlotCapacity() : 100000;
+    if (size > limit) return false;
     
-    // Check magic header (Edge Impulse format)
-    // Real implementation would verify model integrity
-    
-    return true;
+    // Magic, CRC and layer table of the quantized model format
+    return QuantModel::validate(data, size, ML_CLASS_COUNT);
 }
 
 const char* MLInference::getModelVersion() {
@@ -366,12 +909,12 @@ bool MLInference::downloadAndUpdate(const char* url, bool promptUser) {
     
     Display::showProgress("Downloading model...", 0);
     
-    // Would HTTP download model here
-    // Display::showProgress("Downloading...", progress);
-    
-    Display::showProgress("Installing...", 90);
-    
-    // updateModel(downloadedData, downloadedSize);
+    // Streams straight into the inactive flash slot
+    if (!ModelInstaller::installFromUrl(url)) {
+        Display::showInfoBox("ML UPDATE", "Update failed", ModelInstaller::getError());
+        return false;
+    }
+    loadMappedModel();      // Main loop: show the new version, not the old one
     
     Display::showInfoBox("ML UPDATE", "Model updated!", modelVersion);
     
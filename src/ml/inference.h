@@ -4,6 +4,8 @@
 #include <Arduino.h>
 #include <functional>
 #include "features.h"
+#include "latency_histogram.h"
+#include "../core/config.h"
 
 // Model labels
 enum class MLLabel {
@@ -25,6 +27,32 @@ struct MLResult {
 
 typedef std::function<void(MLResult)> MLCallback;
 
+// Async classification queue metrics (see MLInference::getQueueStats)
+struct MLQueueStats {
+    uint16_t depth;          // Requests pending or running right now
+    uint16_t highWater;      // Deepest the queue has been
+    uint32_t submitted;
+    uint32_t completed;
+    uint32_t coalesced;      // Merged into a pending request for the same BSSID
+    uint32_t dropped;        // Rejected because every slot was busy
+    uint32_t avgLatencyUs;   // Submit -> callback
+    uint32_t maxLatencyUs;
+};
+
+// One backend's run over the golden vectors (see MLInference::benchmarkGolden)
+struct MLBenchResult {
+    MLBackend backend;
+    uint32_t runs;
+    uint32_t p50Us;
+    uint32_t p99Us;
+    uint32_t maxUs;
+    float meanUs;
+    int16_t mismatches;      // Labels differing from the reference, -1 = no reference
+    uint8_t classesSeen;     // Bit per MLLabel predicted at least once
+};
+
+#define ML_BENCH_MAX_BACKENDS 4
+
 class MLInference {
 public:
     static void init();
@@ -33,14 +61,47 @@ public:
     // Inference
     static MLResult classify(const float* features, size_t featureCount);
     static MLResult classifyNetwork(const WiFiFeatures& network);
+    // Cached per BSSID: returns the last result without re-scoring (and
+    // without the mood hook) while the features stay within tolerance.
+    // Hit rate and avoided inferences: MLResultCache::getStats()
+    static MLResult classifyNetwork(const uint8_t* bssid, const WiFiFeatures& network);
     
-    // Async inference with callback
-    static void classifyAsync(const float* features, size_t featureCount, MLCallback callback);
+    // Async inference: queued to a low-priority worker task, callback fires
+    // from update() on the main loop. Returns false if the queue is full.
+    static bool classifyAsync(const float* features, size_t featureCount, MLCallback callback);
+    // Keyed by BSSID: a request still waiting for the same BSSID is updated
+    // in place (newest features and callback win) instead of queueing again.
+    static bool classifyAsync(const uint8_t* bssid, const float* features, size_t featureCount, MLCallback callback);
+    static MLQueueStats getQueueStats();
+    
+    // Batch inference over a whole network table in one call.
+    // Results are index-aligned with the input rows; no mood side effects.
+    static void classifyBatch(const FeatureMatrix& features, std::vector<MLResult>& results);
+    static void classifyNetworks(const std::vector<WiFiFeatures>& networks, std::vector<MLResult>& results);
+    
+    // Scalar vs batch throughput (networks/ms) with parity check, logged to serial
+    static void benchmarkBatch(size_t rows);
+    
+    // Every available backend over the golden vectors (golden_vectors.h),
+    // reps passes each: latency histogram plus label parity with the Python
+    // reference. Logged to serial and kept for the ML stats screen.
+    // Returns false on any parity mismatch.
+    static bool benchmarkGolden(uint16_t reps = 50);
+    static const MLBenchResult* getBenchResults(uint8_t& count);
     
     // Model management
     static bool loadModel(const char* path);
     static bool saveModel(const char* path);
     static bool updateModel(const uint8_t* modelData, size_t size);
+    static bool loadMappedModel();    // Zero-copy from the model partition's active slot
+    // Any task: a new slot was committed. The remap, result cache clear and
+    // benchmark run from update() on the main loop (or the next
+    // loadMappedModel() call, whichever comes first).
+    static void requestModelReload();
+    
+    // Backend actually used for MLConfig::backend (AUTO and unavailable
+    // choices resolved)
+    static MLBackend activeBackend();
     
     // Model info
     static const char* getModelVersion();
@@ -51,20 +112,39 @@ public:
     static bool checkForUpdate(const char* serverUrl);
     static bool downloadAndUpdate(const char* url, bool promptUser = true);
     
-    // Statistics
+    // Statistics. Latency covers classify/classifyAsync/classifyBatch since
+    // boot or the last resetLatency(); read from the main loop.
     static uint32_t getInferenceCount() { return inferenceCount; }
-    static uint32_t getAvgInferenceTimeUs() { return avgInferenceTime; }
+    static float getAvgInferenceTimeUs() { return latency.getMean(); }
+    static uint32_t getLatencyP50Us() { return latency.percentile(50.0f); }
+    static uint32_t getLatencyP99Us() { return latency.percentile(99.0f); }
+    static uint32_t getLatencyMaxUs() { return latency.getMax(); }
+    static const LatencyHistogram& getLatencyHistogram() { return latency; }
+    static void resetLatency() { latency.reset(); }
+    static uint32_t getModelLoadUs() { return modelLoadUs; }
     
 private:
     static bool modelLoaded;
     static char modelVersion[16];
     static size_t modelSize;
     static uint32_t inferenceCount;
-    static uint32_t avgInferenceTime;
+    static LatencyHistogram latency;
+    static MLBenchResult benchResults[ML_BENCH_MAX_BACKENDS];
+    static uint8_t benchCount;
+    static uint32_t modelLoadUs;
     
     // Model weights stored in SPIFFS
     static const char* MODEL_PATH;
     
+    // Backend selection without stats or mood; safe from the worker task
+    static MLResult classifyCore(const float* input, size_t size);
+    static MLResult runBackend(MLBackend backend, const float* input, size_t size);
+    static bool wantsNormalized(MLBackend backend);
+    static void workerTask(void* param);
+    
     static MLResult runInference(const float* input, size_t size);
+    static MLResult runQuantized(const float* input, size_t size);
+    static MLResult runForest(const float* input, size_t size);
+    static void benchmarkModel();
     static bool validateModel(const uint8_t* data, size_t size);
 };
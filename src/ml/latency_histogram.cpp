@@ -0,0 +1,68 @@
+// Log-linear latency histogram implementation
+
+#include "latency_histogram.h"
+#include <string.h>
+#include <math.h>
+
+// Sub-bucket bits: 8 sub-buckets = 3 bits of mantissa below the leading 1
+static const uint8_t SUB_BITS = 3;
+
+void LatencyHistogram::reset() {
+    memset(buckets, 0, sizeof(buckets));
+    count = 0;
+    sumUs = 0;
+    minUs = UINT32_MAX;
+    maxUs = 0;
+}
+
+uint16_t LatencyHistogram::bucketIndex(uint32_t us) {
+    if (us < LATENCY_SUB_BUCKETS) return (uint16_t)us;
+
+    // Octave = position of the leading 1 (>= SUB_BITS here)
+    uint8_t octave = 31 - __builtin_clz(us);
+    uint8_t sub = (us >> (octave - SUB_BITS)) & (LATENCY_SUB_BUCKETS - 1);
+    uint32_t index = (uint32_t)(octave - SUB_BITS + 1) * LATENCY_SUB_BUCKETS + sub;
+    return index < LATENCY_BUCKETS ? (uint16_t)index : LATENCY_BUCKETS - 1;
+}
+
+uint32_t LatencyHistogram::bucketLowerUs(uint16_t index) {
+    if (index < LATENCY_SUB_BUCKETS) return index;
+    uint8_t shift = index / LATENCY_SUB_BUCKETS - 1;
+    uint32_t sub = index % LATENCY_SUB_BUCKETS;
+    return (LATENCY_SUB_BUCKETS + sub) << shift;
+}
+
+uint32_t LatencyHistogram::bucketUpperUs(uint16_t index) {
+    if (index < LATENCY_SUB_BUCKETS) return index;
+    if (index >= LATENCY_BUCKETS - 1) return UINT32_MAX;
+    uint8_t shift = index / LATENCY_SUB_BUCKETS - 1;
+    return bucketLowerUs(index) + (1UL << shift) - 1;
+}
+
+void LatencyHistogram::record(uint32_t us, uint32_t times) {
+    if (times == 0) return;
+    buckets[bucketIndex(us)] += times;
+    count += times;
+    sumUs += (uint64_t)us * times;
+    if (us < minUs) minUs = us;
+    if (us > maxUs) maxUs = us;
+}
+
+uint32_t LatencyHistogram::percentile(float pct) const {
+    if (count == 0) return 0;
+
+    // Rank of the sample we want, 1-based, nearest-rank method
+    uint32_t rank = (uint32_t)ceilf(pct / 100.0f * count);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+
+    uint32_t seen = 0;
+    for (uint16_t i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            uint32_t upper = bucketUpperUs(i);
+            return upper < maxUs ? upper : maxUs;
+        }
+    }
+    return maxUs;
+}
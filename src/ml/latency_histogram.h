@@ -0,0 +1,47 @@
+// Log-linear latency histogram
+//
+// Fixed 160 buckets of uint32 (640 bytes): values below 8 us are exact,
+// above that every power of two is split into 8 equal sub-buckets, so a
+// bucket is never wider than 1/8 of its lower bound (~12% worst case).
+// Range tops out at ~4 s; anything slower lands in the last bucket. Sum
+// and max are kept exactly, so mean and max carry no bucketing error.
+//
+// Not thread-safe: record from one task (MLInference records on the main
+// loop only).
+#pragma once
+
+#include <stdint.h>
+
+#define LATENCY_SUB_BUCKETS 8
+#define LATENCY_OCTAVES 20
+#define LATENCY_BUCKETS (LATENCY_SUB_BUCKETS * LATENCY_OCTAVES)
+
+class LatencyHistogram {
+public:
+    LatencyHistogram() { reset(); }
+
+    void reset();
+    void record(uint32_t us, uint32_t times = 1);
+
+    uint32_t getCount() const { return count; }
+    uint32_t getMax() const { return maxUs; }
+    uint32_t getMin() const { return count ? minUs : 0; }
+    float getMean() const { return count ? (float)((double)sumUs / count) : 0.0f; }
+
+    // Upper bound of the bucket holding the pct-th percentile sample,
+    // capped at the exact max. 0 when empty.
+    uint32_t percentile(float pct) const;
+
+    // Raw buckets, for drawing
+    uint32_t bucketCount(uint16_t index) const { return buckets[index]; }
+    static uint32_t bucketLowerUs(uint16_t index);
+    static uint32_t bucketUpperUs(uint16_t index);
+    static uint16_t bucketIndex(uint32_t us);
+
+private:
+    uint32_t buckets[LATENCY_BUCKETS];
+    uint32_t count;
+    uint64_t sumUs;
+    uint32_t minUs;
+    uint32_t maxUs;
+};
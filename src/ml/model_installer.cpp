@@ -0,0 +1,356 @@
+// Streaming model installer implementation
+
+#include "model_installer.h"
+#include <HTTPClient.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "model_partition.h"
+#include "quant_model.h"
+#include "inference.h"
+#include "../core/crc32.h"
+
+volatile bool ModelInstaller::active = false;
+int ModelInstaller::slot = -1;
+size_t ModelInstaller::written = 0;
+size_t ModelInstaller::expected = 0;
+uint32_t ModelInstaller::expectedCrc = 0;
+uint32_t ModelInstaller::crc = 0;
+size_t ModelInstaller::erasedSectors = 0;
+uint32_t ModelInstaller::startMs = 0;
+ModelInstallStats ModelInstaller::stats = {};
+char ModelInstaller::error[48] = "";
+uint8_t ModelInstaller::chunk[MODEL_INSTALL_CHUNK];
+
+// Session state is shared by the HTTP server task and the main loop
+static SemaphoreHandle_t sessionMutex = nullptr;
+
+static void lockSession() {
+    if (sessionMutex) xSemaphoreTake(sessionMutex, portMAX_DELAY);
+}
+
+static void unlockSession() {
+    if (sessionMutex) xSemaphoreGive(sessionMutex);
+}
+
+void ModelInstaller::init() {
+    if (!sessionMutex) sessionMutex = xSemaphoreCreateMutex();
+}
+
+bool ModelInstaller::fail(const char* reason) {
+    strncpy(error, reason, sizeof(error) - 1);
+    error[sizeof(error) - 1] = 0;
+    Serial.printf("[INSTALL] Failed: %s\n", error);
+    active = false;
+    stats.ok = false;
+    return false;
+}
+
+// Failure before our begin(): whatever session is open isn't ours to end
+bool ModelInstaller::failEarly(const char* reason) {
+    lockSession();
+    if (active) {
+        strncpy(error, reason, sizeof(error) - 1);
+        error[sizeof(error) - 1] = 0;
+        Serial.printf("[INSTALL] Failed: %s\n", error);
+    } else {
+        fail(reason);
+    }
+    unlockSession();
+    return false;
+}
+
+bool ModelInstaller::begin(size_t expectedSize, uint32_t crcExpected) {
+    lockSession();
+    bool ok = beginLocked(expectedSize, crcExpected);
+    unlockSession();
+    return ok;
+}
+
+bool ModelInstaller::beginLocked(size_t expectedSize, uint32_t crcExpected) {
+    if (active) {
+        // Someone else's session; leave it and its stats alone
+        strcpy(error, MODEL_INSTALL_BUSY);
+        Serial.println("[INSTALL] Busy, another install is running");
+        return false;
+    }
+    error[0] = 0;
+    memset(&stats, 0, sizeof(stats));
+
+    if (!ModelPartition::isAvailable()) return fail("no model partition");
+    if (expectedSize > ModelPartition::getSlotCapacity()) return fail("model larger than slot");
+
+    slot = ModelPartition::getInactiveSlot();
+    written = 0;
+    expected = expectedSize;
+    expectedCrc = crcExpected;
+    crc = 0;
+    erasedSectors = 0;
+    startMs = millis();
+    active = true;
+
+    // Sector 0 holds the slot header; wiping it first means a half-written
+    // slot can never look valid
+    uint32_t t0 = micros();
+    if (!ModelPartition::eraseSector(slot, 0)) return fail("erase failed");
+    stats.eraseUs += micros() - t0;
+    erasedSectors = 1;
+
+    Serial.printf("[INSTALL] Writing slot %d (%u bytes expected)\n", slot, (unsigned)expectedSize);
+    return true;
+}
+
+bool ModelInstaller::write(const uint8_t* data, size_t len) {
+    lockSession();
+    bool ok = writeLocked(data, len);
+    unlockSession();
+    return ok;
+}
+
+bool ModelInstaller::writeLocked(const uint8_t* data, size_t len) {
+    if (!active) return false;
+    if (written + len > ModelPartition::getSlotCapacity()) return fail("model larger than slot");
+    if (expected && written + len > expected) return fail("more data than announced");
+
+    // Erase just ahead of the cursor (slot offsets include the header)
+    size_t end = sizeof(ModelSlotHeader) + written + len;
+    uint32_t t0 = micros();
+    while (erasedSectors * MODEL_SECTOR_SIZE < end) {
+        if (!ModelPartition::eraseSector(slot, erasedSectors)) return fail("erase failed");
+        erasedSectors++;
+    }
+    uint32_t t1 = micros();
+    if (!ModelPartition::writeBlob(slot, written, data, len)) return fail("flash write failed");
+    uint32_t t2 = micros();
+
+    stats.eraseUs += t1 - t0;
+    stats.writeUs += t2 - t1;
+    crc = Crc32::update(crc, data, len);
+    written += len;
+    return true;
+}
+
+bool ModelInstaller::verify(bool validateModel) {
+    uint32_t t0 = micros();
+    const uint8_t* blob = nullptr;
+    spi_flash_mmap_handle_t handle;
+    if (!ModelPartition::mapSlot(slot, written, &blob, &handle)) return fail("mmap failed");
+
+    // What's on flash must match what we were sent
+    bool crcOk = Crc32::compute(blob, written) == crc;
+    bool modelOk = !validateModel || QuantModel::validate(blob, written, ML_CLASS_COUNT);
+    spi_flash_munmap(handle);
+    stats.verifyUs = micros() - t0;
+
+    if (!crcOk) return fail("flash readback CRC mismatch");
+    if (!modelOk) return fail("not a valid model");
+    return true;
+}
+
+bool ModelInstaller::finish() {
+    lockSession();
+    bool ok = finishLocked();
+    unlockSession();
+    return ok;
+}
+
+bool ModelInstaller::finishLocked() {
+    if (!active) return false;
+    if (written == 0) return fail("no data");
+    if (expected && written != expected) return fail("short transfer");
+    if (expectedCrc && crc != expectedCrc) return fail("CRC mismatch");
+    if (!verify(true)) return false;
+
+    if (!ModelPartition::commit(slot, written, crc)) return fail("header write failed");
+    active = false;
+    stats.bytes = written;
+    stats.totalMs = millis() - startMs;
+    stats.ok = true;
+    logStats("Installed");
+
+    // New slot wins from now on, including after a reboot. This may be
+    // the HTTP server task: the remap, cache clear and benchmark run from
+    // MLInference::update() on the main loop.
+    MLInference::requestModelReload();
+    return true;
+}
+
+void ModelInstaller::abort() {
+    lockSession();
+    if (active) {
+        active = false;
+        Serial.printf("[INSTALL] Aborted after %u bytes\n", (unsigned)written);
+    }
+    unlockSession();
+}
+
+void ModelInstaller::logStats(const char* what) {
+    Serial.printf("[INSTALL] %s %u bytes in %u ms (%.1f KB/s): erase %u ms, write %u ms, verify %u ms\n",
+                  what, stats.bytes, stats.totalMs, stats.kbPerSec(),
+                  stats.eraseUs / 1000, stats.writeUs / 1000, stats.verifyUs / 1000);
+}
+
+bool ModelInstaller::installFromFile(fs::FS& fs, const char* path) {
+    File f = fs.open(path, FILE_READ);
+    if (!f) return failEarly("cannot open file");
+
+    bool ok = begin(f.size());
+    while (ok && f.available()) {
+        size_t n = f.read(chunk, sizeof(chunk));
+        if (n == 0) break;
+        ok = write(chunk, n);
+    }
+    f.close();
+
+    return ok && finish();
+}
+
+bool ModelInstaller::installFromUrl(const char* url) {
+    HTTPClient http;
+    if (!http.begin(url)) return failEarly("bad URL");
+
+    int code = http.GET();
+    if (code != HTTP_CODE_OK) {
+        http.end();
+        return failEarly("HTTP error");
+    }
+
+    // -1 = chunked transfer, size unknown until the stream ends
+    int total = http.getSize();
+    WiFiClient* stream = http.getStreamPtr();
+    bool ok = begin(total > 0 ? total : 0);
+    uint32_t lastData = millis();
+
+    while (ok && http.connected() && (total < 0 || written < (size_t)total)) {
+        size_t avail = stream->available();
+        if (avail == 0) {
+            if (millis() - lastData > MODEL_INSTALL_HTTP_TIMEOUT_MS) {
+                lockSession();
+                ok = fail("download stalled");
+                unlockSession();
+                break;
+            }
+            delay(1);
+            continue;
+        }
+        size_t n = stream->readBytes(chunk, min(avail, sizeof(chunk)));
+        ok = write(chunk, n);
+        lastData = millis();
+    }
+    http.end();
+
+    return ok && finish();
+}
+
+ModelInstallStats ModelInstaller::benchmark(size_t size) {
+    // Held for the whole run: chunk and the session are ours until the end
+    lockSession();
+    if (active) {
+        beginLocked(size, 0);   // Reports busy
+        unlockSession();
+        return stats;
+    }
+    // After a second install the spare slot is the previous model, the
+    // only way back if the new one misbehaves; a timing run can't have it
+    if (ModelPartition::isSlotValid(ModelPartition::getInactiveSlot())) {
+        memset(&stats, 0, sizeof(stats));
+        fail("spare slot holds rollback model");
+        unlockSession();
+        return stats;
+    }
+    if (!beginLocked(size, 0)) {
+        unlockSession();
+        return stats;
+    }
+
+    // Deterministic non-constant pattern so the CRC does real work
+    for (size_t i = 0; i < sizeof(chunk); i++) chunk[i] = (uint8_t)(i * 31 + 7);
+
+    while (active && written < size) {
+        size_t n = min(size - written, sizeof(chunk));
+        writeLocked(chunk, n);
+    }
+    if (active && verify(false)) {
+        stats.bytes = written;
+        stats.totalMs = millis() - startMs;
+        stats.ok = true;
+        logStats("Benchmark");
+    }
+
+    // Never flip: the slot holds junk
+    active = false;
+    unlockSession();
+    return stats;
+}
+
+// Serial receiver state - main loop only
+enum class SerialRxState : uint8_t { LINE, DATA };
+static SerialRxState rxState = SerialRxState::LINE;
+static char rxLine[48];
+static uint8_t rxLineLen = 0;
+static uint32_t rxLastByte = 0;
+
+void ModelInstaller::serviceSerial() {
+    if (rxState == SerialRxState::DATA) {
+        if (!active) {
+            rxState = SerialRxState::LINE;
+            return;
+        }
+        if (Serial.available() == 0) {
+            if (millis() - rxLastByte > MODEL_INSTALL_SERIAL_TIMEOUT_MS) {
+                abort();
+                Serial.println("ERR timeout");
+                rxState = SerialRxState::LINE;
+            }
+            return;
+        }
+
+        size_t want = min((size_t)Serial.available(), min(expected - written, sizeof(chunk)));
+        size_t n = Serial.readBytes(chunk, want);
+        rxLastByte = millis();
+        if (!write(chunk, n)) {
+            Serial.printf("ERR %s\n", error);
+            rxState = SerialRxState::LINE;
+            return;
+        }
+        if (written == expected) {
+            rxState = SerialRxState::LINE;
+            if (finish()) {
+                Serial.printf("OK %u bytes %u ms\n", (unsigned)written, stats.totalMs);
+            } else {
+                Serial.printf("ERR %s\n", error);
+            }
+        }
+        return;
+    }
+
+    while (Serial.available()) {
+        int c = Serial.read();
+        if (c < 0) break;
+        if (c != '\n' && c != '\r') {
+            if (rxLineLen < sizeof(rxLine) - 1) rxLine[rxLineLen++] = (char)c;
+            continue;
+        }
+        if (rxLineLen == 0) continue;
+        rxLine[rxLineLen] = 0;
+        rxLineLen = 0;
+
+        unsigned long size = 0;
+        unsigned long crcArg = 0;
+        if (sscanf(rxLine, "MODEL %lu %lx", &size, &crcArg) == 2) {
+            if (size > 0 && begin(size, crcArg)) {
+                Serial.println("OK send");
+                rxState = SerialRxState::DATA;
+                rxLastByte = millis();
+                return;     // Payload bytes follow; don't eat them as a line
+            }
+            Serial.printf("ERR %s\n", size ? error : "empty model");
+        } else if (sscanf(rxLine, "MODELBENCH %lu", &size) == 1) {
+            ModelInstallStats s = benchmark(size);
+            if (s.ok) {
+                Serial.printf("OK %u bytes %u ms %.1f KB/s\n", s.bytes, s.totalMs, s.kbPerSec());
+            } else {
+                Serial.printf("ERR %s\n", error);
+            }
+        }
+    }
+}
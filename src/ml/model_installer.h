@@ -0,0 +1,99 @@
+// Streaming model installer
+//
+// Writes a model into the inactive ModelPartition slot one chunk at a
+// time: sectors are erased just ahead of the write cursor and a rolling
+// CRC-32 is kept, so peak RAM is one chunk whatever the model size. On
+// finish() the slot is re-read through the flash cache, checked against
+// the rolling CRC and QuantModel::validate, then the slot header is
+// written (the atomic flip) and inference is asked to switch to the new
+// model; the remap itself happens in MLInference::update() on the main
+// loop. Anything short of that leaves the current model active.
+//
+// One session at a time, from whichever task gets there first (the HTTP
+// server task or the main loop): begin() fails with "busy" while another
+// source's session is open, and the session state is only touched under
+// a mutex. Callers only write/finish/abort a session their own begin()
+// opened.
+//
+// Sources:
+//   installFromFile - SPIFFS / SD
+//   installFromUrl  - HTTP GET (MLInference::downloadAndUpdate)
+//   FileServer      - POST /api/model drives begin/write/finish directly
+//   serviceSerial   - USB serial, line protocol:
+//                       MODEL <size> <crc32 hex>\n  then <size> raw bytes
+//                       MODELBENCH <size>\n         timed dry run, no flip;
+//                                                   refused while the spare
+//                                                   slot holds a rollback model
+//                     Replies "OK ..." or "ERR <reason>" ("ERR busy" while
+//                     another install is running).
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+
+#define MODEL_INSTALL_CHUNK 4096
+#define MODEL_INSTALL_SERIAL_TIMEOUT_MS 5000
+#ifndef MODEL_INSTALL_HTTP_TIMEOUT_MS
+#define MODEL_INSTALL_HTTP_TIMEOUT_MS 15000     // No body bytes for this long = stalled
+#endif
+
+struct ModelInstallStats {
+    uint32_t bytes;
+    uint32_t totalMs;       // begin() -> flip
+    uint32_t eraseUs;
+    uint32_t writeUs;
+    uint32_t verifyUs;      // Flash CRC + model validation
+    bool ok;
+
+    float kbPerSec() const { return totalMs ? bytes / 1.024f / totalMs : 0.0f; }
+};
+
+#define MODEL_INSTALL_BUSY "busy"
+
+class ModelInstaller {
+public:
+    static void init();     // Before any other call (MLInference::init)
+
+    // expectedSize / expectedCrc of 0 mean unknown (e.g. multipart upload).
+    // False with getError() == MODEL_INSTALL_BUSY if a session is open.
+    static bool begin(size_t expectedSize = 0, uint32_t expectedCrc = 0);
+    static bool write(const uint8_t* data, size_t len);
+    static bool finish();   // Verify, flip, request the inference reload
+    static void abort();
+
+    static bool isActive() { return active; }
+    static size_t getWritten() { return written; }
+    static const char* getError() { return error; }
+    static ModelInstallStats getLastStats() { return stats; }
+
+    static bool installFromFile(fs::FS& fs, const char* path);
+    static bool installFromUrl(const char* url);
+    static void serviceSerial();    // Main loop
+
+    // Timed erase/write/verify of a synthetic blob; the slot is not flipped.
+    // Fails without touching flash if the spare slot still holds a valid
+    // (rollback) model.
+    static ModelInstallStats benchmark(size_t size);
+
+private:
+    static volatile bool active;
+    static int slot;
+    static size_t written;
+    static size_t expected;
+    static uint32_t expectedCrc;
+    static uint32_t crc;
+    static size_t erasedSectors;
+    static uint32_t startMs;
+    static ModelInstallStats stats;
+    static char error[48];
+
+    static uint8_t chunk[MODEL_INSTALL_CHUNK];  // File / URL / serial staging
+
+    static bool beginLocked(size_t expectedSize, uint32_t expectedCrc);
+    static bool writeLocked(const uint8_t* data, size_t len);
+    static bool finishLocked();
+    static bool fail(const char* reason);       // Ends the session; lock held
+    static bool failEarly(const char* reason);  // Before begin(); takes the lock
+    static bool verify(bool validateModel);
+    static void logStats(const char* what);
+};
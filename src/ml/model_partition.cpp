@@ -0,0 +1,172 @@
+// Model flash partition implementation
+
+#include "model_partition.h"
+#include "../core/crc32.h"
+
+const esp_partition_t* ModelPartition::partition = nullptr;
+spi_flash_mmap_handle_t ModelPartition::mapHandle = 0;
+uint32_t ModelPartition::mapTimeUs = 0;
+int ModelPartition::mappedSlot = -1;
+
+const esp_partition_t* ModelPartition::find() {
+    if (!partition) {
+        partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                             (esp_partition_subtype_t)MODEL_PARTITION_SUBTYPE,
+                                             MODEL_PARTITION_LABEL);
+    }
+    return partition;
+}
+
+bool ModelPartition::isAvailable() {
+    return find() != nullptr;
+}
+
+size_t ModelPartition::slotOffset(int slot) {
+    return (size_t)slot * (find()->size / MODEL_SLOT_COUNT);
+}
+
+size_t ModelPartition::getSlotCapacity() {
+    if (!find()) return 0;
+    return find()->size / MODEL_SLOT_COUNT - sizeof(ModelSlotHeader);
+}
+
+bool ModelPartition::readHeader(int slot, ModelSlotHeader& hdr) {
+    if (esp_partition_read(find(), slotOffset(slot), &hdr, sizeof(hdr)) != ESP_OK) return false;
+    return hdr.magic == MODEL_SLOT_MAGIC &&
+           hdr.formatVersion == MODEL_SLOT_FORMAT_VERSION &&
+           hdr.sequence != 0xFFFFFFFF &&
+           hdr.blobSize > 0 && hdr.blobSize <= getSlotCapacity();
+}
+
+bool ModelPartition::isSlotValid(int slot) {
+    ModelSlotHeader hdr;
+    return find() && readHeader(slot, hdr);
+}
+
+int ModelPartition::getActiveSlot() {
+    if (!find()) return -1;
+
+    int best = -1;
+    uint32_t bestSeq = 0;
+    for (int s = 0; s < MODEL_SLOT_COUNT; s++) {
+        ModelSlotHeader hdr;
+        if (readHeader(s, hdr) && (best < 0 || hdr.sequence > bestSeq)) {
+            best = s;
+            bestSeq = hdr.sequence;
+        }
+    }
+    return best;
+}
+
+bool ModelPartition::map(const uint8_t** blob, size_t* size) {
+    unmap();
+    int newest = getActiveSlot();
+    if (newest < 0) return false;
+    if (mapVerified(newest, blob, size)) return true;
+
+    // Newest slot is damaged: the other valid slot still holds the model
+    // it replaced, which beats having none
+    for (int s = 0; s < MODEL_SLOT_COUNT; s++) {
+        ModelSlotHeader hdr;
+        if (s == newest || !readHeader(s, hdr)) continue;
+        if (mapVerified(s, blob, size)) {
+            Serial.printf("[MODELPART] Fell back to slot %d\n", s);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ModelPartition::mapVerified(int slot, const uint8_t** blob, size_t* size) {
+    uint32_t t0 = micros();
+    ModelSlotHeader hdr;
+    readHeader(slot, hdr);
+
+    const void* ptr = nullptr;
+    spi_flash_mmap_handle_t handle;
+    esp_err_t err = esp_partition_mmap(find(), slotOffset(slot), sizeof(hdr) + hdr.blobSize,
+                                       SPI_FLASH_MMAP_DATA, &ptr, &handle);
+    if (err != ESP_OK) {
+        Serial.printf("[MODELPART] mmap failed: %s\n", esp_err_to_name(err));
+        return false;
+    }
+
+    // Header says the slot is complete; make sure the flash agrees
+    const uint8_t* data = (const uint8_t*)ptr + sizeof(hdr);
+    if (Crc32::compute(data, hdr.blobSize) != hdr.blobCrc) {
+        Serial.printf("[MODELPART] Slot %d CRC mismatch\n", slot);
+        spi_flash_munmap(handle);
+        return false;
+    }
+    mapTimeUs = micros() - t0;
+
+    mapHandle = handle;
+    mappedSlot = slot;
+    *blob = data;
+    *size = hdr.blobSize;
+    Serial.printf("[MODELPART] Slot %d mapped (seq %u, %u bytes) in %u us\n",
+                  slot, hdr.sequence, hdr.blobSize, mapTimeUs);
+    return true;
+}
+
+void ModelPartition::unmap() {
+    if (mapHandle) {
+        spi_flash_munmap(mapHandle);
+        mapHandle = 0;
+        mappedSlot = -1;
+    }
+}
+
+int ModelPartition::getInactiveSlot() {
+    // Never the slot inference reads from, even when map() had to fall
+    // back to the older one
+    int inUse = mapHandle ? mappedSlot : getActiveSlot();
+    return inUse == 0 ? 1 : 0;
+}
+
+bool ModelPartition::eraseSector(int slot, size_t sector) {
+    size_t addr = sector * MODEL_SECTOR_SIZE;
+    if (addr >= find()->size / MODEL_SLOT_COUNT) return false;
+    return esp_partition_erase_range(find(), slotOffset(slot) + addr, MODEL_SECTOR_SIZE) == ESP_OK;
+}
+
+bool ModelPartition::writeBlob(int slot, size_t blobOffset, const uint8_t* data, size_t len) {
+    if (blobOffset + len > getSlotCapacity()) return false;
+    return esp_partition_write(find(), slotOffset(slot) + sizeof(ModelSlotHeader) + blobOffset,
+                               data, len) == ESP_OK;
+}
+
+bool ModelPartition::mapSlot(int slot, size_t size, const uint8_t** blob, spi_flash_mmap_handle_t* handle) {
+    const void* ptr = nullptr;
+    if (esp_partition_mmap(find(), slotOffset(slot), sizeof(ModelSlotHeader) + size,
+                           SPI_FLASH_MMAP_DATA, &ptr, handle) != ESP_OK) {
+        return false;
+    }
+    *blob = (const uint8_t*)ptr + sizeof(ModelSlotHeader);
+    return true;
+}
+
+bool ModelPartition::commit(int slot, size_t size, uint32_t crc) {
+    int active = getActiveSlot();
+    uint32_t sequence = 1;
+    if (active >= 0) {
+        ModelSlotHeader cur;
+        readHeader(active, cur);
+        sequence = cur.sequence + 1;
+    }
+
+    ModelSlotHeader hdr;
+    memset(&hdr, 0xFF, sizeof(hdr));    // Untouched flash bits stay erased
+    hdr.magic = MODEL_SLOT_MAGIC;
+    hdr.formatVersion = MODEL_SLOT_FORMAT_VERSION;
+    hdr.sequence = sequence;
+    hdr.blobSize = size;
+    hdr.blobCrc = crc;
+    if (esp_partition_write(find(), slotOffset(slot), &hdr, sizeof(hdr)) != ESP_OK) {
+        Serial.printf("[MODELPART] Header write to slot %d failed\n", slot);
+        return false;
+    }
+
+    Serial.printf("[MODELPART] Slot %d active (seq %u, %u bytes)\n", slot, sequence, (unsigned)size);
+    return true;
+}
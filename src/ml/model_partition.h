@@ -0,0 +1,71 @@
+// Model weights in a dedicated flash partition
+//
+// The "model" data partition (see partitions.csv) holds two slots. Each
+// slot starts with a ModelSlotHeader followed by the PCML blob. The valid
+// slot with the highest sequence number is active; installs go to the
+// other slot and the header is written last, so a power cut mid-install
+// leaves the previous model in place.
+//
+// The active blob is mapped with esp_partition_mmap: QuantModel reads the
+// weights straight out of cached flash and no RAM copy is made. Writing a
+// slot goes through ModelInstaller, which streams it in chunks.
+#pragma once
+
+#include <Arduino.h>
+#include <esp_partition.h>
+
+#define MODEL_PARTITION_LABEL "model"
+#define MODEL_PARTITION_SUBTYPE 0x40      // First custom data subtype
+#define MODEL_SLOT_COUNT 2
+#define MODEL_SECTOR_SIZE 0x1000          // Flash erase unit
+
+#define MODEL_SLOT_MAGIC 0x534D4350       // "PCMS"
+#define MODEL_SLOT_FORMAT_VERSION 1
+
+struct __attribute__((packed)) ModelSlotHeader {
+    uint32_t magic;
+    uint16_t formatVersion;
+    uint16_t reserved;
+    uint32_t sequence;      // Higher wins; 0xFFFFFFFF = erased
+    uint32_t blobSize;
+    uint32_t blobCrc;       // CRC-32 of the whole blob
+    uint32_t pad[3];        // Keeps the blob 32-byte aligned
+};
+
+class ModelPartition {
+public:
+    static bool isAvailable();    // Partition present in the flashed table
+
+    // Verify the active slot (header + CRC over mapped flash) and map it,
+    // falling back to the other valid slot if the active one is damaged.
+    // blob stays valid until unmap().
+    static bool map(const uint8_t** blob, size_t* size);
+    static void unmap();
+    static bool isMapped() { return mapHandle != 0; }
+    static int getMappedSlot() { return mappedSlot; }   // -1 if not mapped
+
+    static size_t getSlotCapacity();
+    static int getActiveSlot();     // -1 if none valid
+    static int getInactiveSlot();   // Install target, never the mapped slot
+    static bool isSlotValid(int slot);  // Header complete (no CRC check)
+    static uint32_t getMapTimeUs() { return mapTimeUs; }
+
+    // Slot primitives for ModelInstaller. Blob offsets are relative to the
+    // start of the blob (after the header). Never call these on the active
+    // slot while it is mapped.
+    static bool eraseSector(int slot, size_t sector);      // nth 4 KB sector of the slot
+    static bool writeBlob(int slot, size_t blobOffset, const uint8_t* data, size_t len);
+    static bool mapSlot(int slot, size_t size, const uint8_t** blob, spi_flash_mmap_handle_t* handle);
+    static bool commit(int slot, size_t size, uint32_t crc);  // Header last = flip
+
+private:
+    static const esp_partition_t* partition;
+    static spi_flash_mmap_handle_t mapHandle;
+    static uint32_t mapTimeUs;
+    static int mappedSlot;
+
+    static const esp_partition_t* find();
+    static bool readHeader(int slot, ModelSlotHeader& hdr);
+    static bool mapVerified(int slot, const uint8_t** blob, size_t* size);
+    static size_t slotOffset(int slot);
+};
@@ -0,0 +1,251 @@
+// Streaming feature normalization statistics implementation
+
+#include "norm_stats.h"
+#include <SPIFFS.h>
+#include <SD.h>
+#include <math.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "result_cache.h"
+#include "../core/config.h"
+#include "../core/crc32.h"
+
+NormStats::Accumulator NormStats::local;
+NormStats::Accumulator NormStats::fleet;
+NormStats::Accumulator NormStats::delta;
+uint8_t NormStats::deviceId[6] = {0};
+bool NormStats::dirty = false;
+uint32_t NormStats::lastSave = 0;
+uint32_t NormStats::lastAppliedCount = 0;
+
+NormStats::Accumulator NormStats::scratch[2];
+
+static SemaphoreHandle_t statsMutex = nullptr;
+
+void NormStats::Accumulator::clear() {
+    count = 0;
+    memset(mean, 0, sizeof(mean));
+    memset(m2, 0, sizeof(m2));
+}
+
+void NormStats::Accumulator::add(const float* x) {
+    count++;
+    double n = (double)count;
+    for (int i = 0; i < FEATURE_VECTOR_SIZE; i++) {
+        double d = x[i] - mean[i];
+        mean[i] += d / n;
+        m2[i] += d * (x[i] - mean[i]);
+    }
+}
+
+void NormStats::Accumulator::merge(const Accumulator& other) {
+    if (other.count == 0) return;
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+
+    double na = (double)count;
+    double nb = (double)other.count;
+    double n = na + nb;
+    for (int i = 0; i < FEATURE_VECTOR_SIZE; i++) {
+        double d = other.mean[i] - mean[i];
+        mean[i] += d * nb / n;
+        m2[i] += other.m2[i] + d * d * na * nb / n;
+    }
+    count += other.count;
+}
+
+void NormStats::init() {
+    if (!statsMutex) statsMutex = xSemaphoreCreateMutex();
+
+    uint64_t mac = ESP.getEfuseMac();
+    for (int i = 0; i < 6; i++) {
+        deviceId[i] = (uint8_t)(mac >> (8 * i));
+    }
+
+    local.clear();
+    fleet.clear();
+    delta.clear();
+    load(SPIFFS, NORM_STATS_LOCAL_PATH, local, NormStatsKind::LOCAL);
+    if (load(SPIFFS, NORM_STATS_FLEET_PATH, fleet, NormStatsKind::FLEET)) {
+        load(SPIFFS, NORM_STATS_DELTA_PATH, delta, NormStatsKind::DELTA);
+    }
+
+    // New merged snapshot from the host tool? Install it once.
+    if (Config::isSDAvailable() && SD.exists(NORM_STATS_SD_FLEET)) {
+        Accumulator& incoming = scratch[0];
+        if (load(SD, NORM_STATS_SD_FLEET, incoming, NormStatsKind::FLEET)) {
+            fleet = incoming;
+            delta.clear();
+            write(SPIFFS, NORM_STATS_FLEET_PATH, fleet, NormStatsKind::FLEET);
+            write(SPIFFS, NORM_STATS_DELTA_PATH, delta, NormStatsKind::DELTA);
+            Serial.printf("[NORM] Installed fleet statistics (%u samples)\n", fleet.count);
+        }
+        SD.remove(NORM_STATS_SD_FLEET);
+    }
+
+    Serial.printf("[NORM] Local %u samples, fleet %u, delta %u\n",
+                  local.count, fleet.count, delta.count);
+
+    lastSave = millis();
+    apply();
+}
+
+void NormStats::observe(const WiFiFeatures& features) {
+    if (!statsMutex) return;
+
+    float x[FEATURE_VECTOR_SIZE];
+    FeatureExtractor::toFeatureVector(features, x);
+
+    if (xSemaphoreTake(statsMutex, 0) != pdTRUE) return;
+    local.add(x);
+    if (fleet.count > 0) delta.add(x);
+    dirty = true;
+    xSemaphoreGive(statsMutex);
+}
+
+void NormStats::update() {
+    if (!dirty) return;
+    if (millis() - lastSave < Config::ml().normSaveIntervalMs) return;
+
+    save();
+    apply();
+}
+
+bool NormStats::save() {
+    if (!statsMutex) return false;
+
+    xSemaphoreTake(statsMutex, portMAX_DELAY);
+    Accumulator& snapLocal = scratch[0];
+    Accumulator& snapDelta = scratch[1];
+    snapLocal = local;
+    snapDelta = delta;
+    dirty = false;
+    xSemaphoreGive(statsMutex);
+    lastSave = millis();
+
+    bool ok = write(SPIFFS, NORM_STATS_LOCAL_PATH, snapLocal, NormStatsKind::LOCAL);
+    if (fleet.count > 0) {
+        ok &= write(SPIFFS, NORM_STATS_DELTA_PATH, snapDelta, NormStatsKind::DELTA);
+    }
+
+    // Copy for the host merge tool (pull via File Transfer)
+    if (Config::isSDAvailable()) {
+        char path[40];
+        snprintf(path, sizeof(path), NORM_STATS_SD_DIR "/norm_%02X%02X%02X%02X%02X%02X.bin",
+                 deviceId[0], deviceId[1], deviceId[2], deviceId[3], deviceId[4], deviceId[5]);
+        write(SD, path, snapLocal, NormStatsKind::LOCAL);
+    }
+
+    Serial.printf("[NORM] Saved %u samples\n", snapLocal.count);
+    return ok;
+}
+
+void NormStats::reset() {
+    if (statsMutex) xSemaphoreTake(statsMutex, portMAX_DELAY);
+    local.clear();
+    fleet.clear();
+    delta.clear();
+    dirty = false;
+    if (statsMutex) xSemaphoreGive(statsMutex);
+
+    SPIFFS.remove(NORM_STATS_LOCAL_PATH);
+    SPIFFS.remove(NORM_STATS_DELTA_PATH);
+    SPIFFS.remove(NORM_STATS_FLEET_PATH);
+    lastAppliedCount = 0;
+    Serial.println("[NORM] Statistics reset");
+}
+
+void NormStats::effective(Accumulator& out) {
+    xSemaphoreTake(statsMutex, portMAX_DELAY);
+    if (fleet.count > 0) {
+        out = fleet;
+        out.merge(delta);
+    } else {
+        out = local;
+    }
+    xSemaphoreGive(statsMutex);
+}
+
+uint32_t NormStats::getEffectiveCount() {
+    return fleet.count > 0 ? fleet.count + delta.count : local.count;
+}
+
+bool NormStats::apply() {
+    if (!statsMutex || !Config::ml().onlineNorm) return false;
+
+    Accumulator& stats = scratch[0];
+    effective(stats);
+    if (stats.count < NORM_STATS_MIN_SAMPLES || stats.count == lastAppliedCount) return false;
+
+    float means[FEATURE_VECTOR_SIZE];
+    float stds[FEATURE_VECTOR_SIZE];
+    for (int i = 0; i < FEATURE_VECTOR_SIZE; i++) {
+        means[i] = (float)stats.mean[i];
+        stds[i] = (float)sqrt(stats.m2[i] / stats.count);  // Population std, as in train_model.py
+    }
+    FeatureExtractor::setNormalizationParams(means, stds);
+    lastAppliedCount = stats.count;
+
+    // Cached results were scored against the old parameters
+    MLResultCache::clear();
+    return true;
+}
+
+bool NormStats::load(fs::FS& fs, const char* path, Accumulator& acc, NormStatsKind expected) {
+    File f = fs.open(path, FILE_READ);
+    if (!f) return false;
+
+    NormStatsHeader hdr;
+    bool ok = f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+              hdr.magic == NORM_STATS_MAGIC &&
+              hdr.formatVersion == NORM_STATS_FORMAT_VERSION &&
+              hdr.featureCount == FEATURE_VECTOR_SIZE &&
+              hdr.kind == (uint16_t)expected;
+
+    Accumulator tmp;
+    if (ok) {
+        ok = f.read((uint8_t*)tmp.mean, sizeof(tmp.mean)) == sizeof(tmp.mean) &&
+             f.read((uint8_t*)tmp.m2, sizeof(tmp.m2)) == sizeof(tmp.m2);
+    }
+    f.close();
+
+    if (ok) {
+        uint32_t crc = Crc32::update(0, (const uint8_t*)tmp.mean, sizeof(tmp.mean));
+        crc = Crc32::update(crc, (const uint8_t*)tmp.m2, sizeof(tmp.m2));
+        ok = (crc == hdr.payloadCrc);
+    }
+    if (!ok) {
+        Serial.printf("[NORM] Ignoring invalid snapshot %s\n", path);
+        return false;
+    }
+
+    tmp.count = hdr.count;
+    acc = tmp;
+    return true;
+}
+
+bool NormStats::write(fs::FS& fs, const char* path, const Accumulator& acc, NormStatsKind kind) {
+    NormStatsHeader hdr;
+    hdr.magic = NORM_STATS_MAGIC;
+    hdr.formatVersion = NORM_STATS_FORMAT_VERSION;
+    hdr.featureCount = FEATURE_VECTOR_SIZE;
+    memcpy(hdr.deviceId, deviceId, 6);
+    hdr.kind = (uint16_t)kind;
+    hdr.count = acc.count;
+    hdr.payloadCrc = Crc32::update(0, (const uint8_t*)acc.mean, sizeof(acc.mean));
+    hdr.payloadCrc = Crc32::update(hdr.payloadCrc, (const uint8_t*)acc.m2, sizeof(acc.m2));
+
+    File f = fs.open(path, FILE_WRITE);
+    if (!f) {
+        Serial.printf("[NORM] Failed to open %s for writing\n", path);
+        return false;
+    }
+    size_t written = f.write((const uint8_t*)&hdr, sizeof(hdr));
+    written += f.write((const uint8_t*)acc.mean, sizeof(acc.mean));
+    written += f.write((const uint8_t*)acc.m2, sizeof(acc.m2));
+    f.close();
+
+    return written == sizeof(hdr) + sizeof(acc.mean) + sizeof(acc.m2);
+}
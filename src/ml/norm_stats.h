@@ -0,0 +1,97 @@
+// Streaming feature normalization statistics
+//
+// Running mean/variance per feature column (Welford, double accumulators)
+// over every network the device observes, persisted to SPIFFS so the
+// z-score parameters survive reboots and need no offline training pass.
+//
+// Snapshot file (little-endian, also written by train_model.py merge-norm):
+//   NormStatsHeader (24 bytes)
+//   double mean[featureCount]
+//   double m2[featureCount]      // Sum of squared deviations
+//
+// Three accumulators are kept:
+//   local - everything this device saw; exported to SD for the host merge
+//   fleet - merged snapshot from several devices (host tool output)
+//   delta - local samples since the fleet snapshot was installed
+// Normalization uses fleet + delta, or local when no fleet is installed, so
+// this device's samples are never counted twice.
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include "features.h"
+
+#define NORM_STATS_MAGIC 0x534E4350  // "PCNS"
+#define NORM_STATS_FORMAT_VERSION 1
+#define NORM_STATS_MIN_SAMPLES 32    // Don't normalize from a handful of APs
+
+// SPIFFS state
+#define NORM_STATS_LOCAL_PATH "/models/norm_local.bin"
+#define NORM_STATS_DELTA_PATH "/models/norm_delta.bin"
+#define NORM_STATS_FLEET_PATH "/models/norm_fleet.bin"
+
+// SD exchange with the host tool: snapshots go out as norm_<MAC>.bin,
+// a merged norm_fleet.bin dropped here is installed once at boot
+#define NORM_STATS_SD_DIR "/mldata"
+#define NORM_STATS_SD_FLEET "/mldata/norm_fleet.bin"
+
+enum class NormStatsKind : uint16_t {
+    LOCAL = 0,
+    FLEET = 1,
+    DELTA = 2
+};
+
+struct __attribute__((packed)) NormStatsHeader {
+    uint32_t magic;
+    uint16_t formatVersion;
+    uint16_t featureCount;
+    uint8_t deviceId[6];    // Station MAC; zero for merged snapshots
+    uint16_t kind;          // NormStatsKind
+    uint32_t count;
+    uint32_t payloadCrc;    // CRC-32 of mean[] + m2[]
+};
+
+class NormStats {
+public:
+    static void init();      // Load state, install SD fleet snapshot, apply
+    static void update();    // Main loop: periodic persist + re-apply
+
+    // Add one network. Safe from the WiFi task; a sample is dropped rather
+    // than blocking while the main loop is snapshotting.
+    static void observe(const WiFiFeatures& features);
+
+    static bool save();
+    static void reset();
+
+    // Push fleet+delta (or local) means/stds to FeatureExtractor when
+    // MLConfig::onlineNorm is set and enough samples exist
+    static bool apply();
+
+    static uint32_t getLocalCount() { return local.count; }
+    static uint32_t getEffectiveCount();
+    static bool hasFleet() { return fleet.count > 0; }
+
+private:
+    struct Accumulator {
+        uint32_t count;
+        double mean[FEATURE_VECTOR_SIZE];
+        double m2[FEATURE_VECTOR_SIZE];
+
+        void clear();
+        void add(const float* x);
+        void merge(const Accumulator& other);   // Chan et al. parallel update
+    };
+
+    static Accumulator local;
+    static Accumulator fleet;
+    static Accumulator delta;
+    static Accumulator scratch[2];  // Main-loop snapshots, too big for the stack
+    static uint8_t deviceId[6];
+    static bool dirty;
+    static uint32_t lastSave;
+    static uint32_t lastAppliedCount;
+
+    static bool load(fs::FS& fs, const char* path, Accumulator& acc, NormStatsKind expected);
+    static bool write(fs::FS& fs, const char* path, const Accumulator& acc, NormStatsKind kind);
+    static void effective(Accumulator& out);
+};
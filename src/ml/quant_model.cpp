@@ -0,0 +1,186 @@
+// Int8 quantized MLP inference engine implementation
+
+#include "quant_model.h"
+#include "../core/crc32.h"
+#include <Arduino.h>
+#include <string.h>
+#include <math.h>
+
+const uint8_t* QuantModel::blob = nullptr;
+size_t QuantModel::blobSize = 0;
+QModelHeader QuantModel::header = {};
+const QLayerDesc* QuantModel::layers = nullptr;
+const float* QuantModel::inputMean = nullptr;
+const float* QuantModel::inputMul = nullptr;
+uint32_t QuantModel::paramCount = 0;
+
+// Scratch arena: two ping-pong activation buffers plus the quantized input.
+// Sized for the widest layer the format allows, so run() never allocates.
+static float arenaAct[2][QMODEL_MAX_WIDTH] __attribute__((aligned(16)));
+static int8_t arenaQuant[QMODEL_MAX_WIDTH] __attribute__((aligned(16)));
+
+static char versionStr[sizeof(((QModelHeader*)0)->version) + 1];
+
+static size_t align4(size_t n) {
+    return (n + 3) & ~(size_t)3;
+}
+
+// Returns nullptr if the blob is usable, otherwise a reason string
+const char* QuantModel::check(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(QModelHeader)) return "too small";
+
+    QModelHeader h;
+    memcpy(&h, data, sizeof(h));
+
+    if (h.magic != QMODEL_MAGIC) return "bad magic";
+    if (h.formatVersion != QMODEL_FORMAT_VERSION) return "unsupported format version";
+    if (h.layerCount == 0 || h.layerCount > QMODEL_MAX_LAYERS) return "bad layer count";
+    if (h.payloadSize != size - sizeof(QModelHeader)) return "payload size mismatch";
+
+    const uint8_t* payload = data + sizeof(QModelHeader);
+    if (Crc32::compute(payload, h.payloadSize) != h.payloadCrc) return "CRC mismatch";
+
+    size_t tableBytes = (size_t)h.layerCount * sizeof(QLayerDesc);
+    if (h.flags & QMODEL_FLAG_FOLDED_NORM) {
+        tableBytes += (size_t)h.inputSize * 2 * sizeof(float);
+    }
+    if (tableBytes > h.payloadSize) return "layer table truncated";
+
+    const QLayerDesc* table = (const QLayerDesc*)payload;
+    uint16_t expectIn = h.inputSize;
+    for (uint16_t l = 0; l < h.layerCount; l++) {
+        const QLayerDesc& L = table[l];
+        if (L.inSize != expectIn) return "layer shape mismatch";
+        if (L.inSize == 0 || L.inSize > QMODEL_MAX_WIDTH) return "layer too wide";
+        if (L.outSize == 0 || L.outSize > QMODEL_MAX_WIDTH) return "layer too wide";
+        if (L.activation > (uint8_t)QActivation::RELU) return "unknown activation";
+        if (!(L.inputScale > 0.0f)) return "bad input scale";
+        if (L.dataOffset & 3) return "layer data not aligned";
+        if (L.dataOffset < tableBytes) return "layer data overlaps table";
+
+        size_t bytes = align4((size_t)L.inSize * L.outSize) + (size_t)L.outSize * 2 * sizeof(float);
+        if ((size_t)L.dataOffset + bytes > h.payloadSize) return "layer data truncated";
+
+        expectIn = L.outSize;
+    }
+    if (expectIn != h.outputSize) return "output size mismatch";
+
+    return nullptr;
+}
+
+bool QuantModel::validate(const uint8_t* data, size_t size, uint16_t outputs) {
+    if (check(data, size) != nullptr) return false;
+    if (outputs == 0) return true;
+
+    QModelHeader h;
+    memcpy(&h, data, sizeof(h));
+    return h.outputSize == outputs;
+}
+
+bool QuantModel::bind(const uint8_t* data, size_t size) {
+    const char* err = ((uintptr_t)data & 3) ? "blob not 4-byte aligned" : check(data, size);
+    if (err) {
+        Serial.printf("[QMODEL] Rejected model: %s\n", err);
+        return false;
+    }
+
+    memcpy(&header, data, sizeof(header));
+    blob = data;
+    blobSize = size;
+    layers = (const QLayerDesc*)(data + sizeof(QModelHeader));
+    if (header.flags & QMODEL_FLAG_FOLDED_NORM) {
+        inputMean = (const float*)(layers + header.layerCount);
+        inputMul = inputMean + header.inputSize;
+    }
+
+    paramCount = 0;
+    for (uint16_t l = 0; l < header.layerCount; l++) {
+        paramCount += (uint32_t)layers[l].inSize * layers[l].outSize + layers[l].outSize;
+    }
+
+    Serial.printf("[QMODEL] Bound v%s: %u layers, %u->%u, %u params, %u bytes + %u arena\n",
+                  getVersion(), header.layerCount, header.inputSize, header.outputSize,
+                  paramCount, (unsigned)blobSize, (unsigned)getArenaBytes());
+    return true;
+}
+
+void QuantModel::unload() {
+    blob = nullptr;
+    blobSize = 0;
+    layers = nullptr;
+    inputMean = nullptr;
+    inputMul = nullptr;
+    paramCount = 0;
+    memset(&header, 0, sizeof(header));
+}
+
+const char* QuantModel::getVersion() {
+    memcpy(versionStr, header.version, sizeof(header.version));
+    versionStr[sizeof(header.version)] = '\0';
+    return versionStr;
+}
+
+size_t QuantModel::getArenaBytes() {
+    return sizeof(arenaAct) + sizeof(arenaQuant);
+}
+
+bool QuantModel::run(const float* input, size_t inputSize, float* scores) {
+    if (!blob || !input || !scores) return false;
+    if (inputSize < header.inputSize) return false;
+
+    const uint8_t* payload = blob + sizeof(QModelHeader);
+    memcpy(arenaAct[0], input, header.inputSize * sizeof(float));
+    int cur = 0;
+
+    for (uint16_t l = 0; l < header.layerCount; l++) {
+        const QLayerDesc& L = layers[l];
+        const int8_t* weights = (const int8_t*)(payload + L.dataOffset);
+        const float* wScales = (const float*)(payload + L.dataOffset + align4((size_t)L.inSize * L.outSize));
+        const float* bias = wScales + L.outSize;
+
+        const float* x = arenaAct[cur];
+        float* y = arenaAct[cur ^ 1];
+
+        // Quantize the layer input once, symmetric int8. Layer 0 may carry
+        // per-feature normalization folded into the quantizer.
+        float invScale = 1.0f / L.inputScale;
+        for (uint16_t i = 0; i < L.inSize; i++) {
+            float q = (l == 0 && inputMean) ? roundf((x[i] - inputMean[i]) * inputMul[i])
+                                            : roundf(x[i] * invScale);
+            if (q > 127.0f) q = 127.0f;
+            if (q < -127.0f) q = -127.0f;
+            arenaQuant[i] = (int8_t)q;
+        }
+
+        bool relu = L.activation == (uint8_t)QActivation::RELU;
+        for (uint16_t o = 0; o < L.outSize; o++) {
+            const int8_t* row = weights + (size_t)o * L.inSize;
+            int32_t acc = 0;
+            for (uint16_t i = 0; i < L.inSize; i++) {
+                acc += (int32_t)row[i] * (int32_t)arenaQuant[i];
+            }
+            float v = (float)acc * (wScales[o] * L.inputScale) + bias[o];
+            if (relu && v < 0.0f) v = 0.0f;
+            y[o] = v;
+        }
+
+        cur ^= 1;
+    }
+
+    // Softmax over the final logits
+    const float* logits = arenaAct[cur];
+    float maxLogit = logits[0];
+    for (uint16_t o = 1; o < header.outputSize; o++) {
+        if (logits[o] > maxLogit) maxLogit = logits[o];
+    }
+    float sum = 0.0f;
+    for (uint16_t o = 0; o < header.outputSize; o++) {
+        scores[o] = expf(logits[o] - maxLogit);
+        sum += scores[o];
+    }
+    for (uint16_t o = 0; o < header.outputSize; o++) {
+        scores[o] /= sum;
+    }
+
+    return true;
+}
@@ -0,0 +1,98 @@
+// Int8 quantized MLP inference engine
+//
+// Model file format (little-endian, every section 4-byte aligned):
+//
+//   QModelHeader   40 bytes   magic "PCML", format version, CRC of payload
+//   QLayerDesc[n]  16 bytes each, n = header.layerCount
+//   input norm     only with QMODEL_FLAG_FOLDED_NORM, right after the table:
+//                    float inputMean[inputSize]
+//                    float inputMul[inputSize]   1 / (std * layer0.inputScale)
+//   layer data     per layer at QLayerDesc.dataOffset (from payload start):
+//                    int8  weights[outSize][inSize]  (padded to 4 bytes)
+//                    float weightScales[outSize]     per output channel
+//                    float bias[outSize]
+//
+// Payload = everything after the header; payloadCrc is CRC-32 over it.
+// With QMODEL_FLAG_FOLDED_NORM the z-score normalization is folded into the
+// layer 0 input quantizer, x_q = round((x - mean) * inputMul), so the engine
+// takes raw feature vectors at no extra cost.
+//
+// Per layer: x_q = clamp(round(x / inputScale), -127, 127)
+//            y[o] = sum(w_q[o][i] * x_q[i]) * weightScales[o] * inputScale + bias[o]
+// The last layer's outputs are softmaxed into class scores.
+//
+// Written by scripts/train_model.py train-mlp.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define QMODEL_MAGIC 0x4C4D4350UL  // "PCML"
+#define QMODEL_FORMAT_VERSION 1
+#define QMODEL_MAX_LAYERS 4
+#define QMODEL_MAX_WIDTH 128
+#define QMODEL_FLAG_FOLDED_NORM 0x0001
+
+enum class QActivation : uint8_t {
+    LINEAR = 0,
+    RELU = 1
+};
+
+#pragma pack(push, 1)
+struct QModelHeader {
+    uint32_t magic;
+    uint16_t formatVersion;
+    uint16_t layerCount;
+    char version[16];
+    uint16_t inputSize;
+    uint16_t outputSize;
+    uint32_t flags;
+    uint32_t payloadSize;   // Bytes following this header
+    uint32_t payloadCrc;    // CRC-32 of the payload
+};
+
+struct QLayerDesc {
+    uint16_t inSize;
+    uint16_t outSize;
+    uint8_t activation;     // QActivation
+    uint8_t reserved[3];
+    float inputScale;       // Quantization step of this layer's input
+    uint32_t dataOffset;    // From payload start
+};
+#pragma pack(pop)
+
+class QuantModel {
+public:
+    // Check header, CRC and layer table without binding (any alignment).
+    // outputs != 0 additionally requires that many output classes.
+    static bool validate(const uint8_t* blob, size_t size, uint16_t outputs = 0);
+
+    // Point the engine at a validated blob. The blob is NOT copied and must
+    // stay valid until unload() (RAM buffer or memory-mapped flash) and
+    // must be 4-byte aligned.
+    static bool bind(const uint8_t* blob, size_t size);
+    static void unload();
+
+    // Run one vector through the network; scores gets outputSize softmax values.
+    // Uses only the static arena - no heap allocation.
+    static bool run(const float* input, size_t inputSize, float* scores);
+
+    static bool isLoaded() { return blob != nullptr; }
+    static const char* getVersion();
+    static uint32_t getParamCount() { return paramCount; }
+    static uint16_t getOutputSize() { return header.outputSize; }
+    static bool hasFoldedNorm() { return (header.flags & QMODEL_FLAG_FOLDED_NORM) != 0; }
+    static uint32_t getPayloadCrc() { return header.payloadCrc; }   // Identifies the model
+    static size_t getArenaBytes();
+
+private:
+    static const uint8_t* blob;
+    static size_t blobSize;
+    static QModelHeader header;
+    static const QLayerDesc* layers;
+    static const float* inputMean;    // nullptr unless FOLDED_NORM
+    static const float* inputMul;
+    static uint32_t paramCount;
+
+    static const char* check(const uint8_t* data, size_t size);
+};
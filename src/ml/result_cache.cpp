@@ -0,0 +1,149 @@
+// Per-BSSID classification result cache implementation
+// Main loop only - not touched by the async worker.
+
+#include "result_cache.h"
+#include "../core/config.h"
+
+// Drift allowed before a network is re-scored
+#define TOL_RSSI 3
+#define TOL_NOISE 3
+#define TOL_SNR 3.0f
+#define TOL_JITTER 2.0f
+#define TOL_RESPONSE_TIME 1000
+#define TOL_PROBE_RESPONSE_TIME 1000
+#define TOL_ANOMALY 0.05f
+
+MLResultCache::Entry MLResultCache::entries[ML_CACHE_SIZE];
+MLCacheStats MLResultCache::stats = {};
+
+static uint32_t fnv1a(uint32_t h, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619UL;
+    }
+    return h;
+}
+
+MLResultCache::Fingerprint MLResultCache::fingerprint(const WiFiFeatures& f) {
+    Fingerprint fp;
+
+    // beaconCount is left out on purpose: it grows with every beacon and
+    // the TTL already bounds how stale the result can get
+    uint8_t flags = (f.hasWPS ? 0x01 : 0) | (f.hasWPA ? 0x02 : 0) |
+                    (f.hasWPA2 ? 0x04 : 0) | (f.hasWPA3 ? 0x08 : 0) |
+                    (f.isHidden ? 0x10 : 0) | (f.respondsToProbe ? 0x20 : 0);
+    uint32_t h = 2166136261UL;
+    h = fnv1a(h, &f.channel, sizeof(f.channel));
+    h = fnv1a(h, &f.secondaryChannel, sizeof(f.secondaryChannel));
+    h = fnv1a(h, &f.beaconInterval, sizeof(f.beaconInterval));
+    h = fnv1a(h, &f.capability, sizeof(f.capability));
+    h = fnv1a(h, &flags, sizeof(flags));
+    h = fnv1a(h, &f.vendorIECount, sizeof(f.vendorIECount));
+    h = fnv1a(h, &f.supportedRates, sizeof(f.supportedRates));
+    h = fnv1a(h, &f.htCapabilities, sizeof(f.htCapabilities));
+    h = fnv1a(h, &f.vhtCapabilities, sizeof(f.vhtCapabilities));
+    h = fnv1a(h, &f.twinScore, sizeof(f.twinScore));
+    fp.discreteHash = h;
+
+    fp.rssi = f.rssi;
+    fp.noise = f.noise;
+    fp.snr = f.snr;
+    fp.beaconJitter = f.beaconJitter;
+    fp.responseTime = f.responseTime;
+    fp.probeResponseTime = f.probeResponseTime;
+    fp.anomalyScore = f.anomalyScore;
+    return fp;
+}
+
+bool MLResultCache::withinTolerance(const Fingerprint& a, const Fingerprint& b) {
+    if (a.discreteHash != b.discreteHash) return false;
+    if (abs(a.rssi - b.rssi) > TOL_RSSI) return false;
+    if (abs(a.noise - b.noise) > TOL_NOISE) return false;
+    if (fabsf(a.snr - b.snr) > TOL_SNR) return false;
+    if (fabsf(a.beaconJitter - b.beaconJitter) > TOL_JITTER) return false;
+    if (abs((int32_t)(a.responseTime - b.responseTime)) > TOL_RESPONSE_TIME) return false;
+    if (abs((int32_t)a.probeResponseTime - (int32_t)b.probeResponseTime) > TOL_PROBE_RESPONSE_TIME) return false;
+    if (fabsf(a.anomalyScore - b.anomalyScore) > TOL_ANOMALY) return false;
+    return true;
+}
+
+MLResultCache::Entry* MLResultCache::find(const uint8_t* bssid) {
+    for (int i = 0; i < ML_CACHE_SIZE; i++) {
+        if (entries[i].used && memcmp(entries[i].bssid, bssid, 6) == 0) {
+            return &entries[i];
+        }
+    }
+    return nullptr;
+}
+
+bool MLResultCache::lookup(const uint8_t* bssid, const WiFiFeatures& features, MLResult& result) {
+    stats.lookups++;
+
+    Entry* e = find(bssid);
+    if (!e) {
+        stats.misses++;
+        return false;
+    }
+
+    uint32_t now = millis();
+    if (now - e->scoredAt > Config::ml().cacheTtlMs) {
+        stats.expired++;
+        return false;
+    }
+    if (!withinTolerance(e->fp, fingerprint(features))) {
+        stats.changed++;
+        return false;
+    }
+
+    e->lastUsed = now;
+    result = e->result;
+    stats.hits++;
+    return true;
+}
+
+void MLResultCache::store(const uint8_t* bssid, const WiFiFeatures& features, const MLResult& result) {
+    if (!result.valid) return;
+
+    Entry* e = find(bssid);
+    if (!e) {
+        // Free slot, otherwise evict the least recently used
+        Entry* lru = &entries[0];
+        for (int i = 0; i < ML_CACHE_SIZE; i++) {
+            if (!entries[i].used) {
+                lru = &entries[i];
+                break;
+            }
+            if (entries[i].lastUsed < lru->lastUsed) lru = &entries[i];
+        }
+        if (lru->used) stats.evictions++;
+        e = lru;
+        memcpy(e->bssid, bssid, 6);
+        e->used = true;
+    }
+
+    e->fp = fingerprint(features);
+    e->result = result;
+    e->scoredAt = millis();
+    e->lastUsed = e->scoredAt;
+}
+
+void MLResultCache::invalidate(const uint8_t* bssid) {
+    Entry* e = find(bssid);
+    if (e) e->used = false;
+}
+
+void MLResultCache::clear() {
+    for (int i = 0; i < ML_CACHE_SIZE; i++) {
+        entries[i].used = false;
+    }
+}
+
+MLCacheStats MLResultCache::getStats() {
+    MLCacheStats s = stats;
+    s.entries = 0;
+    for (int i = 0; i < ML_CACHE_SIZE; i++) {
+        if (entries[i].used) s.entries++;
+    }
+    return s;
+}
@@ -0,0 +1,66 @@
+// Per-BSSID classification result cache
+//
+// Beacon features barely move between frames, so a network is only
+// re-scored when its fingerprint changes: any discrete feature (channel,
+// security flags, IE counts, twin score...) differs, a continuous one
+// (RSSI, jitter...) drifts past its tolerance, or the entry is older than
+// MLConfig::cacheTtlMs.
+#pragma once
+
+#include <Arduino.h>
+#include "features.h"
+#include "inference.h"
+
+#define ML_CACHE_SIZE 64
+
+struct MLCacheStats {
+    uint32_t lookups;
+    uint32_t hits;           // Inference calls avoided
+    uint32_t misses;         // Not cached yet (or evicted)
+    uint32_t changed;        // Fingerprint moved past tolerance
+    uint32_t expired;        // TTL ran out
+    uint32_t evictions;      // LRU entry replaced to make room
+    uint16_t entries;
+
+    float hitRate() const { return lookups ? (float)hits / lookups : 0.0f; }
+};
+
+class MLResultCache {
+public:
+    // True and fills result if the BSSID is cached and still matches
+    static bool lookup(const uint8_t* bssid, const WiFiFeatures& features, MLResult& result);
+    static void store(const uint8_t* bssid, const WiFiFeatures& features, const MLResult& result);
+
+    static void invalidate(const uint8_t* bssid);
+    static void clear();    // e.g. after a model swap
+
+    static MLCacheStats getStats();
+
+private:
+    struct Fingerprint {
+        uint32_t discreteHash;   // FNV-1a over exact-match features
+        int8_t rssi;
+        int8_t noise;
+        float snr;
+        float beaconJitter;
+        uint32_t responseTime;
+        uint16_t probeResponseTime;
+        float anomalyScore;
+    };
+
+    struct Entry {
+        uint8_t bssid[6];
+        bool used;
+        Fingerprint fp;
+        MLResult result;
+        uint32_t scoredAt;
+        uint32_t lastUsed;
+    };
+
+    static Entry entries[ML_CACHE_SIZE];
+    static MLCacheStats stats;
+
+    static Fingerprint fingerprint(const WiFiFeatures& f);
+    static bool withinTolerance(const Fingerprint& a, const Fingerprint& b);
+    static Entry* find(const uint8_t* bssid);
+};
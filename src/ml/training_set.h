@@ -0,0 +1,99 @@
+// Columnar training dataset ("PCTS")
+//
+// Written by WARHOG's ML export and the host pcap extractor
+// (tools/pcap_extract), read by scripts/train_model.py with numpy.memmap.
+// Little-endian layout:
+//
+//   TrainingSetHeader      32 bytes
+//   TrainingSetColumn[n]   32 bytes each, n = header.columnCount
+//   column blocks          one per column at TrainingSetColumn.offset (from
+//                          file start, TRAINING_SET_ALIGN aligned): rowCount
+//                          values of the column's dtype, back to back
+//
+// Column-major, so a producer writes each column as one sequential run and
+// Python maps each one as a contiguous array without parsing anything.
+// Plain C++ so the same definitions build on device and on the host.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define TRAINING_SET_MAGIC 0x53544350UL    // "PCTS"
+#define TRAINING_SET_FORMAT_VERSION 1
+#define TRAINING_SET_ALIGN 16
+#define TRAINING_SET_NAME_LEN 24
+#define TRAINING_SET_FEATURES 32            // FEATURE_VECTOR_SIZE
+
+#pragma pack(push, 1)
+struct TrainingSetHeader {
+    uint32_t magic;
+    uint16_t formatVersion;
+    uint16_t columnCount;
+    uint32_t rowCount;
+    uint32_t dataOffset;    // First column block
+    uint32_t reserved;
+    char source[12];        // Producer, e.g. "warhog" or "pcap"
+};
+
+struct TrainingSetColumn {
+    char name[TRAINING_SET_NAME_LEN];
+    char dtype[4];          // numpy dtype string: "<f4", "<f8", "<i4", "<u4", "<u8", "S32"
+    uint32_t offset;        // Column block, from file start
+};
+#pragma pack(pop)
+
+// Feature columns in FeatureExtractor::toFeatureVector order - must match
+// FEATURE_NAMES in train_model.py (24..31 are reserved)
+static const char* const TRAINING_FEATURE_NAMES[TRAINING_SET_FEATURES] = {
+    "rssi", "noise", "snr", "channel", "secondary_channel",
+    "beacon_interval", "capability_low", "capability_high",
+    "has_wps", "has_wpa", "has_wpa2", "has_wpa3", "is_hidden",
+    "response_time", "beacon_count", "beacon_jitter",
+    "responds_to_probe", "probe_response_time",
+    "vendor_ie_count", "supported_rates", "ht_capabilities", "vht_capabilities",
+    "anomaly_score", "twin_score",
+    "f24", "f25", "f26", "f27", "f28", "f29", "f30", "f31"
+};
+
+// Bytes per value for the dtypes above, 0 if unknown
+inline size_t trainingSetDtypeSize(const char* dtype) {
+    if (dtype[0] == 'S') {
+        size_t n = 0;
+        for (const char* p = dtype + 1; p < dtype + 4 && *p >= '0' && *p <= '9'; p++) {
+            n = n * 10 + (*p - '0');
+        }
+        return n;
+    }
+    if (dtype[0] != '<') return 0;
+    if (dtype[1] != 'f' && dtype[1] != 'i' && dtype[1] != 'u') return 0;
+    return (size_t)(dtype[2] - '0');
+}
+
+inline void trainingSetColumn(TrainingSetColumn& col, const char* name, const char* dtype) {
+    memset(&col, 0, sizeof(col));
+    strncpy(col.name, name, TRAINING_SET_NAME_LEN - 1);
+    memcpy(col.dtype, dtype, strnlen(dtype, sizeof(col.dtype)));   // Not NUL-terminated when 4 chars
+}
+
+// Fill the header and every column's offset for rowCount rows. Column
+// names/dtypes must already be set. Returns the total file size.
+inline size_t trainingSetLayout(TrainingSetHeader& hdr, TrainingSetColumn* cols, uint16_t columnCount,
+                                uint32_t rowCount, const char* source) {
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = TRAINING_SET_MAGIC;
+    hdr.formatVersion = TRAINING_SET_FORMAT_VERSION;
+    hdr.columnCount = columnCount;
+    hdr.rowCount = rowCount;
+    strncpy(hdr.source, source, sizeof(hdr.source) - 1);
+
+    size_t pos = sizeof(hdr) + (size_t)columnCount * sizeof(TrainingSetColumn);
+    pos = (pos + TRAINING_SET_ALIGN - 1) & ~(size_t)(TRAINING_SET_ALIGN - 1);
+    hdr.dataOffset = (uint32_t)pos;
+    for (uint16_t c = 0; c < columnCount; c++) {
+        cols[c].offset = (uint32_t)pos;
+        pos += trainingSetDtypeSize(cols[c].dtype) * rowCount;
+        pos = (pos + TRAINING_SET_ALIGN - 1) & ~(size_t)(TRAINING_SET_ALIGN - 1);
+    }
+    return pos;
+}
@@ -3,14 +3,20 @@
 #include "oink.h"
 #include "../core/config.h"
 #include "../core/wsl_bypasser.h"
+#include "../core/capture_index.h"
 #include "../ui/display.h"
+#include "../ui/network_list_view.h"
 #include "../piglet/mood.h"
 #include "../ml/inference.h"
+#include "../ml/evil_twin.h"
+#include "../ml/channel_quality.h"
+#include "../ml/norm_stats.h"
 #include <WiFi.h>
 #include <esp_wifi.h>
 #include <SPI.h>
 #include <SD.h>
 #include <algorithm>
+#include <time.h>
 
 // Spinlock for ISR synchronization
 static portMUX_TYPE oinkMux = portMUX_INITIALIZER_UNLOCKED;
@@ -24,6 +30,7 @@ uint8_t OinkMode::currentChannel = 1;
 uint32_t OinkMode::lastHopTime = 0;
 uint32_t OinkMode::lastScanTime = 0;
 std::vector<DetectedNetwork> OinkMode::networks;
+std::vector<uint16_t> OinkMode::priorityOrder;
 std::vector<CapturedHandshake> OinkMode::handshakes;
 int OinkMode::targetIndex = -1;
 uint8_t OinkMode::targetBssid[6] = {0};
@@ -71,7 +78,11 @@ void OinkMode::init() {
     }
     
     networks.clear();
+    priorityOrder.clear();
+    NetworkListView::reset();
     handshakes.clear();
+    EvilTwinIndex::clear();
+    ChannelQuality::reset();
     targetIndex = -1;
     memset(targetBssid, 0, 6);
     selectionIndex = 0;
@@ -327,13 +338,7 @@ void OinkMode::update() {
     
     // Periodic network cleanup - remove stale entries
     if (now - lastScanTime > 30000) {
-        for (auto it = networks.begin(); it != networks.end();) {
-            if (now - it->lastSeen > 60000) {
-                it = networks.erase(it);
-            } else {
-                ++it;
-            }
-        }
+        removeStaleNetworks(now);
         // Revalidate targetIndex after cleanup using stored BSSID
         if (targetIndex >= 0) {
             targetIndex = findNetwork(targetBssid);
@@ -404,22 +409,22 @@ DetectedNetwork* OinkMode::getTarget() {
     return nullptr;
 }
 
+int OinkMode::getSelectionIndex() {
+    return NetworkListView::getSelected();
+}
+
 void OinkMode::moveSelectionUp() {
-    if (networks.empty()) return;
-    selectionIndex--;
-    if (selectionIndex < 0) selectionIndex = networks.size() - 1;
+    NetworkListView::moveUp();
 }
 
 void OinkMode::moveSelectionDown() {
-    if (networks.empty()) return;
-    selectionIndex++;
-    if (selectionIndex >= (int)networks.size()) selectionIndex = 0;
+    NetworkListView::moveDown();
 }
 
 void OinkMode::confirmSelection() {
-    if (networks.empty()) return;
-    if (selectionIndex >= 0 && selectionIndex < (int)networks.size()) {
-        selectTarget(selectionIndex);
+    int index = NetworkListView::getSelected();
+    if (index >= 0 && index < (int)networks.size()) {
+        selectTarget(index);
     }
 }
 
@@ -458,6 +463,7 @@ void IRAM_ATTR OinkMode::promiscuousCallback(void* buf, wifi_promiscuous_pkt_typ
     wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf;
     uint16_t len = pkt->rx_ctrl.sig_len;
     int8_t rssi = pkt->rx_ctrl.rssi;
+    int8_t noise = pkt->rx_ctrl.noise_floor;
     
     // ESP32 adds 4 ghost bytes to sig_len
     if (len > 4) len -= 4;
@@ -469,11 +475,18 @@ void IRAM_ATTR OinkMode::promiscuousCallback(void* buf, wifi_promiscuous_pkt_typ
     packetCount++;
     portEXIT_CRITICAL_ISR(&oinkMux);
     
+    uint8_t channel = pkt->rx_ctrl.channel ? pkt->rx_ctrl.channel : currentChannel;
+    ChannelQuality::recordFrame(channel, rssi, noise, pkt->rx_ctrl.rate, pkt->rx_ctrl.sig_mode);
+    
     const uint8_t* payload = pkt->payload;
     uint8_t frameSubtype = (payload[0] >> 4) & 0x0F;
     
     switch (type) {
         case WIFI_PKT_MGMT:
+            if (frameSubtype == 0x08 || frameSubtype == 0x05) {
+                // Beacon / probe response: addr3 is the BSSID
+                if (len >= 36) ChannelQuality::recordBSSID(payload + 16, rssi, noise);
+            }
             if (frameSubtype == 0x08) {  // Beacon
                 processBeacon(payload, len, rssi);
             } else if (frameSubtype == 0x05) {  // Probe Response
@@ -562,7 +575,8 @@ void OinkMode::processBeacon(const uint8_t* payload, uint16_t len, int8_t rssi)
         net.hasHandshake = hasHandshakeFor(bssid);
         
         // Extract features for ML
-        net.features = FeatureExtractor::extractFromBeacon(payload, len, rssi);
+        net.features = FeatureExtractor::extractFromBeacon(payload, len, rssi,
+                                                           ChannelQuality::getNoise(currentChannel));
         
         // Get channel from DS Parameter Set IE
         offset = 36;
@@ -615,6 +629,16 @@ void OinkMode::processBeacon(const uint8_t* payload, uint16_t len, int8_t rssi)
             net.channel = currentChannel;
         }
         
+        // Known SSID from a new BSSID with different security/vendor/channel?
+        if (!net.isHidden) {
+            checkEvilTwin(net);
+        }
+        
+        // After the twin check, so the twin_score column sees real values.
+        // Once per network: hidden ones are counted here too, with no twin
+        // score, since many are never revealed
+        NormStats::observe(net.features);
+        
         networks.push_back(net);
         Mood::onNewNetwork(net.ssid, net.rssi, net.channel);
         
@@ -627,6 +651,12 @@ void OinkMode::processBeacon(const uint8_t* payload, uint16_t len, int8_t rssi)
         networks[idx].lastSeen = millis();
         networks[idx].beaconCount++;
         networks[idx].hasPMF = hasPMF;  // Update PMF status
+        
+        // Keep the signal features current for re-classification
+        WiFiFeatures& f = networks[idx].features;
+        f.rssi = rssi;
+        f.noise = ChannelQuality::getNoise(networks[idx].channel);
+        f.snr = ChannelQuality::getBSSIDSNR(bssid, (float)(rssi - f.noise));
     }
 }
 
@@ -655,6 +685,8 @@ void OinkMode::processProbeResponse(const uint8_t* payload, uint16_t len, int8_t
                 
                 Serial.printf("[OINK] Hidden SSID revealed: %s\n", networks[idx].ssid);
                 Mood::onNewNetwork(networks[idx].ssid, rssi, networks[idx].channel);
+                // Already observed once from its beacon; not counted again
+                checkEvilTwin(networks[idx]);
                 break;
             }
             
@@ -884,7 +916,8 @@ void OinkMode::autoSaveCheck() {
                 SD.mkdir("/handshakes");
             }
             
-            if (saveHandshakePCAP(hs, filename)) {
+            CaptureRecord rec;
+            if (saveHandshakePCAP(hs, filename, &rec)) {
                 hs.saved = true;
                 Serial.printf("[OINK] Handshake saved: %s\n", filename);
                 
@@ -898,6 +931,8 @@ void OinkMode::autoSaveCheck() {
                     txtFile.println(hs.ssid);
                     txtFile.close();
                 }
+                
+                CaptureIndex::add(rec);
             }
         }
     }
@@ -947,7 +982,7 @@ void OinkMode::writePCAPPacket(fs::File& f, const uint8_t* data, uint16_t len, u
     f.write(data, len);
 }
 
-bool OinkMode::saveHandshakePCAP(const CapturedHandshake& hs, const char* path) {
+bool OinkMode::saveHandshakePCAP(const CapturedHandshake& hs, const char* path, CaptureRecord* rec) {
     File f = SD.open(path, FILE_WRITE);
     if (!f) {
         Serial.printf("[OINK] Failed to create PCAP: %s\n", path);
@@ -957,12 +992,14 @@ bool OinkMode::saveHandshakePCAP(const CapturedHandshake& hs, const char* path)
     writePCAPHeader(f);
     
     int packetCount = 0;
+    uint8_t frameMask = 0;
     
     // Write beacon frame first (required for hashcat to crack)
     // Try per-handshake beacon first, fall back to global
     if (hs.hasBeacon()) {
         writePCAPPacket(f, hs.beaconData, hs.beaconLen, hs.firstSeen);
         packetCount++;
+        frameMask |= CAPTURE_HAS_BEACON;
         Serial.println("[OINK] Per-handshake beacon written to PCAP");
     } else if (beaconCaptured && beaconFrame && beaconFrameLen > 0) {
         // Verify global beacon is from same BSSID as handshake
@@ -970,6 +1007,7 @@ bool OinkMode::saveHandshakePCAP(const CapturedHandshake& hs, const char* path)
         if (memcmp(beaconBssid, hs.bssid, 6) == 0) {
             writePCAPPacket(f, beaconFrame, beaconFrameLen, hs.firstSeen);
             packetCount++;
+            frameMask |= CAPTURE_HAS_BEACON;
             Serial.println("[OINK] Global beacon written to PCAP");
         }
     }
@@ -1025,6 +1063,7 @@ bool OinkMode::saveHandshakePCAP(const CapturedHandshake& hs, const char* path)
         
         writePCAPPacket(f, pkt, pktLen, frame.timestamp);
         packetCount++;
+        frameMask |= 1 << i;
         Serial.printf("[OINK] EAPOL M%d written to PCAP (%d bytes)\n", i + 1, pktLen);
     }
     
@@ -1035,6 +1074,15 @@ bool OinkMode::saveHandshakePCAP(const CapturedHandshake& hs, const char* path)
                  hs.hasM3() ? "M3" : "",
                  hs.hasM4() ? "M4" : "");
     
+    if (rec) {
+        memset(rec, 0, sizeof(*rec));
+        memcpy(rec->bssid, hs.bssid, 6);
+        memcpy(rec->ssid, hs.ssid, sizeof(rec->ssid) - 1);
+        rec->frameMask = frameMask;
+        rec->fileSize = f.position();
+        rec->timestamp = (uint32_t)time(nullptr);
+    }
+    
     f.close();
     return true;
 }
@@ -1194,6 +1242,21 @@ bool OinkMode::detectPMF(const uint8_t* payload, uint16_t len) {
     return false;
 }
 
+void OinkMode::checkEvilTwin(DetectedNetwork& net) {
+    uint8_t flags = EvilTwinIndex::observe(net.ssid, net.bssid, net.channel,
+                                           EvilTwinIndex::securityFromAuthMode(net.authmode));
+    net.features.twinScore = EvilTwinIndex::score(flags);
+    
+    if (flags) {
+        Serial.printf("[OINK] Possible evil twin: %s %02X:%02X:%02X:%02X:%02X:%02X%s%s%s\n",
+                     net.ssid, net.bssid[0], net.bssid[1], net.bssid[2],
+                     net.bssid[3], net.bssid[4], net.bssid[5],
+                     (flags & TWIN_FLAG_SECURITY) ? " security" : "",
+                     (flags & TWIN_FLAG_VENDOR) ? " vendor" : "",
+                     (flags & TWIN_FLAG_CHANNEL) ? " channel" : "");
+    }
+}
+
 int OinkMode::findNetwork(const uint8_t* bssid) {
     for (int i = 0; i < (int)networks.size(); i++) {
         if (memcmp(networks[i].bssid, bssid, 6) == 0) {
@@ -1219,50 +1282,96 @@ void OinkMode::sortNetworksByPriority() {
     // 3. WPA2 without PMF + no handshake
     // 4. Networks with handshake already (skip)
     // 5. PMF protected (can't attack)
-    
-    std::sort(networks.begin(), networks.end(), [](const DetectedNetwork& a, const DetectedNetwork& b) {
-        // Calculate priority score (lower = higher priority)
-        auto getPriority = [](const DetectedNetwork& net) -> int {
-            // Already have handshake - lowest priority
-            if (net.hasHandshake) return 100;
-            // PMF protected - can't attack
-            if (net.hasPMF) return 99;
-            // Open networks - no handshake to capture
-            if (net.authmode == WIFI_AUTH_OPEN) return 98;
-            
-            int priority = 50;  // Base
-            
-            // Has clients = much higher priority (deauth more likely to work)
-            if (net.clientCount > 0) priority -= 30;
-            
-            // Auth mode priority (weaker = higher priority for cracking)
-            switch (net.authmode) {
-                case WIFI_AUTH_WEP: priority -= 15; break;   // Deprecated, easy to crack
-                case WIFI_AUTH_WPA_PSK: priority -= 10; break;  // Weak
-                case WIFI_AUTH_WPA_WPA2_PSK: priority -= 5; break;
-                case WIFI_AUTH_WPA2_PSK: priority += 0; break;  // Standard
-                case WIFI_AUTH_WPA3_PSK: priority += 10; break;  // Usually has PMF
-                default: break;
-            }
-            
-            // Fewer attack attempts = higher priority (try new ones first)
-            priority += net.attackAttempts * 5;
-            
-            // Strong signal = higher priority (more reliable)
-            if (net.rssi > -50) priority -= 5;
-            else if (net.rssi > -70) priority -= 2;
-            
-            return priority;
-        };
+    //
+    // Sorts an index array, not the table: indices held by the target,
+    // the list view and its cursor stay valid
+    
+    auto getPriority = [](const DetectedNetwork& net) -> int {
+        // Already have handshake - lowest priority
+        if (net.hasHandshake) return 100;
+        // PMF protected - can't attack
+        if (net.hasPMF) return 99;
+        // Open networks - no handshake to capture
+        if (net.authmode == WIFI_AUTH_OPEN) return 98;
+        
+        int priority = 50;  // Base
+        
+        // Has clients = much higher priority (deauth more likely to work)
+        if (net.clientCount > 0) priority -= 30;
+        
+        // Auth mode priority (weaker = higher priority for cracking)
+        switch (net.authmode) {
+            case WIFI_AUTH_WEP: priority -= 15; break;   // Deprecated, easy to crack
+            case WIFI_AUTH_WPA_PSK: priority -= 10; break;  // Weak
+            case WIFI_AUTH_WPA_WPA2_PSK: priority -= 5; break;
+            case WIFI_AUTH_WPA2_PSK: priority += 0; break;  // Standard
+            case WIFI_AUTH_WPA3_PSK: priority += 10; break;  // Usually has PMF
+            default: break;
+        }
+        
+        // Fewer attack attempts = higher priority (try new ones first)
+        priority += net.attackAttempts * 5;
         
-        return getPriority(a) < getPriority(b);
+        // Strong signal = higher priority (more reliable)
+        if (net.rssi > -50) priority -= 5;
+        else if (net.rssi > -70) priority -= 2;
+        
+        return priority;
+    };
+    
+    // Score once per network rather than twice per comparison
+    std::vector<int> score(networks.size());
+    priorityOrder.resize(networks.size());
+    for (size_t i = 0; i < networks.size(); i++) {
+        score[i] = getPriority(networks[i]);
+        priorityOrder[i] = i;
+    }
+    std::stable_sort(priorityOrder.begin(), priorityOrder.end(), [&score](uint16_t a, uint16_t b) {
+        return score[a] < score[b];
     });
 }
 
+void OinkMode::removeStaleNetworks(uint32_t now) {
+    // Compact in place and record where each survivor went, so the list
+    // view and the priority order can be remapped instead of rebuilt
+    uint16_t oldCount = networks.size();
+    std::vector<int16_t> newIndex(oldCount);
+    uint16_t kept = 0;
+    for (uint16_t i = 0; i < oldCount; i++) {
+        if (now - networks[i].lastSeen > 60000) {
+            newIndex[i] = -1;
+            continue;
+        }
+        if (kept != i) networks[kept] = networks[i];
+        newIndex[i] = kept++;
+    }
+    if (kept == oldCount) return;
+    networks.resize(kept);
+    
+    NetworkListView::remap(newIndex.data(), oldCount);
+    
+    size_t out = 0;
+    for (size_t i = 0; i < priorityOrder.size(); i++) {
+        uint16_t old = priorityOrder[i];
+        if (old < oldCount && newIndex[old] >= 0) priorityOrder[out++] = newIndex[old];
+    }
+    priorityOrder.resize(out);
+    
+    Serial.printf("[OINK] Removed %u stale networks\n", (unsigned)(oldCount - kept));
+}
+
 int OinkMode::getNextTarget() {
+    // Walk in priority order from the last scan; networks found since
+    // then come after it. They were appended, so they are exactly the
+    // indices past the end of priorityOrder.
+    auto nth = [](size_t n) -> int {
+        return n < priorityOrder.size() ? priorityOrder[n] : (int)n;
+    };
+    
     // Smart target selection with retry logic
     // First pass: networks with clients, no handshake, attackAttempts < 3
-    for (int i = 0; i < (int)networks.size(); i++) {
+    for (size_t n = 0; n < networks.size(); n++) {
+        int i = nth(n);
         if (networks[i].hasPMF) continue;
         if (networks[i].hasHandshake) continue;
         if (networks[i].authmode == WIFI_AUTH_OPEN) continue;  // Open = no handshake
@@ -1272,7 +1381,8 @@ int OinkMode::getNextTarget() {
     }
     
     // Second pass: any network without handshake, attackAttempts < 2
-    for (int i = 0; i < (int)networks.size(); i++) {
+    for (size_t n = 0; n < networks.size(); n++) {
+        int i = nth(n);
         if (networks[i].hasPMF) continue;
         if (networks[i].hasHandshake) continue;
         if (networks[i].authmode == WIFI_AUTH_OPEN) continue;
@@ -1282,7 +1392,8 @@ int OinkMode::getNextTarget() {
     }
     
     // Third pass: retry networks with clients even if attempted before
-    for (int i = 0; i < (int)networks.size(); i++) {
+    for (size_t n = 0; n < networks.size(); n++) {
+        int i = nth(n);
         if (networks[i].hasPMF) continue;
         if (networks[i].hasHandshake) continue;
         if (networks[i].authmode == WIFI_AUTH_OPEN) continue;
@@ -7,6 +7,8 @@
 #include <FS.h>
 #include "../ml/features.h"
 
+struct CaptureRecord;
+
 // Maximum clients to track per network
 #define MAX_CLIENTS_PER_NETWORK 8
 
@@ -88,7 +90,9 @@ public:
     // Handshake capture
     static const std::vector<CapturedHandshake>& getHandshakes() { return handshakes; }
     static uint16_t getCompleteHandshakeCount();
-    static bool saveHandshakePCAP(const CapturedHandshake& hs, const char* path);
+    // rec (optional) is filled with what was written, for the capture index
+    static bool saveHandshakePCAP(const CapturedHandshake& hs, const char* path,
+                                  CaptureRecord* rec = nullptr);
     static bool saveAllHandshakes();
     static void autoSaveCheck();
     
@@ -102,8 +106,8 @@ public:
     static uint32_t getDeauthCount() { return deauthCount; }
     static uint16_t getNetworkCount() { return networks.size(); }
     
-    // Network selection cursor
-    static int getSelectionIndex() { return selectionIndex; }
+    // Network selection cursor (NetworkListView's, by network index)
+    static int getSelectionIndex();
     static void moveSelectionUp();
     static void moveSelectionDown();
     static void confirmSelection();
@@ -117,11 +121,14 @@ private:
     static uint32_t lastHopTime;
     static uint32_t lastScanTime;
     
+    // Indices are stable: entries are only ever appended or compacted by
+    // the stale cleanup (which remaps every index it hands out)
     static std::vector<DetectedNetwork> networks;
+    static std::vector<uint16_t> priorityOrder;  // Attack order from the last scan
     static std::vector<CapturedHandshake> handshakes;
     static int targetIndex;
     static uint8_t targetBssid[6];  // Store BSSID to handle index invalidation
-    static int selectionIndex;  // Cursor for network selection
+    static int selectionIndex;  // Auto-attack's current pick
     static uint32_t packetCount;
     static uint32_t deauthCount;
     
@@ -146,8 +153,10 @@ private:
     static bool detectPMF(const uint8_t* payload, uint16_t len);
 
     static int findNetwork(const uint8_t* bssid);
+    static void checkEvilTwin(DetectedNetwork& net);
     static int findOrCreateHandshake(const uint8_t* bssid, const uint8_t* station);
     static void sortNetworksByPriority();
+    static void removeStaleNetworks(uint32_t now);
     static bool hasHandshakeFor(const uint8_t* bssid);
     static int getNextTarget();  // Smart target selection
     static void writePCAPHeader(fs::File& f);
@@ -6,6 +6,10 @@
 #include "../piglet/mood.h"
 #include "../ml/features.h"
 #include "../ml/inference.h"
+#include "../ml/evil_twin.h"
+#include "../ml/norm_stats.h"
+#include "../ml/training_set.h"
+#include "../gps/gps_scheduler.h"
 #include <WiFi.h>
 #include <SPI.h>
 #include <SD.h>
@@ -28,6 +32,7 @@ String WarhogMode::currentFilename = "";
 
 void WarhogMode::init() {
     entries.clear();
+    EvilTwinIndex::clear();
     newCount = 0;
     totalNetworks = 0;
     openNetworks = 0;
@@ -61,6 +66,7 @@ void WarhogMode::start() {
     
     // Wake up GPS
     GPS::wake();
+    GPSScheduler::start();
     
     running = true;
     lastScanTime = 0;  // Trigger immediate scan
@@ -77,6 +83,7 @@ void WarhogMode::stop() {
     Serial.println("[WARHOG] Stopping...");
     
     running = false;
+    GPSScheduler::stop();
     
     // Put GPS to sleep if power management enabled
     if (Config::gps().powerSave) {
@@ -110,6 +117,10 @@ void WarhogMode::update() {
         WiFi.scanDelete();
     }
     
+    // Speed decides how often we scan and how long we dwell per channel
+    GPSScheduler::update();
+    scanInterval = GPSScheduler::getScanIntervalMs();
+    
     // Periodic scanning - only start new scan if not already scanning
     if (now - lastScanTime >= scanInterval && scanResult != WIFI_SCAN_RUNNING) {
         performScan();
@@ -128,8 +139,8 @@ bool WarhogMode::isScanComplete() {
 void WarhogMode::performScan() {
     Serial.println("[WARHOG] Starting WiFi scan...");
     
-    // Start async scan
-    int result = WiFi.scanNetworks(true, true);  // async=true, hidden=true
+    // Start async scan - dwell shrinks at speed so the scan stays spatially tight
+    int result = WiFi.scanNetworks(true, true, false, GPSScheduler::getDwellMs());  // async, hidden, active
     
     if (result == WIFI_SCAN_RUNNING) {
         // Will check completion in update()
@@ -201,6 +212,10 @@ void WarhogMode::processScanResults() {
             memcpy(apRecord.ssid, entry.ssid, 33);
             apRecord.phy_11n = true;  // Assume 11n capable
             entry.features = FeatureExtractor::extractFromScan(&apRecord);
+            entry.features.twinScore = EvilTwinIndex::score(
+                EvilTwinIndex::observe(entry.ssid, bssid, entry.channel,
+                                       EvilTwinIndex::securityFromAuthMode(entry.authmode)));
+            NormStats::observe(entry.features);
             
             if (hasGPS) {
                 entry.latitude = gps.latitude;
@@ -503,6 +518,53 @@ String WarhogMode::generateFilename(const char* ext) {
     return String(buf);
 }
 
+// Staging buffer for the binary ML export: SD writes go out in 4 KB
+// blocks instead of one small write per value. Static - too big for the
+// loop task's stack.
+static uint8_t mlExportBuf[4096];
+static size_t mlExportLen = 0;
+static size_t mlExportPos = 0;      // Bytes written to the file so far
+static bool mlExportOk = true;
+
+static void mlExportFlush(File& f) {
+    if (mlExportLen > 0 && f.write(mlExportBuf, mlExportLen) != mlExportLen) {
+        mlExportOk = false;
+    }
+    mlExportLen = 0;
+}
+
+static void mlExportPut(File& f, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    mlExportPos += len;
+    while (len > 0) {
+        size_t n = min(len, sizeof(mlExportBuf) - mlExportLen);
+        memcpy(mlExportBuf + mlExportLen, p, n);
+        mlExportLen += n;
+        p += n;
+        len -= n;
+        if (mlExportLen == sizeof(mlExportBuf)) mlExportFlush(f);
+    }
+}
+
+// Zero-fill up to the next column block
+static void mlExportPadTo(File& f, uint32_t offset) {
+    static const uint8_t zeros[TRAINING_SET_ALIGN] = {0};
+    while (mlExportPos < offset) {
+        mlExportPut(f, zeros, min((size_t)(offset - mlExportPos), sizeof(zeros)));
+    }
+}
+
+// Unbuffered write at a fixed file offset (staging buffer must be empty)
+static void mlExportWriteAt(File& f, uint32_t offset, const void* data, size_t len) {
+    if (!f.seek(offset) || f.write((const uint8_t*)data, len) != len) mlExportOk = false;
+}
+
+// Feature vectors are built once per network and transposed into one
+// block per column, a block of rows at a time. The whole n x 32 matrix
+// would be another 256 KB at MAX_ENTRIES.
+#define ML_EXPORT_BLOCK_ROWS 64
+static float mlExportBlock[TRAINING_SET_FEATURES][ML_EXPORT_BLOCK_ROWS];
+
 bool WarhogMode::exportMLTraining(const char* path) {
     File f = SD.open(path, FILE_WRITE);
     if (!f) {
@@ -510,41 +572,95 @@ bool WarhogMode::exportMLTraining(const char* path) {
         return false;
     }
     
-    // CSV header - all 32 feature vector values + label + metadata
-    f.print("bssid,ssid,");
-    f.print("rssi,noise,snr,channel,secondary_ch,beacon_interval,");
-    f.print("capability_lo,capability_hi,has_wps,has_wpa,has_wpa2,has_wpa3,");
-    f.print("is_hidden,response_time,beacon_count,beacon_jitter,");
-    f.print("responds_probe,probe_response_time,vendor_ie_count,");
-    f.print("supported_rates,ht_cap,vht_cap,anomaly_score,");
-    f.print("f23,f24,f25,f26,f27,f28,f29,f30,f31,");  // Reserved features
-    f.println("label,latitude,longitude");
+    uint32_t startMs = millis();
+    uint32_t rows = entries.size();
     
+    // PCTS columnar set (ml/training_set.h): all 32 feature vector values
+    // as float32 columns, then label + metadata
+    const uint16_t colCount = TRAINING_SET_FEATURES + 6;
+    static TrainingSetColumn cols[TRAINING_SET_FEATURES + 6];
+    for (int c = 0; c < TRAINING_SET_FEATURES; c++) {
+        trainingSetColumn(cols[c], TRAINING_FEATURE_NAMES[c], "<f4");
+    }
+    trainingSetColumn(cols[TRAINING_SET_FEATURES + 0], "label", "<i4");
+    trainingSetColumn(cols[TRAINING_SET_FEATURES + 1], "bssid", "<u8");
+    trainingSetColumn(cols[TRAINING_SET_FEATURES + 2], "ssid", "S32");
+    trainingSetColumn(cols[TRAINING_SET_FEATURES + 3], "latitude", "<f8");
+    trainingSetColumn(cols[TRAINING_SET_FEATURES + 4], "longitude", "<f8");
+    trainingSetColumn(cols[TRAINING_SET_FEATURES + 5], "timestamp", "<u4");
+    
+    TrainingSetHeader hdr;
+    size_t fileSize = trainingSetLayout(hdr, cols, colCount, rows, "warhog");
+    
+    mlExportLen = 0;
+    mlExportPos = 0;
+    mlExportOk = true;
+    mlExportPut(f, &hdr, sizeof(hdr));
+    mlExportPut(f, cols, sizeof(TrainingSetColumn) * colCount);
+    
+    // Feature columns: each block lands at its row range in every column.
+    // Column tails are zero-filled explicitly; FAT leaves the gaps a seek
+    // past EOF creates undefined.
+    mlExportPadTo(f, cols[0].offset);
+    mlExportFlush(f);
     float featureVec[FEATURE_VECTOR_SIZE];
+    for (uint32_t r0 = 0; r0 < rows; r0 += ML_EXPORT_BLOCK_ROWS) {
+        uint32_t n = min(rows - r0, (uint32_t)ML_EXPORT_BLOCK_ROWS);
+        for (uint32_t i = 0; i < n; i++) {
+            FeatureExtractor::toFeatureVector(entries[r0 + i].features, featureVec);
+            for (int c = 0; c < TRAINING_SET_FEATURES; c++) mlExportBlock[c][i] = featureVec[c];
+        }
+        for (int c = 0; c < TRAINING_SET_FEATURES; c++) {
+            mlExportWriteAt(f, cols[c].offset + r0 * sizeof(float), mlExportBlock[c], n * sizeof(float));
+        }
+    }
+    static const uint8_t zeros[TRAINING_SET_ALIGN] = {0};
+    for (int c = 0; c < TRAINING_SET_FEATURES; c++) {
+        uint32_t end = cols[c].offset + rows * sizeof(float);
+        if (cols[c + 1].offset > end) mlExportWriteAt(f, end, zeros, cols[c + 1].offset - end);
+    }
+    mlExportPos = cols[TRAINING_SET_FEATURES + 0].offset;
+    if (!f.seek(mlExportPos)) mlExportOk = false;
     
     for (const auto& e : entries) {
-        // BSSID
-        f.printf("%02X:%02X:%02X:%02X:%02X:%02X,",
-                e.bssid[0], e.bssid[1], e.bssid[2],
-                e.bssid[3], e.bssid[4], e.bssid[5]);
-        
-        // SSID (escaped)
-        writeCSVField(f, e.ssid);
-        f.print(",");
-        
-        // Convert features to vector
-        FeatureExtractor::toFeatureVector(e.features, featureVec);
-        
-        // Write all 32 feature values
-        for (int i = 0; i < FEATURE_VECTOR_SIZE; i++) {
-            f.printf("%.4f,", featureVec[i]);
-        }
-        
-        // Label and GPS
-        f.printf("%d,%.6f,%.6f\n", e.label, e.latitude, e.longitude);
+        int32_t label = e.label;
+        mlExportPut(f, &label, sizeof(label));
+    }
+    
+    mlExportPadTo(f, cols[TRAINING_SET_FEATURES + 1].offset);
+    for (const auto& e : entries) {
+        uint64_t bssid = 0;
+        for (int i = 0; i < 6; i++) bssid = (bssid << 8) | e.bssid[i];
+        mlExportPut(f, &bssid, sizeof(bssid));
     }
     
+    mlExportPadTo(f, cols[TRAINING_SET_FEATURES + 2].offset);
+    for (const auto& e : entries) {
+        char ssid[32] = {0};
+        memcpy(ssid, e.ssid, strnlen(e.ssid, sizeof(ssid)));
+        mlExportPut(f, ssid, sizeof(ssid));
+    }
+    
+    mlExportPadTo(f, cols[TRAINING_SET_FEATURES + 3].offset);
+    for (const auto& e : entries) mlExportPut(f, &e.latitude, sizeof(double));
+    
+    mlExportPadTo(f, cols[TRAINING_SET_FEATURES + 4].offset);
+    for (const auto& e : entries) mlExportPut(f, &e.longitude, sizeof(double));
+    
+    mlExportPadTo(f, cols[TRAINING_SET_FEATURES + 5].offset);
+    for (const auto& e : entries) mlExportPut(f, &e.timestamp, sizeof(uint32_t));
+    
+    mlExportPadTo(f, fileSize);
+    mlExportFlush(f);
     f.close();
-    Serial.printf("[WARHOG] ML training export: %d entries to %s\n", entries.size(), path);
+    
+    if (!mlExportOk || mlExportPos != fileSize) {
+        Serial.printf("[WARHOG] ML export write failed: %s\n", path);
+        SD.remove(path);
+        return false;
+    }
+    
+    Serial.printf("[WARHOG] ML training export: %u entries, %u bytes to %s in %lu ms\n",
+                  rows, (unsigned)fileSize, path, millis() - startMs);
     return true;
 }
@@ -43,7 +43,7 @@ public:
     static bool exportCSV(const char* path);
     static bool exportKismet(const char* path);
     static bool exportWigle(const char* path);
-    static bool exportMLTraining(const char* path);  // ML feature vectors for training
+    static bool exportMLTraining(const char* path);  // ML feature vectors, PCTS columnar (.pcts)
     
     // GPS
     static bool hasGPSFix();
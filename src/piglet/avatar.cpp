@@ -2,6 +2,7 @@
 
 #include "avatar.h"
 #include "../ui/display.h"
+#include "../ui/glyph_atlas.h"
 
 // Static members
 AvatarState Avatar::currentState = AvatarState::NEUTRAL;
@@ -114,6 +115,71 @@ const char* AVATAR_BLINK_R[] = {
     "(    )"
 };
 
+// Frame table: state * 2 + facing right, BLINK after the AvatarState values
+#define AVATAR_FRAMES 16
+#define AVATAR_BLINK_INDEX 7
+
+static const char** const FRAMES[AVATAR_FRAMES] = {
+    AVATAR_NEUTRAL_L, AVATAR_NEUTRAL_R,
+    AVATAR_HAPPY_L,   AVATAR_HAPPY_R,
+    AVATAR_EXCITED_L, AVATAR_EXCITED_R,
+    AVATAR_HUNTING_L, AVATAR_HUNTING_R,
+    AVATAR_SLEEPY_L,  AVATAR_SLEEPY_R,
+    AVATAR_SAD_L,     AVATAR_SAD_R,
+    AVATAR_ANGRY_L,   AVATAR_ANGRY_R,
+    AVATAR_BLINK_L,   AVATAR_BLINK_R
+};
+
+// Frame geometry: 3 lines of 6 chars at text size 3
+#define AVATAR_X 2
+#define AVATAR_Y 5
+#define AVATAR_LINE_H 22
+#define AVATAR_W 108
+#define AVATAR_H (2 * AVATAR_LINE_H + 24)
+#define AVATAR_ROW_BYTES 14
+
+// 1-bit atlas: every frame row is an index into a pool of unique rows.
+// Size-3 glyphs repeat each font row 3 times and most rows are shared
+// between states, so 16 frames fit in a few KB instead of 15.
+#define AVATAR_POOL_ROWS 255
+
+static uint8_t rowPool[AVATAR_POOL_ROWS][AVATAR_ROW_BYTES];
+static uint8_t rowPoolCount = 0;
+static uint8_t frameRows[AVATAR_FRAMES][AVATAR_H];
+static bool atlasReady = false;
+
+void Avatar::buildAtlas() {
+    uint8_t mask[AVATAR_H * AVATAR_ROW_BYTES];
+    rowPoolCount = 0;
+    
+    for (uint8_t f = 0; f < AVATAR_FRAMES; f++) {
+        if (!GlyphAtlas::rasterize(FRAMES[f], 3, 3, AVATAR_LINE_H, mask,
+                                   AVATAR_ROW_BYTES * 8, AVATAR_H, AVATAR_ROW_BYTES)) {
+            Serial.println("[AVATAR] No memory to rasterize frames, using drawString");
+            return;
+        }
+        
+        for (uint8_t r = 0; r < AVATAR_H; r++) {
+            const uint8_t* row = mask + r * AVATAR_ROW_BYTES;
+            uint8_t idx = 0;
+            while (idx < rowPoolCount && memcmp(rowPool[idx], row, AVATAR_ROW_BYTES) != 0) idx++;
+            if (idx == rowPoolCount) {
+                if (rowPoolCount >= AVATAR_POOL_ROWS) {
+                    Serial.println("[AVATAR] Atlas row pool full, using drawString");
+                    return;
+                }
+                memcpy(rowPool[rowPoolCount++], row, AVATAR_ROW_BYTES);
+            }
+            frameRows[f][r] = idx;
+        }
+    }
+    atlasReady = true;
+    
+    Serial.printf("[AVATAR] Atlas ready: %u frames, %u unique rows, %u bytes\n",
+                  (unsigned)AVATAR_FRAMES, (unsigned)rowPoolCount,
+                  (unsigned)(rowPoolCount * AVATAR_ROW_BYTES + sizeof(frameRows)));
+}
+
 void Avatar::init() {
     currentState = AvatarState::NEUTRAL;
     isBlinking = false;
@@ -125,6 +191,8 @@ void Avatar::init() {
     facingRight = false;
     lastFlipTime = millis();
     flipInterval = random(3000, 10000);
+    
+    if (!atlasReady) buildAtlas();
 }
 
 void Avatar::setState(AvatarState state) {
@@ -157,31 +225,38 @@ void Avatar::draw(M5Canvas& canvas) {
     }
     
     // Select frame based on state and direction
-    const char** frame;
+    uint8_t index;
     
     if (isBlinking && currentState != AvatarState::SLEEPY) {
-        frame = facingRight ? AVATAR_BLINK_R : AVATAR_BLINK_L;
+        index = AVATAR_BLINK_INDEX;
         isBlinking = false;
     } else {
-        switch (currentState) {
-            case AvatarState::HAPPY:    
-                frame = facingRight ? AVATAR_HAPPY_R : AVATAR_HAPPY_L; break;
-            case AvatarState::EXCITED:  
-                frame = facingRight ? AVATAR_EXCITED_R : AVATAR_EXCITED_L; break;
-            case AvatarState::HUNTING:  
-                frame = facingRight ? AVATAR_HUNTING_R : AVATAR_HUNTING_L; break;
-            case AvatarState::SLEEPY:   
-                frame = facingRight ? AVATAR_SLEEPY_R : AVATAR_SLEEPY_L; break;
-            case AvatarState::SAD:      
-                frame = facingRight ? AVATAR_SAD_R : AVATAR_SAD_L; break;
-            case AvatarState::ANGRY:    
-                frame = facingRight ? AVATAR_ANGRY_R : AVATAR_ANGRY_L; break;
-            default:                    
-                frame = facingRight ? AVATAR_NEUTRAL_R : AVATAR_NEUTRAL_L; break;
-        }
+        index = (uint8_t)currentState;
+        if (index > (uint8_t)AvatarState::ANGRY) index = (uint8_t)AvatarState::NEUTRAL;
     }
+    index = index * 2 + (facingRight ? 1 : 0);
     
-    drawFrame(canvas, frame, 3);
+    if (atlasReady && GlyphAtlas::isEnabled()) {
+        drawAtlasFrame(canvas, index);
+    } else {
+        drawFrame(canvas, FRAMES[index], 3);
+    }
+}
+
+void Avatar::drawAtlasFrame(M5Canvas& canvas, uint8_t index) {
+    // Consecutive rows are usually the same pool row: expand it once,
+    // then memcpy the finished canvas row down
+    const uint8_t* rows = frameRows[index];
+    for (uint8_t r = 0; r < AVATAR_H; r++) {
+        int16_t y = AVATAR_Y + r;
+        if (r > 0 && rows[r] == rows[r - 1]) {
+            GlyphAtlas::copyRow(canvas, AVATAR_X, y - 1, y, AVATAR_W);
+        } else if (!GlyphAtlas::blitRow(canvas, AVATAR_X, y, rowPool[rows[r]], AVATAR_W,
+                                        COLOR_ACCENT, COLOR_BG)) {
+            drawFrame(canvas, FRAMES[index], 3);
+            return;
+        }
+    }
 }
 
 void Avatar::drawFrame(M5Canvas& canvas, const char** frame, uint8_t lines) {
@@ -189,11 +264,7 @@ void Avatar::drawFrame(M5Canvas& canvas, const char** frame, uint8_t lines) {
     canvas.setTextSize(3);
     canvas.setTextColor(COLOR_ACCENT);
     
-    int startX = 2;
-    int startY = 5;
-    int lineHeight = 22;
-    
     for (uint8_t i = 0; i < lines; i++) {
-        canvas.drawString(frame[i], startX, startY + i * lineHeight);
+        canvas.drawString(frame[i], AVATAR_X, AVATAR_Y + i * AVATAR_LINE_H);
     }
 }
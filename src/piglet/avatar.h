@@ -30,6 +30,8 @@ private:
     static uint32_t lastBlinkTime;
     static uint32_t blinkInterval;
     
+    static void buildAtlas();       // Pre-render all frames once at boot
+    static void drawAtlasFrame(M5Canvas& canvas, uint8_t index);
     static void drawFrame(M5Canvas& canvas, const char** frame, uint8_t lines);
 };
 
@@ -1,8 +1,10 @@
 // Piglet mood implementation
 
 #include "mood.h"
+#include "../core/fixed_string.h"
 #include "../core/config.h"
 #include "../ui/display.h"
+#include "../ui/glyph_atlas.h"
 
 // Static members
 String Mood::currentPhrase = "OINK!";
@@ -318,11 +320,12 @@ void Mood::updateAvatarState() {
 
 void Mood::draw(M5Canvas& canvas) {
     // Calculate bubble size based on message length
-    String phrase = currentPhrase;
-    int maxCharsPerLine = 14;  // Slightly less chars for padding
+    const char* phrase = currentPhrase.c_str();
+    size_t phraseLen = currentPhrase.length();
+    size_t maxCharsPerLine = 14;  // Slightly less chars for padding
     int numLines = 1;
-    if (phrase.length() > maxCharsPerLine) numLines = 2;
-    if (phrase.length() > maxCharsPerLine * 2) numLines = 3;
+    if (phraseLen > maxCharsPerLine) numLines = 2;
+    if (phraseLen > maxCharsPerLine * 2) numLines = 3;
     
     int bubbleX = 125;  // Moved left to prevent overflow
     int bubbleY = 3;
@@ -336,33 +339,34 @@ void Mood::draw(M5Canvas& canvas) {
     canvas.fillRoundRect(bubbleX, bubbleY, bubbleW, bubbleH, 6, COLOR_FG);
     
     // Draw < arrow pointing to piglet (filled triangle would be better but text works)
-    canvas.setTextSize(1);
-    canvas.setTextColor(COLOR_FG);
-    canvas.drawString("<", bubbleX - 6, bubbleY + bubbleH / 2 - 4);
-    
-    // Draw phrase inside bubble with word wrapping - BLACK text on pink
-    canvas.setTextDatum(top_left);
-    canvas.setTextColor(COLOR_BG);  // Black text
+    GlyphAtlas::drawText(canvas, bubbleX - 6, bubbleY + bubbleH / 2 - 4, "<", COLOR_FG, COLOR_BG);
     
+    // Draw phrase inside bubble with word wrapping - BLACK text on pink,
+    // blitted from the pre-rasterized glyphs
     int textX = bubbleX + 6;
     int textY = bubbleY + 6;
     int lineHeight = 12;
     
-    // Word wrap logic
-    String remaining = phrase;
+    // Word wrap in place: each line is a slice of the phrase copied into
+    // a stack buffer, no String temporaries per frame
+    const char* remaining = phrase;
+    size_t remainingLen = phraseLen;
     int lineNum = 0;
-    while (remaining.length() > 0 && lineNum < 4) {
-        String line;
-        if (remaining.length() <= maxCharsPerLine) {
-            line = remaining;
-            remaining = "";
+    while (remainingLen > 0 && lineNum < 4) {
+        FixedString<32> line;
+        if (remainingLen <= maxCharsPerLine) {
+            line.append(remaining, remainingLen);
+            remainingLen = 0;
         } else {
-            int splitPos = remaining.lastIndexOf(' ', maxCharsPerLine);
-            if (splitPos <= 0) splitPos = maxCharsPerLine;
-            line = remaining.substring(0, splitPos);
-            remaining = remaining.substring(splitPos + 1);
+            // Last space at or before the line limit
+            size_t splitPos = maxCharsPerLine;
+            while (splitPos > 0 && remaining[splitPos] != ' ') splitPos--;
+            if (splitPos == 0) splitPos = maxCharsPerLine;
+            line.append(remaining, splitPos);
+            remaining += splitPos + 1;
+            remainingLen -= splitPos + 1;
         }
-        canvas.drawString(line, textX, textY + lineNum * lineHeight);
+        GlyphAtlas::drawText(canvas, textX, textY + lineNum * lineHeight, line, COLOR_BG, COLOR_FG);
         lineNum++;
     }
 }
@@ -4,17 +4,22 @@
 #include <M5Cardputer.h>
 #include <SD.h>
 #include <time.h>
+#include <algorithm>
 #include "display.h"
 
 // Static member initialization
-std::vector<CaptureInfo> CapturesMenu::captures;
-uint8_t CapturesMenu::selectedIndex = 0;
-uint8_t CapturesMenu::scrollOffset = 0;
+CaptureRecord CapturesMenu::page[CapturesMenu::VISIBLE_ITEMS];
+uint32_t CapturesMenu::pageStart = 0;
+uint8_t CapturesMenu::pageCount = 0;
+uint32_t CapturesMenu::total = 0;
+uint32_t CapturesMenu::selectedIndex = 0;
+uint32_t CapturesMenu::scrollOffset = 0;
 bool CapturesMenu::active = false;
 bool CapturesMenu::keyWasPressed = false;
 
 void CapturesMenu::init() {
-    captures.clear();
+    total = 0;
+    pageCount = 0;
     selectedIndex = 0;
     scrollOffset = 0;
 }
@@ -24,75 +29,44 @@ void CapturesMenu::show() {
     selectedIndex = 0;
     scrollOffset = 0;
     keyWasPressed = true;  // Ignore the Enter that selected us from menu
-    scanCaptures();
+    openIndex();
 }
 
 void CapturesMenu::hide() {
     active = false;
 }
 
-void CapturesMenu::scanCaptures() {
-    captures.clear();
-    
-    if (!SD.exists("/handshakes")) {
-        Serial.println("[CAPTURES] No handshakes directory");
-        return;
-    }
-    
-    File dir = SD.open("/handshakes");
-    if (!dir || !dir.isDirectory()) {
-        Serial.println("[CAPTURES] Failed to open handshakes directory");
-        return;
-    }
-    
-    File file = dir.openNextFile();
-    while (file) {
-        String name = file.name();
-        if (name.endsWith(".pcap")) {
-            CaptureInfo info;
-            info.filename = name;
-            info.fileSize = file.size();
-            info.captureTime = file.getLastWrite();
-            
-            // Extract BSSID from filename (e.g., "64EEB7208286.pcap")
-            String baseName = name.substring(0, name.indexOf('.'));
-            if (baseName.length() >= 12) {
-                info.bssid = baseName.substring(0, 2) + ":" +
-                             baseName.substring(2, 4) + ":" +
-                             baseName.substring(4, 6) + ":" +
-                             baseName.substring(6, 8) + ":" +
-                             baseName.substring(8, 10) + ":" +
-                             baseName.substring(10, 12);
-            } else {
-                info.bssid = baseName;
-            }
-            
-            // Try to get SSID from companion .txt file if exists
-            String txtPath = "/handshakes/" + baseName + ".txt";
-            if (SD.exists(txtPath)) {
-                File txtFile = SD.open(txtPath, FILE_READ);
-                if (txtFile) {
-                    info.ssid = txtFile.readStringUntil('\n');
-                    info.ssid.trim();
-                    txtFile.close();
-                }
-            }
-            if (info.ssid.isEmpty()) {
-                info.ssid = "[unknown]";
-            }
-            
-            captures.push_back(info);
-        }
-        file = dir.openNextFile();
+void CapturesMenu::openIndex() {
+    // The index is kept current at capture time; only a missing or
+    // outdated one costs a directory walk
+    if (!CaptureIndex::isValid() && SD.exists("/handshakes")) {
+        Display::showProgress("Indexing captures...", 50);
+        CaptureIndex::rebuild();
     }
-    dir.close();
-    
-    // Sort by capture time (newest first)
-    std::sort(captures.begin(), captures.end(), [](const CaptureInfo& a, const CaptureInfo& b) {
-        return a.captureTime > b.captureTime;
-    });
+    total = CaptureIndex::count();
+    if (selectedIndex >= total) selectedIndex = total ? total - 1 : 0;
+    if (scrollOffset > selectedIndex) scrollOffset = selectedIndex;
+    loadPage();
     
-    Serial.printf("[CAPTURES] Found %d captures\n", captures.size());
+    Serial.printf("[CAPTURES] %lu captures indexed\n", (unsigned long)total);
+}
+
+void CapturesMenu::loadPage() {
+    // Rows [scrollOffset, scrollOffset + n) are the n records ending at
+    // (total - scrollOffset): one contiguous read, reversed
+    pageStart = scrollOffset;
+    pageCount = 0;
+    if (scrollOffset >= total) return;
+    
+    uint32_t n = min((uint32_t)VISIBLE_ITEMS, total - scrollOffset);
+    uint32_t first = total - scrollOffset - n;
+    pageCount = CaptureIndex::read(first, page, n);
+    std::reverse(page, page + pageCount);
+}
+
+const CaptureRecord* CapturesMenu::rowRecord(uint32_t row) {
+    if (row < pageStart || row >= pageStart + pageCount) return nullptr;
+    return &page[row - pageStart];
 }
 
 void CapturesMenu::update() {
@@ -112,6 +86,7 @@ void CapturesMenu::handleInput() {
     keyWasPressed = true;
     
     auto keys = M5Cardputer.Keyboard.keysState();
+    uint32_t oldScroll = scrollOffset;
     
     // Navigation with ; (up) and . (down)
     if (M5Cardputer.Keyboard.isKeyPressed(';')) {
@@ -124,7 +99,7 @@ void CapturesMenu::handleInput() {
     }
     
     if (M5Cardputer.Keyboard.isKeyPressed('.')) {
-        if (selectedIndex < captures.size() - 1) {
+        if (selectedIndex + 1 < total) {
             selectedIndex++;
             if (selectedIndex >= scrollOffset + VISIBLE_ITEMS) {
                 scrollOffset = selectedIndex - VISIBLE_ITEMS + 1;
@@ -132,22 +107,31 @@ void CapturesMenu::handleInput() {
         }
     }
     
+    if (scrollOffset != oldScroll) {
+        loadPage();
+    }
+    
+    // R to rebuild the index after editing the card elsewhere
+    if (M5Cardputer.Keyboard.isKeyPressed('r') || M5Cardputer.Keyboard.isKeyPressed('R')) {
+        CaptureIndex::invalidate();
+        openIndex();
+    }
+    
     // Exit with backtick or Enter
     if (keys.enter || M5Cardputer.Keyboard.isKeyPressed('`')) {
         hide();
     }
 }
 
-String CapturesMenu::formatTime(time_t t) {
-    if (t == 0) return "Unknown";
-    
-    struct tm* timeinfo = localtime(&t);
-    if (!timeinfo) return "Unknown";
+void CapturesMenu::formatTime(time_t t, char* buf, size_t len) {
+    struct tm timeinfo;
+    if (t == 0 || !localtime_r(&t, &timeinfo)) {
+        snprintf(buf, len, "Unknown");
+        return;
+    }
     
-    char buf[32];
     // Format: "Dec 06 14:32"
-    strftime(buf, sizeof(buf), "%b %d %H:%M", timeinfo);
-    return String(buf);
+    strftime(buf, len, "%b %d %H:%M", &timeinfo);
 }
 
 void CapturesMenu::draw(M5Canvas& canvas) {
@@ -159,12 +143,12 @@ void CapturesMenu::draw(M5Canvas& canvas) {
     canvas.setTextColor(COLOR_FG);
     canvas.setTextSize(1);
     canvas.setCursor(4, 2);
-    canvas.printf("CAPTURES (%d)", captures.size());
+    canvas.printf("CAPTURES (%lu)", (unsigned long)total);
     
     // Divider line
     canvas.drawFastHLine(0, 12, canvas.width(), COLOR_FG);
     
-    if (captures.empty()) {
+    if (total == 0) {
         canvas.setCursor(4, 50);
         canvas.print("No captures found");
         canvas.setCursor(4, 65);
@@ -176,8 +160,9 @@ void CapturesMenu::draw(M5Canvas& canvas) {
     int y = 16;
     int lineHeight = 18;
     
-    for (uint8_t i = scrollOffset; i < captures.size() && i < scrollOffset + VISIBLE_ITEMS; i++) {
-        const CaptureInfo& cap = captures[i];
+    for (uint32_t i = scrollOffset; i < total && i < scrollOffset + VISIBLE_ITEMS; i++) {
+        const CaptureRecord* cap = rowRecord(i);
+        if (!cap) break;
         
         // Highlight selected
         if (i == selectedIndex) {
@@ -189,19 +174,25 @@ void CapturesMenu::draw(M5Canvas& canvas) {
         
         // SSID (truncated if needed)
         canvas.setCursor(4, y);
-        String displaySSID = cap.ssid;
-        if (displaySSID.length() > 14) {
-            displaySSID = displaySSID.substring(0, 12) + "..";
+        FixedString<16> displaySSID;
+        if (cap->ssid[0] == 0) {
+            displaySSID = "[unknown]";
+        } else if (strlen(cap->ssid) > 14) {
+            displaySSID.append(cap->ssid, 12).append("..");
+        } else {
+            displaySSID = cap->ssid;
         }
-        canvas.print(displaySSID);
+        canvas.print(displaySSID.c_str());
         
         // Date/time
+        char timeBuf[32];
+        formatTime(cap->timestamp, timeBuf, sizeof(timeBuf));
         canvas.setCursor(95, y);
-        canvas.print(formatTime(cap.captureTime));
+        canvas.print(timeBuf);
         
         // File size (KB)
         canvas.setCursor(170, y);
-        canvas.printf("%dK", cap.fileSize / 1024);
+        canvas.printf("%luK", (unsigned long)(cap->fileSize / 1024));
         
         y += lineHeight;
     }
@@ -212,17 +203,25 @@ void CapturesMenu::draw(M5Canvas& canvas) {
         canvas.setTextColor(COLOR_FG);
         canvas.print("^");
     }
-    if (scrollOffset + VISIBLE_ITEMS < captures.size()) {
+    if (scrollOffset + VISIBLE_ITEMS < total) {
         canvas.setCursor(canvas.width() - 10, 16 + (VISIBLE_ITEMS - 1) * lineHeight);
         canvas.setTextColor(COLOR_FG);
         canvas.print("v");
     }
     
-    // Footer with BSSID of selected
-    if (selectedIndex < captures.size()) {
+    // Footer with BSSID and captured frames of selected
+    const CaptureRecord* sel = rowRecord(selectedIndex);
+    if (sel) {
         canvas.drawFastHLine(0, canvas.height() - 14, canvas.width(), COLOR_FG);
         canvas.setTextColor(COLOR_FG);
         canvas.setCursor(4, canvas.height() - 11);
-        canvas.print(captures[selectedIndex].bssid);
+        canvas.printf("%02X:%02X:%02X:%02X:%02X:%02X  %s%s%s%s%s",
+                      sel->bssid[0], sel->bssid[1], sel->bssid[2],
+                      sel->bssid[3], sel->bssid[4], sel->bssid[5],
+                      (sel->frameMask & CAPTURE_HAS_M1) ? "M1 " : "",
+                      (sel->frameMask & CAPTURE_HAS_M2) ? "M2 " : "",
+                      (sel->frameMask & CAPTURE_HAS_M3) ? "M3 " : "",
+                      (sel->frameMask & CAPTURE_HAS_M4) ? "M4 " : "",
+                      (sel->frameMask & CAPTURE_HAS_BEACON) ? "B" : "");
     }
 }
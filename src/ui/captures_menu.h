@@ -3,15 +3,7 @@
 
 #include <Arduino.h>
 #include <M5Unified.h>
-#include <vector>
-
-struct CaptureInfo {
-    String filename;
-    String ssid;
-    String bssid;
-    uint32_t fileSize;
-    time_t captureTime;  // File modification time
-};
+#include "../core/capture_index.h"
 
 class CapturesMenu {
 public:
@@ -23,16 +15,22 @@ public:
     static bool isActive() { return active; }
     
 private:
-    static std::vector<CaptureInfo> captures;
-    static uint8_t selectedIndex;
-    static uint8_t scrollOffset;
+    // Rows are newest first: row r is index record (total - 1 - r).
+    // Only the visible page is held in RAM.
+    static CaptureRecord page[];
+    static uint32_t pageStart;      // Row of page[0]
+    static uint8_t pageCount;
+    static uint32_t total;
+    static uint32_t selectedIndex;
+    static uint32_t scrollOffset;
     static bool active;
     static bool keyWasPressed;
     
     static const uint8_t VISIBLE_ITEMS = 5;
     
-    static void scanCaptures();
+    static void openIndex();
+    static void loadPage();
+    static const CaptureRecord* rowRecord(uint32_t row);
     static void handleInput();
-    static String formatTime(time_t t);
-    static String extractSSID(const String& filename);
+    static void formatTime(time_t t, char* buf, size_t len);
 };
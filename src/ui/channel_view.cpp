@@ -0,0 +1,75 @@
+// Channel quality screen implementation
+
+#include "channel_view.h"
+#include "display.h"
+#include "../ml/channel_quality.h"
+#include "../modes/oink.h"
+#include "../core/fixed_string.h"
+
+bool ChannelView::visible = false;
+
+void ChannelView::draw(M5Canvas& canvas) {
+    canvas.fillSprite(COLOR_BG);
+    canvas.setTextColor(COLOR_FG);
+    canvas.setTextSize(1);
+    canvas.setTextDatum(top_left);
+    
+    uint8_t current = OinkMode::getChannel();
+    
+    canvas.setCursor(4, 2);
+    canvas.print("CHANNEL QUALITY");
+    canvas.setCursor(DISPLAY_W - 60, 2);
+    canvas.print("[C] back");
+    canvas.drawFastHLine(0, 12, canvas.width(), COLOR_FG);
+    
+    int x0 = (DISPLAY_W - CHANNELS_SHOWN * COL_W) / 2;
+    int labelY = BAR_TOP + BAR_H + 2;
+    
+    canvas.setTextDatum(top_center);
+    for (uint8_t ch = 1; ch <= CHANNELS_SHOWN; ch++) {
+        ChannelQualityInfo info = ChannelQuality::getChannel(ch);
+        int x = x0 + (ch - 1) * COL_W;
+        int cx = x + COL_W / 2;
+        
+        // SNR bar
+        if (info.frames > 0) {
+            int h = (int)info.snr;
+            if (h < 1) h = 1;
+            if (h > BAR_H) h = BAR_H;
+            canvas.fillRect(x + 3, BAR_TOP + BAR_H - h, COL_W - 6, h, COLOR_FG);
+        } else {
+            canvas.drawFastHLine(x + 3, BAR_TOP + BAR_H - 1, COL_W - 6, COLOR_FG);
+        }
+        
+        // Channel number, inverted for the one we're listening on
+        if (ch == current) {
+            canvas.fillRect(x + 1, labelY - 1, COL_W - 2, 10, COLOR_FG);
+            canvas.setTextColor(COLOR_BG);
+        }
+        FixedString<4> label;
+        label.format("%u", (unsigned)ch);
+        canvas.drawString(label.c_str(), cx, labelY);
+        canvas.setTextColor(COLOR_FG);
+        
+        // Noise floor, without the minus sign to fit the column
+        if (info.frames > 0) {
+            FixedString<6> noise;
+            noise.format("%d", -info.noise);
+            canvas.drawString(noise.c_str(), cx, labelY + 11);
+        } else {
+            canvas.drawString("--", cx, labelY + 11);
+        }
+    }
+    
+    // Detail line for the current channel
+    ChannelQualityInfo cur = ChannelQuality::getChannel(current);
+    canvas.setTextDatum(top_left);
+    canvas.drawFastHLine(0, canvas.height() - 12, canvas.width(), COLOR_FG);
+    canvas.setCursor(4, canvas.height() - 10);
+    if (cur.frames > 0) {
+        canvas.printf("CH%d NF%ddBm SNR%.0fdB HT%d%% %luf",
+                      current, cur.noise, cur.snr, cur.htPercent, (unsigned long)cur.frames);
+    } else {
+        canvas.printf("CH%d no frames yet", current);
+    }
+}
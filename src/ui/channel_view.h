@@ -0,0 +1,21 @@
+// Channel quality screen - per-channel noise floor / SNR while in OINK mode
+#pragma once
+
+#include <Arduino.h>
+#include <M5Unified.h>
+
+class ChannelView {
+public:
+    static void toggle() { visible = !visible; }
+    static void hide() { visible = false; }
+    static bool isVisible() { return visible; }
+    static void draw(M5Canvas& canvas);
+    
+private:
+    static bool visible;
+    
+    static const uint8_t CHANNELS_SHOWN = 13;   // 14 is Japan-only
+    static const uint8_t COL_W = 18;
+    static const uint8_t BAR_TOP = 15;
+    static const uint8_t BAR_H = 56;            // 1px per dB of SNR
+};
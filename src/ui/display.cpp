@@ -2,17 +2,23 @@
 
 #include "display.h"
 #include <M5Cardputer.h>
+#include <esp_heap_caps.h>
 #include "../core/porkchop.h"
 #include "../core/config.h"
+#include "../core/heap_stats.h"
 #include "../piglet/mood.h"
 #include "../piglet/avatar.h"
 #include "../modes/oink.h"
 #include "../modes/warhog.h"
 #include "../gps/gps.h"
 #include "../web/fileserver.h"
+#include "glyph_atlas.h"
 #include "menu.h"
 #include "settings_menu.h"
 #include "captures_menu.h"
+#include "channel_view.h"
+#include "network_list_view.h"
+#include "ml_stats_view.h"
 
 // Static member initialization
 M5Canvas Display::topBar(&M5.Display);
@@ -22,8 +28,59 @@ bool Display::gpsStatus = false;
 bool Display::wifiStatus = false;
 bool Display::mlStatus = false;
 
+// Widgets of each sprite. A region is re-sent over SPI only when its
+// pixels hash differently from what was last pushed.
+static const DisplayRegion TOP_REGIONS[] = {
+    {0, 0, 90, TOP_BAR_H},          // Mode
+    {90, 0, 60, TOP_BAR_H},         // Clock
+    {150, 0, 66, TOP_BAR_H},        // Battery
+    {216, 0, 24, TOP_BAR_H},        // Status letters
+};
+static const DisplayRegion MAIN_REGIONS[] = {
+    {0, 0, 120, 36},                // Avatar (left half, three bands)
+    {0, 36, 120, 36},
+    {0, 72, 120, MAIN_H - 72},
+    {120, 0, 120, 36},              // Mood bubble / menu text (right half)
+    {120, 36, 120, 36},
+    {120, 72, 120, MAIN_H - 72},
+};
+static const DisplayRegion BOTTOM_REGIONS[] = {
+    {0, 0, 190, BOTTOM_BAR_H},      // Stats line
+    {190, 0, 50, BOTTOM_BAR_H},     // Uptime
+};
+#define TOP_REGION_COUNT (sizeof(TOP_REGIONS) / sizeof(TOP_REGIONS[0]))
+#define MAIN_REGION_COUNT (sizeof(MAIN_REGIONS) / sizeof(MAIN_REGIONS[0]))
+#define BOTTOM_REGION_COUNT (sizeof(BOTTOM_REGIONS) / sizeof(BOTTOM_REGIONS[0]))
+
+uint32_t Display::topHash[TOP_REGION_COUNT];
+uint32_t Display::mainHash[MAIN_REGION_COUNT];
+uint32_t Display::bottomHash[BOTTOM_REGION_COUNT];
+bool Display::panelValid = false;
+FixedString<40> Display::lastTopKey;
+FixedString<64> Display::lastBottomKey;
+uint32_t Display::pushFrames = 0;
+uint32_t Display::pushBytes = 0;
+uint32_t Display::pushFramesPerSec = 0;
+uint32_t Display::pushBytesPerSec = 0;
+uint32_t Display::pushWindowStart = 0;
+uint32_t Display::pushBlockedUs = 0;
+uint32_t Display::pushBlockedUsPerSec = 0;
+uint32_t Display::frameAllocsMax = 0;
+uint32_t Display::frameAllocsPerSec = 0;
+uint16_t* Display::dmaBuf[2] = {nullptr, nullptr};
+uint8_t Display::dmaNext = 0;
+bool Display::transferOpen = false;
+
 extern Porkchop porkchop;
 
+static size_t maxRegionPixels(const DisplayRegion* regions, size_t count) {
+    size_t most = 0;
+    for (size_t i = 0; i < count; i++) {
+        most = max(most, (size_t)regions[i].w * regions[i].h);
+    }
+    return most;
+}
+
 void Display::init() {
     M5.Display.setRotation(1);
     M5.Display.fillScreen(COLOR_BG);
@@ -38,11 +95,30 @@ void Display::init() {
     mainCanvas.setTextSize(1);
     bottomBar.setTextSize(1);
     
-    Serial.println("[DISPLAY] Initialized");
+    // Two staging buffers, each big enough for the largest region: one is
+    // filled while the other goes out over SPI DMA. Double-buffering whole
+    // sprites would cost another 65 KB with no PSRAM.
+    size_t maxRegion = max(maxRegionPixels(TOP_REGIONS, TOP_REGION_COUNT),
+                           max(maxRegionPixels(MAIN_REGIONS, MAIN_REGION_COUNT),
+                               maxRegionPixels(BOTTOM_REGIONS, BOTTOM_REGION_COUNT)));
+    dmaBuf[0] = (uint16_t*)heap_caps_malloc(maxRegion * 2, MALLOC_CAP_DMA);
+    dmaBuf[1] = (uint16_t*)heap_caps_malloc(maxRegion * 2, MALLOC_CAP_DMA);
+    if (!dmaBuf[0] || !dmaBuf[1]) {
+        free(dmaBuf[0]);
+        free(dmaBuf[1]);
+        dmaBuf[0] = dmaBuf[1] = nullptr;
+        Serial.println("[DISPLAY] No DMA staging memory, using blocking pushes");
+    }
+    
+    Serial.printf("[DISPLAY] Initialized (%s pushes, %u B staging)\n",
+                  dmaBuf[0] ? "DMA" : "blocking", dmaBuf[0] ? (unsigned)(maxRegion * 4) : 0);
+    
+    GlyphAtlas::init();
 }
 
 void Display::update() {
-    drawTopBar();
+    uint32_t allocsBefore = HeapStats::getAllocCount();
+    bool topChanged = drawTopBar();
     
     // Draw main content based on mode
     mainCanvas.fillSprite(COLOR_BG);
@@ -52,12 +128,25 @@ void Display::update() {
     
     switch (mode) {
         case PorkchopMode::IDLE:
+            if (MLStatsView::isVisible()) {
+                MLStatsView::draw(mainCanvas);
+                break;
+            }
             // Draw piglet avatar and mood
             Avatar::draw(mainCanvas);
             Mood::draw(mainCanvas);
             break;
             
         case PorkchopMode::OINK_MODE:
+            if (ChannelView::isVisible()) {
+                ChannelView::draw(mainCanvas);
+                break;
+            }
+            if (NetworkListView::isVisible()) {
+                NetworkListView::draw(mainCanvas);
+                break;
+            }
+            // Fall through
         case PorkchopMode::WARHOG_MODE:
             // Draw piglet avatar and mood bubble (info embedded in bubble)
             Avatar::draw(mainCanvas);
@@ -88,8 +177,174 @@ void Display::update() {
             break;
     }
     
-    drawBottomBar();
+    bool bottomChanged = drawBottomBar();
+    
+    // Main content is drawn by many screens, so it's re-rendered every
+    // frame and diffed; the bars are only re-rendered when their text moves
+    uint32_t t0 = micros();
+    waitTransfer();     // Fence: last frame's DMA done, bus free
+    
+    uint32_t bytes = 0;
+    M5.Display.startWrite();
+    transferOpen = true;
+    if (topChanged || !panelValid) {
+        bytes += pushChanged(topBar, 0, TOP_REGIONS, TOP_REGION_COUNT, topHash);
+    }
+    bytes += pushChanged(mainCanvas, TOP_BAR_H, MAIN_REGIONS, MAIN_REGION_COUNT, mainHash);
+    if (bottomChanged || !panelValid) {
+        bytes += pushChanged(bottomBar, DISPLAY_H - BOTTOM_BAR_H, BOTTOM_REGIONS, BOTTOM_REGION_COUNT,
+                             bottomHash);
+    }
+    panelValid = true;
+    
+    // The last region is still in flight; it finishes while the rest of
+    // the loop runs and is fenced by the next update()/pushAll()
+    if (bytes == 0 || !dmaBuf[0]) {
+        M5.Display.endWrite();
+        transferOpen = false;
+    }
+    pushBlockedUs += micros() - t0;
+    
+    uint32_t allocs = HeapStats::getAllocCount() - allocsBefore;
+    if (allocs > frameAllocsMax) frameAllocsMax = allocs;
+    
+    if (bytes > 0) {
+        pushFrames++;
+        pushBytes += bytes;
+    }
+    
+    uint32_t now = millis();
+    if (now - pushWindowStart >= 1000) {
+        pushFramesPerSec = pushFrames;
+        pushBytesPerSec = pushBytes;
+        pushBlockedUsPerSec = pushBlockedUs;
+        frameAllocsPerSec = frameAllocsMax;
+        frameAllocsMax = 0;
+        HeapStats::sample();
+        pushFrames = 0;
+        pushBytes = 0;
+        pushBlockedUs = 0;
+        pushWindowStart = now;
+#ifdef DEBUG_MODE
+        static uint8_t logTick = 0;
+        if (++logTick >= 10) {
+            logTick = 0;
+            Serial.printf("[DISPLAY] %lu frames/s, %lu bytes/s pushed, loop blocked %lu us/s\n",
+                          (unsigned long)pushFramesPerSec, (unsigned long)pushBytesPerSec,
+                          (unsigned long)pushBlockedUsPerSec);
+            if (HeapStats::isHooked()) {
+                Serial.printf("[DISPLAY] Heap allocs/frame max %lu, largest free block %u (min %u)\n",
+                              (unsigned long)frameAllocsPerSec, (unsigned)HeapStats::getLargestFreeBlock(),
+                              (unsigned)HeapStats::getMinLargestFreeBlock());
+            }
+        }
+#endif
+    }
+}
+
+// FNV-1a over the region's RGB565 pixels
+static uint32_t hashRegion(M5Canvas& canvas, const DisplayRegion& r) {
+    const uint16_t* buf = (const uint16_t*)canvas.getBuffer();
+    int32_t stride = canvas.width();
+    uint32_t h = 2166136261UL;
+    for (int16_t y = r.y; y < r.y + r.h; y++) {
+        const uint16_t* row = buf + (int32_t)y * stride + r.x;
+        for (int16_t x = 0; x < r.w; x++) {
+            h = (h ^ row[x]) * 16777619UL;
+        }
+    }
+    return h;
+}
+
+uint32_t Display::pushChanged(M5Canvas& canvas, int16_t screenY, const DisplayRegion* regions,
+                              uint8_t count, uint32_t* hashes) {
+    uint32_t bytes = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        const DisplayRegion& r = regions[i];
+        uint32_t h = hashRegion(canvas, r);
+        if (panelValid && h == hashes[i]) continue;
+        hashes[i] = h;
+        bytes += (uint32_t)r.w * r.h * 2;
+        
+        if (!dmaBuf[0]) {
+            // Clipped blocking push: only the region's window goes over SPI
+            M5.Display.setClipRect(r.x, screenY + r.y, r.w, r.h);
+            canvas.pushSprite(0, screenY);
+            M5.Display.clearClipRect();
+            continue;
+        }
+        
+        // Copy while the previous region (in the other buffer) is still
+        // transferring. Starting this transfer waits for that one, so at
+        // most one buffer is ever in flight.
+        uint16_t* buf = dmaBuf[dmaNext];
+        dmaNext ^= 1;
+        const uint16_t* src = (const uint16_t*)canvas.getBuffer() + (int32_t)r.y * canvas.width() + r.x;
+        for (int16_t y = 0; y < r.h; y++) {
+            memcpy(buf + (int32_t)y * r.w, src + (int32_t)y * canvas.width(), r.w * 2);
+        }
+        // Sprite memory is already in panel byte order
+        M5.Display.pushImageDMA(r.x, screenY + r.y, r.w, r.h, (const lgfx::swap565_t*)buf);
+    }
+    return bytes;
+}
+
+void Display::waitTransfer() {
+    if (!transferOpen) return;
+    M5.Display.waitDMA();
+    M5.Display.endWrite();
+    transferOpen = false;
+}
+
+void Display::benchmarkPush() {
+    // Old path: whole frame, blocking
+    uint32_t t0 = micros();
     pushAll();
+    uint32_t blockingUs = micros() - t0;
+    
+    // Region path with every region dirty: time on the loop vs in flight
+    invalidate();
+    t0 = micros();
+    M5.Display.startWrite();
+    transferOpen = true;
+    uint32_t bytes = pushChanged(topBar, 0, TOP_REGIONS, TOP_REGION_COUNT, topHash);
+    bytes += pushChanged(mainCanvas, TOP_BAR_H, MAIN_REGIONS, MAIN_REGION_COUNT, mainHash);
+    bytes += pushChanged(bottomBar, DISPLAY_H - BOTTOM_BAR_H, BOTTOM_REGIONS, BOTTOM_REGION_COUNT, bottomHash);
+    uint32_t loopUs = micros() - t0;
+    waitTransfer();
+    uint32_t totalUs = micros() - t0;
+    panelValid = true;
+    
+    Serial.printf("[DISPLAY] Full frame %lu B: blocking %lu us, %s %lu us on the loop (%lu us until done)\n",
+                  (unsigned long)bytes, (unsigned long)blockingUs, dmaBuf[0] ? "DMA" : "clipped",
+                  (unsigned long)loopUs, (unsigned long)totalUs);
+}
+
+void Display::benchmarkPiglet() {
+    // Same frame both ways: avatar + bubble through the font rasterizer,
+    // then through the atlases
+    const uint8_t runs = 50;
+    uint32_t us[2];
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        GlyphAtlas::setEnabled(pass == 1);
+        uint32_t t0 = micros();
+        for (uint8_t i = 0; i < runs; i++) {
+            mainCanvas.fillSprite(COLOR_BG);
+            Avatar::draw(mainCanvas);
+            Mood::draw(mainCanvas);
+        }
+        us[pass] = (micros() - t0) / runs;
+    }
+    GlyphAtlas::setEnabled(true);
+    
+    Serial.printf("[DISPLAY] Piglet frame render: font %lu us, atlas %lu us\n",
+                  (unsigned long)us[0], (unsigned long)us[1]);
+}
+
+void Display::invalidate() {
+    panelValid = false;
+    lastTopKey.clear();
+    lastBottomKey.clear();
 }
 
 void Display::clear() {
@@ -100,21 +355,21 @@ void Display::clear() {
 }
 
 void Display::pushAll() {
+    waitTransfer();
     M5.Display.startWrite();
     topBar.pushSprite(0, 0);
     mainCanvas.pushSprite(0, TOP_BAR_H);
     bottomBar.pushSprite(0, DISPLAY_H - BOTTOM_BAR_H);
     M5.Display.endWrite();
+    
+    // Dialogs draw over the bars' sprites; repaint everything next update
+    invalidate();
 }
 
-void Display::drawTopBar() {
-    topBar.fillSprite(COLOR_BG);
-    topBar.setTextColor(COLOR_FG);
-    topBar.setTextSize(1);
-    
+bool Display::drawTopBar() {
     // Left side: mode indicator
     PorkchopMode mode = porkchop.getMode();
-    String modeStr;
+    const char* modeStr = "";
     uint16_t modeColor = COLOR_FG;
     
     switch (mode) {
@@ -142,44 +397,44 @@ void Display::drawTopBar() {
             modeStr = "XFER";
             modeColor = COLOR_SUCCESS;
             break;
+        default:
+            break;
     }
     
+    // Center: clock (from GPS or --:--)
+    char timeStr[8] = "--:--";
+    if (GPS::hasFix()) GPS::formatTime(timeStr, sizeof(timeStr));
+    
+    // Right side: battery percentage + status icons
+    FixedString<16> rightStr;
+    rightStr.format("%d%% %c%c%c", M5.Power.getBatteryLevel(),
+                    gpsStatus ? 'G' : '-', wifiStatus ? 'W' : '-', mlStatus ? 'M' : '-');
+    
+    FixedString<40> key;
+    key.format("%s|%s|%s", modeStr, timeStr, rightStr.c_str());
+    if (key == lastTopKey) return false;
+    lastTopKey = key;
+    
+    topBar.fillSprite(COLOR_BG);
+    topBar.setTextSize(1);
+    
     topBar.setTextColor(modeColor);
     topBar.setTextDatum(top_left);
     topBar.drawString(modeStr, 2, 2);
     
-    // Center: clock (from GPS or --:--)
     topBar.setTextDatum(top_center);
     topBar.setTextColor(COLOR_FG);
-    String timeStr = GPS::hasFix() ? GPS::getTimeString() : "--:--";
     topBar.drawString(timeStr, DISPLAY_W / 2, 2);
     
-    // Right side: battery + status icons
-    topBar.setTextDatum(top_right);
-    
-    // Battery percentage
-    int battLevel = M5.Power.getBatteryLevel();
-    String battStr = String(battLevel) + "%";
-    
-    // Status icons
-    String status = "";
-    status += gpsStatus ? "G" : "-";
-    status += wifiStatus ? "W" : "-";
-    status += mlStatus ? "M" : "-";
-    
     // Draw battery then status
-    String rightStr = battStr + " " + status;
+    topBar.setTextDatum(top_right);
     topBar.drawString(rightStr, DISPLAY_W - 2, 2);
+    return true;
 }
 
-void Display::drawBottomBar() {
-    bottomBar.fillSprite(COLOR_BG);
-    bottomBar.setTextColor(COLOR_ACCENT);  // Use accent color for stats
-    bottomBar.setTextSize(1);
-    bottomBar.setTextDatum(top_left);
-    
+bool Display::drawBottomBar() {
     PorkchopMode mode = porkchop.getMode();
-    String stats;
+    FixedString<48> stats;
     
     if (mode == PorkchopMode::WARHOG_MODE) {
         // WARHOG: show unique networks, saved records, and GPS coords
@@ -189,31 +444,37 @@ void Display::drawBottomBar() {
         
         if (GPS::hasFix()) {
             // Show coords with satellite count: "U:5 S:3 [42.36,-71.05]"
-            char buf[64];
-            snprintf(buf, sizeof(buf), "U:%lu S:%lu [%.2f,%.2f] S:%d", 
-                     unique, saved, gps.latitude, gps.longitude, gps.satellites);
-            stats = String(buf);
+            stats.format("U:%lu S:%lu [%.2f,%.2f] S:%d",
+                         (unsigned long)unique, (unsigned long)saved, gps.latitude, gps.longitude, gps.satellites);
         } else {
             // No fix - show satellite count searching
-            stats = "U:" + String(unique) + " S:" + String(saved) + " GPS:" + String(gps.satellites) + "sat";
+            stats.format("U:%lu S:%lu GPS:%dsat", (unsigned long)unique, (unsigned long)saved, gps.satellites);
         }
     } else {
         // Default: Networks, Handshakes, Deauths
-        uint16_t netCount = porkchop.getNetworkCount();
-        uint16_t hsCount = porkchop.getHandshakeCount();
-        uint16_t deauthCount = porkchop.getDeauthCount();
-        stats = "N:" + String(netCount) + " HS:" + String(hsCount) + " D:" + String(deauthCount);
+        stats.format("N:%u HS:%u D:%u", porkchop.getNetworkCount(), porkchop.getHandshakeCount(),
+                     porkchop.getDeauthCount());
     }
     
+    // Right: uptime
+    uint32_t uptime = porkchop.getUptime();
+    FixedString<12> uptimeStr;
+    uptimeStr.format("%u:%02u", (unsigned)(uint16_t)(uptime / 60), (unsigned)(uptime % 60));
+    
+    FixedString<64> key;
+    key.format("%s|%s", stats.c_str(), uptimeStr.c_str());
+    if (key == lastBottomKey) return false;
+    lastBottomKey = key;
+    
+    bottomBar.fillSprite(COLOR_BG);
+    bottomBar.setTextColor(COLOR_ACCENT);  // Use accent color for stats
+    bottomBar.setTextSize(1);
+    bottomBar.setTextDatum(top_left);
     bottomBar.drawString(stats, 2, 3);
     
-    // Right: uptime
     bottomBar.setTextDatum(top_right);
-    uint32_t uptime = porkchop.getUptime();
-    uint16_t mins = uptime / 60;
-    uint16_t secs = uptime % 60;
-    String uptimeStr = String(mins) + ":" + (secs < 10 ? "0" : "") + String(secs);
     bottomBar.drawString(uptimeStr, DISPLAY_W - 2, 3);
+    return true;
 }
 
 void Display::showInfoBox(const String& title, const String& line1, 
@@ -295,6 +556,8 @@ bool Display::showConfirmBox(const String& title, const String& message) {
 
 // Boot splash - 3 screens: OINK OINK, MY NAME IS, PORKCHOP
 void Display::showBootSplash() {
+    waitTransfer();
+    
     // Screen 1: OINK OINK
     M5.Display.fillScreen(COLOR_BG);
     M5.Display.setTextColor(COLOR_FG);
@@ -322,6 +585,7 @@ void Display::showBootSplash() {
     M5.Display.drawString("BETA", DISPLAY_W / 2, DISPLAY_H / 2 + 35);
     
     delay(1200);
+    invalidate();   // Drawn straight to the panel, sprites are stale
 }
 
 
@@ -345,7 +609,9 @@ void Display::showProgress(const String& title, uint8_t percent) {
     
     // Percentage text
     mainCanvas.setTextSize(1);
-    mainCanvas.drawString(String(percent) + "%", DISPLAY_W / 2, barY + barH + 10);
+    FixedString<8> pct;
+    pct.format("%u%%", percent);
+    mainCanvas.drawString(pct, DISPLAY_W / 2, barY + barH + 10);
     
     pushAll();
 }
@@ -376,11 +642,11 @@ void Display::drawModeInfo(M5Canvas& canvas, PorkchopMode mode) {
         // Show current target being attacked (like M5Gotchi)
         if (target) {
             canvas.setTextColor(COLOR_SUCCESS);
-            String ssid = String(target->ssid);
-            if (ssid.length() == 0) ssid = "<hidden>";
+            FixedString<17> ssid;
+            ssid.append(target->ssid[0] ? target->ssid : "<hidden>", 16);
             canvas.drawString("ATTACKING:", 2, 2);
             canvas.setTextColor(COLOR_ACCENT);
-            canvas.drawString(ssid.substring(0, 16), 2, 14);
+            canvas.drawString(ssid, 2, 14);
             
             char info[32];
             snprintf(info, sizeof(info), "CH%d %ddB", target->channel, target->rssi);
@@ -475,7 +741,9 @@ void Display::drawFileTransferScreen(M5Canvas& canvas) {
         canvas.drawString("Connected! Browse to:", DISPLAY_W / 2, 30);
         
         canvas.setTextColor(COLOR_SUCCESS);
-        String url = "http://" + FileServer::getIP();
+        IPAddress ip = WiFi.localIP();
+        FixedString<24> url;
+        url.format("http://%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
         canvas.drawString(url, DISPLAY_W / 2, 45);
         
         canvas.setTextColor(COLOR_FG);
@@ -488,10 +756,12 @@ void Display::drawFileTransferScreen(M5Canvas& canvas) {
     } else {
         // Not running - check why
         canvas.setTextColor(COLOR_ACCENT);
-        String ssid = Config::wifi().otaSSID;
+        const String& ssid = Config::wifi().otaSSID;
         if (ssid.length() > 0) {
             canvas.drawString("Connection failed", DISPLAY_W / 2, 35);
-            canvas.drawString("SSID: " + ssid, DISPLAY_W / 2, 50);
+            FixedString<40> ssidLine("SSID: ");
+            ssidLine.append(ssid.c_str());
+            canvas.drawString(ssidLine, DISPLAY_W / 2, 50);
             canvas.setTextColor(COLOR_FG);
             canvas.drawString(FileServer::getStatus(), DISPLAY_W / 2, 65);
         } else {
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <M5Unified.h>
+#include "../core/fixed_string.h"
 
 // Forward declarations
 enum class PorkchopMode : uint8_t;
@@ -21,6 +22,14 @@ enum class PorkchopMode : uint8_t;
 #define COLOR_DANGER COLOR_FG   // Pink only
 #define COLOR_SUCCESS COLOR_FG  // Pink only
 
+// Rectangle inside one of the three sprites, tracked for partial pushes
+struct DisplayRegion {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+};
+
 class Display {
 public:
     static void init();
@@ -34,6 +43,10 @@ public:
     
     // Helper functions
     static void pushAll();
+    static void invalidate();       // Next update() pushes every region
+    static void waitTransfer();     // Fence: finish in-flight DMA, release the panel bus
+    static void benchmarkPush();    // Log blocking vs DMA full-frame cost
+    static void benchmarkPiglet();  // Log avatar + bubble render time, font vs atlas
     static void showBootSplash();  // 3-screen boot animation
     static void showInfoBox(const String& title, const String& line1, 
                            const String& line2 = "", bool blocking = true);
@@ -45,6 +58,12 @@ public:
     static void setWiFiStatus(bool connected);
     static void setMLStatus(bool active);
     
+    // SPI traffic over the last full second
+    static uint32_t getPushedFramesPerSec() { return pushFramesPerSec; }
+    static uint32_t getPushedBytesPerSec() { return pushBytesPerSec; }
+    static uint32_t getPushBlockedUsPerSec() { return pushBlockedUsPerSec; }  // Loop time spent pushing
+    static uint32_t getFrameAllocs() { return frameAllocsPerSec; }  // Worst frame last second (HEAP_ALLOC_HOOK builds)
+    
 private:
     static M5Canvas topBar;
     static M5Canvas mainCanvas;
@@ -54,8 +73,35 @@ private:
     static bool wifiStatus;
     static bool mlStatus;
     
-    static void drawTopBar();
-    static void drawBottomBar();
+    // Per-region pixel hashes of what's currently on the panel
+    static uint32_t topHash[];
+    static uint32_t mainHash[];
+    static uint32_t bottomHash[];
+    static bool panelValid;
+    static FixedString<40> lastTopKey;      // Bar contents last rendered
+    static FixedString<64> lastBottomKey;
+    
+    static uint32_t pushFrames;
+    static uint32_t pushBytes;
+    static uint32_t pushFramesPerSec;
+    static uint32_t pushBytesPerSec;
+    static uint32_t pushWindowStart;
+    static uint32_t pushBlockedUs;
+    static uint32_t pushBlockedUsPerSec;
+    static uint32_t frameAllocsMax;
+    static uint32_t frameAllocsPerSec;
+    
+    // Region staging buffers for async transfers (nullptr = blocking pushes).
+    // The panel sits on its own SPI host; SD uses the Arduino SPI instance,
+    // so an open DMA transaction doesn't stall card access.
+    static uint16_t* dmaBuf[2];
+    static uint8_t dmaNext;
+    static bool transferOpen;       // startWrite() held across loop()
+    
+    static bool drawTopBar();       // false if nothing changed
+    static bool drawBottomBar();
+    static uint32_t pushChanged(M5Canvas& canvas, int16_t screenY, const DisplayRegion* regions,
+                                uint8_t count, uint32_t* hashes);
     static void drawModeInfo(M5Canvas& canvas, PorkchopMode mode);
     static void drawSettingsScreen(M5Canvas& canvas);
     static void drawAboutScreen(M5Canvas& canvas);
@@ -0,0 +1,142 @@
+// Pre-rasterized 1-bit glyphs and row blitter implementation
+
+#include "glyph_atlas.h"
+
+#define GLYPH_COUNT (GLYPH_LAST - GLYPH_FIRST + 1)
+
+uint8_t GlyphAtlas::glyphs[GLYPH_COUNT][GLYPH_H];
+bool GlyphAtlas::ready = false;
+bool GlyphAtlas::enabled = true;
+
+// Sprite memory holds RGB565 byte-swapped (panel order)
+static inline uint16_t toRaw(uint16_t color) {
+    return (uint16_t)((color >> 8) | (color << 8));
+}
+
+void GlyphAtlas::init() {
+    if (ready) return;
+
+    // Whole printable range in one pass: one line, one temporary sprite
+    char line[GLYPH_COUNT + 1];
+    for (uint8_t i = 0; i < GLYPH_COUNT; i++) {
+        line[i] = (char)(GLYPH_FIRST + i);
+    }
+    line[GLYPH_COUNT] = 0;
+
+    const uint16_t stride = (GLYPH_COUNT * GLYPH_W + 7) / 8;
+    uint8_t mask[stride * GLYPH_H];
+    const char* lines[] = { line };
+    if (!rasterize(lines, 1, 1, GLYPH_H, mask, stride * 8, GLYPH_H, stride)) {
+        Serial.println("[GLYPH] No memory to rasterize font, using drawString");
+        return;
+    }
+
+    for (uint8_t g = 0; g < GLYPH_COUNT; g++) {
+        for (uint8_t row = 0; row < GLYPH_H; row++) {
+            const uint8_t* src = mask + row * stride;
+            uint8_t bits = 0;
+            for (uint8_t b = 0; b < GLYPH_W; b++) {
+                uint16_t bit = g * GLYPH_W + b;
+                if (src[bit >> 3] & (0x80 >> (bit & 7))) bits |= 0x80 >> b;
+            }
+            glyphs[g][row] = bits;
+        }
+    }
+    ready = true;
+
+    Serial.printf("[GLYPH] Atlas ready: %u glyphs, %u bytes\n",
+                  (unsigned)GLYPH_COUNT, (unsigned)sizeof(glyphs));
+}
+
+bool GlyphAtlas::rasterize(const char* const* lines, uint8_t lineCount, uint8_t textSize,
+                           int16_t lineHeight, uint8_t* mask, int16_t w, int16_t h, uint16_t stride) {
+    // A 1-bit sprite whose width is a multiple of 8 stores rows MSB-first
+    // with no padding, which is the mask layout
+    if (w != stride * 8) return false;
+
+    M5Canvas sprite;
+    sprite.setColorDepth(1);
+    if (!sprite.createSprite(w, h)) return false;
+
+    sprite.fillSprite(TFT_BLACK);
+    sprite.setTextSize(textSize);
+    sprite.setTextDatum(top_left);
+    sprite.setTextColor(TFT_WHITE);
+    for (uint8_t i = 0; i < lineCount; i++) {
+        sprite.drawString(lines[i], 0, i * lineHeight);
+    }
+
+    memcpy(mask, sprite.getBuffer(), (size_t)stride * h);
+    sprite.deleteSprite();
+    return true;
+}
+
+bool GlyphAtlas::blitRow(M5Canvas& canvas, int16_t x, int16_t y, const uint8_t* bits, int16_t w,
+                         uint16_t fg, uint16_t bg) {
+    uint16_t* buf = (uint16_t*)canvas.getBuffer();
+    if (!buf) return false;
+    int16_t cw = canvas.width();
+    if (y < 0 || y >= canvas.height()) return true;
+
+    uint16_t fgRaw = toRaw(fg);
+    uint16_t bgRaw = toRaw(bg);
+    uint16_t* out = buf + (int32_t)y * cw;
+    int16_t start = x < 0 ? -x : 0;
+    int16_t end = (x + w > cw) ? cw - x : w;
+    for (int16_t i = start; i < end; i++) {
+        out[x + i] = (bits[i >> 3] & (0x80 >> (i & 7))) ? fgRaw : bgRaw;
+    }
+    return true;
+}
+
+void GlyphAtlas::copyRow(M5Canvas& canvas, int16_t x, int16_t srcY, int16_t dstY, int16_t w) {
+    uint16_t* buf = (uint16_t*)canvas.getBuffer();
+    int16_t cw = canvas.width();
+    int16_t ch = canvas.height();
+    if (!buf || srcY < 0 || srcY >= ch || dstY < 0 || dstY >= ch) return;
+
+    if (x < 0) {
+        w += x;
+        x = 0;
+    }
+    if (x + w > cw) w = cw - x;
+    if (w <= 0) return;
+    memcpy(buf + (int32_t)dstY * cw + x, buf + (int32_t)srcY * cw + x, w * 2);
+}
+
+void GlyphAtlas::drawText(M5Canvas& canvas, int16_t x, int16_t y, const char* text,
+                          uint16_t fg, uint16_t bg) {
+    if (!text) return;
+    uint16_t* buf = (uint16_t*)canvas.getBuffer();
+    if (!isEnabled() || !buf) {
+        canvas.setTextSize(1);
+        canvas.setTextDatum(top_left);
+        canvas.setTextColor(fg, bg);
+        canvas.drawString(text, x, y);
+        return;
+    }
+
+    int16_t cw = canvas.width();
+    int16_t ch = canvas.height();
+    size_t len = strlen(text);
+    uint16_t fgRaw = toRaw(fg);
+    uint16_t bgRaw = toRaw(bg);
+
+    // Row-major so each canvas row is written front to back once
+    for (uint8_t row = 0; row < GLYPH_H; row++) {
+        int16_t py = y + row;
+        if (py < 0 || py >= ch) continue;
+        uint16_t* out = buf + (int32_t)py * cw;
+
+        int16_t px = x;
+        for (size_t i = 0; i < len && px < cw; i++, px += GLYPH_W) {
+            uint8_t c = (uint8_t)text[i];
+            uint8_t bits = (c >= GLYPH_FIRST && c <= GLYPH_LAST) ? glyphs[c - GLYPH_FIRST][row] : 0;
+            for (uint8_t b = 0; b < GLYPH_W; b++) {
+                int16_t p = px + b;
+                if (p < 0 || p >= cw) continue;
+                out[p] = (bits & (0x80 >> b)) ? fgRaw : bgRaw;
+            }
+        }
+    }
+}
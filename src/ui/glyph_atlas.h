@@ -0,0 +1,43 @@
+// Pre-rasterized 1-bit glyphs and row blitter for canvas text
+#pragma once
+
+#include <M5Unified.h>
+
+// Built-in font at text size 1
+#define GLYPH_W 6
+#define GLYPH_H 8
+#define GLYPH_FIRST 0x20
+#define GLYPH_LAST 0x7E
+
+class GlyphAtlas {
+public:
+    // Rasterize the font once. Call after Display::init().
+    static void init();
+
+    // Off = everything goes back through the font rasterizer (benchmarks)
+    static void setEnabled(bool on) { enabled = on; }
+    static bool isEnabled() { return enabled && ready; }
+
+    // Opaque text at size 1, top-left datum. Falls back to drawString
+    // when the atlas is off or the canvas isn't 16-bit.
+    static void drawText(M5Canvas& canvas, int16_t x, int16_t y, const char* text,
+                         uint16_t fg, uint16_t bg);
+
+    // Render text with the font rasterizer into an MSB-first 1-bit mask,
+    // `stride` bytes per row. Used to build atlases at boot.
+    static bool rasterize(const char* const* lines, uint8_t lineCount, uint8_t textSize,
+                          int16_t lineHeight, uint8_t* mask, int16_t w, int16_t h, uint16_t stride);
+
+    // Expand one mask row to RGB565 and write it into the canvas at (x, y).
+    // Clipped to the canvas; false if the canvas can't be written directly.
+    static bool blitRow(M5Canvas& canvas, int16_t x, int16_t y, const uint8_t* bits, int16_t w,
+                        uint16_t fg, uint16_t bg);
+
+    // Copy a row already written by blitRow() at (x, srcY) to dstY
+    static void copyRow(M5Canvas& canvas, int16_t x, int16_t srcY, int16_t dstY, int16_t w);
+
+private:
+    static uint8_t glyphs[GLYPH_LAST - GLYPH_FIRST + 1][GLYPH_H];
+    static bool ready;
+    static bool enabled;
+};
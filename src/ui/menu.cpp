@@ -128,7 +128,9 @@ void Menu::draw(M5Canvas& canvas) {
             canvas.setTextColor(COLOR_FG);
         }
         
-        canvas.drawString("> " + menuItems[idx].label, 10, y);
+        FixedString<40> line("> ");
+        line.append(menuItems[idx].label.c_str());
+        canvas.drawString(line, 10, y);
     }
     
     // Scroll indicators
@@ -0,0 +1,99 @@
+// ML stats screen implementation
+
+#include "ml_stats_view.h"
+#include "display.h"
+#include "../ml/inference.h"
+#include "../core/config.h"
+#include "../core/fixed_string.h"
+
+bool MLStatsView::visible = false;
+
+void MLStatsView::draw(M5Canvas& canvas) {
+    canvas.fillSprite(COLOR_BG);
+    canvas.setTextColor(COLOR_FG);
+    canvas.setTextSize(1);
+    canvas.setTextDatum(top_left);
+    
+    canvas.setCursor(4, 2);
+    canvas.print("ML LATENCY");
+    canvas.setCursor(DISPLAY_W - 60, 2);
+    canvas.print("[M] back");
+    canvas.drawFastHLine(0, 12, canvas.width(), COLOR_FG);
+    
+    const LatencyHistogram& hist = MLInference::getLatencyHistogram();
+    
+    canvas.setCursor(4, 15);
+    canvas.printf("%s  n=%lu  avg %.1fus",
+                  Config::backendName(MLInference::activeBackend()),
+                  (unsigned long)hist.getCount(), hist.getMean());
+    canvas.setCursor(4, 25);
+    canvas.printf("p50 %luus  p99 %luus  max %luus",
+                  (unsigned long)hist.percentile(50.0f), (unsigned long)hist.percentile(99.0f),
+                  (unsigned long)hist.getMax());
+    
+    // Occupied bucket range, merged down to fit the columns
+    int first = -1;
+    int last = -1;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        if (hist.bucketCount(i) == 0) continue;
+        if (first < 0) first = i;
+        last = i;
+    }
+    
+    int axisY = HIST_TOP + HIST_H;
+    canvas.drawFastHLine(4, axisY, HIST_COLS * 4, COLOR_FG);
+    if (first >= 0) {
+        int span = last - first + 1;
+        int perCol = (span + HIST_COLS - 1) / HIST_COLS;
+        int cols = (span + perCol - 1) / perCol;
+        
+        uint32_t colMax = 1;
+        for (int c = 0; c < cols; c++) {
+            uint32_t sum = 0;
+            for (int i = first + c * perCol; i < first + (c + 1) * perCol && i <= last; i++) {
+                sum += hist.bucketCount(i);
+            }
+            if (sum > colMax) colMax = sum;
+        }
+        
+        // Log scale so the tail stays visible next to the mode
+        float scale = HIST_H / log2f((float)colMax + 1.0f);
+        for (int c = 0; c < cols; c++) {
+            uint32_t sum = 0;
+            for (int i = first + c * perCol; i < first + (c + 1) * perCol && i <= last; i++) {
+                sum += hist.bucketCount(i);
+            }
+            if (sum == 0) continue;
+            int h = (int)(log2f((float)sum + 1.0f) * scale);
+            if (h < 1) h = 1;
+            canvas.fillRect(4 + c * 4, axisY - h, 3, h, COLOR_FG);
+        }
+        
+        canvas.setCursor(4, axisY + 3);
+        canvas.printf("%luus", (unsigned long)LatencyHistogram::bucketLowerUs(first));
+        canvas.setTextDatum(top_right);
+        FixedString<16> maxStr;
+        maxStr.format("%luus", (unsigned long)hist.getMax());
+        canvas.drawString(maxStr.c_str(), 4 + HIST_COLS * 4, axisY + 3);
+        canvas.setTextDatum(top_left);
+    } else {
+        canvas.setCursor(4, HIST_TOP + HIST_H / 2 - 4);
+        canvas.print("no inferences yet");
+    }
+    
+    // Golden benchmark summary
+    canvas.drawFastHLine(0, canvas.height() - 12, canvas.width(), COLOR_FG);
+    canvas.setCursor(4, canvas.height() - 10);
+    uint8_t count = 0;
+    const MLBenchResult* results = MLInference::getBenchResults(count);
+    if (count == 0) {
+        canvas.print("[B] golden bench  [R] reset");
+        return;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        const MLBenchResult& r = results[i];
+        canvas.printf("%.3s:%lu/%lu%s ", Config::backendName(r.backend),
+                      (unsigned long)r.p50Us, (unsigned long)r.p99Us,
+                      r.mismatches > 0 ? "!" : (r.mismatches == 0 ? "" : "?"));
+    }
+}
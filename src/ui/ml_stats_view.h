@@ -0,0 +1,20 @@
+// ML stats screen - inference latency histogram and golden benchmark results
+#pragma once
+
+#include <Arduino.h>
+#include <M5Unified.h>
+
+class MLStatsView {
+public:
+    static void toggle() { visible = !visible; }
+    static void hide() { visible = false; }
+    static bool isVisible() { return visible; }
+    static void draw(M5Canvas& canvas);
+    
+private:
+    static bool visible;
+    
+    static const uint8_t HIST_TOP = 36;
+    static const uint8_t HIST_H = 40;
+    static const uint8_t HIST_COLS = 58;        // 4 px each incl. gap
+};
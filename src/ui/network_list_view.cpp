@@ -0,0 +1,251 @@
+// Network list screen implementation
+
+#include "network_list_view.h"
+#include "display.h"
+#include "../modes/oink.h"
+#include "../core/fixed_string.h"
+#include <algorithm>
+
+std::vector<NetworkListView::Entry> NetworkListView::order;
+std::vector<NetworkListView::Entry> NetworkListView::moved;
+uint16_t NetworkListView::known = 0;
+NetworkSortKey NetworkListView::sortKey = NetworkSortKey::RSSI;
+int NetworkListView::selected = -1;
+uint16_t NetworkListView::topRow = 0;
+bool NetworkListView::visible = false;
+
+static const char* const SORT_NAMES[] = { "RSSI", "SEEN", "CH", "SSID" };
+
+void NetworkListView::reset() {
+    order.clear();
+    moved.clear();
+    known = 0;
+    selected = -1;
+    topRow = 0;
+}
+
+int32_t NetworkListView::keyOf(uint16_t index) {
+    const DetectedNetwork& net = OinkMode::getNetworks()[index];
+    switch (sortKey) {
+        case NetworkSortKey::RSSI:
+            return -net.rssi;
+        case NetworkSortKey::LAST_SEEN:
+            // Whole seconds, so every beacon doesn't reshuffle the list
+            return -(int32_t)(net.lastSeen / 1000);
+        case NetworkSortKey::CHANNEL:
+            return net.channel;
+        default: {
+            // FNV-1a of the name: only used to notice a revealed hidden SSID
+            uint32_t h = 2166136261u;
+            for (const char* p = net.ssid; *p; p++) {
+                h = (h ^ (uint8_t)*p) * 16777619u;
+            }
+            return (int32_t)h;
+        }
+    }
+}
+
+bool NetworkListView::less(const Entry& a, const Entry& b) {
+    if (sortKey == NetworkSortKey::SSID) {
+        const auto& nets = OinkMode::getNetworks();
+        const char* sa = nets[a.index].ssid;
+        const char* sb = nets[b.index].ssid;
+        if (!sa[0] != !sb[0]) return sb[0] == 0;    // Hidden last
+        int c = strcasecmp(sa, sb);
+        if (c != 0) return c < 0;
+    } else if (a.key != b.key) {
+        return a.key < b.key;
+    }
+    // Ties in discovery order, so equal keys never swap places
+    return a.index < b.index;
+}
+
+void NetworkListView::sync() {
+    const auto& nets = OinkMode::getNetworks();
+    uint16_t count = nets.size();
+    if (count < known) {
+        // Shrunk without remap() (mode re-init): start over
+        reset();
+    }
+
+    // Pull out entries whose key changed; the rest are still in order
+    moved.clear();
+    size_t kept = 0;
+    for (size_t r = 0; r < order.size(); r++) {
+        Entry e = order[r];
+        int32_t key = keyOf(e.index);
+        if (key != e.key) {
+            e.key = key;
+            moved.push_back(e);
+        } else {
+            order[kept++] = e;
+        }
+    }
+    order.resize(kept);
+
+    for (uint16_t i = known; i < count; i++) {
+        moved.push_back({i, keyOf(i)});
+    }
+    known = count;
+    if (moved.empty()) return;
+
+    // Sort only what moved, then merge from the back: O(n + k log k)
+    std::sort(moved.begin(), moved.end(), less);
+    order.resize(kept + moved.size());
+    int i = (int)kept - 1;
+    int j = (int)moved.size() - 1;
+    for (int k = (int)order.size() - 1; j >= 0; k--) {
+        if (i >= 0 && less(moved[j], order[i])) {
+            order[k] = order[i--];
+        } else {
+            order[k] = moved[j--];
+        }
+    }
+
+    if (selected < 0) selected = order[0].index;
+}
+
+void NetworkListView::remap(const int16_t* newIndex, uint16_t oldCount) {
+    int row = findRow(selected);
+
+    size_t kept = 0;
+    for (size_t r = 0; r < order.size(); r++) {
+        Entry e = order[r];
+        if (e.index >= oldCount || newIndex[e.index] < 0) continue;
+        e.index = newIndex[e.index];
+        order[kept++] = e;
+    }
+    order.resize(kept);
+
+    uint16_t survivors = 0;
+    for (uint16_t i = 0; i < known && i < oldCount; i++) {
+        if (newIndex[i] >= 0) survivors++;
+    }
+    known = survivors;
+
+    // A removed selection moves to whatever now sits in its row
+    if (selected >= 0 && selected < oldCount && newIndex[selected] >= 0) {
+        selected = newIndex[selected];
+    } else if (order.empty()) {
+        selected = -1;
+    } else {
+        if (row < 0) row = 0;
+        selected = order[min((size_t)row, order.size() - 1)].index;
+    }
+}
+
+void NetworkListView::setSortKey(NetworkSortKey key) {
+    if (key == sortKey) return;
+    sortKey = key;
+
+    // The only full sort: every key is stale
+    for (auto& e : order) {
+        e.key = keyOf(e.index);
+    }
+    std::sort(order.begin(), order.end(), less);
+}
+
+void NetworkListView::cycleSortKey() {
+    setSortKey((NetworkSortKey)(((uint8_t)sortKey + 1) % (uint8_t)NetworkSortKey::COUNT));
+}
+
+int NetworkListView::findRow(int index) {
+    if (index < 0) return -1;
+    for (size_t r = 0; r < order.size(); r++) {
+        if (order[r].index == index) return (int)r;
+    }
+    return -1;
+}
+
+void NetworkListView::moveUp() {
+    sync();
+    if (order.empty()) return;
+    int row = findRow(selected) - 1;
+    if (row < 0) row = order.size() - 1;
+    selected = order[row].index;
+}
+
+void NetworkListView::moveDown() {
+    sync();
+    if (order.empty()) return;
+    int row = findRow(selected) + 1;
+    if (row >= (int)order.size()) row = 0;
+    selected = order[row].index;
+}
+
+int NetworkListView::getSelected() {
+    sync();
+    return selected;
+}
+
+void NetworkListView::draw(M5Canvas& canvas) {
+    sync();
+
+    canvas.fillSprite(COLOR_BG);
+    canvas.setTextColor(COLOR_FG);
+    canvas.setTextSize(1);
+    canvas.setTextDatum(top_left);
+
+    canvas.setCursor(4, 2);
+    canvas.printf("NETWORKS (%u)", (unsigned)order.size());
+    canvas.setCursor(DISPLAY_W - 84, 2);
+    canvas.printf("[S]ort: %s", SORT_NAMES[(uint8_t)sortKey]);
+    canvas.drawFastHLine(0, 12, canvas.width(), COLOR_FG);
+
+    if (order.empty()) {
+        canvas.setCursor(4, 50);
+        canvas.print("Sniffing for networks...");
+        return;
+    }
+
+    // Keep the cursor's row in the window; only these rows are formatted
+    int selRow = findRow(selected);
+    if (selRow < 0) {
+        selRow = 0;
+        selected = order[0].index;
+    }
+    if (selRow < topRow) topRow = selRow;
+    if (selRow >= topRow + VISIBLE_ROWS) topRow = selRow - VISIBLE_ROWS + 1;
+    if ((size_t)topRow + VISIBLE_ROWS > order.size()) {
+        topRow = order.size() > VISIBLE_ROWS ? order.size() - VISIBLE_ROWS : 0;
+    }
+
+    const auto& nets = OinkMode::getNetworks();
+    size_t end = min((size_t)topRow + VISIBLE_ROWS, order.size());
+    for (size_t r = topRow; r < end; r++) {
+        const DetectedNetwork& net = nets[order[r].index];
+        int y = LIST_TOP + (r - topRow) * ROW_H;
+
+        if ((int)r == selRow) {
+            canvas.fillRect(0, y - 1, DISPLAY_W - 6, ROW_H, COLOR_FG);
+            canvas.setTextColor(COLOR_BG);
+        } else {
+            canvas.setTextColor(COLOR_FG);
+        }
+
+        FixedString<20> name;
+        if (net.ssid[0] == 0) {
+            name = "<hidden>";
+        } else if (strlen(net.ssid) > 18) {
+            name.append(net.ssid, 16).append("..");
+        } else {
+            name = net.ssid;
+        }
+
+        FixedString<24> info;
+        info.format("%2u %4d %c%c%c", (unsigned)net.channel, (int)net.rssi,
+                    net.isTarget ? 'T' : ' ', net.hasHandshake ? 'H' : ' ', net.hasPMF ? 'P' : ' ');
+
+        canvas.drawString(name.c_str(), 4, y);
+        canvas.drawString(info.c_str(), 130, y);
+    }
+    canvas.setTextColor(COLOR_FG);
+
+    // Scroll thumb on the right edge
+    int trackH = VISIBLE_ROWS * ROW_H;
+    int thumbH = max(4, (int)(trackH * VISIBLE_ROWS / order.size()));
+    if (thumbH < trackH) {
+        int thumbY = LIST_TOP + (int)((trackH - thumbH) * (uint32_t)topRow / (order.size() - VISIBLE_ROWS));
+        canvas.fillRect(DISPLAY_W - 3, thumbY, 2, thumbH, COLOR_FG);
+    }
+}
@@ -0,0 +1,61 @@
+// Network list screen - sorted, scrollable view over OINK's network table
+#pragma once
+
+#include <Arduino.h>
+#include <M5Unified.h>
+#include <vector>
+
+enum class NetworkSortKey : uint8_t {
+    RSSI,           // Strongest first
+    LAST_SEEN,      // Most recent first (1 s resolution)
+    CHANNEL,
+    SSID,           // Case-insensitive, hidden last
+    COUNT
+};
+
+class NetworkListView {
+public:
+    static void toggle() { visible = !visible; }
+    static void hide() { visible = false; }
+    static bool isVisible() { return visible; }
+    static void draw(M5Canvas& canvas);
+
+    // The view keeps its own sorted array of network indices; the table
+    // itself is never reordered. sync() merges in networks appended since
+    // the last call and re-places only those whose sort key changed.
+    static void reset();
+    static void sync();
+    // Entries were erased: newIndex[old] is the new index or -1
+    static void remap(const int16_t* newIndex, uint16_t oldCount);
+
+    static void setSortKey(NetworkSortKey key);
+    static void cycleSortKey();
+    static NetworkSortKey getSortKey() { return sortKey; }
+
+    // The cursor follows the network, not the row, across re-sorts
+    static void moveUp();
+    static void moveDown();
+    static int getSelected();       // Network index, -1 when empty
+
+private:
+    struct Entry {
+        uint16_t index;
+        int32_t key;        // Sort value, or SSID hash for change detection
+    };
+
+    static std::vector<Entry> order;
+    static std::vector<Entry> moved;    // Scratch for sync(), keeps its capacity
+    static uint16_t known;              // Networks [0, known) are in order
+    static NetworkSortKey sortKey;
+    static int selected;
+    static uint16_t topRow;
+    static bool visible;
+
+    static const uint8_t ROW_H = 11;
+    static const uint8_t LIST_TOP = 15;
+    static const uint8_t VISIBLE_ROWS = 8;
+
+    static int32_t keyOf(uint16_t index);
+    static bool less(const Entry& a, const Entry& b);
+    static int findRow(int index);
+};
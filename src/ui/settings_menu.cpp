@@ -120,6 +120,14 @@ void SettingsMenu::loadFromConfig() {
         -12, 14, 1, "h", ""
     });
     
+    // Speed-adaptive GPS fix rate / WARHOG scan cadence
+    items.push_back({
+        "GPS Adapt",
+        SettingType::TOGGLE,
+        Config::gps().adaptiveRate ? 1 : 0,
+        0, 1, 1, "", ""
+    });
+    
     // Save & Exit action
     items.push_back({
         "< Save & Exit >",
@@ -157,6 +165,7 @@ void SettingsMenu::saveToConfig() {
     g.baudRate = baudRates[items[9].value];
     
     g.timezoneOffset = items[10].value;
+    g.adaptiveRate = items[11].value == 1;
     Config::setGPS(g);
     
     // Save to file
@@ -370,7 +379,7 @@ void SettingsMenu::draw(M5Canvas& canvas) {
         canvas.drawString(item.label, 4, y + 2);
         
         // Draw value on the right
-        String valStr;
+        FixedString<32> valStr;
         if (item.type == SettingType::TOGGLE) {
             valStr = item.value ? "ON" : "OFF";
         } else if (item.type == SettingType::VALUE) {
@@ -378,41 +387,43 @@ void SettingsMenu::draw(M5Canvas& canvas) {
             if (item.label == "GPS Baud") {
                 static const char* baudLabels[] = {"9600", "38400", "57600", "115200"};
                 if (isSelected && editing) {
-                    valStr = "[" + String(baudLabels[item.value]) + "]";
+                    valStr.format("[%s]", baudLabels[item.value]);
                 } else {
-                    valStr = String(baudLabels[item.value]);
+                    valStr = baudLabels[item.value];
                 }
             } else if (isSelected && editing) {
-                valStr = "[" + String(item.value) + item.suffix + "]";
+                valStr.format("[%d%s]", (int)item.value, item.suffix.c_str());
             } else {
-                valStr = String(item.value) + item.suffix;
+                valStr.format("%d%s", (int)item.value, item.suffix.c_str());
             }
         } else if (item.type == SettingType::TEXT) {
             if (isSelected && textEditing) {
                 // Show text with cursor
-                String display = textBuffer;
-                if (display.length() > 12) {
-                    display = "..." + display.substring(display.length() - 9);
+                const char* text = textBuffer.c_str();
+                size_t textLen = textBuffer.length();
+                if (textLen > 12) {
+                    valStr.format("[...%s_]", text + textLen - 9);
+                } else {
+                    valStr.format("[%s_]", text);
                 }
-                valStr = "[" + display + "_]";
             } else {
                 // Show stored value, masked for password
                 if (item.label.indexOf("Pass") >= 0 && item.textValue.length() > 0) {
                     valStr = "****";
                 } else if (item.textValue.length() > 12) {
-                    valStr = item.textValue.substring(0, 9) + "...";
+                    valStr.append(item.textValue.c_str(), 9).append("...");
                 } else if (item.textValue.length() > 0) {
-                    valStr = item.textValue;
+                    valStr = item.textValue.c_str();
                 } else {
                     valStr = "<empty>";
                 }
             }
         } else if (item.type == SettingType::ACTION) {
             // Action - label is the whole thing, centered
-            valStr = "";
+            valStr.clear();
         }
         
-        if (valStr.length() > 0) {
+        if (!valStr.isEmpty()) {
             canvas.setTextDatum(top_right);
             canvas.drawString(valStr, DISPLAY_W - 4, y + 2);
         }
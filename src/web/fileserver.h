@@ -2,8 +2,8 @@
 #pragma once
 
 #include <Arduino.h>
-#include <WebServer.h>
 #include <WiFi.h>
+#include "http_server.h"
 
 enum class FileServerState {
     IDLE,
@@ -28,7 +28,7 @@ public:
     static uint64_t getSDTotalSpace();
     
 private:
-    static WebServer* server;
+    static HttpServer* server;
     static FileServerState state;
     static char statusMessage[64];
     static char targetSSID[64];
@@ -40,6 +40,7 @@ private:
     static void updateConnecting();
     static void updateRunning();
     static void startServer();
+    static bool releaseServer();
     
     // HTTP handlers
     static void handleRoot();
@@ -47,6 +48,8 @@ private:
     static void handleDownload();
     static void handleUpload();
     static void handleUploadProcess();
+    static void handleModelUpload();
+    static void handleModelUploadProcess();
     static void handleDelete();
     static void handleMkdir();
     static void handleSDInfo();
@@ -0,0 +1,1094 @@
+// Event-driven HTTP server implementation
+
+#include "http_server.h"
+#include <lwip/sockets.h>
+#include <errno.h>
+#include <time.h>
+#include <new>
+
+// lwIP can map the BSD names to function-like macros, which would swallow
+// member calls such as send() and file.read(); the socket calls below use
+// the lwip_* functions directly
+#undef send
+#undef read
+#undef write
+#undef close
+
+enum class ConnState : uint8_t {
+    FREE,
+    READ_HEAD,
+    READ_BODY,
+    SEND
+};
+
+enum class BodyKind : uint8_t {
+    NONE,           // Everything is already in io
+    MEMORY,         // bodyData, sent without copying
+    FILE,           // file, read into io as it drains
+    STREAM          // fill(), chunk-framed in io unless HTTP/1.0
+};
+
+enum class MultipartState : uint8_t {
+    NONE,
+    PREAMBLE,
+    AFTER_DELIM,
+    HEADERS,
+    DATA,
+    DONE
+};
+
+struct HttpConn {
+    int fd;
+    ConnState state;
+    uint32_t lastActive;
+
+    // Request head, parsed in place
+    char head[HTTP_HEAD_BUF];
+    uint16_t headLen;
+    HttpMethod method;
+    bool headOnly;
+    bool keepAlive;
+    bool http11;
+    char* path;
+    char* argNames[HTTP_MAX_ARGS];
+    char* argValues[HTTP_MAX_ARGS];
+    uint8_t argCount;
+    char* hdrNames[HTTP_MAX_HEADERS];
+    char* hdrValues[HTTP_MAX_HEADERS];
+    uint8_t hdrCount;
+    HttpHandler handler;
+    HttpHandler uploadHandler;
+    uint32_t bodyRemaining;         // Request body bytes not yet received
+
+    // multipart/form-data, parsed as it streams through io
+    MultipartState mp;
+    char delim[80];                 // "\r\n--" + boundary
+    uint8_t delimLen;
+    bool partIsFile;
+    bool uploadOpen;                // START sent, END/ABORTED not yet
+
+    // Request body in, response head and body out
+    uint8_t io[HTTP_IO_BUF];
+    uint16_t ioLen;
+    uint16_t ioPos;
+
+    // Response
+    bool responded;
+    int status;
+    BodyKind body;
+    const uint8_t* bodyData;
+    String bodyCopy;
+    File file;
+    HttpFill fill;
+    HttpRelease release;
+    void* ctx;
+    bool chunked;
+    uint32_t sendRemaining;         // Body bytes not yet in io (STREAM: 1 until fill() ends)
+
+    // Timing for the DEBUG_MODE log
+    uint32_t startMs;
+    uint32_t firstByteMs;
+    uint32_t bytesOut;
+};
+
+static const char* statusText(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 206: return "Partial Content";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 413: return "Payload Too Large";
+        case 416: return "Range Not Satisfiable";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        default: return "Unknown";
+    }
+}
+
+#ifdef DEBUG_MODE
+static const char* methodName(HttpMethod m) {
+    switch (m) {
+        case HttpMethod::GET: return "GET";
+        case HttpMethod::POST: return "POST";
+        case HttpMethod::HEAD: return "HEAD";
+        default: return "?";
+    }
+}
+#endif
+
+static bool wouldBlock() {
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+static int8_t hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// In place: %XX always, '+' only in the query string
+static void urlDecode(char* s, bool plusIsSpace) {
+    char* out = s;
+    for (; *s; s++) {
+        int8_t hi, lo;
+        if (*s == '%' && (hi = hexValue(s[1])) >= 0 && (lo = hexValue(s[2])) >= 0) {
+            *out++ = (char)((hi << 4) | lo);
+            s += 2;
+        } else if (*s == '+' && plusIsSpace) {
+            *out++ = ' ';
+        } else {
+            *out++ = *s;
+        }
+    }
+    *out = 0;
+}
+
+static const uint8_t* findBytes(const uint8_t* hay, size_t hayLen, const char* needle, size_t len) {
+    if (len == 0 || hayLen < len) return nullptr;
+    const uint8_t* last = hay + hayLen - len;
+    for (const uint8_t* p = hay; p <= last; p++) {
+        p = (const uint8_t*)memchr(p, needle[0], last - p + 1);
+        if (!p) return nullptr;
+        if (memcmp(p, needle, len) == 0) return p;
+    }
+    return nullptr;
+}
+
+static void resetRequest(HttpConn& c) {
+    static char emptyPath[] = "";
+    c.headLen = 0;
+    c.method = HttpMethod::OTHER;
+    c.path = emptyPath;
+    c.ioLen = 0;
+    c.ioPos = 0;
+    c.argCount = 0;
+    c.hdrCount = 0;
+    c.handler = nullptr;
+    c.uploadHandler = nullptr;
+    c.bodyRemaining = 0;
+    c.mp = MultipartState::NONE;
+    c.partIsFile = false;
+    c.uploadOpen = false;
+    c.responded = false;
+    c.status = 0;
+    c.body = BodyKind::NONE;
+    c.bodyData = nullptr;
+    c.fill = nullptr;
+    c.release = nullptr;
+    c.ctx = nullptr;
+    c.chunked = false;
+    c.sendRemaining = 0;
+    c.startMs = 0;
+    c.firstByteMs = 0;
+    c.bytesOut = 0;
+}
+
+HttpServer::HttpServer(uint16_t port)
+    : port(port), listenFd(-1), running(false), task(nullptr), active(0),
+      routeCount(0), notFound(nullptr), conns(nullptr), cur(nullptr), uploader(nullptr),
+      extraLen(0) {
+    memset(&uploadState, 0, sizeof(uploadState));
+    extraHeaders[0] = 0;
+}
+
+HttpServer::~HttpServer() {
+    stop();
+}
+
+void HttpServer::on(const char* path, HttpMethod method, HttpHandler handler, HttpHandler uploadHandler) {
+    if (routeCount >= HTTP_MAX_ROUTES) {
+        Serial.printf("[HTTPD] Route table full, %s dropped\n", path);
+        return;
+    }
+    routes[routeCount++] = { path, method, handler, uploadHandler };
+}
+
+bool HttpServer::begin() {
+    if (task) return true;
+
+    if (!conns) {
+        conns = new (std::nothrow) HttpConn[HTTP_MAX_CLIENTS];
+        if (!conns) {
+            Serial.println("[HTTPD] No memory for connections");
+            return false;
+        }
+    }
+    for (uint8_t i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        conns[i].fd = -1;
+        conns[i].state = ConnState::FREE;
+    }
+    active = 0;
+
+    listenFd = lwip_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listenFd < 0) {
+        Serial.println("[HTTPD] socket() failed");
+        return false;
+    }
+    int yes = 1;
+    lwip_setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (lwip_bind(listenFd, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+        lwip_listen(listenFd, HTTP_MAX_CLIENTS) < 0) {
+        Serial.printf("[HTTPD] Cannot listen on port %u\n", port);
+        lwip_close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    lwip_fcntl(listenFd, F_SETFL, lwip_fcntl(listenFd, F_GETFL, 0) | O_NONBLOCK);
+
+    running = true;
+    TaskHandle_t handle = nullptr;
+    if (xTaskCreatePinnedToCore(taskMain, "httpd", HTTP_TASK_STACK, this,
+                                tskIDLE_PRIORITY + 1, &handle, 0) != pdPASS) {
+        Serial.println("[HTTPD] Failed to start server task");
+        running = false;
+        lwip_close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    task = handle;
+
+    Serial.printf("[HTTPD] Listening on port %u (%d connections)\n", port, HTTP_MAX_CLIENTS);
+    return true;
+}
+
+bool HttpServer::stop() {
+    if (task) {
+        running = false;
+        uint32_t start = millis();
+        while (task && millis() - start < 2000) {
+            delay(10);
+        }
+        if (task) {
+            // Still inside a handler; leak the buffers rather than free them under it
+            Serial.println("[HTTPD] Server task did not exit");
+            return false;
+        }
+    }
+    delete[] conns;
+    conns = nullptr;
+    return true;
+}
+
+void HttpServer::taskMain(void* arg) {
+    HttpServer* self = (HttpServer*)arg;
+    self->run();
+    self->task = nullptr;
+    vTaskDelete(nullptr);
+}
+
+void HttpServer::run() {
+    while (running) {
+        fd_set rd, wr;
+        FD_ZERO(&rd);
+        FD_ZERO(&wr);
+        int maxFd = -1;
+
+        // A full table leaves new clients in the listen backlog
+        if (active < HTTP_MAX_CLIENTS) {
+            FD_SET(listenFd, &rd);
+            maxFd = listenFd;
+        }
+        for (uint8_t i = 0; i < HTTP_MAX_CLIENTS; i++) {
+            HttpConn& c = conns[i];
+            if (c.state == ConnState::FREE) continue;
+            FD_SET(c.fd, c.state == ConnState::SEND ? &wr : &rd);
+            if (c.fd > maxFd) maxFd = c.fd;
+        }
+
+        // Short timeout so stop() and idle timeouts are noticed
+        struct timeval tv = { 0, 50000 };
+        int n = lwip_select(maxFd + 1, &rd, &wr, nullptr, &tv);
+        if (n < 0) {
+            delay(10);
+            continue;
+        }
+
+        if (active < HTTP_MAX_CLIENTS && FD_ISSET(listenFd, &rd)) {
+            acceptClient();
+        }
+
+        uint32_t now = millis();
+        for (uint8_t i = 0; i < HTTP_MAX_CLIENTS; i++) {
+            HttpConn& c = conns[i];
+            if (c.state == ConnState::FREE) continue;
+            bool readable = FD_ISSET(c.fd, &rd);
+            bool writable = FD_ISSET(c.fd, &wr);
+            if (readable || writable) {
+                service(c, readable, writable);
+            } else if (now - c.lastActive > HTTP_IDLE_TIMEOUT_MS) {
+                drop(c);
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        if (conns[i].state != ConnState::FREE) drop(conns[i]);
+    }
+    lwip_close(listenFd);
+    listenFd = -1;
+}
+
+void HttpServer::acceptClient() {
+    struct sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+    int fd = lwip_accept(listenFd, (struct sockaddr*)&addr, &len);
+    if (fd < 0) return;
+
+    HttpConn* slot = nullptr;
+    for (uint8_t i = 0; i < HTTP_MAX_CLIENTS && !slot; i++) {
+        if (conns[i].state == ConnState::FREE) slot = &conns[i];
+    }
+    if (!slot) {
+        lwip_close(fd);
+        return;
+    }
+
+    lwip_fcntl(fd, F_SETFL, lwip_fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    // Small JSON replies shouldn't wait out Nagle
+    int yes = 1;
+    lwip_setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+
+    slot->fd = fd;
+    slot->state = ConnState::READ_HEAD;
+    slot->lastActive = millis();
+    resetRequest(*slot);
+    active++;
+}
+
+void HttpServer::service(HttpConn& c, bool readable, bool writable) {
+    switch (c.state) {
+        case ConnState::READ_HEAD:
+            if (readable) readHead(c);
+            break;
+        case ConnState::READ_BODY:
+            if (readable) readBody(c, true);
+            break;
+        case ConnState::SEND:
+            if (writable) writeBody(c);
+            break;
+        default:
+            break;
+    }
+}
+
+void HttpServer::readHead(HttpConn& c) {
+    int n = lwip_recv(c.fd, c.head + c.headLen, HTTP_HEAD_BUF - 1 - c.headLen, 0);
+    if (n <= 0) {
+        if (n < 0 && wouldBlock()) return;
+        drop(c);
+        return;
+    }
+    c.lastActive = millis();
+    c.headLen += n;
+    c.head[c.headLen] = 0;
+
+    char* end = strstr(c.head, "\r\n\r\n");
+    if (!end) {
+        if (c.headLen >= HTTP_HEAD_BUF - 1) sendError(c, 431);
+        return;
+    }
+    c.startMs = c.lastActive;
+    size_t headEnd = end - c.head + 4;
+    size_t extra = c.headLen - headEnd;
+
+    if (!parseHead(c, headEnd)) {
+        sendError(c, 400);
+        return;
+    }
+
+    const char* lenHdr = nullptr;
+    const char* typeHdr = nullptr;
+    const char* expectHdr = nullptr;
+    for (uint8_t i = 0; i < c.hdrCount; i++) {
+        if (strcasecmp(c.hdrNames[i], "Content-Length") == 0) lenHdr = c.hdrValues[i];
+        else if (strcasecmp(c.hdrNames[i], "Content-Type") == 0) typeHdr = c.hdrValues[i];
+        else if (strcasecmp(c.hdrNames[i], "Expect") == 0) expectHdr = c.hdrValues[i];
+    }
+    uint32_t contentLength = lenHdr ? strtoul(lenHdr, nullptr, 10) : 0;
+
+    // Bytes past the head belong to the body. Anything beyond that is a
+    // pipelined request, which isn't supported: answer this one and close.
+    if (extra > contentLength) {
+        extra = contentLength;
+        c.keepAlive = false;
+    }
+    memcpy(c.io, c.head + headEnd, extra);
+    c.ioLen = extra;
+    c.bodyRemaining = contentLength - extra;
+
+    // Route
+    for (uint8_t i = 0; i < routeCount; i++) {
+        const Route& r = routes[i];
+        if (strcmp(r.path, c.path) != 0) continue;
+        if (r.method == HttpMethod::ANY || r.method == c.method ||
+            (r.method == HttpMethod::GET && c.method == HttpMethod::HEAD)) {
+            c.handler = r.handler;
+            c.uploadHandler = r.uploadHandler;
+            break;
+        }
+    }
+    if (!c.handler) c.handler = notFound;
+
+    if (c.uploadHandler && typeHdr && strncasecmp(typeHdr, "multipart/form-data", 19) == 0) {
+        const char* b = strstr(typeHdr, "boundary=");
+        size_t blen = 0;
+        if (b) {
+            b += 9;
+            if (*b == '"') b++;
+            while (b[blen] && b[blen] != '"' && b[blen] != ';') blen++;
+        }
+        if (blen == 0 || blen > sizeof(c.delim) - 5) {
+            sendError(c, 400);
+            return;
+        }
+        // The upload handlers keep per-file state, so one upload at a time
+        if (uploader && uploader != &c) {
+            sendError(c, 503);
+            return;
+        }
+        uploader = &c;
+        memcpy(c.delim, "\r\n--", 4);
+        memcpy(c.delim + 4, b, blen);
+        c.delimLen = 4 + blen;
+        c.mp = MultipartState::PREAMBLE;
+    }
+
+    if (contentLength == 0) {
+        dispatch(c);
+        return;
+    }
+    if (expectHdr && strcasecmp(expectHdr, "100-continue") == 0 && c.bodyRemaining > 0) {
+        static const char CONTINUE[] = "HTTP/1.1 100 Continue\r\n\r\n";
+        lwip_send(c.fd, CONTINUE, sizeof(CONTINUE) - 1, 0);
+    }
+    c.state = ConnState::READ_BODY;
+    readBody(c, false);
+}
+
+bool HttpServer::parseHead(HttpConn& c, size_t headEnd) {
+    // Request line: METHOD SP target SP version
+    char* line = c.head;
+    char* eol = strstr(line, "\r\n");
+    *eol = 0;
+    char* sp1 = strchr(line, ' ');
+    if (!sp1) return false;
+    *sp1 = 0;
+    char* target = sp1 + 1;
+    char* sp2 = strchr(target, ' ');
+    if (!sp2) return false;
+    *sp2 = 0;
+    const char* version = sp2 + 1;
+
+    if (strcmp(line, "GET") == 0) c.method = HttpMethod::GET;
+    else if (strcmp(line, "POST") == 0) c.method = HttpMethod::POST;
+    else if (strcmp(line, "HEAD") == 0) c.method = HttpMethod::HEAD;
+    else c.method = HttpMethod::OTHER;
+    c.headOnly = c.method == HttpMethod::HEAD;
+    c.http11 = strcmp(version, "HTTP/1.1") == 0;
+    c.keepAlive = c.http11;
+
+    char* query = strchr(target, '?');
+    if (query) *query++ = 0;
+    urlDecode(target, false);
+    c.path = target;
+
+    c.argCount = 0;
+    while (query && *query && c.argCount < HTTP_MAX_ARGS) {
+        char* next = strchr(query, '&');
+        if (next) *next++ = 0;
+        char* eq = strchr(query, '=');
+        if (eq) *eq++ = 0;
+        urlDecode(query, true);
+        if (eq) urlDecode(eq, true);
+        c.argNames[c.argCount] = query;
+        c.argValues[c.argCount] = eq ? eq : query + strlen(query);
+        c.argCount++;
+        query = next;
+    }
+
+    // Header lines up to the blank one
+    c.hdrCount = 0;
+    char* headStop = c.head + headEnd - 2;
+    line = eol + 2;
+    while (line < headStop) {
+        eol = strstr(line, "\r\n");
+        if (!eol) break;
+        *eol = 0;
+        char* colon = strchr(line, ':');
+        if (colon && c.hdrCount < HTTP_MAX_HEADERS) {
+            *colon = 0;
+            char* value = colon + 1;
+            while (*value == ' ' || *value == '\t') value++;
+            c.hdrNames[c.hdrCount] = line;
+            c.hdrValues[c.hdrCount] = value;
+            c.hdrCount++;
+
+            if (strcasecmp(line, "Connection") == 0) {
+                if (strcasecmp(value, "close") == 0) c.keepAlive = false;
+                else if (strcasecmp(value, "keep-alive") == 0) c.keepAlive = true;
+            }
+        }
+        line = eol + 2;
+    }
+    return true;
+}
+
+void HttpServer::readBody(HttpConn& c, bool readable) {
+    if (readable && c.bodyRemaining > 0 && c.ioLen < HTTP_IO_BUF) {
+        size_t want = HTTP_IO_BUF - c.ioLen;
+        if (want > c.bodyRemaining) want = c.bodyRemaining;
+        int n = lwip_recv(c.fd, c.io + c.ioLen, want, 0);
+        if (n <= 0) {
+            if (n < 0 && wouldBlock()) return;
+            drop(c);
+            return;
+        }
+        c.lastActive = millis();
+        c.ioLen += n;
+        c.bodyRemaining -= n;
+    }
+
+    bool final = c.bodyRemaining == 0;
+    if (c.mp != MultipartState::NONE) {
+        consumeMultipart(c, final);
+    } else {
+        c.ioLen = 0;    // A body no handler asked for
+    }
+
+    if (final) {
+        if (c.uploadOpen) emitUpload(c, HttpUploadStatus::ABORTED, nullptr, 0);
+        if (uploader == &c) uploader = nullptr;
+        dispatch(c);
+    } else if (c.ioLen == HTTP_IO_BUF) {
+        // No progress with a full buffer: part headers larger than io
+        if (c.uploadOpen) emitUpload(c, HttpUploadStatus::ABORTED, nullptr, 0);
+        if (uploader == &c) uploader = nullptr;
+        sendError(c, 413);
+    }
+}
+
+void HttpServer::consumeMultipart(HttpConn& c, bool final) {
+    size_t pos = 0;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        const uint8_t* data = c.io + pos;
+        size_t len = c.ioLen - pos;
+
+        switch (c.mp) {
+            case MultipartState::PREAMBLE: {
+                // The first delimiter has no leading CRLF
+                const char* d = c.delim + 2;
+                size_t dl = c.delimLen - 2;
+                const uint8_t* hit = findBytes(data, len, d, dl);
+                if (hit) {
+                    pos = hit - c.io + dl;
+                    c.mp = MultipartState::AFTER_DELIM;
+                    progress = true;
+                } else if (len >= dl) {
+                    pos = c.ioLen - (dl - 1);
+                }
+                break;
+            }
+            case MultipartState::AFTER_DELIM:
+                if (len < 2) break;
+                // "--" closes the body, "\r\n" starts the next part
+                c.mp = (data[0] == '-' && data[1] == '-') ? MultipartState::DONE : MultipartState::HEADERS;
+                pos += 2;
+                progress = true;
+                break;
+            case MultipartState::HEADERS: {
+                const uint8_t* hit = findBytes(data, len, "\r\n\r\n", 4);
+                if (!hit) break;
+                size_t hl = hit - data;
+
+                // Content-Disposition: form-data; name="..."; filename="..."
+                c.partIsFile = false;
+                const uint8_t* fn = findBytes(data, hl, "filename=\"", 10);
+                if (fn) {
+                    const uint8_t* s = fn + 10;
+                    size_t n = 0;
+                    while (s + n < hit && s[n] != '"' && n < sizeof(uploadState.filename) - 1) n++;
+                    memcpy(uploadState.filename, s, n);
+                    uploadState.filename[n] = 0;
+                    c.partIsFile = n > 0;
+                }
+                pos += hl + 4;
+                c.mp = MultipartState::DATA;
+                if (c.partIsFile) {
+                    uploadState.totalSize = 0;
+                    emitUpload(c, HttpUploadStatus::START, nullptr, 0);
+                }
+                progress = true;
+                break;
+            }
+            case MultipartState::DATA: {
+                const uint8_t* hit = findBytes(data, len, c.delim, c.delimLen);
+                // Without a delimiter, hold back enough bytes to catch one split across reads
+                size_t safe = hit ? (size_t)(hit - data)
+                                  : (final ? len : (len >= c.delimLen ? len - (c.delimLen - 1) : 0));
+                if (safe > 0 && c.partIsFile) {
+                    emitUpload(c, HttpUploadStatus::WRITE, data, safe);
+                }
+                pos += safe;
+                if (hit) {
+                    if (c.partIsFile) emitUpload(c, HttpUploadStatus::END, nullptr, 0);
+                    pos += c.delimLen;
+                    c.mp = MultipartState::AFTER_DELIM;
+                    progress = true;
+                }
+                break;
+            }
+            case MultipartState::DONE:
+                pos = c.ioLen;      // Epilogue
+                break;
+            default:
+                break;
+        }
+    }
+
+    c.ioLen -= pos;
+    memmove(c.io, c.io + pos, c.ioLen);
+}
+
+void HttpServer::emitUpload(HttpConn& c, HttpUploadStatus status, const uint8_t* data, size_t len) {
+    uploadState.status = status;
+    uploadState.buf = data;
+    uploadState.currentSize = len;
+    if (status == HttpUploadStatus::WRITE) uploadState.totalSize += len;
+    c.uploadOpen = status == HttpUploadStatus::START || status == HttpUploadStatus::WRITE;
+
+    cur = &c;
+    c.uploadHandler();
+    cur = nullptr;
+}
+
+void HttpServer::dispatch(HttpConn& c) {
+    extraLen = 0;
+    extraHeaders[0] = 0;
+    cur = &c;
+    if (c.handler) {
+        c.handler();
+    } else {
+        send(404, "text/plain", "Not found");
+    }
+    if (!c.responded) {
+        send(500, "text/plain", "No response");
+    }
+    cur = nullptr;
+    c.state = ConnState::SEND;
+}
+
+void HttpServer::writeBody(HttpConn& c) {
+    // A few sends per wakeup, then let the other connections have a turn
+    for (uint8_t burst = 0; burst < 8; burst++) {
+        const uint8_t* out;
+        size_t len;
+
+        if (c.ioPos < c.ioLen) {
+            out = c.io + c.ioPos;
+            len = c.ioLen - c.ioPos;
+        } else if (c.sendRemaining == 0) {
+            finish(c);
+            return;
+        } else if (c.body == BodyKind::MEMORY) {
+            out = c.bodyData;
+            len = c.sendRemaining;
+        } else if (c.body == BodyKind::FILE) {
+            size_t want = c.sendRemaining < HTTP_IO_BUF ? c.sendRemaining : HTTP_IO_BUF;
+            int got = c.file.read(c.io, want);
+            if (got <= 0) {
+                // Shorter than the Content-Length we promised; only closing says so
+                Serial.println("[HTTPD] File read failed mid-response");
+                drop(c);
+                return;
+            }
+            c.ioLen = got;
+            c.ioPos = 0;
+            c.sendRemaining -= got;
+            continue;
+        } else if (c.body == BodyKind::STREAM) {
+            // Chunk size as 4 fixed hex digits (leading zeros are legal),
+            // so the data can be generated in place behind it
+            const size_t frame = c.chunked ? 6 : 0;
+            size_t got = c.fill(c.ctx, c.io + frame, HTTP_IO_BUF - frame - (c.chunked ? 2 : 0));
+            if (got == HTTP_FILL_ABORT) {
+                // No final chunk: closing is the only way to say the body is bad
+                Serial.printf("[HTTPD] %s: stream aborted\n", c.path);
+                drop(c);
+                return;
+            } else if (got == 0) {
+                c.sendRemaining = 0;
+                c.ioLen = 0;
+                if (c.chunked) {
+                    memcpy(c.io, "0\r\n\r\n", 5);
+                    c.ioLen = 5;
+                }
+            } else if (c.chunked) {
+                static const char HEX[] = "0123456789ABCDEF";
+                for (uint8_t i = 0; i < 4; i++) {
+                    c.io[i] = HEX[(got >> (12 - i * 4)) & 0x0F];
+                }
+                c.io[4] = '\r';
+                c.io[5] = '\n';
+                c.io[frame + got] = '\r';
+                c.io[frame + got + 1] = '\n';
+                c.ioLen = frame + got + 2;
+            } else {
+                c.ioLen = got;
+            }
+            c.ioPos = 0;
+            continue;
+        } else {
+            finish(c);
+            return;
+        }
+
+        int n = lwip_send(c.fd, out, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (wouldBlock()) return;
+            drop(c);
+            return;
+        }
+        if (c.bytesOut == 0) c.firstByteMs = millis() - c.startMs;
+        c.bytesOut += n;
+        c.lastActive = millis();
+        if (c.ioPos < c.ioLen) {
+            c.ioPos += n;
+        } else {
+            c.bodyData += n;
+            c.sendRemaining -= n;
+        }
+        if ((size_t)n < len) return;    // Socket buffer full
+    }
+}
+
+void HttpServer::endBody(HttpConn& c) {
+    if (c.body == BodyKind::FILE) {
+        c.file.close();
+    } else if (c.body == BodyKind::STREAM && c.release) {
+        c.release(c.ctx);
+    }
+    c.body = BodyKind::NONE;
+    c.release = nullptr;
+    c.ctx = nullptr;
+}
+
+void HttpServer::finish(HttpConn& c) {
+    endBody(c);
+
+#ifdef DEBUG_MODE
+    uint32_t ms = millis() - c.startMs;
+    Serial.printf("[HTTPD] %s %s %d: %lu B in %lu ms (%lu kB/s), first byte %lu ms\n",
+                  methodName(c.method), c.path, c.status, (unsigned long)c.bytesOut,
+                  (unsigned long)ms, (unsigned long)(ms ? c.bytesOut / ms : 0),
+                  (unsigned long)c.firstByteMs);
+#endif
+
+    if (!c.keepAlive) {
+        drop(c);
+        return;
+    }
+    c.bodyCopy = String();
+    resetRequest(c);
+    c.state = ConnState::READ_HEAD;
+}
+
+void HttpServer::drop(HttpConn& c) {
+    if (c.state == ConnState::FREE) return;
+    if (c.uploadOpen) emitUpload(c, HttpUploadStatus::ABORTED, nullptr, 0);
+    if (uploader == &c) uploader = nullptr;
+    endBody(c);
+    c.bodyCopy = String();
+    lwip_close(c.fd);
+    c.fd = -1;
+    c.state = ConnState::FREE;
+    active--;
+}
+
+void HttpServer::sendError(HttpConn& c, int code) {
+    c.keepAlive = false;
+    c.handler = nullptr;
+    c.uploadHandler = nullptr;
+    c.mp = MultipartState::NONE;
+    extraLen = 0;
+    extraHeaders[0] = 0;
+    cur = &c;
+    send(code, "text/plain", statusText(code));
+    cur = nullptr;
+    c.state = ConnState::SEND;
+}
+
+HttpMethod HttpServer::method() const {
+    return cur ? cur->method : HttpMethod::OTHER;
+}
+
+const char* HttpServer::uri() const {
+    return cur ? cur->path : "";
+}
+
+String HttpServer::arg(const char* name) const {
+    if (!cur) return String();
+    for (uint8_t i = 0; i < cur->argCount; i++) {
+        if (strcmp(cur->argNames[i], name) == 0) return String(cur->argValues[i]);
+    }
+    return String();
+}
+
+bool HttpServer::hasArg(const char* name) const {
+    if (!cur) return false;
+    for (uint8_t i = 0; i < cur->argCount; i++) {
+        if (strcmp(cur->argNames[i], name) == 0) return true;
+    }
+    return false;
+}
+
+const char* HttpServer::header(const char* name) const {
+    if (!cur) return nullptr;
+    for (uint8_t i = 0; i < cur->hdrCount; i++) {
+        if (strcasecmp(cur->hdrNames[i], name) == 0) return cur->hdrValues[i];
+    }
+    return nullptr;
+}
+
+bool HttpServer::acceptsEncoding(const char* coding) const {
+    const char* list = header("Accept-Encoding");
+    if (!list) return false;
+    size_t len = strlen(coding);
+    for (const char* p = list; (p = strcasestr(p, coding)) != nullptr; p += len) {
+        // Whole token only, and not refused with q=0
+        if (p > list && p[-1] != ' ' && p[-1] != ',') continue;
+        const char* q = p + len;
+        while (*q == ' ') q++;
+        if (*q != 0 && *q != ',' && *q != ';') continue;
+        if (*q == ';') {
+            q++;
+            while (*q == ' ') q++;
+            if ((q[0] == 'q' || q[0] == 'Q') && q[1] == '=') return strtof(q + 2, nullptr) > 0;
+        }
+        return true;
+    }
+    return false;
+}
+
+void HttpServer::sendHeader(const char* name, const char* value) {
+    int n = snprintf(extraHeaders + extraLen, sizeof(extraHeaders) - extraLen, "%s: %s\r\n", name, value);
+    if (n > 0 && extraLen + n < (int)sizeof(extraHeaders)) {
+        extraLen += n;
+    } else {
+        extraHeaders[extraLen] = 0;     // Doesn't fit: drop this one whole
+    }
+}
+
+bool HttpServer::beginResponse(int code, const char* contentType, size_t length, bool chunked) {
+    if (!cur || cur->responded) return false;
+    HttpConn& c = *cur;
+
+    // HTTP/1.0 has no chunked coding: the body ends when we close
+    if (chunked && !c.http11) c.keepAlive = false;
+    char lengthHdr[40];
+    if (code == 304) {
+        lengthHdr[0] = 0;       // Not modified: no body, no length
+    } else if (!chunked) {
+        snprintf(lengthHdr, sizeof(lengthHdr), "Content-Length: %lu\r\n", (unsigned long)length);
+    } else if (c.http11) {
+        strcpy(lengthHdr, "Transfer-Encoding: chunked\r\n");
+    } else {
+        lengthHdr[0] = 0;
+    }
+
+    int n = snprintf((char*)c.io, HTTP_IO_BUF,
+                     "HTTP/1.1 %d %s\r\n"
+                     "Content-Type: %s\r\n"
+                     "%s"
+                     "Connection: %s\r\n"
+                     "%s\r\n",
+                     code, statusText(code), contentType, lengthHdr,
+                     c.keepAlive ? "keep-alive" : "close", extraHeaders);
+    if (n < 0 || n >= HTTP_IO_BUF) n = 0;
+    c.ioLen = n;
+    c.ioPos = 0;
+    c.responded = true;
+    c.status = code;
+    c.body = BodyKind::NONE;
+    c.sendRemaining = c.headOnly ? 0 : length;
+    extraLen = 0;
+    extraHeaders[0] = 0;
+    return n > 0;
+}
+
+void HttpServer::send(int code, const char* contentType, const char* body) {
+    if (!body) body = "";
+    size_t len = strlen(body);
+    if (!beginResponse(code, contentType, len)) return;
+    HttpConn& c = *cur;
+    if (c.sendRemaining == 0) return;
+
+    // Most replies fit behind the head; larger ones are copied once
+    if (c.ioLen + len <= HTTP_IO_BUF) {
+        memcpy(c.io + c.ioLen, body, len);
+        c.ioLen += len;
+        c.sendRemaining = 0;
+    } else {
+        c.bodyCopy = body;
+        c.bodyData = (const uint8_t*)c.bodyCopy.c_str();
+        c.body = BodyKind::MEMORY;
+    }
+}
+
+void HttpServer::send_P(int code, const char* contentType, const uint8_t* data, size_t len) {
+    if (!beginResponse(code, contentType, len)) return;
+    cur->bodyData = data;
+    cur->body = BodyKind::MEMORY;
+}
+
+// "bytes=first-last", "bytes=first-" or "bytes=-suffix" against a file of
+// size bytes. Returns 1 and the inclusive span, 0 if the header should be
+// ignored (malformed or several ranges: a full 200 is a valid answer),
+// -1 if it can't be satisfied.
+static int parseRange(const char* spec, uint32_t size, uint32_t& first, uint32_t& last) {
+    while (*spec == ' ') spec++;
+    if (strncasecmp(spec, "bytes=", 6) != 0) return 0;
+    spec += 6;
+    if (strchr(spec, ',')) return 0;
+
+    char* end;
+    if (*spec == '-') {
+        uint32_t suffix = strtoul(spec + 1, &end, 10);
+        if (end == spec + 1) return 0;
+        if (suffix == 0 || size == 0) return -1;
+        first = suffix >= size ? 0 : size - suffix;
+        last = size - 1;
+        return 1;
+    }
+
+    first = strtoul(spec, &end, 10);
+    if (end == spec || *end != '-') return 0;
+    const char* lastStr = end + 1;
+    if (*lastStr == 0 || *lastStr == ' ') {
+        last = size - 1;
+    } else {
+        last = strtoul(lastStr, &end, 10);
+        if (end == lastStr || last < first) return 0;
+        if (last >= size) last = size - 1;
+    }
+    return first < size ? 1 : -1;
+}
+
+// If-None-Match: "*" or a list of tags; weak comparison, so W/"x" matches "x"
+static bool etagListMatches(const char* list, const char* etag) {
+    while (*list == ' ') list++;
+    if (list[0] == '*') return true;
+    return strstr(list, etag) != nullptr;
+}
+
+void HttpServer::sendStatic(const char* contentType, const uint8_t* data, size_t len, const char* etag,
+                            const char* encoding) {
+    if (!cur) return;
+    sendHeader("ETag", etag);
+    sendHeader("Cache-Control", "no-cache");
+    sendHeader("Vary", "Accept-Encoding");
+
+    const char* ifNoneMatch = header("If-None-Match");
+    if (ifNoneMatch && etagListMatches(ifNoneMatch, etag)) {
+        beginResponse(304, contentType, 0);
+        return;
+    }
+    if (encoding) sendHeader("Content-Encoding", encoding);
+    send_P(200, contentType, data, len);
+}
+
+void HttpServer::streamFile(File& file, const char* contentType) {
+    if (!cur) {
+        file.close();
+        return;
+    }
+    uint32_t size = file.size();
+    time_t mtime = file.getLastWrite();
+
+    // Validators: ETag from size + mtime, Last-Modified for clients that prefer dates
+    char etag[24];
+    snprintf(etag, sizeof(etag), "\"%lx-%lx\"", (unsigned long)size, (unsigned long)mtime);
+    char modified[32] = "";
+    struct tm tm;
+    if (mtime > 0 && gmtime_r(&mtime, &tm)) {
+        strftime(modified, sizeof(modified), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    }
+    sendHeader("ETag", etag);
+    if (modified[0]) sendHeader("Last-Modified", modified);
+    sendHeader("Accept-Ranges", "bytes");
+
+    const char* ifNoneMatch = header("If-None-Match");
+    if (ifNoneMatch && etagListMatches(ifNoneMatch, etag)) {
+        file.close();
+        beginResponse(304, contentType, 0);
+        return;
+    }
+
+    // A Range only applies if If-Range (when sent) still names this version
+    uint32_t first = 0;
+    uint32_t last = size ? size - 1 : 0;
+    int ranged = 0;
+    const char* range = header("Range");
+    const char* ifRange = header("If-Range");
+    if (range && (!ifRange || strcmp(ifRange, etag) == 0 || (modified[0] && strcmp(ifRange, modified) == 0))) {
+        ranged = parseRange(range, size, first, last);
+    }
+
+    if (ranged < 0) {
+        char contentRange[32];
+        snprintf(contentRange, sizeof(contentRange), "bytes */%lu", (unsigned long)size);
+        sendHeader("Content-Range", contentRange);
+        file.close();
+        send(416, "text/plain", "Range not satisfiable");
+        return;
+    }
+
+    uint32_t length = size;
+    if (ranged > 0) {
+        char contentRange[48];
+        snprintf(contentRange, sizeof(contentRange), "bytes %lu-%lu/%lu",
+                 (unsigned long)first, (unsigned long)last, (unsigned long)size);
+        sendHeader("Content-Range", contentRange);
+        length = last - first + 1;
+    }
+
+    if (!beginResponse(ranged > 0 ? 206 : 200, contentType, length)) {
+        file.close();
+        return;
+    }
+    HttpConn& c = *cur;
+    if (c.sendRemaining == 0 || (first > 0 && !file.seek(first))) {
+        if (c.sendRemaining) c.keepAlive = false;     // Head promised a body we can't send
+        file.close();
+        c.sendRemaining = 0;
+        return;
+    }
+    c.file = file;
+    c.body = BodyKind::FILE;
+}
+
+void HttpServer::sendStream(int code, const char* contentType, HttpFill fill, HttpRelease release, void* ctx) {
+    if (!beginResponse(code, contentType, 0, true)) {
+        if (release) release(ctx);
+        return;
+    }
+    HttpConn& c = *cur;
+    c.fill = fill;
+    c.release = release;
+    c.ctx = ctx;
+    c.chunked = c.http11;
+    c.body = BodyKind::STREAM;
+    c.sendRemaining = c.headOnly ? 0 : 1;
+    if (c.headOnly) endBody(c);
+}
@@ -0,0 +1,145 @@
+// Event-driven HTTP/1.1 server for the file transfer mode
+//
+// One FreeRTOS task owns the listening socket and up to HTTP_MAX_CLIENTS
+// keep-alive connections, multiplexed with select() on lwIP sockets. Each
+// connection is a small state machine (read head -> body/upload -> send),
+// so a large download never holds up the page, the JSON calls or the UI
+// loop. Handlers run in the server task with a WebServer-like API over the
+// current request; file bodies are streamed from SD after they return.
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+
+#define HTTP_MAX_CLIENTS 4
+#define HTTP_HEAD_BUF 1024          // Request line + headers, per connection
+#define HTTP_IO_BUF 2048            // Body in/out staging, per connection
+#define HTTP_MAX_ARGS 8
+#define HTTP_MAX_HEADERS 16
+#define HTTP_MAX_ROUTES 16
+#define HTTP_EXTRA_HEADERS 384
+#define HTTP_IDLE_TIMEOUT_MS 10000
+#define HTTP_TASK_STACK 8192
+
+enum class HttpMethod : uint8_t {
+    ANY,
+    GET,            // Also matches HEAD
+    POST,
+    HEAD,
+    OTHER
+};
+
+enum class HttpUploadStatus : uint8_t {
+    START,
+    WRITE,
+    END,
+    ABORTED
+};
+
+// One multipart file part, fed to the route's upload handler in chunks
+struct HttpUpload {
+    HttpUploadStatus status;
+    char filename[64];
+    const uint8_t* buf;
+    size_t currentSize;
+    size_t totalSize;
+};
+
+typedef void (*HttpHandler)();
+
+// Generated body: fill() writes up to max bytes and returns how many, 0
+// when done, or HTTP_FILL_ABORT to cut the connection so the client sees
+// an incomplete body. release() runs once, when the response ends or the
+// client goes away.
+#define HTTP_FILL_ABORT ((size_t)-1)
+typedef size_t (*HttpFill)(void* ctx, uint8_t* buf, size_t max);
+typedef void (*HttpRelease)(void* ctx);
+
+struct HttpConn;
+
+class HttpServer {
+public:
+    explicit HttpServer(uint16_t port = 80);
+    ~HttpServer();
+
+    void on(const char* path, HttpMethod method, HttpHandler handler, HttpHandler uploadHandler = nullptr);
+    void onNotFound(HttpHandler handler) { notFound = handler; }
+
+    bool begin();       // Opens the socket and starts the server task
+    // Closes every connection and waits up to 2 s for the task to exit.
+    // False if a handler is still running: the object is in use by the
+    // task and must not be deleted yet; call stop() again later.
+    bool stop();
+
+    uint8_t getActiveConnections() const { return active; }
+
+    // Current request, valid inside a handler
+    HttpMethod method() const;
+    const char* uri() const;
+    String arg(const char* name) const;
+    bool hasArg(const char* name) const;
+    const char* header(const char* name) const;     // nullptr if absent
+    bool acceptsEncoding(const char* coding) const; // Accept-Encoding lists it with q > 0
+    const HttpUpload& upload() const { return uploadState; }
+
+    // Response: at most one send/streamFile per request, sendHeader before it
+    void sendHeader(const char* name, const char* value);
+    void sendHeader(const char* name, const String& value) { sendHeader(name, value.c_str()); }
+    void send(int code, const char* contentType, const char* body);
+    void send(int code, const char* contentType, const String& body) { send(code, contentType, body.c_str()); }
+    // Static data (flash): sent straight from the pointer, not copied
+    void send_P(int code, const char* contentType, const uint8_t* data, size_t len);
+    // Static data under a fixed ETag, revalidated on every use (no-cache):
+    // 304 when If-None-Match has it. encoding sets Content-Encoding.
+    void sendStatic(const char* contentType, const uint8_t* data, size_t len, const char* etag,
+                    const char* encoding = nullptr);
+    // The server takes the file over and closes it when the body is sent.
+    // Adds ETag (size + mtime), Last-Modified and Accept-Ranges; answers
+    // If-None-Match with 304 and a single Range (If-Range permitting) with 206.
+    void streamFile(File& file, const char* contentType);
+    // Length unknown up front: chunked (HTTP/1.1) or until close (HTTP/1.0)
+    void sendStream(int code, const char* contentType, HttpFill fill, HttpRelease release, void* ctx);
+
+private:
+    struct Route {
+        const char* path;
+        HttpMethod method;
+        HttpHandler handler;
+        HttpHandler uploadHandler;
+    };
+
+    uint16_t port;
+    int listenFd;
+    volatile bool running;
+    volatile TaskHandle_t task;
+    volatile uint8_t active;
+
+    Route routes[HTTP_MAX_ROUTES];
+    uint8_t routeCount;
+    HttpHandler notFound;
+
+    HttpConn* conns;
+    HttpConn* cur;          // Request whose handler is running
+    HttpConn* uploader;     // Connection streaming a multipart upload
+    HttpUpload uploadState;
+    char extraHeaders[HTTP_EXTRA_HEADERS];
+    uint16_t extraLen;
+
+    static void taskMain(void* arg);
+    void run();
+
+    void acceptClient();
+    void service(HttpConn& c, bool readable, bool writable);
+    void readHead(HttpConn& c);
+    bool parseHead(HttpConn& c, size_t headEnd);
+    void readBody(HttpConn& c, bool readable);
+    void consumeMultipart(HttpConn& c, bool final);
+    void emitUpload(HttpConn& c, HttpUploadStatus status, const uint8_t* data, size_t len);
+    void dispatch(HttpConn& c);
+    void writeBody(HttpConn& c);
+    void finish(HttpConn& c);
+    void endBody(HttpConn& c);
+    void drop(HttpConn& c);
+    void sendError(HttpConn& c, int code);
+    bool beginResponse(int code, const char* contentType, size_t length, bool chunked = false);
+};
@@ -0,0 +1,589 @@
+// Auto-generated by scripts/web_assets.py from src/web/ui/index.html - do not edit
+#pragma once
+
+#include <Arduino.h>
+
+// Each encoding is its own representation, so each has its own strong ETag
+#define WEB_INDEX_ETAG "\"219f895db0adb914\""
+#define WEB_INDEX_GZ_ETAG "\"219f895db0adb914-gz\""
+#define WEB_INDEX_HTML_LEN 14480
+#define WEB_INDEX_GZ_LEN 3284
+
+// Plain copy for clients that don't accept gzip
+static const char WEB_INDEX_HTML[] PROGMEM = R"rawliteral(<!DOCTYPE html>
+<html>
+<head>
+    <meta charset="UTF-8">
+    <meta name="viewport" content="width=device-width, initial-scale=1.0">
+    <title>PORKCHOP File Manager</title>
+    <style>
+        * { box-sizing: border-box; margin: 0; padding: 0; }
+        body { 
+            background: #000; 
+            color: #fff; 
+            font-family: 'Courier New', monospace;
+            padding: 20px;
+            max-width: 900px;
+            margin: 0 auto;
+        }
+        h1 { 
+            border-bottom: 2px solid #fff; 
+            padding-bottom: 10px; 
+            margin-bottom: 10px;
+            font-size: 1.5em;
+        }
+        .sd-info {
+            color: #888;
+            margin-bottom: 15px;
+            font-size: 0.9em;
+        }
+        .breadcrumb {
+            margin: 10px 0;
+            padding: 8px;
+            background: #111;
+            border: 1px solid #333;
+        }
+        .breadcrumb a { color: #fff; text-decoration: none; }
+        .breadcrumb a:hover { text-decoration: underline; }
+        .file-list {
+            border: 1px solid #444;
+            margin: 10px 0;
+        }
+        .file-item { 
+            display: flex; 
+            justify-content: space-between; 
+            align-items: center;
+            padding: 10px;
+            border-bottom: 1px solid #333;
+        }
+        .file-item:hover { background: #111; }
+        .file-item:last-child { border-bottom: none; }
+        .file-icon { margin-right: 10px; }
+        .file-name { flex: 1; cursor: pointer; }
+        .file-name a { color: #fff; text-decoration: none; }
+        .file-name a:hover { text-decoration: underline; }
+        .file-size { color: #888; margin: 0 15px; min-width: 80px; text-align: right; }
+        .btn {
+            background: #fff;
+            color: #000;
+            border: none;
+            padding: 5px 12px;
+            cursor: pointer;
+            font-family: inherit;
+            font-size: 0.9em;
+            margin-left: 5px;
+        }
+        .btn:hover { background: #ccc; }
+        .btn-del { background: #333; color: #fff; border: 1px solid #fff; }
+        .btn-del:hover { background: #500; }
+        .btn-small { padding: 3px 8px; font-size: 0.8em; }
+        .toolbar {
+            display: flex;
+            gap: 10px;
+            margin: 15px 0;
+            flex-wrap: wrap;
+        }
+        .upload-section {
+            padding: 15px;
+            border: 1px solid #fff;
+            margin-top: 15px;
+        }
+        .upload-section input[type="file"] { 
+            margin: 10px 0;
+            color: #fff;
+        }
+        .progress-bar {
+            width: 100%;
+            height: 20px;
+            background: #333;
+            margin-top: 10px;
+            display: none;
+        }
+        .progress-fill {
+            height: 100%;
+            background: #fff;
+            width: 0%;
+            transition: width 0.2s;
+        }
+        .status { 
+            color: #888; 
+            margin-top: 15px; 
+            font-size: 0.9em;
+        }
+        input[type="text"] {
+            background: #000;
+            color: #fff;
+            border: 1px solid #fff;
+            padding: 5px 10px;
+            font-family: inherit;
+        }
+        .modal {
+            display: none;
+            position: fixed;
+            top: 0; left: 0;
+            width: 100%; height: 100%;
+            background: rgba(0,0,0,0.8);
+            justify-content: center;
+            align-items: center;
+        }
+        .modal-content {
+            background: #000;
+            border: 2px solid #fff;
+            padding: 20px;
+            max-width: 400px;
+        }
+        .modal-content h3 { margin-bottom: 15px; }
+        .modal-content input { width: 100%; margin: 10px 0; }
+    </style>
+</head>
+<body>
+    <h1>PORKCHOP File Manager</h1>
+    <div class="sd-info" id="sdInfo">Loading SD info...</div>
+    
+    <div class="breadcrumb" id="breadcrumb"></div>
+    
+    <div class="toolbar">
+        <button class="btn" onclick="loadDir(currentPath)">Refresh</button>
+        <button class="btn" onclick="showNewFolderModal()">New Folder</button>
+        <button class="btn" onclick="downloadAll()">Download All (ZIP)</button>
+    </div>
+    
+    <div class="file-list" id="fileList"></div>
+    
+    <div class="upload-section">
+        <strong>Upload to current folder</strong>
+        <form id="uploadForm" enctype="multipart/form-data">
+            <input type="file" id="fileInput" name="file" multiple>
+            <button type="submit" class="btn">Upload</button>
+        </form>
+        <div class="progress-bar" id="progressBar">
+            <div class="progress-fill" id="progressFill"></div>
+        </div>
+    </div>
+    
+    <div class="status" id="status">Ready</div>
+    
+    <!-- New Folder Modal -->
+    <div class="modal" id="newFolderModal">
+        <div class="modal-content">
+            <h3>Create New Folder</h3>
+            <input type="text" id="newFolderName" placeholder="Folder name">
+            <div style="margin-top: 15px;">
+                <button class="btn" onclick="createFolder()">Create</button>
+                <button class="btn btn-del" onclick="hideModal()">Cancel</button>
+            </div>
+        </div>
+    </div>
+    
+    <script>
+        let currentPath = '/';
+        
+        async function loadSDInfo() {
+            try {
+                const resp = await fetch('/api/sdinfo');
+                const info = await resp.json();
+                document.getElementById('sdInfo').textContent = 
+                    'SD Card: ' + formatSize(info.used) + ' used / ' + formatSize(info.total) + ' total (' + 
+                    formatSize(info.free) + ' free)';
+            } catch(e) {
+                document.getElementById('sdInfo').textContent = 'SD info unavailable';
+            }
+        }
+        
+        function updateBreadcrumb() {
+            const parts = currentPath.split('/').filter(p => p);
+            let html = '<a href="#" onclick="loadDir(\'/\');return false;">/root</a>';
+            let path = '';
+            for (const p of parts) {
+                path += '/' + p;
+                const safePath = path;
+                html += ' / <a href="#" onclick="loadDir(\'' + safePath + '\');return false;">' + p + '</a>';
+            }
+            document.getElementById('breadcrumb').innerHTML = html;
+        }
+        
+        async function loadDir(path) {
+            currentPath = path || '/';
+            updateBreadcrumb();
+            
+            const container = document.getElementById('fileList');
+            container.innerHTML = '<div class="file-item">Loading...</div>';
+            
+            try {
+                const resp = await fetch('/api/ls?dir=' + encodeURIComponent(currentPath) + '&full=1');
+                const items = await resp.json();
+                
+                let html = '';
+                
+                // Parent directory link
+                if (currentPath !== '/') {
+                    const parent = currentPath.substring(0, currentPath.lastIndexOf('/')) || '/';
+                    html += '<div class="file-item">';
+                    html += '<span class="file-icon">[..]</span>';
+                    html += '<span class="file-name"><a href="#" onclick="loadDir(\'' + parent + '\');return false;">..</a></span>';
+                    html += '<span class="file-size"></span>';
+                    html += '</div>';
+                }
+                
+                // Folders first
+                for (const item of items.filter(i => i.isDir)) {
+                    const itemPath = (currentPath === '/' ? '' : currentPath) + '/' + item.name;
+                    html += '<div class="file-item">';
+                    html += '<span class="file-icon">[D]</span>';
+                    html += '<span class="file-name"><a href="#" onclick="loadDir(\'' + itemPath + '\');return false;">' + item.name + '/</a></span>';
+                    html += '<span class="file-size">-</span>';
+                    html += '<button class="btn btn-del btn-small" onclick="del(\'' + itemPath + '\', true)">X</button>';
+                    html += '</div>';
+                }
+                
+                // Then files
+                for (const item of items.filter(i => !i.isDir)) {
+                    const itemPath = (currentPath === '/' ? '' : currentPath) + '/' + item.name;
+                    html += '<div class="file-item">';
+                    html += '<span class="file-icon">[F]</span>';
+                    html += '<span class="file-name">' + item.name + '</span>';
+                    html += '<span class="file-size">' + formatSize(item.size) + '</span>';
+                    html += '<button class="btn btn-small" onclick="download(\'' + itemPath + '\')">DL</button>';
+                    html += '<button class="btn btn-del btn-small" onclick="del(\'' + itemPath + '\', false)">X</button>';
+                    html += '</div>';
+                }
+                
+                container.innerHTML = html || '<div class="file-item">Empty folder</div>';
+            } catch (e) {
+                container.innerHTML = '<div class="file-item">Error loading directory</div>';
+            }
+        }
+        
+        function formatSize(bytes) {
+            if (bytes < 1024) return bytes + ' B';
+            if (bytes < 1024*1024) return (bytes/1024).toFixed(1) + ' KB';
+            if (bytes < 1024*1024*1024) return (bytes/1024/1024).toFixed(1) + ' MB';
+            return (bytes/1024/1024/1024).toFixed(2) + ' GB';
+        }
+        
+        function download(path) {
+            window.location.href = '/download?f=' + encodeURIComponent(path);
+        }
+        
+        async function downloadAll() {
+            document.getElementById('status').textContent = 'Preparing ZIP...';
+            window.location.href = '/downloadzip?dir=' + encodeURIComponent(currentPath);
+            setTimeout(() => {
+                document.getElementById('status').textContent = 'ZIP download started';
+            }, 1000);
+        }
+        
+        async function del(path, isDir) {
+            const msg = isDir ? 'Delete folder ' + path + ' and all contents?' : 'Delete ' + path + '?';
+            if (!confirm(msg)) return;
+            
+            const endpoint = isDir ? '/rmdir' : '/delete';
+            const resp = await fetch(endpoint + '?f=' + encodeURIComponent(path));
+            if (resp.ok) {
+                document.getElementById('status').textContent = 'Deleted: ' + path;
+                loadDir(currentPath);
+            } else {
+                document.getElementById('status').textContent = 'Delete failed';
+            }
+        }
+        
+        function showNewFolderModal() {
+            document.getElementById('newFolderModal').style.display = 'flex';
+            document.getElementById('newFolderName').value = '';
+            document.getElementById('newFolderName').focus();
+        }
+        
+        function hideModal() {
+            document.getElementById('newFolderModal').style.display = 'none';
+        }
+        
+        async function createFolder() {
+            const name = document.getElementById('newFolderName').value.trim();
+            if (!name) { alert('Enter folder name'); return; }
+            if (name.includes('/') || name.includes('..')) { alert('Invalid name'); return; }
+            
+            const path = (currentPath === '/' ? '' : currentPath) + '/' + name;
+            const resp = await fetch('/mkdir?f=' + encodeURIComponent(path));
+            if (resp.ok) {
+                document.getElementById('status').textContent = 'Created: ' + path;
+                hideModal();
+                loadDir(currentPath);
+            } else {
+                document.getElementById('status').textContent = 'Create folder failed';
+            }
+        }
+        
+        document.getElementById('uploadForm').onsubmit = async function(e) {
+            e.preventDefault();
+            const fileInput = document.getElementById('fileInput');
+            
+            if (!fileInput.files.length) {
+                alert('Select file(s) first');
+                return;
+            }
+            
+            const progressBar = document.getElementById('progressBar');
+            const progressFill = document.getElementById('progressFill');
+            progressBar.style.display = 'block';
+            progressFill.style.width = '0%';
+            
+            for (let i = 0; i < fileInput.files.length; i++) {
+                const file = fileInput.files[i];
+                document.getElementById('status').textContent = 'Uploading ' + (i+1) + '/' + fileInput.files.length + ': ' + file.name;
+                
+                const formData = new FormData();
+                formData.append('file', file);
+                
+                try {
+                    const xhr = new XMLHttpRequest();
+                    
+                    await new Promise((resolve, reject) => {
+                        xhr.upload.onprogress = function(e) {
+                            if (e.lengthComputable) {
+                                const pct = (e.loaded / e.total * 100);
+                                progressFill.style.width = pct + '%';
+                            }
+                        };
+                        xhr.onload = function() {
+                            if (xhr.status === 200) resolve();
+                            else reject(new Error('Upload failed'));
+                        };
+                        xhr.onerror = reject;
+                        xhr.open('POST', '/upload?dir=' + encodeURIComponent(currentPath));
+                        xhr.send(formData);
+                    });
+                } catch (e) {
+                    document.getElementById('status').textContent = 'Upload error: ' + e.message;
+                    progressBar.style.display = 'none';
+                    return;
+                }
+            }
+            
+            progressBar.style.display = 'none';
+            document.getElementById('status').textContent = 'Upload complete!';
+            fileInput.value = '';
+            loadDir(currentPath);
+        };
+        
+        // Handle Enter key in modal
+        document.getElementById('newFolderName').onkeydown = function(e) {
+            if (e.key === 'Enter') createFolder();
+            if (e.key === 'Escape') hideModal();
+        };
+        
+        // Initial load
+        loadSDInfo();
+        loadDir('/');
+    </script>
+</body>
+</html>
+)rawliteral";
+
+static const uint8_t WEB_INDEX_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xdd, 0x5b, 0x6d, 0x73, 0xdb, 0x36,
+    0x12, 0xfe, 0xee, 0x5f, 0x01, 0xab, 0xd3, 0x23, 0x95, 0x58, 0x6f, 0x4e, 0x32, 0xe3, 0x5a, 0x92,
+    0x33, 0x17, 0x3b, 0xbe, 0x78, 0x9a, 0x34, 0x9e, 0xbc, 0xcc, 0xf4, 0xda, 0xe6, 0x03, 0x44, 0x42,
+    0x12, 0x62, 0xbe, 0x1d, 0x09, 0xfa, 0xa5, 0xa9, 0xff, 0xfb, 0xed, 0x02, 0x24, 0x45, 0x82, 0x20,
+    0x45, 0x39, 0xb9, 0x74, 0xe6, 0xd4, 0x99, 0x5a, 0x22, 0xb0, 0x8b, 0xc5, 0xee, 0xb3, 0x0f, 0x16,
+    0x00, 0x33, 0xdb, 0x3f, 0x7b, 0x7b, 0xfa, 0xe1, 0xdf, 0x97, 0x2f, 0xc9, 0x5a, 0xf8, 0xde, 0xc9,
+    0xde, 0x2c, 0xff, 0xc3, 0xa8, 0x7b, 0xb2, 0x47, 0xe0, 0x33, 0xf3, 0x99, 0xa0, 0xc4, 0x59, 0xd3,
+    0x38, 0x61, 0x62, 0xde, 0xfb, 0xf8, 0xe1, 0x7c, 0x70, 0xd4, 0x2b, 0x37, 0x05, 0xd4, 0x67, 0xf3,
+    0xde, 0x35, 0x67, 0x37, 0x51, 0x18, 0x8b, 0x1e, 0x71, 0xc2, 0x40, 0xb0, 0x00, 0xba, 0xde, 0x70,
+    0x57, 0xac, 0xe7, 0x2e, 0xbb, 0xe6, 0x0e, 0x1b, 0xc8, 0x1f, 0x07, 0x84, 0x07, 0x5c, 0x70, 0xea,
+    0x0d, 0x12, 0x87, 0x7a, 0x6c, 0x3e, 0x19, 0x8e, 0x73, 0x55, 0x82, 0x0b, 0x8f, 0x9d, 0x5c, 0xbe,
+    0x7d, 0xf7, 0xf3, 0xe9, 0xab, 0xb7, 0x97, 0xe4, 0x9c, 0x7b, 0x8c, 0xbc, 0xa1, 0x01, 0x5d, 0xb1,
+    0x78, 0x36, 0x52, 0x8d, 0xaa, 0x63, 0x22, 0xee, 0xf2, 0xef, 0xf8, 0x79, 0x44, 0xbe, 0x90, 0x45,
+    0x78, 0x3b, 0x48, 0xf8, 0x9f, 0x3c, 0x58, 0x1d, 0xc3, 0xf7, 0xd8, 0x65, 0xf1, 0x00, 0x1e, 0x4d,
+    0x89, 0x4f, 0xe3, 0x15, 0x0f, 0x8e, 0xc9, 0x78, 0x4a, 0x22, 0xea, 0xba, 0xb2, 0x1d, 0xbe, 0xdf,
+    0x17, 0xc2, 0x8b, 0xd0, 0xbd, 0x03, 0xf9, 0xe2, 0xb7, 0x7c, 0x46, 0x9d, 0xab, 0x55, 0x1c, 0xa6,
+    0x81, 0x7b, 0x4c, 0x7e, 0x18, 0x8f, 0xa1, 0x7f, 0xa5, 0xd9, 0x09, 0xbd, 0x30, 0x86, 0x96, 0xe5,
+    0x72, 0xa9, 0xb5, 0x2c, 0x61, 0xde, 0x83, 0x25, 0xf5, 0xb9, 0x77, 0x77, 0x4c, 0xac, 0xd3, 0x30,
+    0x8d, 0x39, 0x8b, 0xc9, 0x2f, 0xec, 0xc6, 0x3a, 0x20, 0x7e, 0x18, 0x84, 0x49, 0x44, 0x1d, 0x36,
+    0xad, 0x88, 0x14, 0x56, 0x1d, 0x8e, 0xa3, 0xdb, 0x6a, 0x93, 0x4f, 0x6f, 0x95, 0xcf, 0x8e, 0xc9,
+    0x4f, 0x63, 0x43, 0x6b, 0x36, 0x33, 0x42, 0x53, 0x11, 0x6e, 0xda, 0x36, 0x53, 0x5b, 0x4f, 0x6a,
+    0x13, 0xcb, 0x3d, 0x23, 0x44, 0xe8, 0xc3, 0x90, 0xd1, 0x2d, 0x49, 0x42, 0x8f, 0xbb, 0xa6, 0xb9,
+    0x64, 0x86, 0x15, 0x9d, 0x27, 0x68, 0x01, 0x31, 0x98, 0x50, 0xed, 0x51, 0xf7, 0x07, 0x84, 0x85,
+    0x41, 0xe3, 0xf0, 0x19, 0xf3, 0x4d, 0x56, 0x0e, 0x13, 0x77, 0xc0, 0x83, 0x65, 0x48, 0xbe, 0x18,
+    0x9d, 0x7c, 0x74, 0x74, 0x34, 0x6d, 0x1d, 0xf4, 0x59, 0xcb, 0xa0, 0xe3, 0xe1, 0x4f, 0x0d, 0x83,
+    0x2e, 0x62, 0x40, 0xb7, 0x13, 0xa7, 0xfe, 0x42, 0x1b, 0x37, 0x77, 0x2b, 0x4e, 0x06, 0x90, 0x62,
+    0x8e, 0xd5, 0x91, 0x3e, 0x66, 0x05, 0x31, 0x93, 0xc9, 0x64, 0x6a, 0x70, 0x3b, 0xe8, 0xdc, 0xf8,
+    0xfb, 0xc9, 0x93, 0x27, 0xdb, 0xec, 0xa2, 0x10, 0xbd, 0x0a, 0xd4, 0x04, 0xbb, 0x15, 0x03, 0x97,
+    0x39, 0x61, 0x4c, 0x05, 0x0f, 0xc1, 0xc6, 0x20, 0x0c, 0xd8, 0xb4, 0x49, 0xfa, 0x78, 0x1d, 0x5e,
+    0x03, 0xf8, 0xbe, 0xd4, 0xc5, 0xc0, 0x4a, 0x16, 0x7b, 0x5c, 0x93, 0x5d, 0x42, 0xba, 0x0d, 0x3c,
+    0x9e, 0x08, 0xcd, 0x21, 0x06, 0xe3, 0x9f, 0x3e, 0x7d, 0x3a, 0xed, 0xe4, 0x34, 0x5d, 0x3d, 0x17,
+    0xcc, 0xd7, 0x31, 0xe9, 0xf2, 0x24, 0xf2, 0x28, 0xe4, 0xcb, 0xd2, 0x63, 0x3a, 0xc0, 0x3e, 0xa7,
+    0x89, 0xe0, 0xcb, 0xbb, 0x41, 0xc6, 0x27, 0xc7, 0x44, 0x26, 0xd0, 0x60, 0xc1, 0xc4, 0x0d, 0x63,
+    0x81, 0xd6, 0x99, 0x7a, 0x7c, 0x15, 0xc8, 0x21, 0x92, 0x63, 0xe2, 0x40, 0x77, 0x16, 0x37, 0x84,
+    0xaf, 0x0e, 0x54, 0x2d, 0x31, 0x3a, 0x04, 0xaa, 0x98, 0x4f, 0xe1, 0xe7, 0x1a, 0x06, 0xcc, 0xdd,
+    0x3d, 0x9a, 0x88, 0x81, 0xb3, 0xe6, 0x9e, 0x2b, 0x69, 0xab, 0x32, 0x6e, 0x2d, 0xa0, 0x4a, 0x0c,
+    0xa6, 0x0f, 0x7d, 0x33, 0xe0, 0xc7, 0x7c, 0xb5, 0x16, 0x79, 0x3a, 0xea, 0x5d, 0x91, 0x88, 0xa1,
+    0x2b, 0xba, 0x12, 0xba, 0x4c, 0x89, 0x93, 0xc6, 0x09, 0x02, 0x28, 0x0a, 0xb9, 0xf4, 0x87, 0x59,
+    0xe0, 0x01, 0x48, 0x2b, 0x09, 0x3f, 0x08, 0x68, 0x98, 0x9f, 0xa5, 0x51, 0x31, 0xcb, 0x4b, 0x8c,
+    0x26, 0x93, 0x9a, 0xf8, 0x30, 0xdb, 0x8c, 0xff, 0x8e, 0xe4, 0x6c, 0xe5, 0x00, 0x32, 0xcc, 0xc7,
+    0x44, 0xba, 0xa1, 0x0a, 0x7e, 0x11, 0xe8, 0xd0, 0x2d, 0x47, 0x04, 0x27, 0x66, 0x64, 0x18, 0x24,
+    0x78, 0x23, 0xe2, 0xe5, 0xa4, 0xcd, 0x08, 0x02, 0xfb, 0xc8, 0xe4, 0x50, 0x47, 0x91, 0xee, 0xed,
+    0xe6, 0xb5, 0x81, 0x07, 0x6b, 0x16, 0x73, 0xd1, 0x95, 0xb8, 0x4a, 0xbc, 0xe7, 0xb1, 0xa5, 0x90,
+    0xe3, 0x9b, 0xe9, 0x43, 0x04, 0x66, 0x3c, 0x3a, 0x8e, 0xa3, 0x3b, 0x0b, 0x42, 0xe5, 0xe9, 0xdd,
+    0x10, 0xed, 0x55, 0x28, 0x18, 0xd2, 0x5f, 0x3e, 0xaf, 0xeb, 0x32, 0x0f, 0xfc, 0x6c, 0x3c, 0xae,
+    0x75, 0x4e, 0x7c, 0xea, 0xe1, 0xd0, 0x85, 0x3b, 0x9f, 0x80, 0x72, 0xe4, 0xd4, 0xaa, 0x0b, 0x8e,
+    0xc0, 0x05, 0x65, 0x51, 0x11, 0x86, 0xde, 0x82, 0xc6, 0x5a, 0x90, 0xab, 0xfc, 0x51, 0x69, 0x5a,
+    0xd1, 0xc8, 0x94, 0xec, 0x05, 0x5b, 0x3d, 0xab, 0x53, 0x3c, 0x2a, 0x19, 0xdc, 0xc4, 0x28, 0x88,
+    0xff, 0x37, 0x3a, 0x39, 0x8d, 0xbc, 0x90, 0xba, 0x83, 0x84, 0x39, 0x08, 0x73, 0xcd, 0x9c, 0x0d,
+    0xc9, 0x3c, 0x33, 0x93, 0x4c, 0xcd, 0x95, 0xa6, 0x28, 0x8b, 0x30, 0xd2, 0x35, 0x34, 0x1b, 0xc0,
+    0x83, 0x28, 0x15, 0xbf, 0x8b, 0xbb, 0x08, 0x6a, 0x30, 0x4c, 0xae, 0xde, 0x27, 0x9d, 0x63, 0xdb,
+    0x16, 0xb5, 0x72, 0xb4, 0x4d, 0x83, 0x45, 0x71, 0xb8, 0x8a, 0x59, 0x92, 0x0c, 0xea, 0xae, 0xcf,
+    0x92, 0x73, 0x32, 0x1e, 0xff, 0x58, 0xd5, 0xb9, 0x66, 0x8a, 0xa4, 0xea, 0x35, 0x4d, 0x0d, 0x6d,
+    0xcd, 0xb3, 0xaf, 0xc9, 0x16, 0x91, 0xae, 0x26, 0xa6, 0xc9, 0x56, 0x70, 0x83, 0xa7, 0x19, 0x9b,
+    0xdb, 0x54, 0xb7, 0xb6, 0x9d, 0x26, 0xb2, 0x49, 0xea, 0x42, 0x22, 0xa6, 0x41, 0xc2, 0x15, 0xcf,
+    0xc9, 0x2e, 0x00, 0xd8, 0xc3, 0xc4, 0x5c, 0xe0, 0x08, 0x2a, 0xd2, 0x44, 0x8f, 0x49, 0x85, 0xfa,
+    0xda, 0x31, 0x40, 0x76, 0xae, 0x6f, 0xca, 0x90, 0x40, 0xd6, 0x44, 0x48, 0xb4, 0x97, 0xb8, 0xdb,
+    0x31, 0xd1, 0x15, 0xc2, 0x55, 0x92, 0x34, 0xd7, 0x84, 0x8d, 0x3c, 0x58, 0x72, 0x9b, 0x1f, 0xba,
+    0xd4, 0x6b, 0x4a, 0x76, 0x03, 0x37, 0x87, 0x79, 0x38, 0x96, 0xfc, 0x96, 0xb9, 0x5a, 0xb4, 0xd0,
+    0x97, 0x40, 0x44, 0x8a, 0x3d, 0xc7, 0xd3, 0x46, 0x18, 0x77, 0x84, 0x49, 0xbc, 0x5a, 0x50, 0x7b,
+    0x7c, 0x20, 0xff, 0x1b, 0x1e, 0xf5, 0xa7, 0xed, 0x55, 0x8b, 0xa9, 0x18, 0x69, 0xad, 0x56, 0x74,
+    0x2f, 0xe4, 0xaa, 0x76, 0x0a, 0x62, 0x1e, 0xab, 0xc3, 0x2e, 0xb1, 0x6a, 0xdd, 0x7d, 0x3c, 0xad,
+    0xee, 0x3e, 0x1a, 0xad, 0x5b, 0x3f, 0xd9, 0x94, 0x29, 0x95, 0xfa, 0xbc, 0x59, 0x44, 0x02, 0x15,
+    0xa4, 0x2a, 0x31, 0xd0, 0xe8, 0x2a, 0x93, 0x9e, 0x8d, 0xb2, 0x7d, 0xdf, 0x6c, 0xa4, 0xb6, 0xa6,
+    0x33, 0xdc, 0xbb, 0x65, 0x5b, 0xc2, 0xf5, 0xa4, 0x69, 0xe3, 0x08, 0x2d, 0xaa, 0x8b, 0xcb, 0xaf,
+    0x89, 0x03, 0xd5, 0x57, 0x32, 0xef, 0x65, 0x5b, 0x8e, 0x1e, 0xe1, 0x2e, 0xfe, 0xb8, 0xc0, 0xef,
+    0x27, 0xaf, 0x81, 0x53, 0xc1, 0x17, 0xe4, 0xfd, 0x19, 0xc1, 0xc6, 0xe1, 0x70, 0x38, 0x1b, 0x81,
+    0x8c, 0x92, 0xae, 0xa9, 0xd8, 0x94, 0xda, 0x4a, 0x4b, 0xe9, 0xf7, 0x49, 0x9b, 0x5c, 0xb6, 0x88,
+    0xf5, 0x36, 0xdb, 0xd7, 0xd9, 0x22, 0x05, 0x57, 0x05, 0x85, 0x62, 0x11, 0xf4, 0x48, 0x18, 0x38,
+    0x1e, 0x77, 0xae, 0xe6, 0x3d, 0x24, 0xfa, 0x33, 0x1e, 0xdb, 0x50, 0x5a, 0xc4, 0xe0, 0xaf, 0x4b,
+    0x2a, 0xd6, 0xfd, 0xde, 0xc9, 0x3b, 0xb6, 0x04, 0x9a, 0x5b, 0xcf, 0x46, 0x4a, 0xb4, 0xa3, 0xae,
+    0x64, 0x1d, 0xde, 0xc0, 0x5e, 0xf4, 0x3c, 0xf4, 0x00, 0x17, 0x6f, 0x30, 0x0c, 0x36, 0xe8, 0x82,
+    0x27, 0x44, 0x3d, 0xda, 0x51, 0x9d, 0x1b, 0xde, 0x04, 0x68, 0xde, 0x3f, 0x3d, 0xa9, 0xe7, 0x2c,
+    0xfb, 0x49, 0xe0, 0x37, 0xb1, 0x7f, 0xbb, 0xb8, 0xec, 0x57, 0xf5, 0xb5, 0x39, 0xa5, 0xd8, 0x7b,
+    0x28, 0x5f, 0xe2, 0xcf, 0xd7, 0xf8, 0xab, 0xd5, 0x93, 0xd5, 0x55, 0xb0, 0xec, 0xd0, 0x44, 0xc4,
+    0x61, 0xb0, 0x3a, 0xf9, 0x28, 0x3b, 0x40, 0xee, 0x93, 0xcc, 0x7b, 0xc0, 0x3d, 0x6a, 0x9e, 0x59,
+    0x87, 0x8d, 0xc4, 0x32, 0x8c, 0x7d, 0x39, 0xb4, 0x52, 0x7a, 0x0e, 0x3f, 0x7b, 0x84, 0x05, 0x8e,
+    0x62, 0x50, 0x3f, 0xf5, 0x04, 0x8f, 0x68, 0x2c, 0x46, 0xd8, 0x6f, 0xe0, 0x52, 0x41, 0x4b, 0xc3,
+    0x49, 0x05, 0x0a, 0xc7, 0xa5, 0x35, 0xb8, 0x98, 0xc8, 0x05, 0xb6, 0xf4, 0xb2, 0x23, 0x12, 0xd5,
+    0xa4, 0xf4, 0x95, 0x8f, 0x30, 0xca, 0xce, 0x56, 0x4a, 0x92, 0x74, 0xe1, 0x73, 0x3c, 0x4a, 0xd9,
+    0xb8, 0x3e, 0x9b, 0x90, 0x21, 0x4c, 0xd2, 0xae, 0xd2, 0xef, 0x92, 0x97, 0xca, 0xcb, 0xb7, 0x32,
+    0x2a, 0x7f, 0xf2, 0xa2, 0x82, 0xc2, 0x46, 0x39, 0x5c, 0x4a, 0xab, 0x82, 0xe7, 0xf8, 0xa4, 0x1c,
+    0x1a, 0x2d, 0xbc, 0x6d, 0x41, 0x53, 0x6b, 0x61, 0x96, 0x78, 0xea, 0x3b, 0xa0, 0x99, 0xba, 0x77,
+    0x35, 0xa1, 0xfd, 0xc1, 0x80, 0x6c, 0xb0, 0x49, 0x24, 0x5e, 0xc9, 0x60, 0x50, 0x4f, 0x66, 0x49,
+    0x28, 0x4a, 0x63, 0x50, 0x41, 0x77, 0xcf, 0xec, 0x91, 0x0a, 0x01, 0xe9, 0x1e, 0x58, 0x3f, 0x39,
+    0x39, 0x85, 0x4c, 0x16, 0x8c, 0x94, 0xf3, 0x02, 0x9e, 0x36, 0x87, 0x5b, 0xae, 0xaf, 0xd5, 0xe1,
+    0x7f, 0x81, 0x60, 0xf7, 0x08, 0xac, 0x54, 0x0e, 0x5b, 0xcb, 0x07, 0xf3, 0x5e, 0x36, 0x0d, 0x84,
+    0x81, 0xc9, 0xeb, 0x92, 0xda, 0xc0, 0x36, 0x7d, 0xe9, 0xd7, 0xfa, 0x6e, 0x4d, 0x4a, 0x47, 0x1a,
+    0xaf, 0x06, 0xc3, 0xac, 0x54, 0x93, 0xa9, 0x43, 0xa6, 0x59, 0x19, 0xc9, 0xca, 0xf9, 0x92, 0xd2,
+    0x35, 0x77, 0x59, 0xc1, 0x17, 0xa7, 0x34, 0x70, 0x98, 0x67, 0xd6, 0xb8, 0x03, 0x26, 0x12, 0x27,
+    0xe6, 0x91, 0xd8, 0xf4, 0xf5, 0x98, 0x20, 0x25, 0x92, 0x23, 0x73, 0x62, 0x8d, 0xac, 0xcd, 0x9a,
+    0x53, 0x7c, 0xa1, 0xc9, 0x5d, 0xe0, 0x90, 0x65, 0x1a, 0xa8, 0xda, 0x17, 0x13, 0xe2, 0xfd, 0x19,
+    0x12, 0xb8, 0xdd, 0xd7, 0x56, 0x47, 0x11, 0xdf, 0x69, 0x4f, 0x54, 0x69, 0x13, 0x24, 0x82, 0x00,
+    0x8c, 0x23, 0x18, 0x82, 0xde, 0x50, 0x0e, 0xac, 0xc0, 0x84, 0xb3, 0xb6, 0xad, 0x11, 0x8d, 0xf8,
+    0x28, 0x71, 0x91, 0xfb, 0x2d, 0x6d, 0x45, 0xdf, 0x08, 0xca, 0x93, 0xaa, 0x5c, 0x10, 0xb5, 0x0c,
+    0x3f, 0x27, 0x61, 0x60, 0x1b, 0xfa, 0xbb, 0xa1, 0x93, 0xfa, 0x30, 0x9b, 0xe1, 0x8a, 0x89, 0x97,
+    0x1e, 0xc3, 0xaf, 0x2f, 0xee, 0x2e, 0x5c, 0xdb, 0x52, 0xeb, 0x8d, 0xd5, 0x1f, 0x22, 0x70, 0x4e,
+    0xb3, 0x75, 0x70, 0x4e, 0x6a, 0x0a, 0xf0, 0x63, 0xc1, 0x62, 0x74, 0x4a, 0x63, 0x58, 0xdf, 0x2d,
+    0xf2, 0x98, 0x60, 0x96, 0x53, 0xf1, 0x1e, 0x4a, 0x3f, 0x5b, 0xae, 0x50, 0x69, 0xc2, 0xdc, 0x3e,
+    0x3c, 0xb7, 0x08, 0x7e, 0x23, 0x23, 0x63, 0x27, 0x11, 0x0a, 0xea, 0xa9, 0x5e, 0xf2, 0x2b, 0xb1,
+    0xb1, 0x97, 0x71, 0x34, 0x5d, 0x14, 0x16, 0x19, 0xa6, 0x24, 0xe5, 0x37, 0xab, 0x3a, 0xc9, 0x7b,
+    0xe2, 0x50, 0x74, 0x1c, 0xeb, 0x1b, 0xdc, 0xbc, 0xeb, 0xec, 0xad, 0x6c, 0xd5, 0x25, 0x69, 0x40,
+    0xaf, 0x29, 0xf7, 0xe8, 0xc2, 0x63, 0xfa, 0x78, 0x86, 0x02, 0xa4, 0xf8, 0x52, 0x00, 0x22, 0x8d,
+    0x80, 0x9e, 0xd9, 0x8b, 0x62, 0x35, 0xae, 0xc1, 0x42, 0xc5, 0x11, 0xd9, 0x3c, 0x81, 0x71, 0x4b,
+    0x90, 0x1b, 0x42, 0x69, 0xc9, 0x05, 0xe0, 0x00, 0x8c, 0x03, 0xd2, 0x83, 0x82, 0xcc, 0x06, 0x8c,
+    0x9c, 0x90, 0x48, 0x0b, 0x2e, 0x22, 0x15, 0x8f, 0xc8, 0xd1, 0xea, 0x19, 0x25, 0xeb, 0x98, 0x2d,
+    0xe7, 0xbd, 0x1f, 0x0c, 0x6b, 0xf6, 0x1f, 0xd6, 0xe8, 0x0f, 0x40, 0x52, 0xcc, 0x44, 0x1a, 0x07,
+    0x64, 0x49, 0xbd, 0x84, 0x41, 0x3e, 0x8f, 0xe2, 0x30, 0x14, 0xb3, 0x11, 0x3d, 0xb1, 0xea, 0x6a,
+    0xa3, 0x0c, 0xf9, 0x96, 0x5e, 0x32, 0xc7, 0xc4, 0xce, 0xec, 0x26, 0xe1, 0x52, 0x19, 0x6f, 0xf2,
+    0xba, 0x94, 0x7f, 0x2c, 0x53, 0x07, 0xc2, 0x16, 0x35, 0x81, 0x38, 0xa1, 0x4b, 0x96, 0x25, 0x19,
+    0x4a, 0xd4, 0xbb, 0xc9, 0xe9, 0xa1, 0x1e, 0xc0, 0xd4, 0x96, 0x29, 0xe2, 0x40, 0x85, 0x3e, 0x80,
+    0x8a, 0x61, 0xc6, 0xd2, 0x16, 0x6c, 0x33, 0xcc, 0xfa, 0x7e, 0xaf, 0x13, 0x6a, 0x36, 0xd5, 0x15,
+    0x04, 0x87, 0x07, 0x01, 0x8b, 0x5f, 0x7d, 0x78, 0xf3, 0x1a, 0xec, 0x47, 0x4b, 0xa7, 0x6d, 0xc0,
+    0x30, 0xf0, 0x05, 0x1a, 0x8e, 0xf3, 0xae, 0x21, 0xa3, 0x42, 0x3f, 0xd2, 0x97, 0x7f, 0xfd, 0x55,
+    0xa5, 0x21, 0xfc, 0xd4, 0x11, 0x56, 0x6d, 0x37, 0xa0, 0x0d, 0x17, 0x1b, 0xca, 0xc1, 0x6a, 0xd0,
+    0xdb, 0x38, 0xc7, 0xbc, 0xea, 0xd1, 0xc9, 0xa7, 0x10, 0xae, 0x4c, 0xdc, 0xaa, 0xd5, 0x4f, 0xb8,
+    0x97, 0x28, 0xaa, 0xd8, 0xa2, 0x7a, 0xb5, 0x5a, 0x8c, 0x7b, 0x10, 0x43, 0x7a, 0xc9, 0x73, 0x97,
+    0xc7, 0x73, 0x0c, 0x2a, 0x14, 0x48, 0xa1, 0xcb, 0x3e, 0xbe, 0xbb, 0x38, 0x0d, 0xfd, 0x08, 0x36,
+    0x64, 0x81, 0xa8, 0xd4, 0xa9, 0x18, 0xf2, 0x7f, 0x2c, 0x53, 0xcf, 0x9b, 0x4f, 0x5a, 0x08, 0x15,
+    0x77, 0x40, 0xdd, 0x18, 0xb5, 0xf6, 0xa0, 0x9c, 0x89, 0x56, 0x87, 0xfe, 0xa3, 0x11, 0xb9, 0xa4,
+    0xb2, 0x10, 0x84, 0x19, 0x40, 0xd9, 0x18, 0xc2, 0xfc, 0x3d, 0x1e, 0x5c, 0xd5, 0x3a, 0xf2, 0x25,
+    0x29, 0xcf, 0x84, 0xec, 0xcf, 0x65, 0x4e, 0x99, 0x52, 0xae, 0x42, 0x29, 0x8a, 0xcb, 0x2a, 0x9c,
+    0x92, 0x2e, 0xa0, 0xd8, 0x84, 0x80, 0xc0, 0x6e, 0xb1, 0xd2, 0x80, 0xc7, 0xc0, 0x17, 0x81, 0xcb,
+    0x6e, 0xdf, 0x2e, 0x25, 0xe5, 0xf4, 0x8d, 0x58, 0xab, 0x25, 0x64, 0x43, 0xd4, 0xb7, 0x8a, 0x25,
+    0x11, 0x0d, 0xaa, 0x72, 0x0e, 0xd6, 0xcc, 0xbf, 0x0f, 0x87, 0x9f, 0xa0, 0x1c, 0x86, 0xc6, 0x07,
+    0xa8, 0x50, 0xb5, 0x4c, 0x07, 0x7e, 0xc8, 0x3c, 0x63, 0x66, 0x07, 0x04, 0x2a, 0x3d, 0x79, 0xb0,
+    0x11, 0x78, 0x10, 0xd2, 0xeb, 0x2c, 0x6e, 0x4a, 0x89, 0x3a, 0x0d, 0x35, 0x81, 0x47, 0x95, 0x55,
+    0x09, 0x59, 0xf2, 0x38, 0x11, 0x7b, 0x86, 0xd5, 0x33, 0x67, 0x69, 0x79, 0xcf, 0x01, 0x44, 0x2d,
+    0xc1, 0x9d, 0x2f, 0x26, 0x1c, 0x17, 0x13, 0x3e, 0xe4, 0x09, 0x38, 0xa6, 0xdf, 0x0e, 0x25, 0x94,
+    0xcb, 0x68, 0xa8, 0x82, 0xc3, 0xb9, 0xc2, 0x21, 0x79, 0x0e, 0x78, 0x27, 0xc7, 0x44, 0x4f, 0x36,
+    0xc9, 0xfa, 0x28, 0x3b, 0xc4, 0xd0, 0x7c, 0x67, 0x24, 0x9d, 0x7d, 0x07, 0x20, 0x15, 0x7e, 0x69,
+    0x5e, 0x68, 0x8a, 0xe9, 0x4b, 0x87, 0x7c, 0x03, 0x68, 0x0d, 0xba, 0xca, 0x37, 0x56, 0xd2, 0xa4,
+    0x38, 0xf3, 0x2e, 0xef, 0x9e, 0x99, 0x67, 0x9c, 0xd4, 0x01, 0xb0, 0x72, 0xca, 0xa0, 0xce, 0xfe,
+    0xb5, 0x28, 0xb1, 0xff, 0xc7, 0xa8, 0xfe, 0xb0, 0x66, 0xe0, 0x42, 0x98, 0x70, 0xf2, 0x30, 0x48,
+    0xef, 0xff, 0xff, 0x62, 0xfa, 0xfc, 0x6b, 0x31, 0x5d, 0x43, 0xe4, 0x57, 0x82, 0x51, 0x2f, 0xf0,
+    0x51, 0x35, 0xb6, 0xf4, 0x77, 0xd1, 0x6d, 0x06, 0x6a, 0x0d, 0xa0, 0xd9, 0x79, 0x8e, 0x39, 0xf5,
+    0x7a, 0x27, 0x67, 0xaf, 0xbb, 0x03, 0xf4, 0x5b, 0xa5, 0x86, 0x4c, 0xf4, 0xef, 0x96, 0x1b, 0xe6,
+    0xc2, 0x4b, 0xaa, 0xc6, 0xb5, 0xba, 0x01, 0x6c, 0x2f, 0xfd, 0x48, 0xdc, 0x15, 0x27, 0x4d, 0x86,
+    0xd1, 0xb3, 0x7d, 0x13, 0x31, 0x6f, 0x9c, 0x76, 0xab, 0xf6, 0x5e, 0xc6, 0x31, 0xa4, 0xa8, 0x97,
+    0x9d, 0x5c, 0x16, 0x55, 0x8d, 0x79, 0xdc, 0x4e, 0xfb, 0xa7, 0x12, 0xba, 0x16, 0x77, 0x82, 0xd5,
+    0xb6, 0x19, 0x58, 0x1a, 0xc9, 0x06, 0x32, 0x23, 0x93, 0xf1, 0xe1, 0xd3, 0x3e, 0xc9, 0x48, 0x58,
+    0x3d, 0xc4, 0xcd, 0xe2, 0x0b, 0x6d, 0x60, 0x5d, 0xe4, 0x51, 0x45, 0x4e, 0x35, 0x8d, 0xe4, 0x33,
+    0xd8, 0xac, 0x9e, 0xe3, 0xe1, 0xbd, 0x3d, 0x51, 0xdb, 0xce, 0x9f, 0x3b, 0xa9, 0x6a, 0xd4, 0x67,
+    0x56, 0xfa, 0x46, 0x57, 0xda, 0x20, 0xa8, 0x49, 0x1f, 0x2a, 0xe9, 0x7f, 0x95, 0xa5, 0xdb, 0x1c,
+    0x59, 0xe4, 0x8f, 0x69, 0xab, 0x71, 0xc3, 0x03, 0x68, 0x1f, 0x7a, 0xa1, 0x23, 0xaf, 0xca, 0x87,
+    0xb8, 0xf0, 0xc9, 0x23, 0x8f, 0x5c, 0xea, 0xf9, 0xb2, 0xa9, 0xc2, 0x96, 0xea, 0x76, 0xd9, 0xf2,
+    0x54, 0xce, 0x69, 0xf5, 0xfb, 0x94, 0xc6, 0x6d, 0xba, 0x3c, 0x9b, 0xab, 0x6f, 0xd3, 0x2f, 0x63,
+    0x06, 0xd5, 0x1c, 0x82, 0xed, 0xb7, 0x8b, 0x4b, 0xd8, 0x64, 0x58, 0xd3, 0xdd, 0xe6, 0xf5, 0x27,
+    0x8f, 0xba, 0x6e, 0x1f, 0xaa, 0x9a, 0x13, 0x26, 0x3e, 0x70, 0x9f, 0x85, 0xa9, 0xb0, 0x61, 0x16,
+    0xb0, 0xec, 0xec, 0x72, 0xe6, 0xd0, 0x30, 0x19, 0x98, 0x42, 0xe1, 0x1d, 0x02, 0x9d, 0x62, 0xc1,
+    0x5c, 0x3d, 0x69, 0x0e, 0xf0, 0x4e, 0x62, 0xbc, 0x9b, 0xc3, 0x81, 0xbf, 0x30, 0x4a, 0x07, 0x44,
+    0xad, 0x8b, 0xc6, 0x03, 0x08, 0x3f, 0x59, 0x81, 0x09, 0xb2, 0x03, 0x2e, 0x7d, 0x67, 0x0c, 0x36,
+    0x33, 0x2c, 0xa3, 0x0d, 0xa2, 0x8a, 0x66, 0xc5, 0x7b, 0x84, 0x06, 0x2e, 0xc1, 0xfb, 0xf2, 0xec,
+    0xc4, 0x32, 0x79, 0x8e, 0xcb, 0x64, 0x2e, 0x50, 0xee, 0xf9, 0xdc, 0x90, 0x2c, 0xfb, 0x20, 0x05,
+    0xe5, 0xaa, 0x6f, 0xc3, 0x78, 0xfd, 0x3c, 0x47, 0xb6, 0xee, 0x57, 0x59, 0xe0, 0xca, 0x77, 0x18,
+    0xca, 0x16, 0x8e, 0x62, 0x1f, 0x02, 0x27, 0xc7, 0x1e, 0xb9, 0x72, 0x70, 0x6b, 0xba, 0xd7, 0x69,
+    0xdf, 0x58, 0x68, 0x43, 0x1b, 0xdb, 0x71, 0xdd, 0xaf, 0xcf, 0x40, 0x6e, 0x09, 0xc3, 0xab, 0xfe,
+    0xb7, 0x08, 0xb8, 0x72, 0x5a, 0x76, 0x9a, 0x66, 0x3e, 0xfa, 0x30, 0x5d, 0xb8, 0xe8, 0xfc, 0xcd,
+    0x60, 0x15, 0xfa, 0x76, 0xe6, 0xc0, 0xaa, 0x06, 0x84, 0xee, 0x3e, 0x88, 0xad, 0x4d, 0x57, 0x3a,
+    0x5d, 0x53, 0xbc, 0x7a, 0x58, 0x0e, 0xd6, 0xc9, 0x33, 0xe8, 0x61, 0x76, 0xc5, 0x8a, 0xf6, 0xe1,
+    0xcb, 0x10, 0x9a, 0x59, 0xdb, 0xb5, 0xe1, 0xd9, 0x37, 0x28, 0xbb, 0xa6, 0x5e, 0xca, 0x0c, 0x1b,
+    0xf3, 0xce, 0x0a, 0x96, 0xd0, 0x31, 0xb1, 0xfb, 0xdd, 0xc8, 0xb6, 0x74, 0x42, 0xfd, 0xed, 0xa6,
+    0x8f, 0x77, 0xcc, 0xd6, 0x2e, 0x89, 0x5f, 0x3d, 0x7c, 0x37, 0xa6, 0xbd, 0xac, 0x03, 0xe7, 0x3b,
+    0xba, 0x71, 0x28, 0x62, 0xee, 0xdb, 0x86, 0xdc, 0xd8, 0x47, 0x75, 0x30, 0x10, 0xf0, 0x03, 0x8b,
+    0x85, 0x6d, 0xbd, 0xc4, 0x6b, 0xe4, 0x9c, 0x44, 0x02, 0xa9, 0x61, 0x9a, 0xe7, 0xbc, 0x56, 0xf1,
+    0xa0, 0x38, 0xf6, 0x80, 0x32, 0xc3, 0xf1, 0x52, 0x97, 0x25, 0xf2, 0x14, 0x02, 0x0b, 0x1b, 0xed,
+    0x29, 0x70, 0x7c, 0xbf, 0x34, 0xc4, 0x45, 0x00, 0x26, 0x71, 0x77, 0x8b, 0x76, 0xe3, 0x89, 0xeb,
+    0xc3, 0x6a, 0xff, 0x7a, 0xd9, 0xdf, 0x72, 0x40, 0xe5, 0x5f, 0x01, 0x47, 0xfd, 0xbd, 0x1c, 0xa3,
+    0x6e, 0x5c, 0x5a, 0x39, 0xa6, 0x84, 0xd6, 0xbf, 0x97, 0x80, 0xb2, 0xab, 0xae, 0x0c, 0x30, 0xbb,
+    0xf3, 0x50, 0xe3, 0x80, 0x9b, 0x6b, 0x54, 0x18, 0x14, 0xc2, 0x25, 0x2f, 0x33, 0x31, 0x5a, 0x95,
+    0x84, 0xa9, 0x57, 0xc0, 0x6c, 0x18, 0xc5, 0xec, 0x1a, 0xd4, 0x9c, 0xb1, 0x25, 0x4d, 0x3d, 0x61,
+    0xf7, 0x4d, 0xa1, 0x2f, 0xae, 0x55, 0xb7, 0x1d, 0xa7, 0xca, 0x4e, 0x56, 0xdb, 0xf9, 0xac, 0xcc,
+    0xa2, 0xa2, 0xab, 0x7c, 0x37, 0x31, 0x19, 0x7a, 0x2c, 0x58, 0xd5, 0x6b, 0x36, 0xf5, 0xd6, 0x86,
+    0x4c, 0x82, 0xf7, 0x40, 0xdc, 0x8e, 0xb2, 0xc3, 0x86, 0x0a, 0x59, 0x9e, 0x07, 0x99, 0x8e, 0x38,
+    0x4d, 0xcb, 0xed, 0xf6, 0x44, 0xd9, 0xdc, 0xcf, 0xb6, 0xcd, 0xaf, 0xd4, 0xcd, 0x32, 0x7a, 0xa9,
+    0x7c, 0x5d, 0xdb, 0x45, 0x11, 0xf6, 0xd3, 0x35, 0x95, 0x06, 0xa9, 0xf3, 0xe3, 0x02, 0xca, 0xbc,
+    0x2b, 0xcb, 0x2c, 0x80, 0xca, 0x32, 0x09, 0xf5, 0x76, 0x14, 0xf4, 0x1f, 0xff, 0xd8, 0x76, 0x18,
+    0x2d, 0xcf, 0x1a, 0xf0, 0x44, 0x97, 0x43, 0xdf, 0xf1, 0x14, 0xfe, 0xcc, 0x88, 0x39, 0x30, 0xd0,
+    0xf6, 0xf8, 0x71, 0xbf, 0xf1, 0xe4, 0x1a, 0xbb, 0x82, 0x0a, 0x4d, 0xf6, 0x77, 0xfe, 0x69, 0xfa,
+    0xf5, 0x09, 0xa3, 0x6e, 0xe0, 0xb1, 0xfc, 0xc5, 0xec, 0xb6, 0xf9, 0xe3, 0xc9, 0x86, 0xa8, 0xcc,
+    0xc6, 0x62, 0x73, 0x76, 0x7b, 0x07, 0x4f, 0x1b, 0x0e, 0x31, 0x9a, 0x66, 0x02, 0xf9, 0x73, 0x46,
+    0x05, 0x85, 0x91, 0x03, 0x79, 0x1b, 0xad, 0x7e, 0x9a, 0x58, 0x23, 0xef, 0x3a, 0xa4, 0x51, 0x04,
+    0xf5, 0x96, 0x82, 0x3f, 0xee, 0x98, 0xe1, 0x4f, 0x97, 0xa3, 0x74, 0xf3, 0x55, 0xc0, 0xc6, 0x94,
+    0xdb, 0x75, 0x9c, 0x59, 0xf1, 0xeb, 0x9b, 0xd7, 0xaf, 0x84, 0x88, 0xde, 0xb1, 0xff, 0xa4, 0x2c,
+    0x11, 0x26, 0x5b, 0x8c, 0x03, 0xc8, 0xec, 0x91, 0x5c, 0x8d, 0x4a, 0x2e, 0xe3, 0xd0, 0xe7, 0x09,
+    0xb3, 0x91, 0x79, 0x43, 0xef, 0x9a, 0x1d, 0x40, 0xaa, 0x7c, 0x86, 0x94, 0x6a, 0xa8, 0xec, 0xf3,
+    0x0f, 0x58, 0x91, 0xbd, 0xfc, 0x08, 0xa4, 0x92, 0x43, 0x0d, 0x63, 0xdd, 0x48, 0x28, 0xa6, 0x93,
+    0x7d, 0x96, 0x85, 0x06, 0xd7, 0x85, 0x54, 0xe0, 0x4d, 0xe3, 0x36, 0xa9, 0x52, 0x52, 0x39, 0x88,
+    0x03, 0x54, 0x01, 0x46, 0xc8, 0x3b, 0x57, 0xa6, 0x6e, 0x58, 0xc9, 0x23, 0xdc, 0x28, 0x34, 0x78,
+    0xa3, 0x63, 0x86, 0xa0, 0x72, 0x80, 0xcb, 0x8f, 0x56, 0xbb, 0x96, 0xfb, 0xc6, 0xd6, 0xfb, 0x69,
+    0xab, 0xeb, 0x42, 0xb5, 0xd3, 0x29, 0xf9, 0xab, 0x8b, 0xbb, 0x50, 0x32, 0x7b, 0x85, 0x11, 0xd7,
+    0xeb, 0x43, 0x98, 0x25, 0xc9, 0xc2, 0x66, 0x6f, 0x99, 0xaf, 0x5c, 0xa7, 0x54, 0x64, 0x6d, 0x0c,
+    0xbb, 0x3c, 0xae, 0xb0, 0xb3, 0x2c, 0xca, 0xd7, 0x9b, 0x7e, 0x8b, 0x92, 0xad, 0x13, 0x62, 0xf2,
+    0x00, 0x64, 0x9e, 0x0d, 0xb2, 0xa5, 0x37, 0x64, 0x86, 0x6d, 0x5d, 0xbe, 0x7d, 0xff, 0x01, 0x12,
+    0xc3, 0x1a, 0x29, 0x20, 0x75, 0xdd, 0x8d, 0xf6, 0xdb, 0x75, 0x27, 0x98, 0x74, 0x79, 0x12, 0x36,
+    0xf4, 0xbd, 0x37, 0x3c, 0x6f, 0x3f, 0x0c, 0xfa, 0x0a, 0x8e, 0x22, 0xd2, 0x33, 0x8a, 0x79, 0xd8,
+    0xd0, 0x07, 0xc0, 0xd1, 0x55, 0xc3, 0xf1, 0x69, 0x2b, 0xc9, 0x6b, 0x45, 0xf0, 0xb6, 0xd5, 0xad,
+    0x8e, 0xcf, 0x96, 0xf5, 0x6e, 0xd7, 0x81, 0x1f, 0xea, 0x0a, 0x07, 0x22, 0x8a, 0x3b, 0xad, 0x7d,
+    0xfd, 0x5e, 0xbd, 0x60, 0xec, 0xa6, 0xdd, 0x4a, 0x7b, 0x31, 0x76, 0x6f, 0x78, 0x3f, 0x65, 0x34,
+    0x22, 0xaf, 0x60, 0xc7, 0x0e, 0x4b, 0x90, 0x2a, 0xc6, 0xaf, 0xd8, 0x1d, 0xe1, 0x01, 0x91, 0x2f,
+    0x1d, 0xed, 0xed, 0xbc, 0x09, 0x0a, 0x03, 0x90, 0xc7, 0x23, 0x8a, 0x56, 0x92, 0x53, 0xa4, 0x86,
+    0x23, 0xc9, 0x82, 0x5a, 0x0e, 0x0c, 0xb5, 0x7c, 0x75, 0x3b, 0x32, 0x6d, 0x15, 0x49, 0x1c, 0x1a,
+    0xc1, 0x80, 0xe6, 0xd2, 0xb4, 0x61, 0x9e, 0x17, 0xea, 0x1f, 0xf2, 0x49, 0x27, 0xed, 0x95, 0x3d,
+    0x96, 0xbf, 0x90, 0x33, 0xdd, 0xd3, 0xfd, 0x88, 0x7b, 0x8c, 0x69, 0xfe, 0x36, 0x67, 0xf6, 0x06,
+    0xd0, 0x6c, 0xa4, 0xde, 0xe3, 0x9c, 0x8d, 0xd4, 0x3f, 0x3c, 0xfc, 0x2f, 0x33, 0x0f, 0x29, 0x1d,
+    0x90, 0x38, 0x00, 0x00,
+};
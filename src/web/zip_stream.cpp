@@ -0,0 +1,334 @@
+// Streaming store-only ZIP implementation
+
+#include "zip_stream.h"
+#include "../core/crc32.h"
+#include "http_server.h"
+#include <SD.h>
+#include <esp_heap_caps.h>
+#include <time.h>
+#include <new>
+
+#define ZIP_LOCAL_SIG 0x04034b50
+#define ZIP_DESCRIPTOR_SIG 0x08074b50
+#define ZIP_CENTRAL_SIG 0x02014b50
+#define ZIP_END_SIG 0x06054b50
+#define ZIP_VERSION 20              // 2.0: data descriptors
+#define ZIP_FLAGS 0x0808            // Bit 3: sizes in descriptor, bit 11: UTF-8 names
+
+static void put16(uint8_t* p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static void put32(uint8_t* p, uint32_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = v >> 24;
+}
+
+// MS-DOS date/time; anything before 1980 (clock never set) becomes 1980-01-01
+static void dosDateTime(time_t t, uint16_t& date, uint16_t& time) {
+    struct tm tm;
+    if (t <= 0 || !localtime_r(&t, &tm) || tm.tm_year < 80) {
+        date = (1 << 5) | 1;
+        time = 0;
+        return;
+    }
+    date = ((tm.tm_year - 80) << 9) | ((tm.tm_mon + 1) << 5) | tm.tm_mday;
+    time = (tm.tm_hour << 11) | (tm.tm_min << 5) | (tm.tm_sec / 2);
+}
+
+ZipStream::ZipStream()
+    : phase(Phase::NEXT_FILE), written(0), centralStart(0), centralCount(0),
+      depth(0), rootLen(0), fileCrc(0), fileSize(0), pendingLen(0), pendingPos(0) {
+    path[0] = 0;
+}
+
+ZipStream::~ZipStream() {
+    if (file) file.close();
+    endWalk();
+}
+
+ZipStream* ZipStream::open(const char* dir) {
+    size_t len = strlen(dir);
+    while (len > 1 && dir[len - 1] == '/') len--;
+    if (len >= ZIP_MAX_PATH) return nullptr;
+
+    ZipStream* z = new (std::nothrow) ZipStream();
+    if (!z) return nullptr;
+
+    // The root is "" so its children come out as "/name"
+    if (len == 1 && dir[0] == '/') len = 0;
+    memcpy(z->path, dir, len);
+    z->path[len] = 0;
+    z->rootLen = len;
+
+    if (!z->startWalk()) {
+        delete z;
+        return nullptr;
+    }
+    return z;
+}
+
+bool ZipStream::reserveEntry() {
+    if (entries.size() < entries.capacity()) return true;
+    size_t next = entries.empty() ? 64 : entries.capacity() * 2;
+    if (next > ZIP_MAX_ENTRIES) next = ZIP_MAX_ENTRIES;
+    // The old array stays live while it's copied into the new one
+    if (next * sizeof(Entry) + ZIP_HEAP_RESERVE > heap_caps_get_largest_free_block(MALLOC_CAP_8BIT)) {
+        return false;
+    }
+    entries.reserve(next);
+    return true;
+}
+
+bool ZipStream::startWalk() {
+    path[rootLen] = 0;
+    File dir = SD.open(rootLen ? path : "/");
+    if (!dir || !dir.isDirectory()) {
+        if (dir) dir.close();
+        return false;
+    }
+    stack[0].dir = dir;
+    stack[0].pathLen = rootLen;
+    depth = 1;
+    return true;
+}
+
+void ZipStream::endWalk() {
+    while (depth > 0) {
+        stack[--depth].dir.close();
+    }
+}
+
+bool ZipStream::nextFile(File& out) {
+    // Depth first, in directory order; both walks see the same sequence
+    while (depth > 0) {
+        Level& top = stack[depth - 1];
+        File entry = top.dir.openNextFile();
+        if (!entry) {
+            top.dir.close();
+            depth--;
+            continue;
+        }
+
+        const char* name = entry.name();
+        const char* slash = strrchr(name, '/');
+        if (slash) name = slash + 1;
+        size_t nameLen = strlen(name);
+        if (top.pathLen + 1 + nameLen >= ZIP_MAX_PATH) {
+            Serial.printf("[ZIP] Path too long, skipped: %s\n", name);
+            entry.close();
+            continue;
+        }
+        path[top.pathLen] = '/';
+        memcpy(path + top.pathLen + 1, name, nameLen + 1);
+        uint16_t len = top.pathLen + 1 + nameLen;
+
+        if (entry.isDirectory()) {
+            if (depth < ZIP_MAX_DEPTH) {
+                stack[depth].dir = entry;
+                stack[depth].pathLen = len;
+                depth++;
+            } else {
+                Serial.printf("[ZIP] Too deep, skipped: %s\n", path);
+                entry.close();
+            }
+            continue;
+        }
+        out = entry;
+        return true;
+    }
+    return false;
+}
+
+void ZipStream::queueLocalHeader(uint16_t date, uint16_t time) {
+    const char* name = archiveName();
+    uint16_t nameLen = strlen(name);
+    uint8_t* p = pending;
+    put32(p, ZIP_LOCAL_SIG);
+    put16(p + 4, ZIP_VERSION);
+    put16(p + 6, ZIP_FLAGS);
+    put16(p + 8, 0);                // Stored
+    put16(p + 10, time);
+    put16(p + 12, date);
+    put32(p + 14, 0);               // CRC and sizes follow the data
+    put32(p + 18, 0);
+    put32(p + 22, 0);
+    put16(p + 26, nameLen);
+    put16(p + 28, 0);
+    memcpy(p + 30, name, nameLen);
+    pendingLen = 30 + nameLen;
+    pendingPos = 0;
+}
+
+void ZipStream::queueDescriptor() {
+    uint8_t* p = pending;
+    put32(p, ZIP_DESCRIPTOR_SIG);
+    put32(p + 4, fileCrc);
+    put32(p + 8, fileSize);
+    put32(p + 12, fileSize);
+    pendingLen = 16;
+    pendingPos = 0;
+}
+
+void ZipStream::queueCentralHeader(const Entry& e, uint16_t date, uint16_t time) {
+    const char* name = archiveName();
+    uint16_t nameLen = strlen(name);
+    uint8_t* p = pending;
+    put32(p, ZIP_CENTRAL_SIG);
+    put16(p + 4, ZIP_VERSION);      // Made by
+    put16(p + 6, ZIP_VERSION);      // Needed
+    put16(p + 8, ZIP_FLAGS);
+    put16(p + 10, 0);
+    put16(p + 12, time);
+    put16(p + 14, date);
+    put32(p + 16, e.crc);
+    put32(p + 20, e.size);
+    put32(p + 24, e.size);
+    put16(p + 28, nameLen);
+    put16(p + 30, 0);               // Extra
+    put16(p + 32, 0);               // Comment
+    put16(p + 34, 0);               // Disk
+    put16(p + 36, 0);               // Internal attributes
+    put32(p + 38, 0);               // External attributes
+    put32(p + 42, e.offset);
+    memcpy(p + 46, name, nameLen);
+    pendingLen = 46 + nameLen;
+    pendingPos = 0;
+}
+
+void ZipStream::queueEnd() {
+    uint8_t* p = pending;
+    put32(p, ZIP_END_SIG);
+    put16(p + 4, 0);
+    put16(p + 6, 0);
+    put16(p + 8, centralCount);
+    put16(p + 10, centralCount);
+    put32(p + 12, written - centralStart);
+    put32(p + 16, centralStart);
+    put16(p + 20, 0);
+    pendingLen = 22;
+    pendingPos = 0;
+}
+
+size_t ZipStream::produce(uint8_t* buf, size_t max) {
+    size_t n = pendingLen - pendingPos;
+    if (n > max) n = max;
+    memcpy(buf, pending + pendingPos, n);
+    pendingPos += n;
+    written += n;
+    return n;
+}
+
+size_t ZipStream::fill(void* ctx, uint8_t* buf, size_t max) {
+    ZipStream* z = (ZipStream*)ctx;
+    size_t out = 0;
+
+    while (out < max) {
+        if (z->pendingPos < z->pendingLen) {
+            out += z->produce(buf + out, max - out);
+            continue;
+        }
+
+        switch (z->phase) {
+            case Phase::NEXT_FILE: {
+                File f;
+                bool more = z->entries.size() < ZIP_MAX_ENTRIES && z->nextFile(f);
+                // Offsets are 32-bit without ZIP64: stop before crossing 4 GB
+                if (more && (uint64_t)z->written + f.size() + 2 * (46 + ZIP_MAX_PATH) > 0xFFFFFFFFull) {
+                    Serial.println("[ZIP] 4 GB limit reached, archive truncated");
+                    f.close();
+                    more = false;
+                }
+                if (more && !z->reserveEntry()) {
+                    Serial.printf("[ZIP] Heap limit reached at %u files, archive truncated\n",
+                                  (unsigned)z->entries.size());
+                    f.close();
+                    more = false;
+                }
+                if (!more) {
+                    z->endWalk();
+                    z->centralStart = z->written;
+                    if (z->startWalk()) {
+                        z->phase = Phase::CENTRAL;
+                    } else {
+                        z->queueEnd();
+                        z->phase = Phase::DONE;
+                    }
+                    break;
+                }
+
+                uint16_t date, time;
+                dosDateTime(f.getLastWrite(), date, time);
+                const char* name = z->archiveName();
+                z->entries.push_back({0, 0, z->written, Crc32::compute((const uint8_t*)name, strlen(name))});
+                z->queueLocalHeader(date, time);
+                z->file = f;
+                z->fileCrc = 0;
+                z->fileSize = 0;
+                z->phase = Phase::DATA;
+                break;
+            }
+
+            case Phase::DATA: {
+                // Straight into the response buffer, CRC on the way through
+                int n = z->file.read(buf + out, max - out);
+                if (n > 0) {
+                    z->fileCrc = Crc32::update(z->fileCrc, buf + out, n);
+                    z->fileSize += n;
+                    z->written += n;
+                    out += n;
+                } else {
+                    z->file.close();
+                    Entry& e = z->entries.back();
+                    e.crc = z->fileCrc;
+                    e.size = z->fileSize;
+                    z->queueDescriptor();
+                    z->phase = Phase::NEXT_FILE;
+                }
+                break;
+            }
+
+            case Phase::CENTRAL: {
+                // Names come from walking the tree again; each has to be
+                // the one its entry was written under
+                if (z->centralCount >= z->entries.size()) {
+                    z->endWalk();
+                    z->queueEnd();
+                    z->phase = Phase::DONE;
+                    Serial.printf("[ZIP] %u files, %lu bytes\n", (unsigned)z->centralCount,
+                                  (unsigned long)(z->written + 22));
+                    break;
+                }
+                File f;
+                const Entry& e = z->entries[z->centralCount];
+                bool found = z->nextFile(f);
+                const char* name = z->archiveName();
+                if (!found || Crc32::compute((const uint8_t*)name, strlen(name)) != e.nameCrc) {
+                    Serial.printf("[ZIP] Folder changed while sending (entry %u), aborted\n",
+                                  (unsigned)z->centralCount);
+                    if (found) f.close();
+                    z->endWalk();
+                    z->phase = Phase::DONE;
+                    return HTTP_FILL_ABORT;
+                }
+                uint16_t date, time;
+                dosDateTime(f.getLastWrite(), date, time);
+                f.close();
+                z->queueCentralHeader(e, date, time);
+                z->centralCount++;
+                break;
+            }
+
+            case Phase::DONE:
+                return out;
+        }
+    }
+    return out;
+}
+
+void ZipStream::release(void* ctx) {
+    delete (ZipStream*)ctx;
+}
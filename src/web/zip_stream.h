@@ -0,0 +1,89 @@
+// Streaming store-only ZIP of an SD directory tree
+//
+// Produces the archive on the fly for HttpServer::sendStream: a local
+// header per file, the file data straight from SD with its CRC-32 taken
+// on the way through, a data descriptor, then the central directory. No
+// temp files; RAM is a few hundred bytes plus 16 bytes per file for the
+// CRC/size/offset the central directory needs and a CRC-32 of the name.
+// That table only grows while the largest free heap block can take the
+// doubled array with ZIP_HEAP_RESERVE to spare; past that the archive is
+// cut short with a complete central directory, like the 4 GB limit.
+// Names are re-read by walking the tree a second time; if that walk no
+// longer lines up with the entries (the folder changed while it was being
+// sent), the stream is aborted rather than pairing names with the wrong
+// data.
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <vector>
+
+#define ZIP_MAX_DEPTH 8
+#define ZIP_MAX_PATH 192
+#define ZIP_MAX_ENTRIES 0xFFFF      // No ZIP64
+#define ZIP_HEAP_RESERVE 32768      // Left free for everything else when the entry table grows
+
+class ZipStream {
+public:
+    // nullptr if dir isn't a directory or there's no memory
+    static ZipStream* open(const char* dir);
+
+    // HttpServer body callbacks; ctx is the ZipStream
+    static size_t fill(void* ctx, uint8_t* buf, size_t max);     // HTTP_FILL_ABORT if the folder changed
+    static void release(void* ctx);
+
+private:
+    enum class Phase : uint8_t {
+        NEXT_FILE,      // Walk to the next file, queue its local header
+        DATA,
+        CENTRAL,        // Second walk: one central header per entry
+        DONE
+    };
+
+    struct Entry {
+        uint32_t crc;
+        uint32_t size;
+        uint32_t offset;    // Of the local header
+        uint32_t nameCrc;   // Archive name, checked by the second walk
+    };
+
+    struct Level {
+        File dir;
+        uint16_t pathLen;
+    };
+
+    Phase phase;
+    std::vector<Entry> entries;
+    uint32_t written;           // Archive bytes produced so far
+    uint32_t centralStart;
+    uint16_t centralCount;
+
+    // Directory walk
+    Level stack[ZIP_MAX_DEPTH];
+    uint8_t depth;
+    char path[ZIP_MAX_PATH];    // Current file's SD path
+    uint16_t rootLen;           // Archive names start after this prefix
+
+    File file;
+    uint32_t fileCrc;
+    uint32_t fileSize;
+
+    // Header bytes waiting to go out ahead of anything else
+    uint8_t pending[46 + ZIP_MAX_PATH];
+    uint16_t pendingLen;
+    uint16_t pendingPos;
+
+    ZipStream();
+    ~ZipStream();
+
+    bool reserveEntry();        // Room for one more entry without starving the heap
+    bool startWalk();
+    bool nextFile(File& out);
+    void endWalk();
+    const char* archiveName() const { return path + rootLen + 1; }
+    void queueLocalHeader(uint16_t date, uint16_t time);
+    void queueDescriptor();
+    void queueCentralHeader(const Entry& e, uint16_t date, uint16_t time);
+    void queueEnd();
+    size_t produce(uint8_t* buf, size_t max);
+};
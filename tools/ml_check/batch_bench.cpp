@@ -0,0 +1,114 @@
+// Host benchmark: scalar vs column-major network classification
+//
+// Usage: batch_bench [rows] [passes]
+//
+// The "before" path is what OINK/WARHOG did per network: toFeatureVector,
+// normalizeVector, then the rule set (HeuristicRules::score) one vector at
+// a time. The "after" path is MLInference::classifyNetworks' heuristic
+// route: toColumns, normalizeColumns, BatchKernels::heuristicScores over
+// the whole table. Both run the firmware sources; labels and confidences
+// must match exactly. Prints networks classified per millisecond.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "ml/features.h"
+#include "ml/heuristic.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedMs(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// Same shape of table as MLInference::benchmarkBatch generates on device
+static std::vector<WiFiFeatures> syntheticNetworks(size_t rows) {
+    std::mt19937 rng(1);
+    auto pick = [&](int lo, int hi) { return lo + (int)(rng() % (uint32_t)(hi - lo)); };
+
+    std::vector<WiFiFeatures> nets(rows);
+    for (auto& f : nets) {
+        memset(&f, 0, sizeof(f));
+        f.rssi = pick(-95, -20);
+        f.noise = pick(-98, -85);
+        f.snr = (float)(f.rssi - f.noise);
+        f.channel = pick(1, 14);
+        f.beaconInterval = pick(0, 4) == 0 ? pick(20, 400) : 100;
+        f.hasWPS = pick(0, 4) == 0;
+        f.hasWPA = pick(0, 5) == 0;
+        f.hasWPA2 = pick(0, 4) != 0;
+        f.hasWPA3 = pick(0, 6) == 0;
+        f.isHidden = pick(0, 8) == 0;
+        f.beaconJitter = pick(0, 200) / 10.0f;
+        f.vendorIECount = pick(0, 6);
+        f.supportedRates = pick(1, 12);
+        f.htCapabilities = pick(0, 2);
+        f.vhtCapabilities = pick(0, 2);
+        f.twinScore = pick(0, 10) == 0 ? 0.6f : 0.0f;
+    }
+    return nets;
+}
+
+int main(int argc, char** argv) {
+    size_t rows = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200;
+    int passes = argc > 2 ? atoi(argv[2]) : 2000;
+    if (rows == 0 || passes <= 0) {
+        fprintf(stderr, "usage: batch_bench [rows] [passes]\n");
+        return 2;
+    }
+
+    // Identity normalization: the z-score passes run, values are unchanged,
+    // so the heuristic sees raw features on both paths as on device
+    float means[FEATURE_VECTOR_SIZE] = {0};
+    float stds[FEATURE_VECTOR_SIZE];
+    for (int i = 0; i < FEATURE_VECTOR_SIZE; i++) stds[i] = 1.0f;
+    FeatureExtractor::setNormalizationParams(means, stds);
+
+    std::vector<WiFiFeatures> nets = syntheticNetworks(rows);
+    std::vector<uint8_t> scalarLabel(rows);
+    std::vector<float> scalarConf(rows);
+    volatile float sink = 0.0f;
+
+    // Before: one vector at a time
+    float vec[FEATURE_VECTOR_SIZE];
+    float scores[ML_CLASS_COUNT];
+    Clock::time_point t0 = Clock::now();
+    for (int p = 0; p < passes; p++) {
+        for (size_t r = 0; r < rows; r++) {
+            FeatureExtractor::toFeatureVector(nets[r], vec);
+            FeatureExtractor::normalizeVector(vec);
+            uint8_t best = HeuristicRules::score(vec, scores);
+            scalarLabel[r] = best;
+            scalarConf[r] = scores[best];
+        }
+        sink = sink + scalarConf[p % rows];
+    }
+    double scalarMs = elapsedMs(t0);
+
+    // After: transpose once, column kernels over the table
+    FeatureMatrix m;
+    ScoreMatrix out;
+    t0 = Clock::now();
+    for (int p = 0; p < passes; p++) {
+        FeatureExtractor::toColumns(nets, m);
+        FeatureExtractor::normalizeColumns(m);
+        BatchKernels::heuristicScores(m, out);
+        sink = sink + out.confidence[p % rows];
+    }
+    double batchMs = elapsedMs(t0);
+
+    size_t mismatches = 0;
+    for (size_t r = 0; r < rows; r++) {
+        if (scalarLabel[r] != out.label[r] || scalarConf[r] != out.confidence[r]) mismatches++;
+    }
+
+    double total = (double)rows * passes;
+    printf("rows %zu x %d passes\n", rows, passes);
+    printf("  scalar  %10.1f nets/ms\n", total / scalarMs);
+    printf("  batch   %10.1f nets/ms  (%.2fx)\n", total / batchMs, scalarMs / batchMs);
+    printf("  parity  %s (%zu of %zu rows differ)\n", mismatches ? "MISMATCH" : "OK", mismatches, rows);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+// Host parity check: ForestClassifier::predict vs train_model.py
+//
+// Usage: forest_parity reference.csv
+//
+// reference.csv comes from `train_model.py train-forest --reference`:
+// every holdout row with the scores forest_predict() gave it. forest.cpp
+// is compiled against the header the same run generated
+// (FOREST_MODEL_HEADER), so this checks the emitted C++ tables and the
+// device traversal code, not a re-implementation. Labels must match on
+// every row; scores are compared bit for bit (both sides accumulate the
+// pre-divided float32 leaf distributions in tree order). Also replays the
+// embedded FOREST_GOLDEN rows through selfTest() and times predict().
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+#include "ml/forest.h"
+
+#define CLASSES 5
+#define FEATURES 24
+#define PAD 32          // predict() reads a full feature vector
+
+struct RefRow {
+    int label;
+    float scores[CLASSES];
+    float x[PAD];
+};
+
+static bool loadReference(const char* path, std::vector<RefRow>& rows) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    char line[2048];
+    if (!fgets(line, sizeof(line), f)) {        // Header
+        fclose(f);
+        return false;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        RefRow r;
+        memset(&r, 0, sizeof(r));
+        char* p = line;
+        r.label = (int)strtol(p, &p, 10);
+        for (int c = 0; c < CLASSES; c++) r.scores[c] = strtof(p + 1, &p);
+        for (int i = 0; i < FEATURES; i++) r.x[i] = strtof(p + 1, &p);
+        if (*p != '\n' && *p != '\r' && *p != 0) {
+            fprintf(stderr, "%s: bad row %zu\n", path, rows.size() + 1);
+            fclose(f);
+            return false;
+        }
+        rows.push_back(r);
+    }
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: forest_parity reference.csv\n");
+        return 2;
+    }
+    if (!ForestClassifier::isAvailable()) {
+        fprintf(stderr, "forest_parity: built against a placeholder forest_model.h\n");
+        return 2;
+    }
+
+    std::vector<RefRow> rows;
+    if (!loadReference(argv[1], rows) || rows.empty()) {
+        fprintf(stderr, "forest_parity: no reference rows\n");
+        return 2;
+    }
+
+    size_t labelMismatches = 0;
+    size_t scoreMismatches = 0;
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < rows.size(); i++) {
+        float scores[CLASSES];
+        ForestClassifier::predict(rows[i].x, scores);
+
+        int best = 0;
+        for (int c = 1; c < CLASSES; c++) {
+            if (scores[c] > scores[best]) best = c;
+        }
+        if (best != rows[i].label) {
+            labelMismatches++;
+            if (labelMismatches <= 5) {
+                printf("  row %zu: C++ %d, Python %d\n", i, best, rows[i].label);
+            }
+        }
+        bool exact = true;
+        for (int c = 0; c < CLASSES; c++) {
+            float d = fabsf(scores[c] - rows[i].scores[c]);
+            if (d > maxDiff) maxDiff = d;
+            if (scores[c] != rows[i].scores[c]) exact = false;
+        }
+        if (!exact) scoreMismatches++;
+    }
+
+    // Timing: every holdout row, many passes
+    const int passes = 2000;
+    volatile float sink = 0.0f;
+    float scores[CLASSES];
+    auto t0 = std::chrono::steady_clock::now();
+    for (int p = 0; p < passes; p++) {
+        for (size_t i = 0; i < rows.size(); i++) {
+            ForestClassifier::predict(rows[i].x, scores);
+            sink = sink + scores[0];
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+
+    bool golden = ForestClassifier::selfTest();
+
+    printf("forest: %u trees, depth %u, %zu table bytes\n", ForestClassifier::getTreeCount(),
+           ForestClassifier::getDepth(), ForestClassifier::getTableBytes());
+    printf("  holdout rows   %zu\n", rows.size());
+    printf("  label parity   %zu/%zu\n", rows.size() - labelMismatches, rows.size());
+    printf("  exact scores   %zu/%zu (max diff %g)\n", rows.size() - scoreMismatches, rows.size(), maxDiff);
+    printf("  embedded golden %s\n", golden ? "OK" : "MISMATCH");
+    printf("  predict        %.1f ns/classification\n", ns / ((double)passes * rows.size()));
+
+    return (labelMismatches == 0 && scoreMismatches == 0 && golden) ? 0 : 1;
+}
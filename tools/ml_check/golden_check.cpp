@@ -0,0 +1,157 @@
+// Host golden check: the device classifiers vs golden_vectors.h
+//
+// Usage: golden_check [model.bin]
+//
+// Runs every GOLDEN_X row through the real HeuristicRules::score and
+// BatchKernels::heuristicScores and compares labels with
+// GOLDEN_HEURISTIC_Y and scores with GOLDEN_HEURISTIC_SCORES (1e-5, the
+// tolerance benchmarkGolden uses on the device). Given a PCML model, binds
+// it with QuantModel and compares against GOLDEN_MODEL_Y when the model's
+// payload CRC is the GOLDEN_MODEL_CRC the header was generated for;
+// other models are run and reported without a reference. Regenerate the
+// header with `train_model.py golden` after changing either side.
+// GOLDEN_VECTORS_HEADER swaps in a header generated for another model
+// (`make check` does this with synth_model.py's output).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "ml/batch.h"
+#ifdef GOLDEN_VECTORS_HEADER
+#include GOLDEN_VECTORS_HEADER
+#else
+#include "ml/golden_vectors.h"
+#endif
+#include "ml/heuristic.h"
+#include "ml/quant_model.h"
+
+static int failures = 0;
+
+static void report(const char* what, int mismatches) {
+    printf("  %-32s %d/%d %s\n", what, GOLDEN_COUNT - mismatches, GOLDEN_COUNT, mismatches ? "FAIL" : "OK");
+    if (mismatches) failures++;
+}
+
+static int argmax(const float* scores) {
+    int best = 0;
+    for (int c = 1; c < GOLDEN_CLASSES; c++) {
+        if (scores[c] > scores[best]) best = c;
+    }
+    return best;
+}
+
+static bool scoresMatch(const float* got, const float* want) {
+    for (int c = 0; c < GOLDEN_CLASSES; c++) {
+        if (fabsf(got[c] - want[c]) > 1e-5f) return false;
+    }
+    return true;
+}
+
+static void checkHeuristic() {
+    int mismatches = 0;
+    for (int i = 0; i < GOLDEN_COUNT; i++) {
+        float vec[FEATURE_VECTOR_SIZE] = {0};
+        memcpy(vec, GOLDEN_X[i], sizeof(GOLDEN_X[i]));
+        float scores[ML_CLASS_COUNT];
+        uint8_t label = HeuristicRules::score(vec, scores);
+        if (label != GOLDEN_HEURISTIC_Y[i] || !scoresMatch(scores, GOLDEN_HEURISTIC_SCORES[i])) {
+            mismatches++;
+            printf("  %s: heuristic %d, expected %d\n", GOLDEN_NAME[i], label, GOLDEN_HEURISTIC_Y[i]);
+        }
+    }
+    report("HeuristicRules::score", mismatches);
+}
+
+static void checkBatch() {
+    FeatureMatrix m;
+    m.resize(GOLDEN_COUNT);
+    for (int i = 0; i < GOLDEN_COUNT; i++) {
+        for (int f = 0; f < GOLDEN_FEATURES; f++) m.column(f)[i] = GOLDEN_X[i][f];
+    }
+    ScoreMatrix out;
+    BatchKernels::heuristicScores(m, out);
+
+    int mismatches = 0;
+    for (int i = 0; i < GOLDEN_COUNT; i++) {
+        float scores[ML_CLASS_COUNT];
+        for (int c = 0; c < ML_CLASS_COUNT; c++) scores[c] = out.column(c)[i];
+        if (out.label[i] != GOLDEN_HEURISTIC_Y[i] || !scoresMatch(scores, GOLDEN_HEURISTIC_SCORES[i])) {
+            mismatches++;
+            printf("  %s: batch %d, expected %d\n", GOLDEN_NAME[i], out.label[i], GOLDEN_HEURISTIC_Y[i]);
+        }
+    }
+    report("BatchKernels::heuristicScores", mismatches);
+}
+
+static uint8_t* readFile(const char* path, size_t* size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return nullptr;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    // malloc is at least 4-byte aligned, which QuantModel::bind requires
+    uint8_t* buf = len > 0 ? (uint8_t*)malloc(len) : nullptr;
+    if (!buf || fread(buf, 1, len, f) != (size_t)len) {
+        fprintf(stderr, "%s: read failed\n", path);
+        free(buf);
+        buf = nullptr;
+    }
+    fclose(f);
+    *size = (size_t)len;
+    return buf;
+}
+
+static void checkModel(const char* path) {
+    size_t size = 0;
+    uint8_t* blob = readFile(path, &size);
+    if (!blob || !QuantModel::validate(blob, size, ML_CLASS_COUNT) || !QuantModel::bind(blob, size)) {
+        printf("  %-32s not a usable PCML model FAIL\n", path);
+        failures++;
+        free(blob);
+        return;
+    }
+    if (!QuantModel::hasFoldedNorm()) {
+        // Golden rows are raw features; benchmarkGolden feeds them as-is
+        printf("  %-32s needs z-scored inputs, skipped\n", path);
+        QuantModel::unload();
+        free(blob);
+        return;
+    }
+
+    bool reference = GOLDEN_MODEL_CRC != 0 && QuantModel::getPayloadCrc() == GOLDEN_MODEL_CRC;
+    int mismatches = 0;
+    for (int i = 0; i < GOLDEN_COUNT; i++) {
+        float vec[FEATURE_VECTOR_SIZE] = {0};
+        memcpy(vec, GOLDEN_X[i], sizeof(GOLDEN_X[i]));
+        float scores[ML_CLASS_COUNT];
+        int label = QuantModel::run(vec, FEATURE_VECTOR_SIZE, scores) ? argmax(scores) : -1;
+        if (!reference) {
+            printf("  %s: model %d\n", GOLDEN_NAME[i], label);
+        } else if (label != GOLDEN_MODEL_Y[i]) {
+            mismatches++;
+            printf("  %s: model %d, expected %d\n", GOLDEN_NAME[i], label, GOLDEN_MODEL_Y[i]);
+        }
+    }
+    if (reference) {
+        report("QuantModel::run", mismatches);
+    } else {
+        printf("  QuantModel::run                  CRC %08X has no reference (header: %08lX)\n",
+               QuantModel::getPayloadCrc(), (unsigned long)GOLDEN_MODEL_CRC);
+    }
+    QuantModel::unload();
+    free(blob);
+}
+
+int main(int argc, char** argv) {
+    printf("golden_check: %d vectors\n", GOLDEN_COUNT);
+    checkHeuristic();
+    checkBatch();
+    if (argc > 1) checkModel(argv[1]);
+    printf("%s\n", failures ? "FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,3 @@
+// Host shim: config.h includes ArduinoJson but the headers the ML sources
+// pull in never use it
+#pragma once
@@ -0,0 +1,39 @@
+// Host shim: fs::FS / File over stdio, enough for ModelInstaller::installFromFile
+#pragma once
+
+#include <Arduino.h>
+#include <stdio.h>
+
+#define FILE_READ "r"
+
+namespace fs {
+
+class File {
+public:
+    File(FILE* f = nullptr) : fp(f) {}
+    explicit operator bool() const { return fp != nullptr; }
+    size_t size() {
+        long pos = ftell(fp);
+        fseek(fp, 0, SEEK_END);
+        long end = ftell(fp);
+        fseek(fp, pos, SEEK_SET);
+        return (size_t)end;
+    }
+    int available() { return (int)(size() - (size_t)ftell(fp)); }
+    size_t read(uint8_t* buf, size_t len) { return fread(buf, 1, len, fp); }
+    void close() {
+        if (fp) fclose(fp);
+        fp = nullptr;
+    }
+private:
+    FILE* fp;
+};
+
+class FS {
+public:
+    File open(const char* path, const char* mode) { return File(fopen(path, "rb")); }
+};
+
+}  // namespace fs
+
+using fs::File;
@@ -0,0 +1,69 @@
+// Host shim: plain-HTTP GET over loopback, the HTTPClient calls
+// ModelInstaller::installFromUrl makes
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <stdlib.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#define HTTP_CODE_OK 200
+
+class HTTPClient {
+public:
+    HTTPClient() : port(80), size(-1) {}
+
+    bool begin(const char* url) {
+        // http://<ipv4>[:port]/path only
+        if (strncmp(url, "http://", 7) != 0) return false;
+        const char* hostStart = url + 7;
+        const char* slash = strchr(hostStart, '/');
+        path = slash ? slash : "/";
+        host.assign(hostStart, slash ? (size_t)(slash - hostStart) : strlen(hostStart));
+        size_t colon = host.find(':');
+        if (colon != std::string::npos) {
+            port = atoi(host.c_str() + colon + 1);
+            host.resize(colon);
+        }
+        return true;
+    }
+
+    int GET() {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        if (fd < 0 || inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1 ||
+            connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+            if (fd >= 0) ::close(fd);
+            return -1;
+        }
+        client.attach(fd);
+        std::string req = "GET " + path + " HTTP/1.1\r\nHost: " + host + "\r\nConnection: close\r\n\r\n";
+        client.write((const uint8_t*)req.data(), req.size());
+
+        // Headers one byte at a time so the body stays in the socket
+        std::string head;
+        uint8_t c;
+        while (head.size() < 4096 && head.find("\r\n\r\n") == std::string::npos) {
+            if (client.readBytes(&c, 1) != 1) return -1;
+            head += (char)c;
+        }
+        size_t cl = head.find("Content-Length:");
+        size = cl == std::string::npos ? -1 : atoi(head.c_str() + cl + 15);
+        return head.size() > 12 ? atoi(head.c_str() + 9) : -1;
+    }
+
+    int getSize() { return size; }
+    WiFiClient* getStreamPtr() { return &client; }
+    bool connected() { return client.connected(); }
+    void end() { client.stop(); }
+
+private:
+    std::string host;
+    std::string path;
+    int port;
+    int size;
+    WiFiClient client;
+};
@@ -0,0 +1,43 @@
+// Host shim: WiFiClient over a connected POSIX socket
+#pragma once
+
+#include <Arduino.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+class WiFiClient {
+public:
+    WiFiClient() : fd(-1) {}
+    ~WiFiClient() { stop(); }
+
+    void attach(int sock) { fd = sock; }
+    void stop() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+    // Readable bytes; a closed peer drops the connection like lwIP does
+    int available() {
+        if (fd < 0) return 0;
+        int n = 0;
+        if (ioctl(fd, FIONREAD, &n) < 0) return 0;
+        if (n == 0) {
+            char c;
+            if (recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 0) stop();
+        }
+        return n;
+    }
+    bool connected() { return available() > 0 || fd >= 0; }
+    size_t readBytes(uint8_t* buf, size_t len) {
+        ssize_t n = fd < 0 ? 0 : recv(fd, buf, len, 0);
+        return n > 0 ? (size_t)n : 0;
+    }
+    size_t write(const uint8_t* buf, size_t len) {
+        ssize_t n = fd < 0 ? 0 : send(fd, buf, len, MSG_NOSIGNAL);
+        return n > 0 ? (size_t)n : 0;
+    }
+
+private:
+    int fd;
+};
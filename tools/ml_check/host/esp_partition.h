@@ -0,0 +1,50 @@
+// Host shim: the esp_partition API ModelPartition uses, over a RAM image
+//
+// host/flash_shim.cpp holds one "model" partition (MODEL_PARTITION_BYTES)
+// and behaves like NOR flash: erase sets whole 4 KB sectors to 0xFF and
+// writes can only clear bits. Erase and page-program latency can be
+// simulated (hostFlashEraseUs / hostFlashPageUs), off by default.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MODEL_PARTITION_BYTES (1024 * 1024)
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_ARG 0x102
+
+typedef enum {
+    ESP_PARTITION_TYPE_APP = 0,
+    ESP_PARTITION_TYPE_DATA = 1
+} esp_partition_type_t;
+typedef int esp_partition_subtype_t;
+
+typedef struct {
+    esp_partition_type_t type;
+    esp_partition_subtype_t subtype;
+    uint32_t address;
+    uint32_t size;
+    char label[17];
+    bool encrypted;
+} esp_partition_t;
+
+typedef uint32_t spi_flash_mmap_handle_t;
+typedef enum { SPI_FLASH_MMAP_DATA, SPI_FLASH_MMAP_INST } spi_flash_mmap_memory_t;
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label);
+esp_err_t esp_partition_read(const esp_partition_t* p, size_t offset, void* dst, size_t len);
+esp_err_t esp_partition_write(const esp_partition_t* p, size_t offset, const void* src, size_t len);
+esp_err_t esp_partition_erase_range(const esp_partition_t* p, size_t offset, size_t len);
+esp_err_t esp_partition_mmap(const esp_partition_t* p, size_t offset, size_t len,
+                             spi_flash_mmap_memory_t memory, const void** out, spi_flash_mmap_handle_t* handle);
+void spi_flash_munmap(spi_flash_mmap_handle_t handle);
+const char* esp_err_to_name(esp_err_t err);
+
+// Test hooks
+extern uint8_t hostFlash[MODEL_PARTITION_BYTES];
+extern uint32_t hostFlashEraseUs;   // Per 4 KB sector
+extern uint32_t hostFlashPageUs;    // Per 256-byte page program
@@ -0,0 +1,66 @@
+// RAM-backed "model" partition for the host checks
+
+#include <esp_partition.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+
+uint8_t hostFlash[MODEL_PARTITION_BYTES];
+uint32_t hostFlashEraseUs = 0;
+uint32_t hostFlashPageUs = 0;
+
+static const esp_partition_t modelPartition = {
+    ESP_PARTITION_TYPE_DATA, 0x40, 0x310000, MODEL_PARTITION_BYTES, "model", false
+};
+
+static bool inRange(size_t offset, size_t len) {
+    return offset <= MODEL_PARTITION_BYTES && len <= MODEL_PARTITION_BYTES - offset;
+}
+
+static void busy(uint32_t us) {
+    if (us) std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+    if (type != modelPartition.type || subtype != modelPartition.subtype) return nullptr;
+    if (label && strcmp(label, modelPartition.label) != 0) return nullptr;
+    return &modelPartition;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* p, size_t offset, void* dst, size_t len) {
+    if (!inRange(offset, len)) return ESP_ERR_INVALID_ARG;
+    memcpy(dst, hostFlash + offset, len);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t* p, size_t offset, const void* src, size_t len) {
+    if (!inRange(offset, len)) return ESP_ERR_INVALID_ARG;
+    // NOR: programming only clears bits, so writing unerased flash corrupts
+    const uint8_t* s = (const uint8_t*)src;
+    for (size_t i = 0; i < len; i++) hostFlash[offset + i] &= s[i];
+    busy(hostFlashPageUs * (uint32_t)((len + 255) / 256));
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t* p, size_t offset, size_t len) {
+    if (!inRange(offset, len) || (offset & 0xFFF) || (len & 0xFFF)) return ESP_ERR_INVALID_ARG;
+    memset(hostFlash + offset, 0xFF, len);
+    busy(hostFlashEraseUs * (uint32_t)(len / 0x1000));
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t* p, size_t offset, size_t len,
+                             spi_flash_mmap_memory_t memory, const void** out, spi_flash_mmap_handle_t* handle) {
+    if (!inRange(offset, len)) return ESP_ERR_INVALID_ARG;
+    *out = hostFlash + offset;
+    *handle = 1;
+    return ESP_OK;
+}
+
+void spi_flash_munmap(spi_flash_mmap_handle_t handle) {
+}
+
+const char* esp_err_to_name(esp_err_t err) {
+    return err == ESP_OK ? "ESP_OK" : "ESP_FAIL";
+}
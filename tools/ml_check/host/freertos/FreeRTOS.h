@@ -0,0 +1,11 @@
+// Host shim: the FreeRTOS types the installer uses
+#pragma once
+
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFF)
@@ -0,0 +1,19 @@
+// Host shim: mutexes are std::mutex; only portMAX_DELAY waits are used
+#pragma once
+
+#include <mutex>
+#include "FreeRTOS.h"
+
+typedef std::mutex* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return new std::mutex(); }
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t m, TickType_t) {
+    m->lock();
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t m) {
+    m->unlock();
+    return pdTRUE;
+}
@@ -0,0 +1,4 @@
+// Host shim: Arduino.h pulls this in; nothing here creates tasks
+#pragma once
+
+#include "FreeRTOS.h"
@@ -0,0 +1,254 @@
+// Host check: ModelInstaller end to end against a local HTTP server
+//
+// Usage: install_check [size] [eraseUs pageUs]
+//
+// Links the firmware's model_installer.cpp, model_partition.cpp and
+// quant_model.cpp against a RAM-backed model partition (host/flash_shim.cpp)
+// and an HTTPClient that talks to a server thread on 127.0.0.1 standing in
+// for the model host. Installs a valid PCML blob of `size` bytes (default
+// 512000, the 500 KB case) and walks the slot lifecycle: first install,
+// second install without Content-Length, MODELBENCH refusing to erase the
+// rollback slot, fallback to that slot when the active one is corrupted,
+// and a download that stalls mid-body. eraseUs / pageUs simulate flash
+// sector erase and page program latency so the timings can be compared
+// with MODELBENCH on the device; by default flash is free and only the
+// transfer, CRC and validation cost is measured.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <esp_partition.h>
+#include "core/crc32.h"
+#include "ml/inference.h"
+#include "ml/model_installer.h"
+#include "ml/model_partition.h"
+#include "ml/quant_model.h"
+
+// Inference proper isn't linked; the flip only has to map and bind.
+// finish() only requests the reload, installOver() plays the main loop.
+static bool reloadPending = false;
+
+void MLInference::requestModelReload() {
+    reloadPending = true;
+}
+
+bool MLInference::loadMappedModel() {
+    reloadPending = false;
+    const uint8_t* blob = nullptr;
+    size_t size = 0;
+    return ModelPartition::map(&blob, &size) && QuantModel::bind(blob, size);
+}
+
+// Valid two-layer model (24 -> 16 -> 5) padded out to `size` bytes; the
+// format allows slack after the last layer and the CRC covers all of it
+static std::vector<uint8_t> makeModel(size_t size, const char* version, uint32_t seed) {
+    std::vector<uint8_t> blob(size, 0);
+    QModelHeader h = {};
+    h.magic = QMODEL_MAGIC;
+    h.formatVersion = QMODEL_FORMAT_VERSION;
+    h.layerCount = 2;
+    strncpy(h.version, version, sizeof(h.version) - 1);
+    h.inputSize = 24;
+    h.outputSize = ML_CLASS_COUNT;
+    h.payloadSize = size - sizeof(h);
+
+    QLayerDesc layers[2] = {};
+    layers[0].inSize = 24;
+    layers[0].outSize = 16;
+    layers[0].activation = (uint8_t)QActivation::RELU;
+    layers[0].inputScale = 1.0f;
+    layers[0].dataOffset = sizeof(layers);
+    layers[1].inSize = 16;
+    layers[1].outSize = ML_CLASS_COUNT;
+    layers[1].activation = (uint8_t)QActivation::LINEAR;
+    layers[1].inputScale = 1.0f;
+    layers[1].dataOffset = layers[0].dataOffset + 24 * 16 + 16 * 2 * sizeof(float);
+
+    uint8_t* payload = blob.data() + sizeof(h);
+    memcpy(payload, layers, sizeof(layers));
+    size_t pad = layers[1].dataOffset + 16 * ML_CLASS_COUNT + ML_CLASS_COUNT * 2 * sizeof(float);
+    pad = (pad + 3) & ~(size_t)3;
+    for (size_t i = pad; i < h.payloadSize; i++) payload[i] = (uint8_t)(i * 31 + seed);
+
+    h.payloadCrc = Crc32::compute(payload, h.payloadSize);
+    memcpy(blob.data(), &h, sizeof(h));
+    return blob;
+}
+
+// Model host stand-in --------------------------------------------------------
+
+enum class ServeMode { LENGTH, CLOSE_DELIMITED, STALL };
+
+static std::vector<uint8_t> served;
+static std::atomic<int> serveMode(0);
+static int serverPort = 0;
+
+static void serveOne(int fd) {
+    char req[1024];
+    size_t got = 0;
+    while (got < sizeof(req) - 1) {
+        ssize_t n = recv(fd, req + got, sizeof(req) - 1 - got, 0);
+        if (n <= 0) break;
+        got += n;
+        req[got] = 0;
+        if (strstr(req, "\r\n\r\n")) break;
+    }
+
+    ServeMode mode = (ServeMode)serveMode.load();
+    char head[160];
+    if (mode == ServeMode::CLOSE_DELIMITED) {
+        snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\n"
+                                     "Connection: close\r\n\r\n");
+    } else {
+        snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\n"
+                                     "Content-Length: %zu\r\nConnection: close\r\n\r\n", served.size());
+    }
+    send(fd, head, strlen(head), MSG_NOSIGNAL);
+
+    // Send in TCP-segment-ish pieces so the installer sees a real stream
+    size_t limit = mode == ServeMode::STALL ? served.size() / 2 : served.size();
+    for (size_t off = 0; off < limit; off += 1460) {
+        size_t n = std::min((size_t)1460, limit - off);
+        if (send(fd, served.data() + off, n, MSG_NOSIGNAL) <= 0) break;
+    }
+    if (mode == ServeMode::STALL) {
+        // Hold the connection open past the installer's stall timeout
+        std::this_thread::sleep_for(std::chrono::milliseconds(MODEL_INSTALL_HTTP_TIMEOUT_MS * 2));
+    }
+    close(fd);
+}
+
+static bool startServer() {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    if (fd < 0 || bind(fd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 4) != 0 ||
+        getsockname(fd, (sockaddr*)&addr, &len) != 0) {
+        perror("install_check: server");
+        return false;
+    }
+    serverPort = ntohs(addr.sin_port);
+    std::thread([fd]() {
+        for (;;) {
+            int c = accept(fd, nullptr, nullptr);
+            if (c >= 0) std::thread(serveOne, c).detach();
+        }
+    }).detach();
+    return true;
+}
+
+// Checks ---------------------------------------------------------------------
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what) {
+    printf("  %-44s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+static bool installOver(ServeMode mode, const std::vector<uint8_t>& blob, double* ms) {
+    served = blob;
+    serveMode = (int)mode;
+    char url[64];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%d/porkchop_model.bin", serverPort);
+    auto t0 = std::chrono::steady_clock::now();
+    bool ok = ModelInstaller::installFromUrl(url);
+    *ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    if (ok && ModelPartition::getMappedSlot() == ModelPartition::getInactiveSlot()) {
+        printf("  finish() remapped on the installing task\n");
+        return false;
+    }
+    if (reloadPending) MLInference::loadMappedModel();    // MLInference::update()
+    return ok;
+}
+
+static bool slotHolds(int slot, const std::vector<uint8_t>& blob) {
+    size_t base = (size_t)slot * (MODEL_PARTITION_BYTES / MODEL_SLOT_COUNT) + sizeof(ModelSlotHeader);
+    return ModelPartition::isSlotValid(slot) && memcmp(hostFlash + base, blob.data(), blob.size()) == 0;
+}
+
+static void printStats(const char* what, double wallMs) {
+    ModelInstallStats s = ModelInstaller::getLastStats();
+    printf("  %s: %u bytes in %.1f ms wall (%u ms installer, %.1f KB/s): "
+           "erase %.1f ms, write %.1f ms, verify %.1f ms\n",
+           what, s.bytes, wallMs, s.totalMs, s.kbPerSec(),
+           s.eraseUs / 1000.0, s.writeUs / 1000.0, s.verifyUs / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    size_t size = argc > 1 ? strtoul(argv[1], nullptr, 0) : 512000;
+    if (argc > 3) {
+        hostFlashEraseUs = strtoul(argv[2], nullptr, 0);
+        hostFlashPageUs = strtoul(argv[3], nullptr, 0);
+    }
+    if (size < 1024 || size > ModelPartition::getSlotCapacity()) {
+        fprintf(stderr, "install_check: size must be 1024..%zu\n", ModelPartition::getSlotCapacity());
+        return 2;
+    }
+    memset(hostFlash, 0xFF, sizeof(hostFlash));
+    if (!startServer()) return 2;
+
+    std::vector<uint8_t> a = makeModel(size, "check-a", 7);
+    std::vector<uint8_t> b = makeModel(size, "check-b", 11);
+    std::vector<uint8_t> c = makeModel(size, "check-c", 13);
+    double ms = 0;
+
+    printf("install_check: %zu byte model, flash erase %u us/sector, program %u us/page\n",
+           size, hostFlashEraseUs, hostFlashPageUs);
+
+    bool ok = installOver(ServeMode::LENGTH, a, &ms);
+    printStats("HTTP install", ms);
+    expect(ok && ModelPartition::getMappedSlot() == 0 && slotHolds(0, a), "first install lands in slot 0");
+
+    ok = installOver(ServeMode::CLOSE_DELIMITED, b, &ms);
+    printStats("HTTP install, no Content-Length", ms);
+    expect(ok && ModelPartition::getMappedSlot() == 1 && slotHolds(1, b), "second install lands in slot 1");
+    expect(slotHolds(0, a), "slot 0 keeps the rollback model");
+
+    ModelInstallStats bench = ModelInstaller::benchmark(size);
+    expect(!bench.ok && slotHolds(0, a), "MODELBENCH refuses to erase the rollback");
+
+    // Damage the live blob: the next map must fall back to slot 0 and the
+    // next install must then target slot 1, never the mapped slot
+    size_t slot1 = MODEL_PARTITION_BYTES / MODEL_SLOT_COUNT + sizeof(ModelSlotHeader);
+    hostFlash[slot1 + size / 2] ^= 0x01;
+    ok = MLInference::loadMappedModel();
+    expect(ok && ModelPartition::getMappedSlot() == 0, "CRC failure falls back to slot 0");
+    expect(ModelPartition::getInactiveSlot() == 1, "install target avoids the mapped slot");
+
+    ok = installOver(ServeMode::LENGTH, c, &ms);
+    expect(ok && ModelPartition::getMappedSlot() == 1 && slotHolds(1, c), "reinstall over the damaged slot");
+
+    // A second source (serial, HTTP upload) while one session is open is
+    // refused; the open session keeps its bytes and can still finish
+    ModelInstaller::init();
+    ok = ModelInstaller::begin(c.size());
+    ok = ok && ModelInstaller::write(c.data(), c.size() / 2);
+    bool second = installOver(ServeMode::LENGTH, a, &ms);
+    expect(ok && !second && strcmp(ModelInstaller::getError(), MODEL_INSTALL_BUSY) == 0,
+           "second install while one is open is busy");
+    expect(ModelInstaller::isActive() && ModelInstaller::getWritten() == c.size() / 2,
+           "busy refusal leaves the open session alone");
+    ModelInstaller::abort();
+
+    ok = installOver(ServeMode::STALL, a, &ms);
+    printf("  stalled download gave up after %.0f ms (%s)\n", ms, ModelInstaller::getError());
+    expect(!ok && strcmp(ModelInstaller::getError(), "download stalled") == 0, "stalled download fails");
+    expect(MLInference::loadMappedModel() && ModelPartition::getMappedSlot() == 1 && slotHolds(1, c),
+           "stall leaves the active model in place");
+
+    printf("%s\n", failures ? "FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
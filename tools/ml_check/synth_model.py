@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+"""
+Small PCML model for the host golden check
+
+Trains the train-mlp network on a labeled CSV (by default the
+synth_training.py rows) and writes it with the normalization folded in,
+so `train_model.py golden --model` can record its outputs and
+golden_check can replay them through QuantModel.
+
+    python3 tools/ml_check/synth_model.py -i build/synth.csv -o build/model.bin
+"""
+
+import argparse
+import os
+import sys
+
+import numpy as np
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', 'scripts'))
+import train_model as tm  # noqa: E402
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Synthetic PCML model')
+    parser.add_argument('--input', '-i', required=True)
+    parser.add_argument('--output', '-o', required=True)
+    parser.add_argument('--hidden', type=int, default=16)
+    parser.add_argument('--epochs', type=int, default=150)
+    args = parser.parse_args()
+
+    X, y = tm.load_training_csv(args.input)
+    X = X[:, :len(tm.FEATURE_NAMES)]
+    means, stds = tm.compute_normalization_params(X)
+    X_norm = (X - np.array(means, dtype=np.float32)) / np.array(stds, dtype=np.float32)
+
+    layers = tm.train_mlp(X_norm, y, hidden=args.hidden, epochs=args.epochs)
+    scales = tm.calibrate_input_scales(layers, X_norm)
+    tm.export_quantized_model(layers, scales, args.output, 'mlcheck', means, stds)
+
+
+if __name__ == '__main__':
+    main()
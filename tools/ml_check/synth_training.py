@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+"""
+Synthetic WARHOG ML training export for the host checks
+
+Jitters the train_model.py golden cases into a labeled CSV in the
+exportMLTraining layout, so train-forest has something to learn from
+without a real survey. Deterministic for a given seed.
+
+    python3 tools/ml_check/synth_training.py -o build/synth.csv
+"""
+
+import argparse
+import csv
+import os
+import sys
+
+import numpy as np
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', 'scripts'))
+import train_model as tm  # noqa: E402
+
+# MLLabel class -> exportMLTraining label code (DEAUTH_TARGET has none)
+CLASS_TO_CSV_LABEL = {v: k for k, v in tm.CSV_LABEL_TO_CLASS.items()}
+
+BINARY = ('has_wps', 'has_wpa', 'has_wpa2', 'has_wpa3', 'is_hidden', 'responds_to_probe',
+          'ht_capabilities', 'vht_capabilities')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Synthetic ML training CSV')
+    parser.add_argument('--output', '-o', required=True)
+    parser.add_argument('--rows', type=int, default=400, help='Rows per golden case')
+    parser.add_argument('--seed', type=int, default=1)
+    args = parser.parse_args()
+
+    rng = np.random.default_rng(args.seed)
+    X, classes, names = tm.golden_vectors()
+    col = {name: i for i, name in enumerate(tm.FEATURE_NAMES)}
+
+    n = 0
+    with open(args.output, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(['bssid', 'ssid'] + tm.TRAINING_FEATURE_COLUMNS + ['label'])
+        for base, cls, name in zip(X, classes, names):
+            label = CLASS_TO_CSV_LABEL.get(int(cls))
+            if label is None:
+                continue
+            for _ in range(args.rows):
+                x = base.astype(np.float64).copy()
+                x[col['rssi']] = np.clip(x[col['rssi']] + rng.normal(0, 6), -100, -10).round()
+                x[col['noise']] = -95 + rng.integers(-3, 4)
+                x[col['snr']] = x[col['rssi']] - x[col['noise']]
+                x[col['beacon_jitter']] = max(0.0, x[col['beacon_jitter']] + rng.normal(0, 2))
+                x[col['beacon_count']] = max(1, x[col['beacon_count']] + rng.integers(-10, 30))
+                x[col['vendor_ie_count']] = max(0, x[col['vendor_ie_count']] + rng.integers(-1, 2))
+                x[col['twin_score']] = np.clip(x[col['twin_score']] + rng.normal(0, 0.1), 0, 1) \
+                    if x[col['twin_score']] > 0 else 0.0
+                # Label noise on the flags so the trees have something to split
+                for b in BINARY:
+                    if rng.random() < 0.05:
+                        x[col[b]] = 1.0 - x[col[b]]
+                row = ['02:00:00:%02X:%02X:%02X' % tuple(rng.integers(0, 256, 3)), name]
+                row += ['%.4f' % v for v in x] + ['0.0000'] * 8 + [label]
+                writer.writerow(row)
+                n += 1
+    print(f"Wrote {n} synthetic rows to {args.output}")
+
+
+if __name__ == '__main__':
+    main()
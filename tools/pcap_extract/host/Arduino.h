@@ -0,0 +1,107 @@
+// Host shim: just enough of Arduino.h for the shared ML sources
+// (features.cpp, evil_twin.cpp, batch.cpp, forest.cpp, ...) and the web
+// server sources to build with a desktop compiler
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+// The core pulls FreeRTOS in; tools that need it supply host/freertos/
+#if __has_include(<freertos/FreeRTOS.h>)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+using std::min;
+using std::max;
+
+#define IRAM_ATTR
+#define PROGMEM
+
+class HardwareSerial {
+public:
+    void println(const char* s) { fprintf(stderr, "%s\n", s); }
+    template <typename... Args>
+    void printf(const char* fmt, Args... args) { fprintf(stderr, fmt, args...); }
+
+    // Nothing ever arrives on the host
+    int available() { return 0; }
+    int read() { return -1; }
+    size_t readBytes(uint8_t* buf, size_t len) { return 0; }
+};
+
+extern HardwareSerial Serial;
+
+// What config.h's settings structs and the web/capture index code use
+class String {
+public:
+    String(const char* s = "") : str(s ? s : "") {}
+    String(const std::string& s) : str(s) {}
+    explicit String(char c) : str(1, c) {}
+    explicit String(int v) : str(std::to_string(v)) {}
+    explicit String(unsigned v) : str(std::to_string(v)) {}
+    explicit String(long v) : str(std::to_string(v)) {}
+    explicit String(unsigned long v) : str(std::to_string(v)) {}
+    explicit String(unsigned long long v) : str(std::to_string(v)) {}
+
+    const char* c_str() const { return str.c_str(); }
+    size_t length() const { return str.size(); }
+    bool isEmpty() const { return str.empty(); }
+    char operator[](size_t i) const { return i < str.size() ? str[i] : 0; }
+
+    String& operator+=(const String& s) { str += s.str; return *this; }
+    String& operator+=(const char* s) { str += s ? s : ""; return *this; }
+    String& operator+=(char c) { str += c; return *this; }
+    friend String operator+(const String& a, const String& b) { return String(a.str + b.str); }
+    friend String operator+(const String& a, const char* b) { return String(a.str + b); }
+    friend String operator+(const char* a, const String& b) { return String(a + b.str); }
+
+    bool operator==(const String& s) const { return str == s.str; }
+    bool operator==(const char* s) const { return str == s; }
+    bool operator!=(const String& s) const { return str != s.str; }
+    bool operator!=(const char* s) const { return str != s; }
+
+    int indexOf(char c, size_t from = 0) const { return found(str.find(c, from)); }
+    int indexOf(const char* s, size_t from = 0) const { return found(str.find(s, from)); }
+    int lastIndexOf(char c) const { return found(str.rfind(c)); }
+    int lastIndexOf(const char* s) const { return found(str.rfind(s)); }
+    bool startsWith(const char* s) const { return str.compare(0, strlen(s), s) == 0; }
+    bool endsWith(const char* s) const {
+        size_t n = strlen(s);
+        return str.size() >= n && str.compare(str.size() - n, n, s) == 0;
+    }
+    String substring(size_t from) const { return from < str.size() ? String(str.substr(from)) : String(); }
+    String substring(size_t from, size_t to) const {
+        return from < to && from < str.size() ? String(str.substr(from, to - from)) : String();
+    }
+
+    void replace(const char* find, const char* with) {
+        size_t n = strlen(find), m = strlen(with);
+        for (size_t p = n ? str.find(find) : std::string::npos; p != std::string::npos; p = str.find(find, p + m)) {
+            str.replace(p, n, with);
+        }
+    }
+    void remove(size_t from) { if (from < str.size()) str.erase(from); }
+    void toLowerCase() { for (char& c : str) c = (char)tolower((unsigned char)c); }
+    void trim() {
+        size_t b = str.find_first_not_of(" \t\r\n");
+        size_t e = str.find_last_not_of(" \t\r\n");
+        str = b == std::string::npos ? std::string() : str.substr(b, e - b + 1);
+    }
+    long toInt() const { return strtol(str.c_str(), nullptr, 10); }
+
+private:
+    std::string str;
+    static int found(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+};
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
@@ -0,0 +1,37 @@
+// Host definitions behind the shims
+//
+// ChannelQuality is replaced rather than linked: on the device it smooths
+// rx_ctrl readings across frames, here each capture's radiotap values are
+// aggregated per BSSID by the extractor itself, so getBSSIDSNR just hands
+// back the per-frame value it is given.
+
+#include <Arduino.h>
+#include <chrono>
+#include <thread>
+#include "ml/channel_quality.h"
+
+HardwareSerial Serial;
+
+static const auto hostStart = std::chrono::steady_clock::now();
+
+uint32_t millis() {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - hostStart).count();
+}
+
+uint32_t micros() {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - hostStart).count();
+}
+
+void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+int8_t ChannelQuality::getNoise(uint8_t channel) {
+    return CQ_DEFAULT_NOISE;
+}
+
+float ChannelQuality::getBSSIDSNR(const uint8_t* bssid, float fallback) {
+    return fallback;
+}
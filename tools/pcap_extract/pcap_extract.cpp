@@ -0,0 +1,502 @@
+// Host-side pcap -> training set extractor
+//
+// Usage: pcap_extract [-j threads] [-l label] -o out.pcts <pcap|dir>...
+//
+// Every beacon and probe response goes through the firmware's own
+// FeatureExtractor::extractFromBeacon, so the 32 feature columns are the
+// ones the piglet computes. With the whole capture on hand, the timing
+// features the device leaves at zero are filled in as well:
+//
+//   beacon_count         beacons seen from the BSSID
+//   beacon_jitter        std dev (ms) of beacon TSF deltas around the
+//                        advertised interval (missed beacons allowed for)
+//   responds_to_probe    1 if a probe response from the BSSID was captured
+//   response_time        mean probe request -> response latency (us)
+//   probe_response_time  fastest such latency (us, capped at 65535)
+//
+// twin_score comes from replaying each capture through EvilTwinIndex.
+// rssi/noise/snr are averaged over every frame from the BSSID.
+//
+// Captures are spread over worker threads (largest first, each thread
+// pulls the next file when it's done), mmap'd and parsed independently.
+// Rows are merged in input order, so the output doesn't depend on the
+// thread count. Output format: src/ml/training_set.h.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "pcap_reader.h"
+#include "ml/features.h"
+#include "ml/channel_quality.h"
+#include "ml/evil_twin.h"
+#include "ml/training_set.h"
+
+#define PROBE_MATCH_WINDOW_US 500000     // Request -> response pairing window
+#define MAX_BEACON_GAP_US 10000000ULL    // Longer TSF gaps restart jitter tracking
+
+struct NetAgg {
+    uint8_t bssid[6];
+    char ssid[33];
+    TwinSecurity security;
+    WiFiFeatures features;      // From the first beacon / probe response
+
+    int64_t rssiSum;
+    int64_t noiseSum;
+    uint32_t signalCount;
+
+    uint32_t beacons;
+    uint64_t lastTsf;
+    bool haveTsf;
+    uint32_t jitterCount;       // Welford over TSF residuals (ms)
+    double jitterMean;
+    double jitterM2;
+
+    uint32_t responses;
+    uint64_t latencySum;
+    uint32_t latencyCount;
+    uint32_t latencyMin;
+};
+
+struct CaptureResult {
+    std::vector<NetAgg> nets;   // First-seen order
+    uint64_t frames = 0;
+    uint64_t bytes = 0;
+    bool ok = false;
+    std::string error;
+};
+
+static uint64_t macKey(const uint8_t* mac) {
+    uint64_t k = 0;
+    for (int i = 0; i < 6; i++) k = (k << 8) | mac[i];
+    return k;
+}
+
+static uint64_t le64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+}
+
+static uint8_t channelFromFreq(uint16_t freq) {
+    if (freq == 2484) return 14;
+    if (freq >= 2412 && freq <= 2472) return (uint8_t)((freq - 2407) / 5);
+    if (freq >= 5000 && freq <= 5900) return (uint8_t)((freq - 5000) / 5);
+    return 0;
+}
+
+// The fields extractFromScan gets from the driver: channel, secondary
+// channel, security, SSID. Same IE walk as OinkMode's beacon handler.
+static void parseNetworkIEs(const uint8_t* frame, uint32_t len, NetAgg& net) {
+    WiFiFeatures& f = net.features;
+    bool rsn = false;
+    bool sae = false;
+    bool psk = false;
+
+    uint32_t offset = 36;
+    while (offset + 2 <= len) {
+        uint8_t id = frame[offset];
+        uint8_t ieLen = frame[offset + 1];
+        const uint8_t* ie = frame + offset + 2;
+        if (offset + 2 + ieLen > len) break;
+
+        switch (id) {
+            case 0:     // SSID
+                if (ieLen > 0 && ieLen < 33 && ie[0] != 0) {
+                    memcpy(net.ssid, ie, ieLen);
+                    net.ssid[ieLen] = 0;
+                }
+                break;
+            case 3:     // DS Parameter Set
+                if (ieLen == 1) f.channel = ie[0];
+                break;
+            case 61:    // HT Operation: secondary channel offset
+                if (ieLen >= 2) {
+                    uint8_t sco = ie[1] & 0x03;
+                    f.secondaryChannel = sco == 1 ? WIFI_SECOND_CHAN_ABOVE
+                                       : sco == 3 ? WIFI_SECOND_CHAN_BELOW : WIFI_SECOND_CHAN_NONE;
+                }
+                break;
+            case 48: {  // RSN: walk the AKM suites for SAE vs PSK/802.1X
+                rsn = true;
+                uint32_t p = 2 + 4;                          // Version, group cipher
+                if (p + 2 > ieLen) break;
+                uint16_t pairwise = ie[p] | (ie[p + 1] << 8);
+                p += 2 + 4 * pairwise;
+                if (p + 2 > ieLen) break;
+                uint16_t akms = ie[p] | (ie[p + 1] << 8);
+                p += 2;
+                for (uint16_t a = 0; a < akms && p + 4 <= ieLen; a++, p += 4) {
+                    if (ie[p] == 0x00 && ie[p + 1] == 0x0F && ie[p + 2] == 0xAC) {
+                        if (ie[p + 3] == 8 || ie[p + 3] == 24) sae = true;
+                        else psk = true;
+                    }
+                }
+                break;
+            }
+            case 221:   // WPA1 vendor IE
+                if (ieLen >= 4 && ie[0] == 0x00 && ie[1] == 0x50 && ie[2] == 0xF2 && ie[3] == 0x01) {
+                    f.hasWPA = true;
+                }
+                break;
+        }
+        offset += 2 + ieLen;
+    }
+
+    if (rsn) {
+        f.hasWPA3 = sae;
+        f.hasWPA2 = psk || !sae;
+    }
+    net.security = rsn ? TwinSecurity::RSN
+                 : (f.hasWPA || (f.capability & 0x0010)) ? TwinSecurity::LEGACY   // Privacy bit = WEP
+                 : TwinSecurity::OPEN;
+}
+
+static void processCapture(const std::string& path, CaptureResult& out) {
+    PcapReader reader;
+    if (!reader.open(path.c_str())) {
+        out.error = reader.getError();
+        return;
+    }
+    uint32_t link = reader.getLinkType();
+    if (link != LINKTYPE_IEEE802_11_RADIOTAP && link != LINKTYPE_IEEE802_11) {
+        out.error = "unsupported link type " + std::to_string(link);
+        return;
+    }
+    out.bytes = reader.getSize();
+
+    std::unordered_map<uint64_t, uint32_t> index;
+    std::unordered_map<uint64_t, uint64_t> lastProbe;    // Client MAC -> request time
+    PcapPacket pkt;
+
+    while (reader.next(pkt)) {
+        out.frames++;
+
+        RadioInfo radio;
+        const uint8_t* frame = pkt.data;
+        uint32_t len = pkt.len;
+        if (link == LINKTYPE_IEEE802_11_RADIOTAP) {
+            if (!PcapReader::parseRadiotap(pkt.data, pkt.len, radio, &frame, &len)) continue;
+            if (radio.badFcs) continue;
+        } else {
+            memset(&radio, 0, sizeof(radio));
+        }
+        if (len < 24) continue;
+
+        uint8_t type = (frame[0] >> 2) & 0x03;
+        uint8_t subtype = frame[0] >> 4;
+        if (type != 0) continue;
+
+        if (subtype == 4) {     // Probe request: remember when the client asked
+            lastProbe[macKey(frame + 10)] = pkt.tsUs;
+            continue;
+        }
+        bool beacon = subtype == 8;
+        if (!beacon && subtype != 5) continue;
+        if (len < 36) continue;
+
+        int8_t rssi = radio.hasRssi ? radio.rssi : -100;
+        int8_t noise = radio.hasNoise ? radio.noise : CQ_DEFAULT_NOISE;
+        const uint8_t* bssid = frame + 16;
+
+        auto it = index.find(macKey(bssid));
+        NetAgg* net;
+        if (it == index.end()) {
+            index[macKey(bssid)] = (uint32_t)out.nets.size();
+            out.nets.emplace_back();
+            net = &out.nets.back();
+            memset(net, 0, sizeof(*net));
+            memcpy(net->bssid, bssid, 6);
+            net->latencyMin = UINT32_MAX;
+
+            // Same extractor the firmware runs on the first beacon
+            net->features = FeatureExtractor::extractFromBeacon(frame, (uint16_t)std::min(len, 0xFFFFu),
+                                                                rssi, noise);
+            parseNetworkIEs(frame, len, *net);
+            if (net->features.channel == 0) net->features.channel = channelFromFreq(radio.freq);
+        } else {
+            net = &out.nets[it->second];
+        }
+
+        if (radio.hasRssi) {
+            net->rssiSum += rssi;
+            net->noiseSum += noise;
+            net->signalCount++;
+        }
+
+        if (beacon) {
+            net->beacons++;
+
+            // The AP's own TSF (beacon body), not the receiver's clock
+            uint64_t tsf = le64(frame + 24);
+            uint64_t period = (uint64_t)net->features.beaconInterval * 1024;
+            if (net->haveTsf && period > 0 && tsf > net->lastTsf &&
+                tsf - net->lastTsf < MAX_BEACON_GAP_US) {
+                uint64_t delta = tsf - net->lastTsf;
+                uint64_t n = (delta + period / 2) / period;
+                if (n >= 1) {
+                    double residualMs = ((double)delta - (double)(n * period)) / 1000.0;
+                    net->jitterCount++;
+                    double d = residualMs - net->jitterMean;
+                    net->jitterMean += d / net->jitterCount;
+                    net->jitterM2 += d * (residualMs - net->jitterMean);
+                }
+            }
+            net->lastTsf = tsf;
+            net->haveTsf = true;
+        } else {
+            net->responses++;
+            auto req = lastProbe.find(macKey(frame + 4));
+            if (req != lastProbe.end() && pkt.tsUs >= req->second &&
+                pkt.tsUs - req->second <= PROBE_MATCH_WINDOW_US) {
+                uint32_t latency = (uint32_t)(pkt.tsUs - req->second);
+                net->latencySum += latency;
+                net->latencyCount++;
+                if (latency < net->latencyMin) net->latencyMin = latency;
+            }
+        }
+    }
+
+    // Fold the aggregates into the feature struct
+    for (NetAgg& net : out.nets) {
+        WiFiFeatures& f = net.features;
+        if (net.signalCount > 0) {
+            float rssi = (float)net.rssiSum / net.signalCount;
+            float noise = (float)net.noiseSum / net.signalCount;
+            f.rssi = (int8_t)lroundf(rssi);
+            f.noise = (int8_t)lroundf(noise);
+            f.snr = rssi - noise;
+        }
+        f.beaconCount = (uint16_t)std::min(net.beacons, 65535u);
+        f.beaconJitter = net.jitterCount >= 2 ? (float)sqrt(net.jitterM2 / net.jitterCount) : 0.0f;
+        f.respondsToProbe = net.responses > 0;
+        if (net.latencyCount > 0) {
+            f.responseTime = (uint32_t)(net.latencySum / net.latencyCount);
+            f.probeResponseTime = (uint16_t)std::min(net.latencyMin, 65535u);
+        }
+    }
+    out.ok = true;
+}
+
+static bool isCaptureName(const std::string& name) {
+    static const char* exts[] = {".pcap", ".cap", ".dmp"};
+    for (const char* ext : exts) {
+        size_t n = strlen(ext);
+        if (name.size() >= n && name.compare(name.size() - n, n, ext) == 0) return true;
+    }
+    return false;
+}
+
+static void collectInputs(const std::string& path, std::vector<std::string>& out) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        fprintf(stderr, "[PCAP] Skipping %s: not found\n", path.c_str());
+        return;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        out.push_back(path);
+        return;
+    }
+
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return;
+    std::vector<std::string> entries;
+    while (struct dirent* e = readdir(dir)) {
+        if (e->d_name[0] == '.') continue;
+        entries.push_back(path + "/" + e->d_name);
+    }
+    closedir(dir);
+
+    std::sort(entries.begin(), entries.end());
+    for (const std::string& p : entries) {
+        if (stat(p.c_str(), &st) != 0) continue;
+        if (S_ISDIR(st.st_mode)) {
+            collectInputs(p, out);
+        } else if (isCaptureName(p)) {
+            out.push_back(p);
+        }
+    }
+}
+
+static bool writeTrainingSet(const char* path, const std::vector<CaptureResult>& results, int32_t label) {
+    std::vector<const NetAgg*> rows;
+    std::vector<uint32_t> captureOf;
+    for (size_t i = 0; i < results.size(); i++) {
+        for (const NetAgg& net : results[i].nets) {
+            rows.push_back(&net);
+            captureOf.push_back((uint32_t)i);
+        }
+    }
+    size_t n = rows.size();
+
+    std::vector<float> vectors(n * FEATURE_VECTOR_SIZE);
+    for (size_t r = 0; r < n; r++) {
+        FeatureExtractor::toFeatureVector(rows[r]->features, &vectors[r * FEATURE_VECTOR_SIZE]);
+    }
+
+    const int extra = 4;
+    TrainingSetColumn cols[TRAINING_SET_FEATURES + extra];
+    for (int c = 0; c < TRAINING_SET_FEATURES; c++) {
+        trainingSetColumn(cols[c], TRAINING_FEATURE_NAMES[c], "<f4");
+    }
+    trainingSetColumn(cols[TRAINING_SET_FEATURES + 0], "label", "<i4");
+    trainingSetColumn(cols[TRAINING_SET_FEATURES + 1], "bssid", "<u8");
+    trainingSetColumn(cols[TRAINING_SET_FEATURES + 2], "ssid", "S32");
+    trainingSetColumn(cols[TRAINING_SET_FEATURES + 3], "capture", "<u4");
+
+    TrainingSetHeader hdr;
+    uint16_t colCount = TRAINING_SET_FEATURES + extra;
+    trainingSetLayout(hdr, cols, colCount, (uint32_t)n, "pcap");
+
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        fprintf(stderr, "[PCAP] Cannot write %s\n", path);
+        return false;
+    }
+    static char fileBuf[1 << 20];
+    setvbuf(f, fileBuf, _IOFBF, sizeof(fileBuf));
+
+    fwrite(&hdr, sizeof(hdr), 1, f);
+    fwrite(cols, sizeof(TrainingSetColumn), colCount, f);
+
+    auto padTo = [f](uint32_t offset) {
+        static const uint8_t zeros[TRAINING_SET_ALIGN] = {0};
+        long pos = ftell(f);
+        if (pos < (long)offset) fwrite(zeros, 1, offset - pos, f);
+    };
+
+    std::vector<float> column(n);
+    for (int c = 0; c < TRAINING_SET_FEATURES; c++) {
+        padTo(cols[c].offset);
+        for (size_t r = 0; r < n; r++) column[r] = vectors[r * FEATURE_VECTOR_SIZE + c];
+        fwrite(column.data(), sizeof(float), n, f);
+    }
+
+    padTo(cols[TRAINING_SET_FEATURES].offset);
+    for (size_t r = 0; r < n; r++) fwrite(&label, sizeof(label), 1, f);
+
+    padTo(cols[TRAINING_SET_FEATURES + 1].offset);
+    for (size_t r = 0; r < n; r++) {
+        uint64_t key = macKey(rows[r]->bssid);
+        fwrite(&key, sizeof(key), 1, f);
+    }
+
+    padTo(cols[TRAINING_SET_FEATURES + 2].offset);
+    for (size_t r = 0; r < n; r++) {
+        char ssid[32] = {0};
+        memcpy(ssid, rows[r]->ssid, strnlen(rows[r]->ssid, sizeof(ssid)));
+        fwrite(ssid, 1, sizeof(ssid), f);
+    }
+
+    padTo(cols[TRAINING_SET_FEATURES + 3].offset);
+    fwrite(captureOf.data(), sizeof(uint32_t), n, f);
+
+    bool ok = ferror(f) == 0;
+    ok &= fclose(f) == 0;
+    return ok;
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: pcap_extract [-j threads] [-l label] -o out.pcts <pcap|dir>...\n"
+            "  -j  worker threads (default: all cores)\n"
+            "  -l  label for every row, WARHOG export codes (default 0 = unknown)\n");
+}
+
+int main(int argc, char** argv) {
+    unsigned threads = std::thread::hardware_concurrency();
+    int32_t label = 0;
+    const char* output = nullptr;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "j:l:o:h")) != -1) {
+        switch (opt) {
+            case 'j': threads = (unsigned)atoi(optarg); break;
+            case 'l': label = atoi(optarg); break;
+            case 'o': output = optarg; break;
+            default: usage(); return 2;
+        }
+    }
+    if (!output || optind >= argc) {
+        usage();
+        return 2;
+    }
+    if (threads == 0) threads = 1;
+
+    std::vector<std::string> inputs;
+    for (int i = optind; i < argc; i++) collectInputs(argv[i], inputs);
+    if (inputs.empty()) {
+        fprintf(stderr, "[PCAP] No captures found\n");
+        return 1;
+    }
+
+    // Biggest captures first so one large file doesn't start last and
+    // leave the other cores idle at the end
+    std::vector<size_t> order(inputs.size());
+    std::vector<off_t> sizes(inputs.size(), 0);
+    for (size_t i = 0; i < inputs.size(); i++) {
+        struct stat st;
+        if (stat(inputs[i].c_str(), &st) == 0) sizes[i] = st.st_size;
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+    std::vector<CaptureResult> results(inputs.size());
+    std::atomic<size_t> next(0);
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> pool;
+    threads = std::min<unsigned>(threads, (unsigned)inputs.size());
+    for (unsigned t = 0; t < threads; t++) {
+        pool.emplace_back([&]() {
+            for (size_t i = next++; i < order.size(); i = next++) {
+                processCapture(inputs[order[i]], results[order[i]]);
+            }
+        });
+    }
+    for (auto& t : pool) t.join();
+    double parseSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // Evil-twin replay: EvilTwinIndex is a single static table, so this
+    // runs per capture after the parallel phase (cheap: once per network)
+    uint64_t frames = 0;
+    uint64_t bytes = 0;
+    size_t networks = 0;
+    size_t failed = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        CaptureResult& r = results[i];
+        if (!r.ok) {
+            fprintf(stderr, "[PCAP] Skipped %s: %s\n", inputs[i].c_str(), r.error.c_str());
+            failed++;
+            continue;
+        }
+        EvilTwinIndex::clear();
+        for (NetAgg& net : r.nets) {
+            uint8_t flags = EvilTwinIndex::observe(net.ssid, net.bssid, net.features.channel, net.security);
+            net.features.twinScore = EvilTwinIndex::score(flags);
+        }
+        frames += r.frames;
+        bytes += r.bytes;
+        networks += r.nets.size();
+    }
+
+    if (!writeTrainingSet(output, results, label)) return 1;
+    double totalSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    fprintf(stderr, "[PCAP] %zu captures (%zu skipped), %llu frames, %zu networks -> %s\n",
+            inputs.size() - failed, failed, (unsigned long long)frames, networks, output);
+    fprintf(stderr, "[PCAP] %u threads: parse %.2f s (%.1f MB/s), total %.2f s\n",
+            threads, parseSec, bytes / 1e6 / std::max(parseSec, 1e-9), totalSec);
+    return 0;
+}
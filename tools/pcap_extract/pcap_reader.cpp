@@ -0,0 +1,168 @@
+// Memory-mapped pcap reader implementation
+
+#include "pcap_reader.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define PCAP_MAGIC_US 0xA1B2C3D4UL
+#define PCAP_MAGIC_NS 0xA1B23C4DUL
+#define PCAPNG_MAGIC  0x0A0D0D0AUL
+#define PCAP_GLOBAL_HEADER 24
+#define PCAP_RECORD_HEADER 16
+
+static uint32_t le32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+uint32_t PcapReader::read32(const uint8_t* p) const {
+    return swapped ? be32(p) : le32(p);
+}
+
+bool PcapReader::open(const char* path) {
+    close();
+
+    fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open";
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < PCAP_GLOBAL_HEADER) {
+        error = "too small";
+        close();
+        return false;
+    }
+    size = (size_t)st.st_size;
+
+    void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        error = "mmap failed";
+        size = 0;
+        close();
+        return false;
+    }
+    base = (const uint8_t*)map;
+    madvise(map, size, MADV_SEQUENTIAL);
+
+    uint32_t magic = le32(base);
+    if (magic == PCAP_MAGIC_US || magic == PCAP_MAGIC_NS) {
+        swapped = false;
+    } else if (be32(base) == PCAP_MAGIC_US || be32(base) == PCAP_MAGIC_NS) {
+        swapped = true;
+        magic = be32(base);
+    } else {
+        error = magic == PCAPNG_MAGIC ? "pcapng not supported (convert with editcap -F pcap)" : "not a pcap";
+        close();
+        return false;
+    }
+    nanos = magic == PCAP_MAGIC_NS;
+    linkType = read32(base + 20) & 0x0FFFFFFF;   // Upper bits carry FCS info
+    pos = PCAP_GLOBAL_HEADER;
+    return true;
+}
+
+void PcapReader::close() {
+    if (base) munmap((void*)base, size);
+    if (fd >= 0) ::close(fd);
+    base = nullptr;
+    fd = -1;
+    size = 0;
+    pos = 0;
+}
+
+bool PcapReader::next(PcapPacket& pkt) {
+    if (!base || pos + PCAP_RECORD_HEADER > size) return false;
+
+    const uint8_t* rec = base + pos;
+    uint32_t sec = read32(rec);
+    uint32_t frac = read32(rec + 4);
+    uint32_t capLen = read32(rec + 8);
+
+    // Truncated last record (capture killed mid-write): stop cleanly
+    if (pos + PCAP_RECORD_HEADER + capLen > size) return false;
+
+    pkt.tsUs = (uint64_t)sec * 1000000ULL + (nanos ? frac / 1000 : frac);
+    pkt.data = rec + PCAP_RECORD_HEADER;
+    pkt.len = capLen;
+    pos += PCAP_RECORD_HEADER + capLen;
+    return true;
+}
+
+// Radiotap field sizes/alignments for present bits 0..6, the only ones we
+// read; fields past the last one we need are never walked
+static const uint8_t RT_SIZE[] = {8, 1, 1, 4, 2, 1, 1};
+static const uint8_t RT_ALIGN[] = {8, 1, 1, 2, 1, 1, 1};
+
+#define RT_TSFT 0
+#define RT_FLAGS 1
+#define RT_CHANNEL 3
+#define RT_DBM_SIGNAL 5
+#define RT_DBM_NOISE 6
+
+#define RT_FLAG_FCS 0x10
+#define RT_FLAG_BADFCS 0x40
+
+bool PcapReader::parseRadiotap(const uint8_t* data, uint32_t len, RadioInfo& info,
+                               const uint8_t** frame, uint32_t* frameLen) {
+    memset(&info, 0, sizeof(info));
+    if (len < 8 || data[0] != 0) return false;
+
+    uint16_t rtLen = data[2] | (data[3] << 8);
+    if (rtLen < 8 || rtLen > len) return false;
+
+    uint32_t present = le32(data + 4);
+
+    // Skip extended presence words (bit 31 chains another one)
+    uint32_t off = 8;
+    uint32_t word = present;
+    while (word & 0x80000000UL) {
+        if (off + 4 > rtLen) return false;
+        word = le32(data + off);
+        off += 4;
+    }
+
+    for (uint8_t bit = 0; bit <= RT_DBM_NOISE; bit++) {
+        if (!(present & (1UL << bit))) continue;
+        off = (off + RT_ALIGN[bit] - 1) & ~(uint32_t)(RT_ALIGN[bit] - 1);
+        if (off + RT_SIZE[bit] > rtLen) break;
+
+        const uint8_t* f = data + off;
+        switch (bit) {
+            case RT_TSFT:
+                info.tsft = (uint64_t)le32(f) | ((uint64_t)le32(f + 4) << 32);
+                info.hasTsft = true;
+                break;
+            case RT_FLAGS:
+                info.fcsAtEnd = (f[0] & RT_FLAG_FCS) != 0;
+                info.badFcs = (f[0] & RT_FLAG_BADFCS) != 0;
+                break;
+            case RT_CHANNEL:
+                info.freq = f[0] | (f[1] << 8);
+                break;
+            case RT_DBM_SIGNAL:
+                info.rssi = (int8_t)f[0];
+                info.hasRssi = true;
+                break;
+            case RT_DBM_NOISE:
+                info.noise = (int8_t)f[0];
+                info.hasNoise = true;
+                break;
+        }
+        off += RT_SIZE[bit];
+    }
+
+    *frame = data + rtLen;
+    *frameLen = len - rtLen;
+    if (info.fcsAtEnd) {
+        if (*frameLen < 4) return false;
+        *frameLen -= 4;
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+// Memory-mapped pcap reader with radiotap decoding
+//
+// Classic libpcap files only (usec or nsec timestamps, either byte order).
+// pcapng is detected and rejected. The file is mmap'd read-only, so packets
+// are handed out as pointers into the mapping and nothing is copied.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define LINKTYPE_IEEE802_11 105
+#define LINKTYPE_IEEE802_11_RADIOTAP 127
+
+struct PcapPacket {
+    uint64_t tsUs;          // Capture timestamp, microseconds
+    const uint8_t* data;
+    uint32_t len;           // Captured bytes
+};
+
+// Radiotap fields the extractor uses
+struct RadioInfo {
+    uint64_t tsft;          // MAC timestamp (us), valid if hasTsft
+    uint16_t freq;          // MHz, 0 if absent
+    int8_t rssi;
+    int8_t noise;
+    bool hasTsft;
+    bool hasRssi;
+    bool hasNoise;
+    bool fcsAtEnd;          // 4 FCS bytes trail the frame
+    bool badFcs;
+};
+
+class PcapReader {
+public:
+    PcapReader() {}
+    ~PcapReader() { close(); }
+
+    bool open(const char* path);
+    void close();
+    bool next(PcapPacket& pkt);
+
+    uint32_t getLinkType() const { return linkType; }
+    size_t getSize() const { return size; }
+    const char* getError() const { return error; }
+
+    // Strip the radiotap header: on success frame/frameLen point at the
+    // 802.11 frame (FCS removed) and info is filled in
+    static bool parseRadiotap(const uint8_t* data, uint32_t len, RadioInfo& info,
+                              const uint8_t** frame, uint32_t* frameLen);
+
+private:
+    int fd = -1;
+    const uint8_t* base = nullptr;
+    size_t size = 0;
+    size_t pos = 0;
+    bool swapped = false;
+    bool nanos = false;
+    uint32_t linkType = 0;
+    const char* error = "";
+
+    uint32_t read32(const uint8_t* p) const;
+
+    PcapReader(const PcapReader&);
+    PcapReader& operator=(const PcapReader&);
+};
@@ -0,0 +1,10 @@
+// Host shim: mDNS does nothing on the host
+#pragma once
+
+class MDNSResponder {
+public:
+    bool begin(const char* hostname) { return true; }
+    void end() {}
+};
+
+extern MDNSResponder MDNS;
@@ -0,0 +1,70 @@
+// Host shim: fs::FS / File over a directory standing in for the SD card
+//
+// Paths are SD paths ("/handshakes/x.pcap") resolved under hostSdRoot.
+// File copies share one handle, like the core's File, so the HTTP server
+// can take a File over from a handler.
+#pragma once
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <time.h>
+#include <dirent.h>
+#include <memory>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+extern const char* hostSdRoot;
+
+namespace fs {
+
+class File {
+public:
+    explicit operator bool() const { return h && (h->fp || h->dp); }
+
+    size_t read(uint8_t* buf, size_t len) { return h && h->fp ? fread(buf, 1, len, h->fp) : 0; }
+    size_t write(const uint8_t* buf, size_t len) { return h && h->fp ? fwrite(buf, 1, len, h->fp) : 0; }
+    bool seek(uint32_t pos) { return h && h->fp && fseek(h->fp, pos, SEEK_SET) == 0; }
+    size_t position() { return h && h->fp ? (size_t)ftell(h->fp) : 0; }
+    size_t size();
+    int available() { return (int)(size() - position()); }
+    String readStringUntil(char end);
+
+    const char* name() const { return h ? h->name.c_str() : ""; }
+    bool isDirectory() const { return h && h->dp; }
+    File openNextFile();
+    time_t getLastWrite();
+    void close();
+
+private:
+    struct Handle {
+        FILE* fp = nullptr;
+        DIR* dp = nullptr;
+        std::string path;       // SD path
+        std::string name;       // Last component
+        ~Handle();
+    };
+    std::shared_ptr<Handle> h;
+
+    friend class FS;
+};
+
+class FS {
+public:
+    File open(const char* path, const char* mode = FILE_READ);
+    File open(const String& path, const char* mode = FILE_READ) { return open(path.c_str(), mode); }
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool mkdir(const char* path);
+    bool mkdir(const String& path) { return mkdir(path.c_str()); }
+    bool rmdir(const char* path);
+    bool rmdir(const String& path) { return rmdir(path.c_str()); }
+    bool rename(const char* from, const char* to);
+};
+
+}  // namespace fs
+
+using fs::File;
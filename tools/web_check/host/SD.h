@@ -0,0 +1,12 @@
+// Host shim: SD as the directory at hostSdRoot
+#pragma once
+
+#include <FS.h>
+
+class SDFS : public fs::FS {
+public:
+    uint64_t totalBytes();
+    uint64_t usedBytes();
+};
+
+extern SDFS SD;
@@ -0,0 +1,24 @@
+// Host shim: a station that is always connected, on loopback
+#pragma once
+
+#include <Arduino.h>
+
+#define WIFI_OFF 0
+#define WIFI_STA 1
+#define WL_CONNECTED 3
+
+class IPAddress {
+public:
+    String toString() const { return String("127.0.0.1"); }
+};
+
+class WiFiClass {
+public:
+    void mode(int m) {}
+    void begin(const char* ssid, const char* password) {}
+    void disconnect(bool wifiOff = false) {}
+    int status() { return WL_CONNECTED; }
+    IPAddress localIP() { return IPAddress(); }
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,11 @@
+// Host shim: the largest free block is whatever the check says it is
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+
+extern size_t hostLargestFreeBlock;
+
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) { return hostLargestFreeBlock; }
@@ -0,0 +1,11 @@
+// Host shim: the FreeRTOS types the web server uses
+#pragma once
+
+#include <stdint.h>
+
+typedef void* TaskHandle_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define pdPASS 1
+#define tskIDLE_PRIORITY 0
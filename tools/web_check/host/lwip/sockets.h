@@ -0,0 +1,43 @@
+// Host shim: lwIP socket calls on POSIX sockets
+//
+// Any bind goes to an ephemeral loopback port instead (no root needed for
+// port 80, no clashes between runs); the port actually bound is left in
+// hostHttpPort for the client side.
+#pragma once
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0      // macOS: the check ignores SIGPIPE instead
+#endif
+
+extern volatile uint16_t hostHttpPort;
+
+inline int lwip_socket(int domain, int type, int protocol) { return ::socket(domain, type, protocol); }
+inline int lwip_setsockopt(int fd, int level, int name, const void* value, socklen_t len) {
+    return ::setsockopt(fd, level, name, value, len);
+}
+inline int lwip_bind(int fd, const struct sockaddr* addr, socklen_t len) {
+    struct sockaddr_in local = *(const struct sockaddr_in*)addr;
+    local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    local.sin_port = 0;
+    if (::bind(fd, (struct sockaddr*)&local, sizeof(local)) < 0) return -1;
+    socklen_t got = sizeof(local);
+    ::getsockname(fd, (struct sockaddr*)&local, &got);
+    hostHttpPort = ntohs(local.sin_port);
+    return 0;
+}
+inline int lwip_listen(int fd, int backlog) { return ::listen(fd, backlog); }
+inline int lwip_accept(int fd, struct sockaddr* addr, socklen_t* len) { return ::accept(fd, addr, len); }
+inline int lwip_fcntl(int fd, int cmd, int value) { return ::fcntl(fd, cmd, value); }
+inline int lwip_select(int n, fd_set* rd, fd_set* wr, fd_set* ex, struct timeval* tv) {
+    return ::select(n, rd, wr, ex, tv);
+}
+inline ssize_t lwip_recv(int fd, void* buf, size_t len, int flags) { return ::recv(fd, buf, len, flags); }
+inline ssize_t lwip_send(int fd, const void* buf, size_t len, int flags) { return ::send(fd, buf, len, flags); }
+inline int lwip_close(int fd) { return ::close(fd); }
@@ -0,0 +1,127 @@
+// Host definitions behind the web_check shims
+
+#include <Arduino.h>
+#include <ESPmDNS.h>
+#include <esp_heap_caps.h>
+#include <SD.h>
+#include <WiFi.h>
+#include <lwip/sockets.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <thread>
+
+const char* hostSdRoot = ".";
+volatile uint16_t hostHttpPort = 0;
+size_t hostLargestFreeBlock = SIZE_MAX;
+
+SDFS SD;
+WiFiClass WiFi;
+MDNSResponder MDNS;
+
+static std::string hostPath(const std::string& path) {
+    return std::string(hostSdRoot) + (path.empty() || path[0] != '/' ? "/" : "") + path;
+}
+
+// Tasks ----------------------------------------------------------------------
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+    std::thread t(fn, arg);
+    if (handle) *handle = (TaskHandle_t)(uintptr_t)std::hash<std::thread::id>()(t.get_id());
+    t.detach();
+    return pdPASS;
+}
+
+// The thread ends when the task function returns
+void vTaskDelete(TaskHandle_t task) {}
+
+// File -----------------------------------------------------------------------
+
+namespace fs {
+
+File::Handle::~Handle() {
+    if (fp) fclose(fp);
+    if (dp) closedir(dp);
+}
+
+size_t File::size() {
+    struct stat st;
+    if (!h || h->dp) return 0;
+    if (h->fp) fflush(h->fp);
+    return stat(hostPath(h->path).c_str(), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+String File::readStringUntil(char end) {
+    std::string s;
+    int c;
+    while (h && h->fp && (c = fgetc(h->fp)) != EOF && c != end) s += (char)c;
+    return String(s);
+}
+
+File File::openNextFile() {
+    File next;
+    if (!h || !h->dp) return next;
+    struct dirent* e;
+    while ((e = readdir(h->dp)) != nullptr) {
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+        std::string child = h->path + (h->path == "/" ? "" : "/") + e->d_name;
+        return SD.open(child.c_str());
+    }
+    return next;
+}
+
+time_t File::getLastWrite() {
+    struct stat st;
+    return h && stat(hostPath(h->path).c_str(), &st) == 0 ? st.st_mtime : 0;
+}
+
+void File::close() {
+    if (!h) return;
+    if (h->fp) fclose(h->fp);
+    if (h->dp) closedir(h->dp);
+    h->fp = nullptr;
+    h->dp = nullptr;
+}
+
+File FS::open(const char* path, const char* mode) {
+    File f;
+    std::string full = hostPath(path);
+    std::shared_ptr<File::Handle> h(new File::Handle());
+    h->path = path;
+    const char* slash = strrchr(path, '/');
+    h->name = slash ? slash + 1 : path;
+
+    struct stat st;
+    if (stat(full.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        h->dp = opendir(full.c_str());
+    } else {
+        std::string m = std::string(mode) + "b";
+        h->fp = fopen(full.c_str(), m.c_str());
+    }
+    if (h->fp || h->dp) f.h = h;
+    return f;
+}
+
+bool FS::exists(const char* path) {
+    struct stat st;
+    return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path) { return ::remove(hostPath(path).c_str()) == 0; }
+bool FS::mkdir(const char* path) { return ::mkdir(hostPath(path).c_str(), 0755) == 0; }
+bool FS::rmdir(const char* path) { return ::rmdir(hostPath(path).c_str()) == 0; }
+bool FS::rename(const char* from, const char* to) {
+    return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+}  // namespace fs
+
+uint64_t SDFS::totalBytes() {
+    struct statvfs vfs;
+    return statvfs(hostSdRoot, &vfs) == 0 ? (uint64_t)vfs.f_blocks * vfs.f_frsize : 0;
+}
+
+uint64_t SDFS::usedBytes() {
+    struct statvfs vfs;
+    return statvfs(hostSdRoot, &vfs) == 0 ? (uint64_t)(vfs.f_blocks - vfs.f_bfree) * vfs.f_frsize : 0;
+}
@@ -0,0 +1,550 @@
+// Host check: the file server end to end over loopback
+//
+// Usage: loopback_check <sd-dir> [MB]
+//
+// Links the firmware's fileserver.cpp, http_server.cpp, zip_stream.cpp and
+// capture_index.cpp against a directory standing in for the SD card
+// (host/web_shims.cpp) and drives them with real HTTP clients on
+// 127.0.0.1: keep-alive, HEAD, a download of an MB-sized file (default
+// 16) alone, four at once and alongside page/JSON requests, Range and
+// ETag handling, the gzipped page and its revalidation, a multipart
+// upload full of near-delimiter bytes, a folder ZIP checked entry by entry
+// against the files it came from, one cut short by a tight heap and one
+// whose folder changes while it streams, model uploads, and stopping the server while an upload handler
+// is still busy. Build with -fsanitize=address to catch the server being
+// freed under its own task.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <lwip/sockets.h>
+#include "core/crc32.h"
+#include "ml/model_installer.h"
+#include "web/fileserver.h"
+#include "web/zip_stream.h"
+#include <esp_heap_caps.h>
+
+// ModelInstaller stand-in: counts bytes, and can hold one write() to keep
+// the server task inside a handler
+volatile bool ModelInstaller::active = false;
+size_t ModelInstaller::written = 0;
+char ModelInstaller::error[48] = "";
+ModelInstallStats ModelInstaller::stats = {};
+
+static std::atomic<int> installWriteDelayMs(0);
+static std::atomic<int> installWrites(0);
+static std::atomic<int> installAborts(0);
+
+bool ModelInstaller::begin(size_t expectedSize, uint32_t expectedCrc) {
+    if (active) {
+        strcpy(error, MODEL_INSTALL_BUSY);
+        return false;
+    }
+    active = true;
+    written = 0;
+    return true;
+}
+
+bool ModelInstaller::write(const uint8_t* data, size_t len) {
+    int ms = installWriteDelayMs.exchange(0);
+    installWrites++;
+    if (ms) std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    written += len;
+    return true;
+}
+
+bool ModelInstaller::finish() {
+    active = false;
+    memset(&stats, 0, sizeof(stats));
+    stats.ok = true;
+    stats.bytes = written;
+    return true;
+}
+
+void ModelInstaller::abort() {
+    active = false;
+    installAborts++;
+}
+
+// Client side ----------------------------------------------------------------
+
+static const auto checkStart = std::chrono::steady_clock::now();
+
+static double nowMs() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - checkStart).count();
+}
+
+static int connectServer() {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(hostHttpPort);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        perror("loopback_check: connect");
+        exit(2);
+    }
+    return fd;
+}
+
+static void sendAll(int fd, const std::string& data, size_t piece = 0) {
+    for (size_t off = 0, k = 0; off < data.size(); k++) {
+        // Awkward piece sizes so every parser boundary gets hit
+        size_t n = piece ? std::min(data.size() - off, 1 + (k * 7919) % piece) : data.size() - off;
+        ssize_t sent = send(fd, data.data() + off, n, MSG_NOSIGNAL);
+        if (sent <= 0) return;
+        off += sent;
+    }
+}
+
+struct Response {
+    int status = 0;
+    long length = -1;       // Content-Length, -1 if none (read to close)
+    std::string head;
+    std::string body;
+    bool matches = true;    // Body equals the compare file
+    double firstByteMs = 0;
+    double totalMs = 0;
+};
+
+// One response off fd. With compare, the body is checked against that
+// file as it arrives instead of being kept; slowMs paces the reads.
+static Response readResponse(int fd, const char* compare = nullptr, int slowMs = 0, bool headOnly = false) {
+    Response r;
+    double t0 = nowMs();
+    FILE* ref = compare ? fopen(compare, "rb") : nullptr;
+    std::string buf;
+    std::vector<char> chunk(65536), want(65536);
+    long got = 0;
+    bool inBody = false;
+
+    for (;;) {
+        ssize_t n = recv(fd, chunk.data(), chunk.size(), 0);
+        if (n <= 0) break;
+        if (!r.firstByteMs) r.firstByteMs = nowMs() - t0;
+        const char* data = chunk.data();
+        if (!inBody) {
+            buf.append(data, n);
+            size_t end = buf.find("\r\n\r\n");
+            if (end == std::string::npos) continue;
+            r.head = buf.substr(0, end);
+            r.status = atoi(r.head.c_str() + 9);
+            size_t p = r.head.find("Content-Length: ");
+            if (p != std::string::npos) r.length = atol(r.head.c_str() + p + 16);
+            if (r.status == 304) r.length = 0;     // Never has a body
+            inBody = true;
+            if (headOnly || r.length == 0) break;
+            buf.erase(0, end + 4);
+            data = buf.data();
+            n = buf.size();
+        }
+        if (ref) {
+            if (fread(want.data(), 1, n, ref) != (size_t)n || memcmp(want.data(), data, n) != 0) r.matches = false;
+        } else {
+            r.body.append(data, n);
+        }
+        got += n;
+        if (slowMs) std::this_thread::sleep_for(std::chrono::milliseconds(slowMs));
+        if (r.length >= 0 && got >= r.length) break;
+    }
+    if (ref) {
+        if (fgetc(ref) != EOF) r.matches = false;
+        fclose(ref);
+    }
+    r.totalMs = nowMs() - t0;
+    return r;
+}
+
+// Value of a response header, empty if absent
+static std::string headerValue(const Response& r, const char* name) {
+    std::string key = std::string("\r\n") + name + ": ";
+    size_t p = r.head.find(key);
+    if (p == std::string::npos) return std::string();
+    p += key.size();
+    return r.head.substr(p, r.head.find("\r\n", p) - p);
+}
+
+static Response request(int fd, const std::string& req, const char* compare = nullptr, int slowMs = 0,
+                        bool headOnly = false) {
+    sendAll(fd, req);
+    return readResponse(fd, compare, slowMs, headOnly);
+}
+
+static std::string get(const std::string& path, const char* extra = "", const char* method = "GET") {
+    return std::string(method) + " " + path + " HTTP/1.1\r\nHost: porkchop\r\n" + extra + "\r\n";
+}
+
+static std::string multipart(const char* path, const std::string& boundary, const char* filename,
+                             const std::string& data) {
+    std::string body = "--" + boundary + "\r\nContent-Disposition: form-data; name=\"file\"";
+    if (filename) body += std::string("; filename=\"") + filename + "\"";
+    body += "\r\nContent-Type: application/octet-stream\r\n\r\n" + data + "\r\n--" + boundary + "--\r\n";
+    return std::string("POST ") + path + " HTTP/1.1\r\nHost: porkchop\r\n"
+           "Content-Type: multipart/form-data; boundary=" + boundary + "\r\n"
+           "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+}
+
+// SD fixture ------------------------------------------------------------------
+
+static std::string sdRoot;
+
+static std::string sdPath(const std::string& path) {
+    return sdRoot + path;
+}
+
+static std::string makeData(size_t size, uint32_t seed) {
+    std::string data(size, 0);
+    for (size_t i = 0; i < size; i++) {
+        seed = seed * 1664525 + 1013904223;
+        data[i] = (char)(seed >> 24);
+    }
+    return data;
+}
+
+static bool writeFile(const std::string& path, const std::string& data) {
+    FILE* f = fopen(sdPath(path).c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+    return fclose(f) == 0 && ok;
+}
+
+static bool readFile(const std::string& path, std::string& out) {
+    FILE* f = fopen(sdPath(path).c_str(), "rb");
+    if (!f) return false;
+    out.clear();
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+    fclose(f);
+    return true;
+}
+
+// ZIP ------------------------------------------------------------------------
+
+static uint32_t get16(const std::string& s, size_t p) {
+    return (uint8_t)s[p] | (uint8_t)s[p + 1] << 8;
+}
+
+static uint32_t get32(const std::string& s, size_t p) {
+    return get16(s, p) | get16(s, p + 2) << 16;
+}
+
+// Every central entry must name the same file as its local header, and
+// its CRC, size and data must be those of the SD file under dir by that name
+static bool zipMatches(const std::string& zip, const std::string& dir, int* count) {
+    *count = 0;
+    if (zip.size() < 22 || get32(zip, zip.size() - 22) != 0x06054b50) return false;
+    size_t end = zip.size() - 22;
+    uint32_t entries = get16(zip, end + 10);
+    size_t p = get32(zip, end + 16);
+
+    for (uint32_t i = 0; i < entries; i++) {
+        if (p + 46 > zip.size() || get32(zip, p) != 0x02014b50) return false;
+        uint32_t crc = get32(zip, p + 16);
+        uint32_t size = get32(zip, p + 24);
+        uint32_t nameLen = get16(zip, p + 28);
+        uint32_t local = get32(zip, p + 42);
+        std::string name = zip.substr(p + 46, nameLen);
+        p += 46 + nameLen + get16(zip, p + 30) + get16(zip, p + 32);
+
+        if (local + 30 > zip.size() || get32(zip, local) != 0x04034b50) return false;
+        uint32_t localNameLen = get16(zip, local + 26);
+        size_t data = local + 30 + localNameLen + get16(zip, local + 28);
+        std::string want;
+        if (zip.compare(local + 30, localNameLen, name) != 0 || !readFile(dir + "/" + name, want) ||
+            want.size() != size || zip.compare(data, size, want) != 0 ||
+            Crc32::compute((const uint8_t*)want.data(), want.size()) != crc) {
+            printf("  zip entry %u (%s) does not match\n", i, name.c_str());
+            return false;
+        }
+        (*count)++;
+    }
+    return true;
+}
+
+// Checks ---------------------------------------------------------------------
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what) {
+    printf("  %-52s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+static bool startServer() {
+    FileServer::start("porkchop", "password");
+    FileServer::update();
+    return FileServer::isRunning();
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: loopback_check <sd-dir> [MB]\n");
+        return 2;
+    }
+    signal(SIGPIPE, SIG_IGN);
+    sdRoot = argv[1];
+    hostSdRoot = argv[1];
+    size_t bigSize = (argc > 2 ? strtoul(argv[2], nullptr, 0) : 16) << 20;
+
+    const char* dirs[] = { "/up", "/handshakes", "/zipme", "/zipme/sub", "/zipme/sub/deeper" };
+    for (const char* d : dirs) ::mkdir(sdPath(d).c_str(), 0755);
+    bool fixture = writeFile("/big.bin", makeData(bigSize, 1));
+    for (int i = 0; i < 12; i++) {
+        // Same sizes under different names, so a name/entry mix-up shows
+        std::string name = i < 4 ? "/zipme/f" : i < 8 ? "/zipme/sub/g" : "/zipme/sub/deeper/h";
+        fixture &= writeFile(name + std::to_string(i) + ".bin", makeData(1000 + (i % 4) * 7000, 100 + i));
+    }
+    if (!fixture) {
+        fprintf(stderr, "loopback_check: cannot write under %s\n", argv[1]);
+        return 2;
+    }
+    std::string big = sdPath("/big.bin");
+
+    printf("loopback_check: %zu MB file, SD at %s\n", bigSize >> 20, argv[1]);
+    expect(startServer(), "server starts");
+
+    // Keep-alive: several requests, then Connection: close ends it
+    int fd = connectServer();
+    Response r = request(fd, get("/", "Accept-Encoding: gzip\r\n"));
+    printf("  GET / %ld B, first byte %.2f ms\n", r.length, r.firstByteMs);
+    bool ok = r.status == 200 && r.length == (long)r.body.size();
+    ok &= request(fd, get("/api/sdinfo")).body[0] == '{';
+    ok &= request(fd, get("/api/ls?dir=%2F&full=1")).body.find("big.bin") != std::string::npos;
+    ok &= request(fd, get("/nope")).status == 404;
+    r = request(fd, get("/download?f=/big.bin", "", "HEAD"), nullptr, 0, true);
+    ok &= r.status == 200 && r.length == (long)bigSize;
+    ok &= request(fd, get("/api/sdinfo", "Connection: close\r\n")).status == 200;
+    char c;
+    ok &= recv(fd, &c, 1, 0) == 0;
+    close(fd);
+    expect(ok, "keep-alive, HEAD and Connection: close");
+
+    fd = connectServer();
+    r = request(fd, get("/download?f=/big.bin"), big.c_str());
+    close(fd);
+    printf("  1 download: %.1f MB/s, first byte %.2f ms\n", (bigSize >> 20) / (r.totalMs / 1000), r.firstByteMs);
+    expect(r.status == 200 && r.matches, "download is byte-identical");
+
+    {
+        // Validators and ranges on a download, cached page revalidation
+        std::string whole;
+        readFile("/big.bin", whole);
+        fd = connectServer();
+        r = request(fd, get("/download?f=/big.bin", "Range: bytes=1000-1999\r\n"));
+        std::string etag = headerValue(r, "ETag");
+        ok = r.status == 206 && r.body == whole.substr(1000, 1000) &&
+             headerValue(r, "Content-Range") == "bytes 1000-1999/" + std::to_string(bigSize);
+        r = request(fd, get("/download?f=/big.bin", "Range: bytes=-500\r\n"));
+        ok &= r.status == 206 && r.body == whole.substr(bigSize - 500);
+        r = request(fd, get("/download?f=/big.bin", ("Range: bytes=0-99\r\nIf-Range: " + etag + "\r\n").c_str()));
+        ok &= r.status == 206 && r.body == whole.substr(0, 100);
+        expect(ok && !etag.empty(), "Range, suffix Range and matching If-Range get 206");
+
+        r = request(fd, get("/download?f=/big.bin", ("If-None-Match: " + etag + "\r\n").c_str()));
+        ok = r.status == 304 && r.body.empty();
+        r = request(fd, get("/download?f=/big.bin", "Range: bytes=0-99\r\nIf-Range: \"stale\"\r\n"), big.c_str());
+        ok &= r.status == 200 && r.matches;
+        r = request(fd, get("/download?f=/big.bin", ("Range: bytes=" + std::to_string(bigSize) + "-\r\n").c_str()));
+        ok &= r.status == 416;
+        expect(ok, "If-None-Match 304, stale If-Range 200, bad Range 416");
+
+        r = request(fd, get("/", "Accept-Encoding: gzip\r\n"));
+        etag = headerValue(r, "ETag");
+        ok = headerValue(r, "Content-Encoding") == "gzip" && r.body.compare(0, 2, "\x1f\x8b") == 0;
+        r = request(fd, get("/", ("Accept-Encoding: gzip\r\nIf-None-Match: " + etag + "\r\n").c_str()));
+        ok &= r.status == 304;
+        r = request(fd, get("/", "Accept-Encoding: gzip;q=0\r\nConnection: close\r\n"));
+        ok &= r.status == 200 && headerValue(r, "Content-Encoding").empty() && r.body.find("PORKCHOP") != std::string::npos;
+        close(fd);
+        expect(ok, "page is gzipped, revalidates to 304, plain on q=0");
+    }
+
+    {
+        std::vector<std::thread> clients;
+        std::vector<Response> rs(HTTP_MAX_CLIENTS);
+        double t0 = nowMs();
+        for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+            clients.emplace_back([&rs, &big, i]() {
+                int f = connectServer();
+                rs[i] = request(f, get("/download?f=/big.bin"), big.c_str());
+                close(f);
+            });
+        }
+        for (auto& t : clients) t.join();
+        double worst = 0;
+        ok = true;
+        for (auto& q : rs) {
+            ok &= q.status == 200 && q.matches;
+            worst = std::max(worst, q.firstByteMs);
+        }
+        printf("  %d concurrent downloads: %.1f MB/s total, worst first byte %.2f ms\n", HTTP_MAX_CLIENTS,
+               HTTP_MAX_CLIENTS * (bigSize >> 20) / ((nowMs() - t0) / 1000), worst);
+        expect(ok, "concurrent downloads are byte-identical");
+    }
+
+    {
+        // A slow reader must not hold up the page or the JSON calls
+        std::atomic<bool> done(false);
+        Response slow;
+        std::thread reader([&]() {
+            int f = connectServer();
+            slow = request(f, get("/download?f=/big.bin"), big.c_str(), 1);
+            close(f);
+            done = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        int f = connectServer();
+        double worst = 0;
+        ok = true;
+        for (int i = 0; i < 20; i++) {
+            Response q = request(f, get(i % 2 ? "/api/ls?dir=/" : "/"));
+            ok &= q.status == 200;
+            worst = std::max(worst, q.totalMs);
+        }
+        close(f);
+        bool overlapped = !done;
+        printf("  20 page/JSON requests during a slow download: worst %.2f ms\n", worst);
+        reader.join();
+        expect(ok && overlapped && slow.status == 200 && slow.matches, "slow download doesn't block other requests");
+    }
+
+    {
+        // Upload data sprinkled with partial delimiters
+        std::string boundary = "----WebKitFormBoundaryAbC123";
+        std::string data = makeData(300000, 7);
+        srand(1);
+        for (int i = 0; i < 50; i++) {
+            data.insert(rand() % data.size(), "\r\n--" + boundary.substr(0, rand() % boundary.size()));
+        }
+        int f = connectServer();
+        double t0 = nowMs();
+        sendAll(f, multipart("/upload?dir=%2Fup", boundary, "a b.bin", data), 3000);
+        r = readResponse(f);
+        close(f);
+        std::string stored;
+        printf("  upload: %zu B in %.2f ms\n", data.size(), nowMs() - t0);
+        expect(r.status == 200 && readFile("/up/a b.bin", stored) && stored == data, "multipart upload is intact");
+    }
+
+    {
+        // HTTP/1.0, so the stream is close-delimited rather than chunked
+        int f = connectServer();
+        r = request(f, "GET /downloadzip?dir=%2Fzipme HTTP/1.0\r\n\r\n");
+        close(f);
+        int entries = 0;
+        bool match = zipMatches(r.body, "/zipme", &entries);
+        printf("  ZIP of /zipme: %zu B, %d entries\n", r.body.size(), entries);
+        expect(r.status == 200 && match && entries == 12, "folder ZIP entries match their files");
+    }
+
+    {
+        // Heap too tight for the entry table to grow past 128 files: the
+        // archive stops there with a central directory that still matches
+        ::mkdir(sdPath("/zipmany").c_str(), 0755);
+        for (int i = 0; i < 200; i++) writeFile("/zipmany/m" + std::to_string(1000 + i), makeData(64, 300 + i));
+        hostLargestFreeBlock = ZIP_HEAP_RESERVE + 128 * 16 + 1024;
+        int f = connectServer();
+        r = request(f, "GET /downloadzip?dir=%2Fzipmany HTTP/1.0\r\n\r\n");
+        close(f);
+        hostLargestFreeBlock = SIZE_MAX;
+        int entries = 0;
+        bool match = zipMatches(r.body, "/zipmany", &entries);
+        printf("  ZIP of 200 files on a tight heap: %d entries\n", entries);
+        expect(r.status == 200 && match && entries == 128, "ZIP entry table stops at the heap limit");
+    }
+
+    {
+        // Rename a file while its folder streams: the central directory
+        // can't name it any more, so the stream has to be cut short rather
+        // than end with a clean final chunk
+        ::mkdir(sdPath("/zipchange").c_str(), 0755);
+        for (int i = 0; i < 3; i++) writeFile("/zipchange/c" + std::to_string(i) + ".bin", makeData(8 << 20, 200 + i));
+        int f = connectServer();
+        sendAll(f, get("/downloadzip?dir=%2Fzipchange", "Connection: close\r\n"));
+        std::string raw(65536, 0);
+        ssize_t n = recv(f, &raw[0], raw.size(), MSG_WAITALL);
+        raw.resize(n > 0 ? n : 0);
+        ok = ::rename(sdPath("/zipchange/c1.bin").c_str(), sdPath("/zipchange/renamed.bin").c_str()) == 0;
+        char buf[65536];
+        while ((n = recv(f, buf, sizeof(buf), 0)) > 0) raw.append(buf, n);
+        close(f);
+        bool clean = raw.size() >= 5 && raw.compare(raw.size() - 5, 5, "0\r\n\r\n") == 0;
+        expect(ok && raw.compare(0, 15, "HTTP/1.1 200 OK") == 0 && !clean, "folder changed mid-ZIP cuts the stream");
+    }
+
+    {
+        int f = connectServer();
+        r = request(f, get("/", ("X-Big: " + std::string(2000, 'a') + "\r\n").c_str()));
+        close(f);
+        expect(r.status == 431, "oversized request head gets 431");
+    }
+
+    {
+        std::string boundary = "modelboundary";
+        int f = connectServer();
+        r = request(f, multipart("/api/model", boundary, nullptr, "not a file"));
+        expect(r.status == 400, "model POST without a file part gets 400");
+        r = request(f, multipart("/api/model", boundary, "model.bin", makeData(50000, 3)));
+        close(f);
+        expect(r.status == 200 && r.body.find("50000 bytes") != std::string::npos, "model upload reaches the installer");
+    }
+
+    {
+        // Serial install already open: the upload is refused and never
+        // writes into or aborts that session
+        ModelInstaller::begin(1000);
+        int writes = installWrites;
+        int aborts = installAborts;
+        int f = connectServer();
+        r = request(f, multipart("/api/model", "busy", "model.bin", makeData(50000, 4)));
+        close(f);
+        expect(r.status == 503, "model upload during another install gets 503");
+        expect(installWrites == writes && installAborts == aborts && ModelInstaller::isActive(),
+               "refused upload leaves the open session alone");
+        ModelInstaller::abort();
+    }
+
+    {
+        // Stop while the upload handler is stuck: the server has to outlive
+        // its task, and a restart frees it once the task is gone
+        installWriteDelayMs = 5000;     // Past stop()'s wait, and a second one
+        int writes = installWrites;
+        int aborts = installAborts;
+        std::thread uploader([]() {
+            int f = connectServer();
+            sendAll(f, multipart("/api/model", "stuck", "model.bin", makeData(200000, 5)));
+            readResponse(f);
+            close(f);
+        });
+        while (installWrites == writes) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        double t0 = nowMs();
+        FileServer::stop();
+        printf("  stop with a busy handler returned after %.0f ms\n", nowMs() - t0);
+        expect(!FileServer::isRunning(), "stop with a busy handler");
+        uploader.join();
+        expect(startServer(), "restart once the handler returns");
+        expect(installAborts == aborts + 1, "busy upload aborted when the task exits");
+        fd = connectServer();
+        expect(request(fd, get("/api/sdinfo", "Connection: close\r\n")).status == 200, "restarted server answers");
+        close(fd);
+    }
+
+    FileServer::stop();
+    expect(!FileServer::isRunning(), "server stops");
+
+    printf("%s\n", failures ? "FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}